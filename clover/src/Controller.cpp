@@ -1,5 +1,6 @@
 #include "Controller.h"
 #include "MutexGuard.h"
+#include "RateGroup.h"
 #include "config.h"
 #include "flight/FlightController.h"
 #include "flight/StateEstimator.h"
@@ -14,6 +15,9 @@
 #include <zephyr/kernel/thread_stack.h>
 #include <zephyr/logging/log.h>
 
+#include <optional>
+#include <tuple>
+
 #include "PwmActuator.h"
 #include "ThrottleValve.h"
 #include "hornet/HornetRcs.h"
@@ -22,6 +26,7 @@
 #include "ranger/RangerRcs.h"
 #include "ranger/RangerThrottle.h"
 #include "ranger/RangerTvc.h"
+#include "sim/ControllerBenchmark.h"
 
 LOG_MODULE_REGISTER(Controller, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -57,6 +62,26 @@ float prev_yaw_servo_command = 0.0f;
 static uint64_t trace_start_cycle = 0;
 static float trace_total_time_msec = 0;
 
+// Valid in THROTTLE, TVC, RCS, FLIGHT and STATIC_FIRE. Each module runs in its rate group, counted in control ticks
+// from the start of the trace, and its latest output is held on the ticks it skips.
+static uint64_t active_control_tick = 0;
+static RateGroup flight_outer_group{FLIGHT_OUTER_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK};
+static RateGroup flight_inner_group{FLIGHT_INNER_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK};
+static RateGroup throttle_group{THROTTLE_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK};
+static RateGroup tvc_group{TVC_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK};
+static RateGroup rcs_group{RCS_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK};
+static std::optional<FlightControllerDesiredState> flight_outer_output;
+static std::optional<std::tuple<float, float, float, FlightControllerMetrics>> flight_inner_output;
+#ifdef CONFIG_RANGER
+static std::optional<std::tuple<ThrottleValveCommand, ThrottleValveCommand, RangerThrottleMetrics>> throttle_output;
+static std::optional<std::tuple<TvcActuatorCommand, TvcActuatorCommand, RangerTvcMetrics>> tvc_output;
+static std::optional<std::tuple<bool, bool, RangerRcsMetrics>> rcs_output;
+#elif CONFIG_HORNET
+static std::optional<std::tuple<float, HornetThrottleMetrics>> throttle_output;
+static std::optional<std::tuple<float, float, HornetTvcMetrics>> tvc_output;
+static std::optional<std::tuple<float, float, HornetRcsMetrics>> rcs_output;
+#endif
+
 // Valid in ABORT.
 static uint64_t abort_start_cycle = 0;
 
@@ -120,6 +145,107 @@ static void control_loop_schedule(k_timer* timer)
 
 K_TIMER_DEFINE(control_loop_schedule_timer, control_loop_schedule, nullptr);
 
+/// Starts the trace clock and the rate groups for an active control state. Must be called when state lock is held.
+static void start_active_control()
+{
+    trace_start_cycle = k_cycle_get_64();
+    active_control_tick = 0;
+
+    for (RateGroup* group : {&flight_outer_group, &flight_inner_group, &throttle_group, &tvc_group, &rcs_group}) {
+        group->reset_stats();
+    }
+    flight_outer_output.reset();
+    flight_inner_output.reset();
+#if defined(CONFIG_RANGER) || defined(CONFIG_HORNET)
+    throttle_output.reset();
+    tvc_output.reset();
+    rcs_output.reset();
+#endif
+}
+
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+/// Benchmark phase a rate group's module is recorded under.
+static ControllerBenchmark::Phase benchmark_module_phase(const RateGroup& group)
+{
+    if (&group == &flight_outer_group) {
+        return ControllerBenchmark::Phase::FLIGHT_OUTER;
+    }
+    if (&group == &flight_inner_group) {
+        return ControllerBenchmark::Phase::FLIGHT_INNER;
+    }
+    if (&group == &throttle_group) {
+        return ControllerBenchmark::Phase::THROTTLE;
+    }
+    if (&group == &tvc_group) {
+        return ControllerBenchmark::Phase::TVC;
+    }
+    return ControllerBenchmark::Phase::RCS;
+}
+
+/// Records the time since mark_ns as one phase of the tick, adds it to the tick total, and restarts the mark, so the
+/// recording itself is left out of both.
+static void benchmark_phase(SystemState state, ControllerBenchmark::Phase phase, uint64_t& mark_ns, uint64_t& tick_ns)
+{
+    const uint64_t elapsed_ns = ControllerBenchmark::now_ns() - mark_ns;
+    ControllerBenchmark::record(state, phase, elapsed_ns);
+    tick_ns += elapsed_ns;
+    mark_ns = ControllerBenchmark::now_ns();
+}
+#endif  // CONFIG_CONTROLLER_BENCHMARK
+
+/// Runs a module when its rate group is due, or on its first tick of the trace so there is always an output to hold,
+/// and records the group's timing in the data packet. Returns the module's latest output.
+template <typename T, typename F>
+static std::expected<T, Error> run_rate_group(
+    RateGroup& group, std::optional<T>& held, uint64_t tick_time_ns, bool& has_timing, RateGroupTiming& timing, F&& run)
+{
+    bool ran = !held.has_value() || group.due(active_control_tick);
+    if (ran) {
+        float dt_s = group.begin(tick_time_ns);
+        uint64_t start_cycle = k_cycle_get_64();
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+        const uint64_t benchmark_start_ns = ControllerBenchmark::now_ns();
+#endif
+        std::expected<T, Error> output = run(dt_s);
+        group.end(static_cast<uint64_t>(nsec_since_cycle(start_cycle)));
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+        ControllerBenchmark::record(current_state, benchmark_module_phase(group), ControllerBenchmark::now_ns() - benchmark_start_ns);
+#endif
+        if (!output.has_value()) {
+            return std::unexpected(output.error());
+        }
+        held = *output;
+    }
+
+    const RateGroupStats& stats = group.stats();
+    has_timing = true;
+    timing = RateGroupTiming{
+        .ran = ran,
+        .dt_s = stats.dt_s,
+        .exec_time_ns = static_cast<float>(stats.exec_time_ns),
+        .max_exec_time_ns = static_cast<float>(stats.max_exec_time_ns),
+        .run_count = stats.run_count,
+        .overrun_count = stats.overrun_count,
+    };
+    return *held;
+}
+
+/// Latest thrust reported by the throttle module [N], for flight gain scheduling. Flight runs ahead of the throttle in
+/// the tick, so this is the previous throttle output, or 0 before the throttle has run.
+static float latest_thrust_N()
+{
+#ifdef CONFIG_RANGER
+    if (throttle_output.has_value()) {
+        return std::get<2>(*throttle_output).predicted_thrust_lbf / N_TO_LBF;
+    }
+#elif CONFIG_HORNET
+    if (throttle_output.has_value() && std::get<1>(*throttle_output).has_thrust_N) {
+        return std::get<1>(*throttle_output).thrust_N;
+    }
+#endif
+    return 0.0f;
+}
+
 // TODO roll control. the module should not accept a position as that is active control
 
 /// Transform actuator commands into actuator commands, modifying the data pcket in-place.
@@ -194,10 +320,36 @@ static std::expected<void, Error> tick_active_control(DataPacket& data)
         data.has_rcs_roll_command_deg = true;
         data.rcs_roll_command_deg = *roll_sample;
 
-        // Execute flight controller to generate raw acceleration commands
-        auto flight_response = FlightController::tick(data.estimated_state, data.flight_x_command_m, data.flight_y_command_m, data.flight_z_command_m);
+        // Execute flight controller to generate raw acceleration commands. The outer loop turns position commands into
+        // a setpoint that the faster inner loop tracks.
+        auto desired_state = run_rate_group(
+            flight_outer_group,
+            flight_outer_output,
+            data.time_ns,
+            data.controller_timing.has_flight_outer,
+            data.controller_timing.flight_outer,
+            [&](float dt_s) {
+                return FlightController::tick_outer(
+                    data.estimated_state,
+                    data.flight_x_command_m,
+                    data.flight_y_command_m,
+                    data.flight_z_command_m,
+                    latest_thrust_N(),
+                    dt_s);
+            });
+        if (!desired_state.has_value()) {
+            return std::unexpected(desired_state.error().context("error in FlightController outer loop"));
+        }
+
+        auto flight_response = run_rate_group(
+            flight_inner_group,
+            flight_inner_output,
+            data.time_ns,
+            data.controller_timing.has_flight_inner,
+            data.controller_timing.flight_inner,
+            [&](float dt_s) { return FlightController::tick_inner(data.estimated_state, *desired_state, dt_s); });
         if (!flight_response.has_value()) {
-            return std::unexpected(flight_response.error().context("error in FlightController"));
+            return std::unexpected(flight_response.error().context("error in FlightController inner loop"));
         }
         data.has_flight_pitch_accel_rad_s2 = true;
         data.has_flight_yaw_accel_rad_s2 = true;
@@ -251,7 +403,13 @@ static std::expected<void, Error> tick_active_control(DataPacket& data)
         if (!data.has_throttle_thrust_command_lbf) {
             return std::unexpected(Error::from_cause("missing throttle thrust command"));
         }
-        auto throttle_response = RangerThrottle::tick(data.analog_sensors, data.throttle_thrust_command_lbf);
+        auto throttle_response = run_rate_group(
+            throttle_group,
+            throttle_output,
+            data.time_ns,
+            data.controller_timing.has_throttle,
+            data.controller_timing.throttle,
+            [&](float) { return RangerThrottle::tick(data.analog_sensors, data.throttle_thrust_command_lbf); });
         if (!throttle_response.has_value()) {
             return std::unexpected(throttle_response.error().context("error in RangerThrottle"));
         }
@@ -264,7 +422,13 @@ static std::expected<void, Error> tick_active_control(DataPacket& data)
         if (!data.has_flight_z_accel_m_s2) {
             return std::unexpected(Error::from_cause("missing flight z acceleration command"));
         }
-        auto throttle_response = HornetThrottle::tick(data.flight_z_accel_m_s2);
+        auto throttle_response = run_rate_group(
+            throttle_group,
+            throttle_output,
+            data.time_ns,
+            data.controller_timing.has_throttle,
+            data.controller_timing.throttle,
+            [&](float) { return HornetThrottle::tick(data.flight_z_accel_m_s2); });
         if (!throttle_response.has_value()) {
             return std::unexpected(throttle_response.error().context("error in HornetThrottle"));
         }
@@ -282,7 +446,13 @@ static std::expected<void, Error> tick_active_control(DataPacket& data)
         if (!data.has_tvc_yaw_command_deg) {
             return std::unexpected(Error::from_cause("missing tvc yaw command"));
         }
-        auto tvc_response = RangerTvc::tick(data.tvc_pitch_command_deg, data.tvc_yaw_command_deg);
+        auto tvc_response = run_rate_group(
+            tvc_group,
+            tvc_output,
+            data.time_ns,
+            data.controller_timing.has_tvc,
+            data.controller_timing.tvc,
+            [&](float) { return RangerTvc::tick(data.tvc_pitch_command_deg, data.tvc_yaw_command_deg); });
         if (!tvc_response.has_value()) {
             return std::unexpected(tvc_response.error().context("error in RangerTvc"));
         }
@@ -295,7 +465,15 @@ static std::expected<void, Error> tick_active_control(DataPacket& data)
         if (!data.has_flight_pitch_accel_rad_s2 || !data.has_flight_yaw_accel_rad_s2 || !data.has_hornet_throttle_metrics) {
             return std::unexpected(Error::from_cause("missing flight acceleration commands for TVC"));
         }
-        auto tvc_response = HornetTvc::tick(data.flight_pitch_accel_rad_s2, data.flight_yaw_accel_rad_s2, data.hornet_throttle_metrics.thrust_N);
+        auto tvc_response = run_rate_group(
+            tvc_group,
+            tvc_output,
+            data.time_ns,
+            data.controller_timing.has_tvc,
+            data.controller_timing.tvc,
+            [&](float) {
+                return HornetTvc::tick(data.flight_pitch_accel_rad_s2, data.flight_yaw_accel_rad_s2, data.hornet_throttle_metrics.thrust_N);
+            });
         if (!tvc_response.has_value()) {
             return std::unexpected(tvc_response.error().context("error in HornetTvc"));
         }
@@ -312,7 +490,13 @@ static std::expected<void, Error> tick_active_control(DataPacket& data)
         }
 
 #ifdef CONFIG_RANGER
-        auto rcs_response = RangerRcs::tick(data.rcs_roll_command_deg);
+        auto rcs_response = run_rate_group(
+            rcs_group,
+            rcs_output,
+            data.time_ns,
+            data.controller_timing.has_rcs,
+            data.controller_timing.rcs,
+            [&](float) { return RangerRcs::tick(data.rcs_roll_command_deg); });
         if (!rcs_response.has_value()) {
             return std::unexpected(rcs_response.error().context("error in RangerRcs"));
         }
@@ -324,7 +508,13 @@ static std::expected<void, Error> tick_active_control(DataPacket& data)
         std::tie(data.has_pitch_servo_command, data.has_pitch_servo_command, data.ranger_rcs_metrics) = *rcs_response;
 
 #elif CONFIG_HORNET
-        auto rcs_response = HornetRcs::tick(data.estimated_state, data.rcs_roll_command_deg);
+        auto rcs_response = run_rate_group(
+            rcs_group,
+            rcs_output,
+            data.time_ns,
+            data.controller_timing.has_rcs,
+            data.controller_timing.rcs,
+            [&](float) { return HornetRcs::tick(data.estimated_state, data.rcs_roll_command_deg); });
         if (!rcs_response.has_value()) {
             return std::unexpected(rcs_response.error().context("error in HornetRcs"));
         }
@@ -369,6 +559,7 @@ std::expected<void, Error> Controller::init()
 
 #ifdef CONFIG_FLIGHT
     StateEstimator::init();
+    StateEstimator::start();
 #endif  // CONFIG_FLIGHT
 
     k_sched_unlock();
@@ -390,6 +581,7 @@ std::expected<void, Error> Controller::init()
 
 // Only read/written to by tick workqueue.
 static uint64_t packet_number = 0;
+static uint32_t last_imu_sample_counter = 0;
 
 /// Execute one tick of the top-level controller.
 static void step_control_loop(k_work*)
@@ -397,6 +589,11 @@ static void step_control_loop(k_work*)
     MutexGuard current_state_guard{&controller_state_lock};
 
     uint64_t start_cycle = k_cycle_get_64();
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+    const SystemState benchmark_state = current_state;
+    uint64_t benchmark_mark_ns = ControllerBenchmark::now_ns();
+    uint64_t benchmark_tick_ns = 0;
+#endif
     DataPacket data = DataPacket_init_default;
     data.time_ns = k_cyc_to_ns_near64(start_cycle);
     data.state = current_state;
@@ -423,22 +620,7 @@ static void step_control_loop(k_work*)
 #ifdef CONFIG_GNSS
     if (auto gnss = Gnss::read()) {
         data.has_gnss = true;
-        data.gnss.north_m = gnss->north_m;
-        data.gnss.east_m = gnss->east_m;
-        data.gnss.up_m = gnss->up_m;
-        data.gnss.pos_sigma_m = gnss->pos_sigma_m;
-        data.gnss.vx_ms = gnss->vx_ms;
-        data.gnss.vy_ms = gnss->vy_ms;
-        data.gnss.vz_ms = gnss->vz_ms;
-        data.gnss.vel_sigma_ms = gnss->vel_sigma_ms;
-        data.gnss.hrms_m = gnss->hrms_m;
-        data.gnss.vrms_m = gnss->vrms_m;
-        data.gnss.hvel_rms_ms = gnss->hvel_rms_ms;
-        data.gnss.vvel_rms_ms = gnss->vvel_rms_ms;
-        data.gnss.solution_time_ms = gnss->solution_time_ms;
-        data.gnss.receiver_time_ms = gnss->receiver_time_ms;
-        data.gnss.sol_type = gnss->sol_type;
-        data.gnss.sense_time_ns = gnss->sense_time_ns;
+        data.gnss = Gnss::to_proto(*gnss);
         LOG_INF(
             "[Gnss] sol_type=%u sol_time=%u ms rx_time=%u ms",
             Gnss::current_reading.sol_type,
@@ -486,7 +668,10 @@ static void step_control_loop(k_work*)
 #endif  // CONFIG_LIDAR
 
 #ifdef CONFIG_IMU
-    if (auto vectornav = VectornavImu::read()) {
+    // The estimator thread consumes IMU readings and their increments; telemetry takes each new sample once.
+    auto vectornav = VectornavImu::latest();
+    if (vectornav && vectornav->sample_counter != last_imu_sample_counter) {
+        last_imu_sample_counter = vectornav->sample_counter;
         data.imu = *vectornav;
         data.has_imu = true;
         LOG_INF(
@@ -524,13 +709,17 @@ static void step_control_loop(k_work*)
     // Valve actuator statuses
 
 #ifdef CONFIG_FLIGHT
-    auto estimated_state = StateEstimator::estimate(data.lidar_1, data.lidar_2, data.imu, data.gnss);
-    if (estimated_state) {
+    // The estimator runs in its own thread at the IMU rate; take its newest estimate without waiting.
+    if (auto estimate = StateEstimator::latest()) {
         data.has_estimated_state = true;
-        data.estimated_state = *estimated_state;
+        data.estimated_state = estimate->state;
+        uint64_t estimate_age_ns = data.time_ns > estimate->time_ns ? data.time_ns - estimate->time_ns : 0;
+        data.estimated_state.estimate_age_ns = static_cast<float>(estimate_age_ns);
+        data.estimated_state.stale = data.estimated_state.stale || estimate_age_ns > IMU_STALE_AFTER_NS;
+        data.controller_timing.state_estimator_update_time_ns = estimate->update_time_ns;
     }
     else {
-        // TODO: handle estimate failure; leaving defaults for now
+        // No estimate published yet; leaving defaults
     }
 #endif  // CONFIG_FLIGHT
 
@@ -568,6 +757,10 @@ static void step_control_loop(k_work*)
     data.yaw_servo_command = prev_yaw_servo_command;
 #endif  // CONFIG_PWM_ACTUATORS
 
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+    benchmark_phase(benchmark_state, ControllerBenchmark::Phase::SENSE, benchmark_mark_ns, benchmark_tick_ns);
+#endif
+
     // Transform sensor data into actuator commands. Different logic paths are applied via state machine.
     switch (current_state) {
     case SystemState_STATE_IDLE:
@@ -599,11 +792,10 @@ static void step_control_loop(k_work*)
     // Calibration of throttle valves.
 #ifdef CONFIG_THROTTLE_VALVES
     case SystemState_STATE_CALIBRATE_THROTTLE_VALVE: {
-        const float valve_pos = (calibrating_valve == ThrottleValveType_FUEL) ? data.fuel_valve_status.encoder_pos_deg : data.lox_valve_status.encoder_pos_deg;
         const float valve_pos_enc =
             (calibrating_valve == ThrottleValveType_FUEL) ? data.fuel_valve_status.encoder_pos_deg : data.lox_valve_status.encoder_pos_deg;
 
-        auto cal_result = RangerThrottle::calibration_tick(calibrating_valve, (uint32_t)k_uptime_get(), valve_pos, valve_pos_enc);
+        auto cal_result = RangerThrottle::calibration_tick(calibrating_valve, (uint32_t)k_uptime_get(), valve_pos_enc);
 
         if (!cal_result.has_value()) {
             LOG_ERR("Throttle valve calibration error: %s", cal_result.error().build_message().c_str());
@@ -617,6 +809,17 @@ static void step_control_loop(k_work*)
         else {
             data.lox_valve_command = *cal_result;
         }
+
+        if (auto calibration = RangerThrottle::calibration_result()) {
+            if (calibrating_valve == ThrottleValveType_FUEL) {
+                FuelValve::set_calibration(*calibration);
+            }
+            else {
+                LoxValve::set_calibration(*calibration);
+            }
+            LOG_INF("Throttle valve calibration finished, entering IDLE");
+            current_state = SystemState_STATE_IDLE;
+        }
         break;
     }
 #endif  // CONFIG_THROTTLE_VALVES
@@ -638,6 +841,7 @@ static void step_control_loop(k_work*)
 
         // Dispatch to active control handler, which returns an Error if an abort is necessary.
         auto result = tick_active_control(data);
+        active_control_tick++;
 
         if (!result.has_value()) {
             // Abort case may leave some actuators partially set, depending on when the error occurs.
@@ -661,6 +865,10 @@ static void step_control_loop(k_work*)
     }
     }
 
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+    benchmark_phase(benchmark_state, ControllerBenchmark::Phase::CONTROL, benchmark_mark_ns, benchmark_tick_ns);
+#endif
+
     // Dispatch commands to actuators
 #if CONFIG_THROTTLE_VALVES
     auto fuel_valve_result = FuelValve::tick(data.fuel_valve_command);
@@ -716,6 +924,10 @@ static void step_control_loop(k_work*)
     prev_yaw_servo_command = data.yaw_servo_command;
 #endif  // CONFIG_PWM_ACTUATORS
 
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+    benchmark_phase(benchmark_state, ControllerBenchmark::Phase::ACTUATE, benchmark_mark_ns, benchmark_tick_ns);
+#endif
+
     // Record how long controller tick calculations took.
     data.controller_timing.controller_tick_time_ns = nsec_since_cycle(start_cycle);
 
@@ -739,6 +951,11 @@ static void step_control_loop(k_work*)
 #ifdef CONFIG_ANALOG_SENSORS
     AnalogSensors::start_sense();
 #endif  // CONFIG_ANALOG_SENSORS
+
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+    benchmark_phase(benchmark_state, ControllerBenchmark::Phase::TELEMETRY, benchmark_mark_ns, benchmark_tick_ns);
+    ControllerBenchmark::record(benchmark_state, ControllerBenchmark::Phase::TICK, benchmark_tick_ns);
+#endif
 }
 
 /// Retrieves a data packet from the telemetry message queue.
@@ -865,10 +1082,9 @@ std::expected<void, Error> Controller::handle_calibrate_throttle_valve(const Cal
     }
 
 #ifdef CONFIG_RANGER
-    const float valve_pos = (req.valve == ThrottleValveType_FUEL) ? FuelValve::get_pos_internal() : LoxValve::get_pos_internal();
     const float valve_pos_enc = (req.valve == ThrottleValveType_FUEL) ? FuelValve::get_pos_encoder() : LoxValve::get_pos_encoder();
 
-    RangerThrottle::calibration_reset(req.valve, valve_pos, valve_pos_enc);
+    RangerThrottle::calibration_reset(req.valve, (uint32_t)k_uptime_get(), valve_pos_enc);
     calibrating_valve = req.valve;
 #endif
 
@@ -946,7 +1162,7 @@ std::expected<void, Error> Controller::handle_start_throttle_valve_sequence(cons
         return std::unexpected(Error::from_cause("State must be THROTTLE_VALVE_PRIMED to enter THROTTLE_VALVE"));
     }
 
-    trace_start_cycle = k_cycle_get_64();
+    start_active_control();
     current_state = SystemState_STATE_THROTTLE_VALVE;
 
     LOG_INF("Starting throttle valve sequence");
@@ -990,7 +1206,7 @@ std::expected<void, Error> Controller::handle_start_throttle_sequence(const Star
     }
 
     RangerThrottle::reset();
-    trace_start_cycle = k_cycle_get_64();
+    start_active_control();
     current_state = SystemState_STATE_THROTTLE;
 
     LOG_INF("Starting throttle thrust sequence");
@@ -1063,7 +1279,7 @@ std::expected<void, Error> Controller::handle_start_tvc_sequence(const StartTvcS
         return std::unexpected(Error::from_cause("State must be TVC_PRIMED to enter TVC"));
     }
 
-    trace_start_cycle = k_cycle_get_64();
+    start_active_control();
     current_state = SystemState_STATE_TVC;
 
     LOG_INF("Starting TVC sequence");
@@ -1120,7 +1336,7 @@ std::expected<void, Error> Controller::handle_start_rcs_valve_sequence(const Sta
         return std::unexpected(Error::from_cause("State must be RCS_VALVE_PRIMED to enter RCS_VALVE"));
     }
 
-    trace_start_cycle = k_cycle_get_64();
+    start_active_control();
     current_state = SystemState_STATE_RCS_VALVE;
 
     LOG_INF("Starting RCS valve sequence");
@@ -1161,7 +1377,7 @@ std::expected<void, Error> Controller::handle_start_rcs_sequence(const StartRcsS
         return std::unexpected(Error::from_cause("State must be RCS_PRIMED to enter RCS"));
     }
 
-    trace_start_cycle = k_cycle_get_64();
+    start_active_control();
     current_state = SystemState_STATE_RCS;
 
     LOG_INF("Starting RCS roll sequence");
@@ -1204,7 +1420,7 @@ std::expected<void, Error> Controller::handle_load_static_fire_sequence(const Lo
             static_cast<double>(tvc_pitch_trace_deg.get_total_time_ms()),
             static_cast<double>(tvc_yaw_trace_deg.get_total_time_ms())));
     }
-    trace_total_time_msec = flight_x_trace_m.get_total_time_ms();
+    trace_total_time_msec = throttle_thrust_lbf.get_total_time_ms();
 
     current_state = SystemState_STATE_STATIC_FIRE_PRIMED;
     LOG_INF("Primed static fire sequence");
@@ -1223,7 +1439,7 @@ std::expected<void, Error> Controller::handle_start_static_fire_sequence(const S
         return std::unexpected(Error::from_cause("State must be STATIC_FIRE_PRIMED to enter static fire"));
     }
 
-    trace_start_cycle = k_cycle_get_64();
+    start_active_control();
     current_state = SystemState_STATE_STATIC_FIRE;
 
     LOG_INF("Starting static fire sequence");
@@ -1292,7 +1508,7 @@ std::expected<void, Error> Controller::handle_start_flight_sequence(const StartF
         return std::unexpected(Error::from_cause("State must be FLIGHT_PRIMED to enter FLIGHT"));
     }
 
-    trace_start_cycle = k_cycle_get_64();
+    start_active_control();
     FlightController::reset();
     current_state = SystemState_STATE_FLIGHT;
 
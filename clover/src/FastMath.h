@@ -0,0 +1,168 @@
+#ifndef APP_FAST_MATH_H
+#define APP_FAST_MATH_H
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+/// Polynomial approximations of the trig and square root functions the control path calls every tick, with bounded
+/// error and no transcendental libm calls, lookup tables or data-dependent loops. Max errors are measured over the whole domain by the
+/// FastMath accuracy test:
+///
+///   function      domain              max error
+///   sin, cos      |x| <= 1e4 rad      2e-7 absolute (1e-7 within |x| <= 2 pi; grows past 1e4 with the range reduction)
+///   tan           |x| <= 1e4 rad      2e-7 * (|tan x| + tan^2 x + 1) absolute, i.e. relative away from the poles
+///   atan2         all finite y, x     3e-7 rad absolute
+///   asin          [-1, 1]             2e-7 rad absolute
+///   rsqrt         x > 0, normal       5e-6 relative
+///
+/// Control modules pick an implementation at compile time: fastmath::Fast or fastmath::Precise directly, or GncMath,
+/// which follows CONFIG_GNC_FAST_MATH.
+namespace fastmath {
+
+namespace detail {
+
+    // pi/2 split so that k * PIO2_HI is exact for the k range reduction sees
+    constexpr float PIO2_HI = 1.5703125f;
+    constexpr float PIO2_LO = 4.83826794897e-4f;
+    constexpr float TWO_OVER_PI = 0.636619772367581f;
+
+    // Minimax polynomials on [-pi/4, pi/4]
+    inline float sin_poly(float r)
+    {
+        const float z = r * r;
+        return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+    }
+
+    inline float cos_poly(float r)
+    {
+        const float z = r * r;
+        return 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+    }
+
+    // Reduces x to r in [-pi/4, pi/4] with x = r + quadrant * pi/2. Rounds through a float-to-int conversion, a
+    // single instruction where nearbyint may be a library call.
+    inline float reduce(float x, int32_t& quadrant)
+    {
+        quadrant = static_cast<int32_t>(x * TWO_OVER_PI + (x >= 0.0f ? 0.5f : -0.5f));
+        const float k = static_cast<float>(quadrant);
+        return (x - k * PIO2_HI) - k * PIO2_LO;
+    }
+
+    // Minimax polynomial for atan on [-tan(pi/8), tan(pi/8)]
+    inline float atan_poly(float t)
+    {
+        const float z = t * t;
+        return t + t * z * (-3.33329491539e-1f + z * (1.99777106478e-1f + z * (-1.38776856032e-1f + z * 8.05374449538e-2f)));
+    }
+
+    // atan for t >= 0, reduced into the polynomial's range by atan(t) = pi/4 + atan((t - 1) / (t + 1)) and
+    // atan(t) = pi/2 - atan(1 / t).
+    inline float atan_positive(float t)
+    {
+        if (t > 2.414213562373095f) {
+            return std::numbers::pi_v<float> / 2.0f - atan_poly(1.0f / t);
+        }
+        if (t > 0.4142135623730950f) {
+            return std::numbers::pi_v<float> / 4.0f + atan_poly((t - 1.0f) / (t + 1.0f));
+        }
+        return atan_poly(t);
+    }
+
+}  // namespace detail
+
+struct Fast {
+    static float sin(float x)
+    {
+        int32_t quadrant;
+        const float r = detail::reduce(x, quadrant);
+        const float s = (quadrant & 1) ? detail::cos_poly(r) : detail::sin_poly(r);
+        return (quadrant & 2) ? -s : s;
+    }
+
+    static float cos(float x)
+    {
+        int32_t quadrant;
+        const float r = detail::reduce(x, quadrant);
+        const float c = (quadrant & 1) ? detail::sin_poly(r) : detail::cos_poly(r);
+        return ((quadrant + 1) & 2) ? -c : c;
+    }
+
+    static float tan(float x)
+    {
+        int32_t quadrant;
+        const float r = detail::reduce(x, quadrant);
+        const float s = detail::sin_poly(r);
+        const float c = detail::cos_poly(r);
+        return (quadrant & 1) ? -c / s : s / c;
+    }
+
+    static float atan2(float y, float x)
+    {
+        const float ax = std::fabs(x);
+        const float ay = std::fabs(y);
+        if (ax == 0.0f && ay == 0.0f) {
+            return std::signbit(x) ? std::copysign(std::numbers::pi_v<float>, y) : std::copysign(0.0f, y);
+        }
+
+        // Keep the ratio within [0, 1] so it never overflows, and fold the octant back in.
+        float angle = ay <= ax ? detail::atan_positive(ay / ax) : std::numbers::pi_v<float> / 2.0f - detail::atan_positive(ax / ay);
+        if (std::signbit(x)) {
+            angle = std::numbers::pi_v<float> - angle;
+        }
+        return std::copysign(angle, y);
+    }
+
+    static float asin(float x)
+    {
+        const float a = std::fabs(x);
+        float result;
+        if (a > 0.5f) {
+            // asin(a) = pi/2 - 2 asin(sqrt((1 - a) / 2)), keeping the polynomial argument within [0, 0.5]
+            const float z = 0.5f * (1.0f - a);
+            const float s = std::sqrt(z);
+            result = std::numbers::pi_v<float> / 2.0f - 2.0f * asin_poly(s, z);
+        }
+        else {
+            result = asin_poly(a, a * a);
+        }
+        return std::copysign(result, x);
+    }
+
+    /// 1 / sqrt(x): bit-level initial guess refined by two Newton steps, avoiding the divide.
+    static float rsqrt(float x)
+    {
+        float y = std::bit_cast<float>(0x5f375a86u - (std::bit_cast<uint32_t>(x) >> 1));
+        const float half_x = 0.5f * x;
+        y = y * (1.5f - half_x * y * y);
+        y = y * (1.5f - half_x * y * y);
+        return y;
+    }
+
+private:
+    // Minimax polynomial for asin on [0, 0.5], given a and z = a^2
+    static float asin_poly(float a, float z)
+    {
+        return a + a * z * (1.6666752422e-1f + z * (7.4953002686e-2f + z * (4.5470025998e-2f + z * (2.4181311049e-2f + z * 4.2163199048e-2f))));
+    }
+};
+
+struct Precise {
+    static float sin(float x) { return std::sin(x); }
+    static float cos(float x) { return std::cos(x); }
+    static float tan(float x) { return std::tan(x); }
+    static float atan2(float y, float x) { return std::atan2(y, x); }
+    static float asin(float x) { return std::asin(x); }
+    static float rsqrt(float x) { return 1.0f / std::sqrt(x); }
+};
+
+}  // namespace fastmath
+
+#ifdef CONFIG_GNC_FAST_MATH
+using GncMath = fastmath::Fast;
+#else
+using GncMath = fastmath::Precise;
+#endif
+
+#endif  // APP_FAST_MATH_H
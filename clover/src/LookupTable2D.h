@@ -4,6 +4,49 @@
 #include <array>
 #include <cmath>
 
+// Bounding breakpoints of a point on a regular 2D grid, and where the point sits between them. Every table on the same
+// grid can be sampled with one cell.
+struct LookupCell2D {
+    int x_low_idx;
+    int y_low_idx;
+    float x_tween;
+    float y_tween;
+};
+
+template <int x_len, int y_len>
+LookupCell2D lookup_cell_2d(float x, float x_min, float x_max, float x_gap, float y, float y_min, float y_max, float y_gap)
+{
+    // Determine bp indices bounding input point, clamping into bps array domain
+    int x_low_idx = std::clamp(static_cast<int>(std::floor((x - x_min) / x_gap)), 0, x_len - 2);
+    int y_low_idx = std::clamp(static_cast<int>(std::floor((y - y_min) / y_gap)), 0, y_len - 2);
+
+    // Determine where input bp is within indexes bounding box, clamping such that it remains inside.
+    float x_tween = std::clamp((std::clamp(x, x_min, x_max) - x_min) / x_gap - x_low_idx, 0.0f, 1.0f);
+    float y_tween = std::clamp((std::clamp(y, y_min, y_max) - y_min) / y_gap - y_low_idx, 0.0f, 1.0f);
+
+    return {x_low_idx, y_low_idx, x_tween, y_tween};
+}
+
+template <int x_len, int y_len>
+float lookup_interpolate_2d(const std::array<std::array<float, y_len>, x_len>& bps, const LookupCell2D& cell)
+{
+    int x_high_idx = cell.x_low_idx + 1;  // Bound to [1, x_len - 1]
+    int y_high_idx = cell.y_low_idx + 1;  // Bound to [1, y_len - 1]
+
+    // Sample bounding box breakpoints
+    float bp_x_low_y_low = bps[cell.x_low_idx][cell.y_low_idx];
+    float bp_x_low_y_high = bps[cell.x_low_idx][y_high_idx];
+    float bp_x_high_y_low = bps[x_high_idx][cell.y_low_idx];
+    float bp_x_high_y_high = bps[x_high_idx][y_high_idx];
+
+    // Tween along X axis
+    float bp_x_tween_y_low = bp_x_low_y_low + (bp_x_high_y_low - bp_x_low_y_low) * cell.x_tween;
+    float bp_x_tween_y_high = bp_x_low_y_high + (bp_x_high_y_high - bp_x_low_y_high) * cell.x_tween;
+
+    // Tween along Y axis
+    return bp_x_tween_y_low + (bp_x_tween_y_high - bp_x_tween_y_low) * cell.y_tween;
+}
+
 template <int x_len, float x_min, float x_max, float x_gap, int y_len, float y_min, float y_max, float y_gap, std::array<std::array<float, y_len>, x_len> bps>
 class LookupTable2D {
 private:
@@ -25,26 +68,41 @@ float LookupTable2D<x_len, x_min, x_max, x_gap, y_len, y_min, y_max, y_gap, bps>
     static_assert(std::abs(x_min + x_gap * (x_len - 1) - x_max) < EPSILON, "x_max is incorrect given bp count and gap");
     static_assert(std::abs(y_min + y_gap * (y_len - 1) - y_max) < EPSILON, "y_max is incorrect given bp count and gap");
 
-    // Determine bp indices bounding input point, clamping into bps array domain
-    int x_low_idx = std::clamp(static_cast<int>(std::floor((x - x_min) / x_gap)), 0, x_len - 2);
-    int y_low_idx = std::clamp(static_cast<int>(std::floor((y - y_min) / y_gap)), 0, y_len - 2);
-    int x_high_idx = x_low_idx + 1;  // Bound to [1, x_len - 1]
-    int y_high_idx = y_low_idx + 1;  // Bound to [1, y_len - 1]
+    return lookup_interpolate_2d<x_len, y_len>(bps, lookup_cell_2d<x_len, y_len>(x, x_min, x_max, x_gap, y, y_min, y_max, y_gap));
+}
 
-    // Determine where input bp is within indexes bounding box, clamping such that it remains inside.
-    float x_tween = std::clamp((std::clamp(x, x_min, x_max) - x_min) / x_gap - x_low_idx, 0.0f, 1.0f);
-    float y_tween = std::clamp((std::clamp(y, y_min, y_max) - y_min) / y_gap - y_low_idx, 0.0f, 1.0f);
+// Grid axes of tables loaded at runtime, e.g. over the command protocol, sampled the same way as LookupTable2D.
+template <int x_len, int y_len>
+class LookupGrid2D {
+    static_assert(x_len >= 2);
+    static_assert(y_len >= 2);
 
-    // Sample bounding box breakpoints
-    float bp_x_low_y_low = bps[x_low_idx][y_low_idx];
-    float bp_x_low_y_high = bps[x_low_idx][y_high_idx];
-    float bp_x_high_y_low = bps[x_high_idx][y_low_idx];
-    float bp_x_high_y_high = bps[x_high_idx][y_high_idx];
+public:
+    using Table = std::array<std::array<float, y_len>, x_len>;
 
-    // Tween along X axis
-    float bp_x_tween_y_low = bp_x_low_y_low + (bp_x_high_y_low - bp_x_low_y_low) * x_tween;
-    float bp_x_tween_y_high = bp_x_low_y_high + (bp_x_high_y_high - bp_x_low_y_high) * x_tween;
+    constexpr LookupGrid2D() : LookupGrid2D(0.0f, 1.0f, 0.0f, 1.0f) {}
 
-    // Tween along Y axis
-    return bp_x_tween_y_low + (bp_x_tween_y_high - bp_x_tween_y_low) * y_tween;
-}
+    // Gaps must be positive.
+    constexpr LookupGrid2D(float x_min, float x_gap, float y_min, float y_gap)
+        : x_min_(x_min), x_max_(x_min + x_gap * (x_len - 1)), x_gap_(x_gap),
+          y_min_(y_min), y_max_(y_min + y_gap * (y_len - 1)), y_gap_(y_gap)
+    {
+    }
+
+    LookupCell2D locate(float x, float y) const
+    {
+        return lookup_cell_2d<x_len, y_len>(x, x_min_, x_max_, x_gap_, y, y_min_, y_max_, y_gap_);
+    }
+
+    static float interpolate(const Table& bps, const LookupCell2D& cell) { return lookup_interpolate_2d<x_len, y_len>(bps, cell); }
+
+    float sample(const Table& bps, float x, float y) const { return interpolate(bps, locate(x, y)); }
+
+private:
+    float x_min_;
+    float x_max_;
+    float x_gap_;
+    float y_min_;
+    float y_max_;
+    float y_gap_;
+};
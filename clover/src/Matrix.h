@@ -0,0 +1,311 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#ifdef CONFIG_GNC_MATRIX_CMSIS_DSP
+#include <arm_math.h>
+#endif
+
+/// Fixed-size, row-major dense matrix. Dimensions are template parameters, so every size is checked at compile time and
+/// nothing is heap allocated. Element-wise operations and small products are fully unrolled. Larger float products go
+/// through CMSIS-DSP when CONFIG_GNC_MATRIX_CMSIS_DSP is set (Cortex-M7), with portable loops as the fallback.
+///
+/// There are no expression templates. Binary operators return a new matrix, and hot paths use the fused in-place
+/// helpers (multiply_into, multiply_add, multiply_transposed_into, sandwich, rank1_update, axpy) to avoid temporaries.
+template <int R, int C, typename T = float> struct Matrix {
+    static_assert(R > 0 && C > 0, "Matrix dimensions must be positive");
+
+    static constexpr int ROWS = R;
+    static constexpr int COLS = C;
+    static constexpr int SIZE = R * C;
+
+    std::array<T, SIZE> data{};
+
+    static constexpr Matrix zeros() { return {}; }
+    static constexpr Matrix filled(T value);
+    static constexpr Matrix identity()
+        requires(R == C);
+
+    constexpr T& operator()(int r, int c) { return data[r * C + c]; }
+    constexpr const T& operator()(int r, int c) const { return data[r * C + c]; }
+
+    constexpr T& operator[](int i)
+        requires(R == 1 || C == 1)
+    {
+        return data[i];
+    }
+    constexpr const T& operator[](int i) const
+        requires(R == 1 || C == 1)
+    {
+        return data[i];
+    }
+
+    constexpr Matrix& operator+=(const Matrix& other);
+    constexpr Matrix& operator-=(const Matrix& other);
+    constexpr Matrix& operator*=(T scalar);
+    constexpr Matrix& operator/=(T scalar);
+};
+
+/// Column vector.
+template <int N, typename T = float> using Vec = Matrix<N, 1, T>;
+
+namespace matrix_detail {
+
+// Operations with at most this many element operations or multiply-accumulates are fully unrolled.
+constexpr int UNROLL_LIMIT = 64;
+
+// Float products with more multiply-accumulates than this use CMSIS-DSP when it is enabled.
+constexpr int CMSIS_MIN_MACS = 64;
+
+template <int N, typename F> constexpr void unroll(F&& f)
+{
+    [&]<int... I>(std::integer_sequence<int, I...>) { (f(I), ...); }(std::make_integer_sequence<int, N>{});
+}
+
+/// Call f(i) for i in [0, N), unrolled when N is small.
+template <int N, typename F> constexpr void for_each(F&& f)
+{
+    if constexpr (N <= UNROLL_LIMIT) {
+        unroll<N>(f);
+    } else {
+        for (int i = 0; i < N; i++) {
+            f(i);
+        }
+    }
+}
+
+#ifdef CONFIG_GNC_MATRIX_CMSIS_DSP
+template <int R, int C> arm_matrix_instance_f32 cmsis_view(const Matrix<R, C, float>& m)
+{
+    // CMSIS takes non-const pointers even for inputs, but never writes through them
+    arm_matrix_instance_f32 view;
+    arm_mat_init_f32(&view, R, C, const_cast<float*>(m.data.data()));
+    return view;
+}
+#endif
+
+}  // namespace matrix_detail
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T> Matrix<R, C, T>::filled(T value)
+{
+    Matrix out;
+    matrix_detail::for_each<SIZE>([&](int i) { out.data[i] = value; });
+    return out;
+}
+
+template <int R, int C, typename T>
+constexpr Matrix<R, C, T> Matrix<R, C, T>::identity()
+    requires(R == C)
+{
+    Matrix out;
+    matrix_detail::for_each<R>([&](int i) { out(i, i) = T(1); });
+    return out;
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T>& Matrix<R, C, T>::operator+=(const Matrix& other)
+{
+    matrix_detail::for_each<SIZE>([&](int i) { data[i] += other.data[i]; });
+    return *this;
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T>& Matrix<R, C, T>::operator-=(const Matrix& other)
+{
+    matrix_detail::for_each<SIZE>([&](int i) { data[i] -= other.data[i]; });
+    return *this;
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T>& Matrix<R, C, T>::operator*=(T scalar)
+{
+    matrix_detail::for_each<SIZE>([&](int i) { data[i] *= scalar; });
+    return *this;
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T>& Matrix<R, C, T>::operator/=(T scalar)
+{
+    return *this *= T(1) / scalar;
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T> operator+(Matrix<R, C, T> a, const Matrix<R, C, T>& b)
+{
+    return a += b;
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T> operator-(Matrix<R, C, T> a, const Matrix<R, C, T>& b)
+{
+    return a -= b;
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T> operator-(Matrix<R, C, T> a)
+{
+    return a *= T(-1);
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T> operator*(Matrix<R, C, T> a, T scalar)
+{
+    return a *= scalar;
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T> operator*(T scalar, Matrix<R, C, T> a)
+{
+    return a *= scalar;
+}
+
+template <int R, int C, typename T> constexpr Matrix<R, C, T> operator/(Matrix<R, C, T> a, T scalar)
+{
+    return a /= scalar;
+}
+
+/// out = a * b. out must not alias a or b.
+template <int R, int K, int C, typename T> constexpr void multiply_into(Matrix<R, C, T>& out, const Matrix<R, K, T>& a, const Matrix<K, C, T>& b)
+{
+#ifdef CONFIG_GNC_MATRIX_CMSIS_DSP
+    if constexpr (std::is_same_v<T, float> && R * K * C > matrix_detail::CMSIS_MIN_MACS) {
+        if !consteval {
+            arm_matrix_instance_f32 a_view = matrix_detail::cmsis_view(a);
+            arm_matrix_instance_f32 b_view = matrix_detail::cmsis_view(b);
+            arm_matrix_instance_f32 out_view;
+            arm_mat_init_f32(&out_view, R, C, out.data.data());
+            arm_mat_mult_f32(&a_view, &b_view, &out_view);
+            return;
+        }
+    }
+#endif
+    matrix_detail::for_each<R * C>([&](int rc) {
+        const int r = rc / C;
+        const int c = rc % C;
+        T sum = T(0);
+        if constexpr (K <= matrix_detail::UNROLL_LIMIT) {
+            matrix_detail::unroll<K>([&](int k) { sum += a(r, k) * b(k, c); });
+        } else {
+            for (int k = 0; k < K; k++) {
+                sum += a(r, k) * b(k, c);
+            }
+        }
+        out(r, c) = sum;
+    });
+}
+
+/// out += a * b. out must not alias a or b.
+template <int R, int K, int C, typename T> constexpr void multiply_add(Matrix<R, C, T>& out, const Matrix<R, K, T>& a, const Matrix<K, C, T>& b)
+{
+    matrix_detail::for_each<R * C>([&](int rc) {
+        const int r = rc / C;
+        const int c = rc % C;
+        T sum = out(r, c);
+        for (int k = 0; k < K; k++) {
+            sum += a(r, k) * b(k, c);
+        }
+        out(r, c) = sum;
+    });
+}
+
+/// out = a * b^T, walking rows of both operands. out must not alias a or b.
+template <int R, int K, int C, typename T>
+constexpr void multiply_transposed_into(Matrix<R, C, T>& out, const Matrix<R, K, T>& a, const Matrix<C, K, T>& b)
+{
+    matrix_detail::for_each<R * C>([&](int rc) {
+        const int r = rc / C;
+        const int c = rc % C;
+        T sum = T(0);
+        for (int k = 0; k < K; k++) {
+            sum += a(r, k) * b(c, k);
+        }
+        out(r, c) = sum;
+    });
+}
+
+template <int R, int K, int C, typename T> constexpr Matrix<R, C, T> operator*(const Matrix<R, K, T>& a, const Matrix<K, C, T>& b)
+{
+    Matrix<R, C, T> out;
+    multiply_into(out, a, b);
+    return out;
+}
+
+template <int R, int C, typename T> constexpr Matrix<C, R, T> transpose(const Matrix<R, C, T>& m)
+{
+    Matrix<C, R, T> out;
+    matrix_detail::for_each<R * C>([&](int rc) { out(rc % C, rc / C) = m.data[rc]; });
+    return out;
+}
+
+/// out = f * p * f^T for a symmetric p, as used by covariance propagation. Only the upper triangle of the result is
+/// computed and then mirrored, so out is exactly symmetric. scratch holds f * p; out must not alias any input.
+template <int R, int K, typename T>
+constexpr void sandwich(Matrix<R, R, T>& out, const Matrix<R, K, T>& f, const Matrix<K, K, T>& p, Matrix<R, K, T>& scratch)
+{
+    multiply_into(scratch, f, p);
+    for (int i = 0; i < R; i++) {
+        for (int j = i; j < R; j++) {
+            T sum = T(0);
+            for (int k = 0; k < K; k++) {
+                sum += scratch(i, k) * f(j, k);
+            }
+            out(i, j) = sum;
+            out(j, i) = sum;
+        }
+    }
+}
+
+/// m += alpha * u * v^T.
+template <int R, int C, typename T> constexpr void rank1_update(Matrix<R, C, T>& m, T alpha, const Vec<R, T>& u, const Vec<C, T>& v)
+{
+    matrix_detail::for_each<R * C>([&](int rc) { m.data[rc] += alpha * u[rc / C] * v[rc % C]; });
+}
+
+/// y += alpha * x.
+template <int R, int C, typename T> constexpr void axpy(Matrix<R, C, T>& y, T alpha, const Matrix<R, C, T>& x)
+{
+    matrix_detail::for_each<R * C>([&](int i) { y.data[i] += alpha * x.data[i]; });
+}
+
+/// Copy of the BR x BC block starting at (R0, C0).
+template <int R0, int C0, int BR, int BC, int R, int C, typename T> constexpr Matrix<BR, BC, T> block(const Matrix<R, C, T>& m)
+{
+    static_assert(R0 >= 0 && C0 >= 0 && R0 + BR <= R && C0 + BC <= C, "block out of range");
+    Matrix<BR, BC, T> out;
+    matrix_detail::for_each<BR * BC>([&](int rc) { out.data[rc] = m(R0 + rc / BC, C0 + rc % BC); });
+    return out;
+}
+
+/// Overwrite the block starting at (R0, C0) with b.
+template <int R0, int C0, int BR, int BC, int R, int C, typename T> constexpr void set_block(Matrix<R, C, T>& m, const Matrix<BR, BC, T>& b)
+{
+    static_assert(R0 >= 0 && C0 >= 0 && R0 + BR <= R && C0 + BC <= C, "block out of range");
+    matrix_detail::for_each<BR * BC>([&](int rc) { m(R0 + rc / BC, C0 + rc % BC) = b.data[rc]; });
+}
+
+template <int N, typename T> constexpr T dot(const Vec<N, T>& a, const Vec<N, T>& b)
+{
+    T sum = T(0);
+    matrix_detail::for_each<N>([&](int i) { sum += a[i] * b[i]; });
+    return sum;
+}
+
+template <int N, typename T> T norm(const Vec<N, T>& v)
+{
+    return std::sqrt(dot(v, v));
+}
+
+/// Unit vector along v, or zero for a (near) zero vector.
+template <int N, typename T> Vec<N, T> normalized(const Vec<N, T>& v)
+{
+    const T n = norm(v);
+    if (n <= T(1e-8)) {
+        return {};
+    }
+    return v / n;
+}
+
+template <typename T> constexpr Vec<3, T> cross(const Vec<3, T>& a, const Vec<3, T>& b)
+{
+    return {{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]}};
+}
+
+/// Cross-product matrix, skew(a) * b == cross(a, b).
+template <typename T> constexpr Matrix<3, 3, T> skew(const Vec<3, T>& a)
+{
+    return {{T(0), -a[2], a[1], a[2], T(0), -a[0], -a[1], a[0], T(0)}};
+}
@@ -1,21 +1,125 @@
 #pragma once
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <limits>
 #include <cmath>
+#include <numbers>
+#include <type_traits>
 #include "math_util.h"
 #ifdef abs
 #undef abs // allow std::abs despite Arduino macro
 #endif
 
-class PID
+// Feature policies for BasicPID. Each feature has a "No*" policy that compiles away entirely, and a policy that holds
+// its configuration. Every coefficient is precomputed when gains, limits or dt change, so calculate() only multiplies,
+// adds and clamps.
+
+// Integral zone: only accumulate the integral while |error| is within the zone.
+struct NoIntegralZone
+{
+    bool accumulate(float) const { return true; }
+};
+
+struct IntegralZone
+{
+    float zone = std::numeric_limits<float>::infinity();
+    bool accumulate(float error) const { return std::abs(error) <= zone; }
+};
+
+// Anti-windup: clamp the integral's contribution to the output, storing the clamped integral back.
+struct NoAntiWindup
+{
+    void update_bounds(float) {}
+    float apply(float& integral, float ki) const { return integral * ki; }
+};
+
+struct ClampIntegral
+{
+    float min_output = -std::numeric_limits<float>::infinity();
+    float max_output = std::numeric_limits<float>::infinity();
+
+    // Limits on the stored (unscaled) integral, precomputed from ki so it is never divided by. Only applied for
+    // positive ki, like the output limits were divided back through.
+    bool clamp_integral = false;
+    float min_integral = 0.0f;
+    float max_integral = 0.0f;
+
+    void update_bounds(float ki)
+    {
+        clamp_integral = ki > 0.000001f;
+        if (clamp_integral) {
+            min_integral = min_output / ki;
+            max_integral = max_output / ki;
+        }
+    }
+
+    float apply(float& integral, float ki) const
+    {
+        if (clamp_integral) {
+            integral = std::clamp(integral, min_integral, max_integral);
+        }
+        return std::clamp(integral * ki, min_output, max_output);
+    }
+};
+
+// Derivative filter: optional 1st-order low-pass on the derivative.
+struct RawDerivative
+{
+    void update_coefficients(float) {}
+    float filter(float deriv_raw) { return deriv_raw; }
+    void reset() {}
+};
+
+struct LowPassDerivative
+{
+    float rc = 0.0f;     // 0 disables the filter
+    float a = 1.0f;      // y = (1 - a) * y + a * x, precomputed from rc and dt. Exactly y = x when disabled.
+    float state = 0.0f;
+
+    void update_coefficients(float dt) { a = rc > 0.0f ? dt / (rc + dt) : 1.0f; }
+    float filter(float deriv_raw)
+    {
+        state = (1.0f - a) * state + a * deriv_raw;
+        return state;
+    }
+    void reset() { state = 0.0f; }
+};
+
+// Output clamp.
+struct NoOutputClamp
+{
+    float apply(float u) const { return u; }
+};
+
+struct ClampOutput
+{
+    float min_out = -std::numeric_limits<float>::infinity();
+    float max_out = std::numeric_limits<float>::infinity();
+    float apply(float u) const { return std::clamp(u, min_out, max_out); }
+};
+
+template <typename IntegralZonePolicy, typename AntiWindupPolicy, typename DerivativePolicy, typename OutputPolicy>
+class BasicPID
 {
 public:
-    PID(float kp, float ki, float kd,
-        float min_out = -1e6f, float max_out = 1e6f,
+    static constexpr bool has_integral_zone = std::is_same_v<IntegralZonePolicy, IntegralZone>;
+    static constexpr bool has_integral_limits = std::is_same_v<AntiWindupPolicy, ClampIntegral>;
+    static constexpr bool has_derivative_lowpass = std::is_same_v<DerivativePolicy, LowPassDerivative>;
+    static constexpr bool has_output_limits = std::is_same_v<OutputPolicy, ClampOutput>;
+
+    BasicPID(float kp, float ki, float kd) : kp_(kp), ki_(ki), kd_(kd)
+    {
+        anti_windup_.update_bounds(ki_);
+    }
+
+    BasicPID(float kp, float ki, float kd,
+        float min_out, float max_out,
         float min_integral = -1e6f, float max_integral = 1e6f,
         float integral_zone = std::numeric_limits<float>::infinity(),
         float deriv_lowpass_hz = 0.0f)
-        : kp_(kp), ki_(ki), kd_(kd)
+        requires(has_integral_zone && has_integral_limits && has_derivative_lowpass && has_output_limits)
+        : BasicPID(kp, ki, kd)
     {
         if (min_out != -1e6f || max_out != 1e6f) {
             setOutputLimits(min_out, max_out);
@@ -31,79 +135,74 @@ public:
         }
     }
 
-
-
-
-    // Calculate control output given a setpoint and a measurement.
-    // dt is computed internally from steady_clock;
-    // on the first call, derivative and integral are not applied to avoid a large transient.
-
+    // Calculate control output given a setpoint, a measurement and the measurement's change since the last call.
+    // On the first call, derivative and integral are not applied to avoid a large transient.
     float calculate(float setpoint, float measurement, float measurement_d, float dt)
     {
-
+        const float error = setpoint - measurement;
 
         if (std::isnan(prev_meas_))
         {
-
-            prev_meas_ = measurement;
             // First call: just proportional action.
-            const float error = setpoint - measurement;
-            return clampOutput(kp_ * error);
+            prev_meas_ = measurement;
+            return output_.apply(kp_ * error);
         }
+        prev_meas_ = measurement;
 
-        const float error = setpoint - measurement;
+        if (dt != dt_)
+        {
+            setDt(dt);
+        }
 
         // Integral (respect integral zone if enabled)
-        if (!use_integral_zone_ || std::abs(error) <= integral_zone_)
+        if (zone_.accumulate(error))
         {
             integral_ += error * dt;
         }
 
         // Derivative on measurement to reduce derivative kick
-        float deriv_raw = 0.0f;
-        if (!std::isnan(prev_meas_))
-        {
-            deriv_raw = -measurement_d / std::max(dt, 1e-9f); // negative sign: d(error)/dt = -d(meas)/dt
-        }
-        prev_meas_ = measurement;
-
-        // Optional 1st-order low-pass on derivative: y += a*(x - y)
-        float deriv_term = deriv_raw;
-        if (use_deriv_lp_)
-        {
-            const float rc = 1.0f / (2.0f * pi * std::max(deriv_cutoff_hz_, 1e-6f));
-            const float a = dt / (rc + dt);
-            deriv_state_ += a * (deriv_raw - deriv_state_);
-            deriv_term = deriv_state_;
-        }
-
-        float integral_output = integral_ * ki_;
-        if (use_integral_limits_)
-        {
-            integral_output = std::clamp(integral_output, min_integral_, max_integral_);
-        }
-        // prevent division by 0
-        if (ki_ > 0.000001f)
-        {
-            integral_ = integral_output / ki_; // store back clamped integral
-        }
-        float output = kp_ * error + integral_output + kd_ * deriv_term;
+        const float deriv_raw = -measurement_d * inv_dt_; // negative sign: d(error)/dt = -d(meas)/dt
+        const float deriv_term = derivative_.filter(deriv_raw);
 
-        return clampOutput(output);
+        const float integral_output = anti_windup_.apply(integral_, ki_);
+        return output_.apply(kp_ * error + integral_output + kd_ * deriv_term);
     }
 
     // uses previous measurement to calculate derivative
     float calculate(float setpoint, float measurement, float dt)
     {
         // Derivative on measurement to reduce derivative kick
-        float dmeas = 0.0f;
-        if (!std::isnan(prev_meas_))
+        const float dmeas = std::isnan(prev_meas_) ? 0.0f : measurement - prev_meas_;
+        return calculate(setpoint, measurement, dmeas, dt);
+    }
+
+    // Batched calculate for several controllers sharing one dt, e.g. the axes of a vector loop.
+    template <size_t N>
+    static std::array<float, N> calculate(
+        const std::array<BasicPID*, N>& pids, const std::array<float, N>& setpoints, const std::array<float, N>& measurements, float dt)
+    {
+        std::array<float, N> outputs;
+        for (size_t i = 0; i < N; i++)
         {
-            dmeas = measurement - prev_meas_;
+            outputs[i] = pids[i]->calculate(setpoints[i], measurements[i], dt);
         }
+        return outputs;
+    }
 
-        return calculate(setpoint, measurement, dmeas, dt);
-
+    template <size_t N>
+    static std::array<float, N> calculate(
+        const std::array<BasicPID*, N>& pids,
+        const std::array<float, N>& setpoints,
+        const std::array<float, N>& measurements,
+        const std::array<float, N>& measurements_d,
+        float dt)
+    {
+        std::array<float, N> outputs;
+        for (size_t i = 0; i < N; i++)
+        {
+            outputs[i] = pids[i]->calculate(setpoints[i], measurements[i], measurements_d[i], dt);
+        }
+        return outputs;
     }
 
     // Reset internal state (integral, derivative filter). Optionally set a new integral value.
@@ -111,7 +210,7 @@ public:
     {
         integral_ = integral;
         prev_meas_ = std::numeric_limits<float>::quiet_NaN();
-        deriv_state_ = 0.0f;
+        derivative_.reset();
     }
 
     // --- Configuration helpers ---
@@ -120,11 +219,16 @@ public:
         kp_ = kp;
         ki_ = ki;
         kd_ = kd;
+        anti_windup_.update_bounds(ki_);
         reset();
     }
 
     void setP(float kp) { kp_ = kp; }
-    void setI(float ki) { ki_ = ki; }
+    void setI(float ki)
+    {
+        ki_ = ki;
+        anti_windup_.update_bounds(ki_);
+    }
     void setD(float kd) { kd_ = kd; }
 
     float getP() const { return kp_; }
@@ -132,55 +236,56 @@ public:
     float getD() const { return kd_; }
     float getIntegralOutput() const { return integral_ * ki_; }
 
-    void setOutputLimits(float min_out, float max_out)
+    void setOutputLimits(float min_out, float max_out) requires has_output_limits
     {
-        min_out_ = min_out;
-        max_out_ = max_out;
-        use_output_limits_ = true;
-        if (min_out_ > max_out_)
-            std::swap(min_out_, max_out_);
+        if (min_out > max_out)
+            std::swap(min_out, max_out);
+        output_.min_out = min_out;
+        output_.max_out = max_out;
     }
-    void clearOutputLimits() { use_output_limits_ = false; }
+    void clearOutputLimits() requires has_output_limits { output_ = {}; }
 
-    void setIntegralLimits(float min_i, float max_i)
+    void setIntegralLimits(float min_i, float max_i) requires has_integral_limits
     {
-        min_integral_ = min_i;
-        max_integral_ = max_i;
-        use_integral_limits_ = true;
-        if (min_integral_ > max_integral_)
-            std::swap(min_integral_, max_integral_);
+        if (min_i > max_i)
+            std::swap(min_i, max_i);
+        anti_windup_.min_output = min_i;
+        anti_windup_.max_output = max_i;
+        anti_windup_.update_bounds(ki_);
     }
-    void clearIntegralLimits() { use_integral_limits_ = false; }
-
-    void setIntegralZone(float zone_abs_error)
+    void clearIntegralLimits() requires has_integral_limits
     {
-        integral_zone_ = std::max(0.0f, zone_abs_error);
-        use_integral_zone_ = true;
+        anti_windup_ = {};
+        anti_windup_.update_bounds(ki_);
     }
-    void clearIntegralZone() { use_integral_zone_ = false; }
 
-    // Enable a lowâ€‘pass filter on the derivative term. Example: cutoff_hz = 30.0
-    void setDerivativeLowPass(float cutoff_hz)
+    void setIntegralZone(float zone_abs_error) requires has_integral_zone { zone_.zone = std::max(0.0f, zone_abs_error); }
+    void clearIntegralZone() requires has_integral_zone { zone_ = {}; }
+
+    // Enable a low-pass filter on the derivative term. Example: cutoff_hz = 30.0
+    void setDerivativeLowPass(float cutoff_hz) requires has_derivative_lowpass
     {
-        deriv_cutoff_hz_ = cutoff_hz;
-        use_deriv_lp_ = true;
+        // While disabled the state passes the raw derivative through, but a newly enabled filter starts from zero
+        if (derivative_.rc == 0.0f)
+        {
+            derivative_.reset();
+        }
+        derivative_.rc = 1.0f / (2.0f * std::numbers::pi_v<float> * std::max(cutoff_hz, 1e-6f));
+        derivative_.update_coefficients(dt_);
     }
-    void clearDerivativeLowPass()
+    void clearDerivativeLowPass() requires has_derivative_lowpass
     {
-        use_deriv_lp_ = false;
-        deriv_state_ = 0.0f;
+        derivative_.rc = 0.0f;
+        derivative_.update_coefficients(dt_);
+        derivative_.reset();
     }
 
 private:
-    float clampOutput(float u) const
+    void setDt(float dt)
     {
-        if (!use_output_limits_)
-            return u;
-        if (u > max_out_)
-            return max_out_;
-        if (u < min_out_)
-            return min_out_;
-        return u;
+        dt_ = dt;
+        inv_dt_ = 1.0f / std::max(dt, 1e-9f);
+        derivative_.update_coefficients(dt);
     }
 
     // Gains
@@ -188,23 +293,23 @@ private:
     float ki_{};
     float kd_{};
 
-    // State
-    const float pi = std::acos(-1.0);
+    // Coefficients for the last dt
+    float dt_ = std::numeric_limits<float>::quiet_NaN();
+    float inv_dt_ = 0.0f;
 
+    // State
     float integral_ = 0.0f;
     float prev_meas_ = std::numeric_limits<float>::quiet_NaN();
 
-    // Derivative lowâ€‘pass state
-    bool use_deriv_lp_ = false;
-    float deriv_cutoff_hz_ = 0.0f;
-    float deriv_state_ = 0.0f;
+    // Features
+    [[no_unique_address]] IntegralZonePolicy zone_;
+    [[no_unique_address]] AntiWindupPolicy anti_windup_;
+    [[no_unique_address]] DerivativePolicy derivative_;
+    [[no_unique_address]] OutputPolicy output_;
+};
 
+// Every feature, each configurable at runtime. Unconfigured features leave the output unchanged.
+using PID = BasicPID<IntegralZone, ClampIntegral, LowPassDerivative, ClampOutput>;
 
-    // Limits
-    bool use_output_limits_ = false;
-    float min_out_ = -1.0f, max_out_ = 1.0f;
-    bool use_integral_limits_ = false;
-    float min_integral_ = -1e6f, max_integral_ = 1e6f;
-    bool use_integral_zone_ = false;
-    float integral_zone_ = std::numeric_limits<float>::infinity();
-};
+// Plain PID with an unbounded integral and unfiltered derivative.
+using SimplePID = BasicPID<NoIntegralZone, NoAntiWindup, RawDerivative, NoOutputClamp>;
@@ -0,0 +1,248 @@
+#pragma once
+
+#include "Error.h"
+#include "MutexGuard.h"
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#ifdef CONFIG_THROTTLE_VALVES
+
+// Quadrature encoders count the A/B transitions of a motor encoder, four counts per line. They share one interface so
+// ThrottleValve can use either:
+//   init(prefix)     configure the hardware, prefix is used in logs
+//   count()          signed count, negated when reversed
+//   set_count(count) rebase the count
+
+// -----------------------------------------------------------------------------
+// GpioQuadratureEncoder
+// -----------------------------------------------------------------------------
+// Decodes A and B in software from an interrupt on every edge of either. Costs an interrupt per count, and counts are
+// lost if an edge waits behind a busier interrupt for longer than the next edge takes to arrive.
+// -----------------------------------------------------------------------------
+template <gpio_dt_spec a_dt_init, gpio_dt_spec b_dt_init, bool reversed> class GpioQuadratureEncoder {
+private:
+    constexpr static gpio_dt_spec a_gpio = a_dt_init;
+    constexpr static gpio_dt_spec b_gpio = b_dt_init;
+
+    inline static volatile int count_ = 0;
+    inline static volatile uint8_t prev_state = 0;
+    inline static gpio_callback a_callback = {};
+    inline static gpio_callback b_callback = {};
+
+    static uint8_t read_state()
+    {
+        int a = gpio_pin_get_dt(&a_gpio);
+        if (a < 0) [[unlikely]] {
+            a = 0;
+        }
+        int b = gpio_pin_get_dt(&b_gpio);
+        if (b < 0) [[unlikely]] {
+            b = 0;
+        }
+        return (static_cast<uint8_t>(b) << 1) | static_cast<uint8_t>(a);
+    }
+
+    static void update_isr(const device*, gpio_callback*, gpio_port_pins_t)
+    {
+        constexpr int8_t STEP_TABLE[4][4] = {
+            {0, +1, -1, 0},
+            {-1, 0, 0, +1},
+            {+1, 0, 0, -1},
+            {0, -1, +1, 0},
+        };
+
+        uint8_t new_state = read_state();
+        if constexpr (reversed) {
+            count_ = count_ - STEP_TABLE[prev_state][new_state];
+        }
+        else {
+            count_ = count_ + STEP_TABLE[prev_state][new_state];
+        }
+        prev_state = new_state;
+    }
+
+public:
+    GpioQuadratureEncoder() = delete;
+
+    static std::expected<void, Error> init(const char* prefix)
+    {
+        LOG_MODULE_DECLARE(ThrottleValve);
+
+        if (!device_is_ready(a_gpio.port)) {
+            LOG_ERR("%s Encoder A GPIO not ready", prefix);
+            return std::unexpected(Error::from_device_not_ready(a_gpio.port).context("encoder A GPIO not ready on %s valve", prefix));
+        }
+        if (!device_is_ready(b_gpio.port)) {
+            LOG_ERR("%s Encoder B GPIO not ready", prefix);
+            return std::unexpected(Error::from_device_not_ready(b_gpio.port).context("encoder B GPIO not ready on %s valve", prefix));
+        }
+
+        int err = gpio_pin_configure_dt(&a_gpio, GPIO_INPUT);
+        if (err) {
+            LOG_ERR("%s Failed to configure encoder A GPIO: err %d", prefix, err);
+            return std::unexpected(Error::from_code(err).context("failed to configure encoder A GPIO on %s valve", prefix));
+        }
+        err = gpio_pin_configure_dt(&b_gpio, GPIO_INPUT);
+        if (err) {
+            LOG_ERR("%s Failed to configure encoder B GPIO: err %d", prefix, err);
+            return std::unexpected(Error::from_code(err).context("failed to configure encoder B GPIO on %s valve", prefix));
+        }
+
+        prev_state = read_state();
+
+        err = gpio_pin_interrupt_configure_dt(&a_gpio, GPIO_INT_EDGE_BOTH);
+        if (err) {
+            LOG_ERR("%s Failed to enable encoder A interrupts: err %d", prefix, err);
+            return std::unexpected(Error::from_code(err).context("failed to enable encoder A interrupts on %s valve", prefix));
+        }
+        err = gpio_pin_interrupt_configure_dt(&b_gpio, GPIO_INT_EDGE_BOTH);
+        if (err) {
+            LOG_ERR("%s Failed to enable encoder B interrupts: err %d", prefix, err);
+            return std::unexpected(Error::from_code(err).context("failed to enable encoder B interrupts on %s valve", prefix));
+        }
+
+        gpio_init_callback(&a_callback, update_isr, BIT(a_gpio.pin));
+        gpio_add_callback_dt(&a_gpio, &a_callback);
+        gpio_init_callback(&b_callback, update_isr, BIT(b_gpio.pin));
+        gpio_add_callback_dt(&b_gpio, &b_callback);
+        return {};
+    }
+
+    static int count() { return count_; }
+    static void set_count(int count) { count_ = count; }
+};
+
+#ifdef CONFIG_THROTTLE_VALVE_QDEC
+
+// -----------------------------------------------------------------------------
+// QdecQuadratureEncoder
+// -----------------------------------------------------------------------------
+// Reads a quadrature decoder peripheral through the Zephyr QDEC sensor API (e.g. the i.MX RT ENC or an STM32 timer in
+// encoder mode), which counts every edge in hardware without an interrupt.
+//
+// QDEC drivers report SENSOR_CHAN_ROTATION in degrees, most of them wrapped to one revolution of
+// counts_per_revolution counts, so count() unwraps each reading against the previous one. That holds as long as
+// count() is called at least every half revolution of the motor, 40 ms at the valve's maximum velocity. The
+// controller reads it every tick.
+// -----------------------------------------------------------------------------
+template <const device* qdec_dt_init, int counts_per_revolution, bool reversed> class QdecQuadratureEncoder {
+private:
+    constexpr static const device* qdec = qdec_dt_init;
+
+    inline static const char* prefix = "";
+    inline static k_mutex lock = {};
+    inline static int count_ = 0;
+    inline static int64_t last_raw = 0;  // Last reading [counts]
+
+    static std::expected<int64_t, int> read_raw()
+    {
+        int err = sensor_sample_fetch(qdec);
+        if (err) [[unlikely]] {
+            return std::unexpected(err);
+        }
+        sensor_value rotation;
+        err = sensor_channel_get(qdec, SENSOR_CHAN_ROTATION, &rotation);
+        if (err) [[unlikely]] {
+            return std::unexpected(err);
+        }
+
+        // Rounded to the nearest count, kept in integers so large unwrapped readings stay exact.
+        const int64_t micro_deg = static_cast<int64_t>(rotation.val1) * 1'000'000 + rotation.val2;
+        const int64_t scaled = micro_deg * counts_per_revolution;
+        constexpr int64_t MICRO_DEG_PER_REV = 360'000'000;
+        return (scaled >= 0 ? scaled + MICRO_DEG_PER_REV / 2 : scaled - MICRO_DEG_PER_REV / 2) / MICRO_DEG_PER_REV;
+    }
+
+public:
+    QdecQuadratureEncoder() = delete;
+
+    static std::expected<void, Error> init(const char* log_prefix)
+    {
+        LOG_MODULE_DECLARE(ThrottleValve);
+        prefix = log_prefix;
+
+        if (!device_is_ready(qdec)) {
+            LOG_ERR("%s Encoder QDEC not ready", prefix);
+            return std::unexpected(Error::from_device_not_ready(qdec).context("encoder QDEC not ready on %s valve", prefix));
+        }
+
+        auto raw = read_raw();
+        if (!raw) {
+            LOG_ERR("%s Failed to read encoder QDEC: err %d", prefix, raw.error());
+            return std::unexpected(Error::from_code(raw.error()).context("failed to read encoder QDEC on %s valve", prefix));
+        }
+        last_raw = *raw;
+        count_ = 0;
+        k_mutex_init(&lock);
+        return {};
+    }
+
+    static int count()
+    {
+        LOG_MODULE_DECLARE(ThrottleValve);
+
+        MutexGuard guard{&lock};
+        auto raw = read_raw();
+        if (raw) [[likely]] {
+            int64_t delta = (*raw - last_raw) % counts_per_revolution;
+            if (delta > counts_per_revolution / 2) {
+                delta -= counts_per_revolution;
+            }
+            else if (delta < -counts_per_revolution / 2) {
+                delta += counts_per_revolution;
+            }
+            last_raw = *raw;
+            count_ += reversed ? -static_cast<int>(delta) : static_cast<int>(delta);
+        }
+        else {
+            LOG_ERR("%s Failed to read encoder QDEC: err %d", prefix, raw.error());
+        }
+        return count_;
+    }
+
+    static void set_count(int count)
+    {
+        MutexGuard guard{&lock};
+        count_ = count;
+    }
+};
+
+#endif  // CONFIG_THROTTLE_VALVE_QDEC
+
+#ifdef CONFIG_PLANT_SIM
+
+// -----------------------------------------------------------------------------
+// SimQuadratureEncoder
+// -----------------------------------------------------------------------------
+// Encoder for the native_sim plant simulator. The plant sets the shaft position with drive() from its valve model, so
+// count() is exact and never misses an edge. channel only tells the fuel and lox instances apart.
+// -----------------------------------------------------------------------------
+template <int channel> class SimQuadratureEncoder {
+private:
+    inline static std::atomic<int> shaft_count{0};  // Set by the plant [counts]
+    inline static std::atomic<int> offset{0};       // shaft_count at count() == 0
+
+public:
+    SimQuadratureEncoder() = delete;
+
+    static std::expected<void, Error> init(const char*)
+    {
+        offset = shaft_count.load();
+        return {};
+    }
+
+    static int count() { return shaft_count.load(std::memory_order_relaxed) - offset.load(std::memory_order_relaxed); }
+    static void set_count(int count) { offset = shaft_count.load() - count; }
+
+    /// Move the shaft to an absolute position, called by the plant.
+    static void drive(int count) { shaft_count.store(count, std::memory_order_relaxed); }
+};
+
+#endif  // CONFIG_PLANT_SIM
+
+#endif  // CONFIG_THROTTLE_VALVES
@@ -0,0 +1,82 @@
+#ifndef APP_RATE_GROUP_H
+#define APP_RATE_GROUP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+/// A controller module's schedule: it runs on ticks where tick % divisor == phase, and is expected to finish within
+/// budget_ns of CPU time.
+struct RateGroupConfig {
+    const char* name;
+    uint32_t divisor;
+    uint32_t phase;
+    uint32_t budget_ns;
+};
+
+/// True if two rate groups can never run on the same tick.
+constexpr bool rate_groups_staggered(const RateGroupConfig& a, const RateGroupConfig& b)
+{
+    const uint32_t period = std::gcd(a.divisor, b.divisor);
+    return a.phase % period != b.phase % period;
+}
+
+/// Execution statistics of one rate group, since the last reset_stats().
+struct RateGroupStats {
+    float dt_s;              // Measured time between the latest run and the one before it
+    uint32_t exec_time_ns;   // CPU time of the latest run
+    uint32_t max_exec_time_ns;
+    uint32_t run_count;
+    uint32_t overrun_count;  // Runs that exceeded the budget
+};
+
+/// Schedules one module within the controller tick and measures it. Owned by the controller tick.
+class RateGroup {
+public:
+    constexpr RateGroup(const RateGroupConfig& config, uint64_t tick_period_ns)
+        : config_(config), nominal_dt_s_(static_cast<float>(tick_period_ns * config.divisor) * 1e-9f)
+    {
+    }
+
+    bool due(uint64_t tick) const { return tick % config_.divisor == config_.phase; }
+
+    /// Start a run at the given tick time, returning the measured time since the previous run [s]. The nominal period
+    /// is returned on the first run, or after the group has sat idle for more than two periods (e.g. between traces).
+    float begin(uint64_t tick_time_ns)
+    {
+        float dt_s = nominal_dt_s_;
+        if (last_run_ns_ != 0 && tick_time_ns > last_run_ns_) {
+            float measured_s = static_cast<float>(tick_time_ns - last_run_ns_) * 1e-9f;
+            if (measured_s <= 2.0f * nominal_dt_s_) {
+                dt_s = measured_s;
+            }
+        }
+        last_run_ns_ = tick_time_ns;
+        stats_.dt_s = dt_s;
+        return dt_s;
+    }
+
+    /// Finish a run that took exec_time_ns of CPU time.
+    void end(uint64_t exec_time_ns)
+    {
+        stats_.exec_time_ns = static_cast<uint32_t>(std::min<uint64_t>(exec_time_ns, UINT32_MAX));
+        stats_.max_exec_time_ns = std::max(stats_.max_exec_time_ns, stats_.exec_time_ns);
+        stats_.run_count++;
+        if (stats_.exec_time_ns > config_.budget_ns) {
+            stats_.overrun_count++;
+        }
+    }
+
+    void reset_stats() { stats_ = {}; }
+
+    const RateGroupConfig& config() const { return config_; }
+    const RateGroupStats& stats() const { return stats_; }
+
+private:
+    RateGroupConfig config_;
+    float nominal_dt_s_;
+    uint64_t last_run_ns_ = 0;
+    RateGroupStats stats_ = {};
+};
+
+#endif  // APP_RATE_GROUP_H
@@ -0,0 +1,102 @@
+#ifndef APP_S_CURVE_TRAJECTORY_H
+#define APP_S_CURVE_TRAJECTORY_H
+
+#include <algorithm>
+#include <cmath>
+
+/// Velocity, acceleration and jerk limits of a trajectory, in units of position per second, per second squared and
+/// per second cubed.
+struct SCurveLimits {
+    float max_velocity;
+    float max_acceleration;
+    float max_jerk;
+};
+
+/// Jerk-limited (S-curve) profile towards a moving target, advanced in steps much shorter than the rate the target is
+/// updated at. The target is extrapolated at its velocity between updates, so a ramp is followed without lagging a
+/// whole update behind.
+///
+/// Each step cascades two square-root controllers: position error sets a velocity that can still stop at the target
+/// at half the acceleration limit, and velocity error sets an acceleration that can still level off under the jerk
+/// limit. Acceleration then moves towards it by at most max_jerk * dt, so acceleration is continuous and position
+/// has no corners.
+class SCurveTrajectory {
+public:
+    explicit constexpr SCurveTrajectory(const SCurveLimits& limits)
+        : limits_(limits),
+          velocity_gain_(limits.max_jerk / limits.max_acceleration),
+          position_gain_(velocity_gain_ / 4.0f)
+    {
+    }
+
+    /// Stop immediately at position, without a profile.
+    void reset(float position)
+    {
+        position_ = position;
+        velocity_ = 0.0f;
+        acceleration_ = 0.0f;
+        target_ = position;
+        target_velocity_ = 0.0f;
+    }
+
+    /// New target, moving at target_velocity until the next call.
+    void set_target(float target, float target_velocity = 0.0f)
+    {
+        target_ = target;
+        target_velocity_ = std::clamp(target_velocity, -limits_.max_velocity, limits_.max_velocity);
+    }
+
+    void advance(float dt)
+    {
+        if (dt <= 0.0f) {
+            return;
+        }
+        target_ += target_velocity_ * dt;
+
+        const float desired_velocity = std::clamp(
+            target_velocity_ + sqrt_controller(target_ - position_, position_gain_, 0.5f * limits_.max_acceleration),
+            -limits_.max_velocity, limits_.max_velocity);
+        const float desired_acceleration = std::clamp(
+            sqrt_controller(desired_velocity - velocity_, velocity_gain_, limits_.max_jerk),
+            -limits_.max_acceleration, limits_.max_acceleration);
+
+        const float max_change = limits_.max_jerk * dt;
+        acceleration_ += std::clamp(desired_acceleration - acceleration_, -max_change, max_change);
+
+        const float previous_velocity = velocity_;
+        velocity_ = std::clamp(velocity_ + acceleration_ * dt, -limits_.max_velocity, limits_.max_velocity);
+        position_ += 0.5f * (previous_velocity + velocity_) * dt;
+    }
+
+    float position() const { return position_; }
+    float velocity() const { return velocity_; }
+    float acceleration() const { return acceleration_; }
+    float target() const { return target_; }
+
+private:
+    /// Output that drives error to zero at the given gain when small, and at a constant rate of change limit when
+    /// large: linear below limit / gain^2 and a square root above, matched in value and slope where they meet.
+    static float sqrt_controller(float error, float gain, float limit)
+    {
+        const float linear_dist = limit / (gain * gain);
+        if (error > linear_dist) {
+            return std::sqrt(2.0f * limit * (error - 0.5f * linear_dist));
+        }
+        if (error < -linear_dist) {
+            return -std::sqrt(2.0f * limit * (-error - 0.5f * linear_dist));
+        }
+        return error * gain;
+    }
+
+    SCurveLimits limits_;
+    float velocity_gain_;  // [1/s]
+    float position_gain_;  // [1/s]
+
+    float position_ = 0.0f;
+    float velocity_ = 0.0f;
+    float acceleration_ = 0.0f;
+    float target_ = 0.0f;
+    float target_velocity_ = 0.0f;
+};
+
+#endif  // APP_S_CURVE_TRAJECTORY_H
@@ -0,0 +1,441 @@
+#pragma once
+
+#include "Error.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <expected>
+#include <zephyr/drivers/counter.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/pwm.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#ifdef CONFIG_THROTTLE_VALVES
+
+// Step generators drive a stepper driver's PUL/DIR inputs at a commanded step rate and keep track of the steps sent.
+// They share one interface so ThrottleValve can use either:
+//   init(prefix)          configure the hardware, prefix is used in logs
+//   set_rate(steps_per_s) signed step rate until the next call, positive drives DIR high
+//   steps()               steps sent so far, including those the hardware sent since the last set_rate()
+//   set_steps(steps)      rebase the step count
+//   nsec_per_pulse()      latest pulse period
+
+// -----------------------------------------------------------------------------
+// CounterStepGenerator
+// -----------------------------------------------------------------------------
+// A counter top interrupt toggles PUL one half-step at a time and counts each rising edge in software. Costs two
+// interrupts per step.
+//
+// Setting the top value restarts the counter, so set_rate() retimes the half-step in progress to end one new period
+// after it started, and the interrupt restores the full period. Otherwise rate updates more frequent than a half-step
+// would hold off steps entirely.
+// -----------------------------------------------------------------------------
+template <gpio_dt_spec pul_dt_init, gpio_dt_spec dir_dt_init, const device* counter_dt_init> class CounterStepGenerator {
+private:
+    constexpr static gpio_dt_spec pul_gpio = pul_dt_init;
+    constexpr static gpio_dt_spec dir_gpio = dir_dt_init;
+    constexpr static const device* control_counter = counter_dt_init;
+
+    inline static const char* prefix = "";
+    inline static volatile float rate = 0;
+    inline static volatile int steps_ = 0;
+    inline static k_spinlock lock = {};
+    inline static bool started = false;
+    inline static bool retimed = false;       // The half-step in progress was shortened or lengthened
+    inline static uint32_t period_ticks = 0;  // Half-step period of the current rate [counter ticks]
+    inline static volatile uint64_t last_pulse_cycle = 0;
+    inline static volatile uint64_t pulse_interval_cycles = 0;
+
+    static int set_top(uint32_t ticks)
+    {
+        counter_top_cfg pulse_counter_config{.ticks = ticks, .callback = control_pulse_isr, .user_data = nullptr, .flags = 0};
+        return counter_set_top_value(control_counter, &pulse_counter_config);
+    }
+
+    static void control_pulse_isr(const device*, void*)
+    {
+        LOG_MODULE_DECLARE(ThrottleValve);
+
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        if (retimed) {
+            retimed = false;
+            int err = set_top(period_ticks);
+            if (err) [[unlikely]] {
+                LOG_ERR("%s Failed to set pulse counter top value: err %d", prefix, err);
+            }
+        }
+        toggle_pulse();
+        k_spin_unlock(&lock, key);
+    }
+
+    static void toggle_pulse()
+    {
+        uint64_t now_cycles = k_cycle_get_64();
+        pulse_interval_cycles = now_cycles - last_pulse_cycle;
+        last_pulse_cycle = now_cycles;
+
+        int prev_dir_state = gpio_pin_get_dt(&dir_gpio);
+        if (prev_dir_state < 0) [[unlikely]] {
+            prev_dir_state = 0;
+        }
+        int prev_pul_state = gpio_pin_get_dt(&pul_gpio);
+        if (prev_pul_state < 0) [[unlikely]] {
+            prev_pul_state = 0;
+        }
+        // Switch direction, if we must. Positive rate -> dir gpio should be high. Negative rate -> dir gpio should be
+        // low.
+        if ((!prev_dir_state && rate > 0) || (prev_dir_state && rate < 0)) {
+            gpio_pin_toggle_dt(&dir_gpio);
+            return;
+        }
+        // About to switch low -> high. This is a rising edge, so count a step.
+        if (!prev_pul_state) {
+            if (!prev_dir_state) {
+                steps_ = steps_ - 1;
+            }
+            else {
+                steps_ = steps_ + 1;
+            }
+        }
+        gpio_pin_toggle_dt(&pul_gpio);
+    }
+
+public:
+    CounterStepGenerator() = delete;
+
+    static std::expected<void, Error> init(const char* log_prefix)
+    {
+        LOG_MODULE_DECLARE(ThrottleValve);
+        prefix = log_prefix;
+
+        if (!device_is_ready(pul_gpio.port)) {
+            LOG_ERR("%s Pulse GPIO not ready", prefix);
+            return std::unexpected(Error::from_device_not_ready(pul_gpio.port).context("pulse GPIO not ready on %s valve", prefix));
+        }
+        if (!device_is_ready(dir_gpio.port)) {
+            LOG_ERR("%s Direction GPIO not ready", prefix);
+            return std::unexpected(Error::from_device_not_ready(dir_gpio.port).context("direction GPIO not ready on %s valve", prefix));
+        }
+        if (!device_is_ready(control_counter)) {
+            LOG_ERR("%s Stepper counter not ready", prefix);
+            return std::unexpected(Error::from_device_not_ready(control_counter).context("stepper counter not ready on %s valve", prefix));
+        }
+
+        int err = gpio_pin_configure_dt(&pul_gpio, GPIO_OUTPUT_INACTIVE);
+        if (err) {
+            LOG_ERR("%s Failed to configure pulse GPIO: err %d", prefix, err);
+            return std::unexpected(Error::from_code(err).context("failed to configure pulse GPIO on %s valve", prefix));
+        }
+        err = gpio_pin_configure_dt(&dir_gpio, GPIO_OUTPUT_INACTIVE);
+        if (err) {
+            LOG_ERR("%s Failed to configure direction GPIO: err %d", prefix, err);
+            return std::unexpected(Error::from_code(err).context("failed to configure direction GPIO on %s valve", prefix));
+        }
+        return {};
+    }
+
+    static void set_rate(float steps_per_s)
+    {
+        LOG_MODULE_DECLARE(ThrottleValve);
+
+        rate = steps_per_s;
+
+        // Must divide by two as each counter trigger only toggles pulse, so two triggers are needed for full step on
+        // rising edge.
+        uint32_t ticks = counter_get_max_top_value(control_counter);
+        if (steps_per_s != 0.0f) {
+            auto usec_per_pulse = static_cast<uint64_t>(1e6 / static_cast<double>(std::abs(steps_per_s)) / 2.0);
+            ticks = std::clamp(counter_us_to_ticks(control_counter, usec_per_pulse), 1u, ticks);
+        }
+
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        uint32_t first_ticks = ticks;
+        if (started) {
+            uint32_t value = 0;
+            counter_get_value(control_counter, &value);
+            uint32_t elapsed = counter_is_counting_up(control_counter) ? value : counter_get_top_value(control_counter) - value;
+            first_ticks = ticks > elapsed ? ticks - elapsed : 1;
+        }
+        period_ticks = ticks;
+        retimed = first_ticks != ticks;
+
+        int err = set_top(first_ticks);
+        if (err) [[unlikely]] {
+            LOG_ERR("%s Failed to set pulse counter top value: err %d", prefix, err);
+        }
+
+        if (!started) {
+            err = counter_start(control_counter);
+            if (err) [[unlikely]] {
+                LOG_ERR("%s Failed to start pulse counter: err %d", prefix, err);
+            }
+            started = err == 0;
+        }
+        k_spin_unlock(&lock, key);
+    }
+
+    static int steps() { return steps_; }
+    static void set_steps(int steps) { steps_ = steps; }
+    static uint64_t nsec_per_pulse() { return k_cyc_to_ns_near64(pulse_interval_cycles); }
+};
+
+#ifdef CONFIG_THROTTLE_VALVE_PWM_STEPS
+
+// -----------------------------------------------------------------------------
+// PwmStepGenerator
+// -----------------------------------------------------------------------------
+// A PWM channel on PUL produces the pulse train at 50% duty, so no interrupt runs per step. Steps are derived from
+// the elapsed PWM periods: a segment starts with a rising edge and has one more every period, until the next
+// set_rate() closes it.
+//
+// Assumes the PWM hardware applies a new period at the end of the one in progress (reload, like the i.MX RT FlexPWM
+// with LDOK), so segments follow each other without a gap. An update that lands right on a period boundary could be
+// applied either side of it, so set_rate() waits until just past the boundary instead, for at most UPDATE_GUARD_NS.
+// It is therefore called from the control thread, not an interrupt (see CONFIG_THROTTLE_VALVE_SCURVE).
+//
+// DIR only changes while the output is quiet: a reversal idles the output, and the following set_rate() switches DIR
+// and resumes pulses from the next period boundary, so the output pauses for one control tick.
+// -----------------------------------------------------------------------------
+template <pwm_dt_spec pul_dt_init, gpio_dt_spec dir_dt_init> class PwmStepGenerator {
+private:
+    constexpr static pwm_dt_spec pul_pwm = pul_dt_init;
+    constexpr static gpio_dt_spec dir_gpio = dir_dt_init;
+
+    // Period kept running at 0% duty while stopped, so a restart takes effect within it
+    constexpr static uint64_t IDLE_PERIOD_NS = 10'000;
+    constexpr static uint64_t UPDATE_GUARD_NS = 5'000;
+
+    inline static const char* prefix = "";
+    inline static uint64_t pwm_cycles_per_sec = 0;
+    inline static uint64_t sys_cycles_per_sec = 0;
+    inline static uint32_t idle_period_cycles = 0;
+
+    inline static int base_steps = 0;              // Steps sent before the current segment
+    inline static int direction = 0;               // Of the current segment: +1, -1, or 0 while stopped
+    inline static int dir_level = 0;               // Current DIR output
+    inline static uint32_t period_cycles = 0;      // PWM period of the current segment [PWM cycles]
+    inline static uint64_t segment_start_cycle = 0;  // First rising edge, or start of the first idle period [sys cycles]
+
+    static uint64_t pwm_to_sys_cycles(uint64_t pwm_cycles) { return pwm_cycles * sys_cycles_per_sec / pwm_cycles_per_sec; }
+
+    static uint64_t sys_to_pwm_cycles(uint64_t sys_cycles)
+    {
+        // Segments last about a control tick; the clamp only keeps a stale segment from overflowing.
+        return std::min<uint64_t>(sys_cycles, UINT64_MAX / pwm_cycles_per_sec) * pwm_cycles_per_sec / sys_cycles_per_sec;
+    }
+
+    // Whole periods of the current segment that started at or before now. A running segment has a rising edge at the
+    // start of each.
+    static uint64_t periods_started(uint64_t now_cycle, uint32_t period)
+    {
+        if (now_cycle < segment_start_cycle) {
+            return 0;
+        }
+        return sys_to_pwm_cycles(now_cycle - segment_start_cycle) / period + 1;
+    }
+
+    // Time the period in progress ends, when an update made now takes effect [sys cycles]. Waits out the boundary if
+    // it is too close to call.
+    static uint64_t next_boundary(uint64_t& now_cycle)
+    {
+        const uint32_t period = direction != 0 ? period_cycles : idle_period_cycles;
+        if (now_cycle < segment_start_cycle) {
+            return segment_start_cycle;
+        }
+
+        uint64_t boundary = segment_start_cycle + pwm_to_sys_cycles(periods_started(now_cycle, period) * period);
+        if (k_cyc_to_ns_ceil64(boundary - now_cycle) < UPDATE_GUARD_NS) {
+            k_busy_wait(static_cast<uint32_t>(k_cyc_to_us_ceil64(boundary - now_cycle)) + 1);
+            now_cycle = k_cycle_get_64();
+            boundary = segment_start_cycle + pwm_to_sys_cycles(periods_started(now_cycle, period) * period);
+        }
+        return boundary;
+    }
+
+    static int set_output(uint32_t period, uint32_t pulse)
+    {
+        return pwm_set_cycles(pul_pwm.dev, pul_pwm.channel, period, pulse, pul_pwm.flags);
+    }
+
+public:
+    PwmStepGenerator() = delete;
+
+    static std::expected<void, Error> init(const char* log_prefix)
+    {
+        LOG_MODULE_DECLARE(ThrottleValve);
+        prefix = log_prefix;
+
+        if (!pwm_is_ready_dt(&pul_pwm)) {
+            LOG_ERR("%s Pulse PWM not ready", prefix);
+            return std::unexpected(Error::from_device_not_ready(pul_pwm.dev).context("pulse PWM not ready on %s valve", prefix));
+        }
+        if (!device_is_ready(dir_gpio.port)) {
+            LOG_ERR("%s Direction GPIO not ready", prefix);
+            return std::unexpected(Error::from_device_not_ready(dir_gpio.port).context("direction GPIO not ready on %s valve", prefix));
+        }
+
+        int err = gpio_pin_configure_dt(&dir_gpio, GPIO_OUTPUT_INACTIVE);
+        if (err) {
+            LOG_ERR("%s Failed to configure direction GPIO: err %d", prefix, err);
+            return std::unexpected(Error::from_code(err).context("failed to configure direction GPIO on %s valve", prefix));
+        }
+        dir_level = 0;
+
+        err = pwm_get_cycles_per_sec(pul_pwm.dev, pul_pwm.channel, &pwm_cycles_per_sec);
+        if (err) {
+            LOG_ERR("%s Failed to get pulse PWM clock rate: err %d", prefix, err);
+            return std::unexpected(Error::from_code(err).context("failed to get pulse PWM clock rate on %s valve", prefix));
+        }
+        if (pwm_cycles_per_sec == 0) {
+            LOG_ERR("%s Pulse PWM clock rate is zero", prefix);
+            return std::unexpected(Error::from_cause("pulse PWM clock rate is zero on %s valve", prefix));
+        }
+        sys_cycles_per_sec = sys_clock_hw_cycles_per_sec();
+        idle_period_cycles = static_cast<uint32_t>(std::max<uint64_t>(IDLE_PERIOD_NS * pwm_cycles_per_sec / NSEC_PER_SEC, 2));
+
+        err = set_output(idle_period_cycles, 0);
+        if (err) {
+            LOG_ERR("%s Failed to start pulse PWM: err %d", prefix, err);
+            return std::unexpected(Error::from_code(err).context("failed to start pulse PWM on %s valve", prefix));
+        }
+        segment_start_cycle = k_cycle_get_64();
+        direction = 0;
+        return {};
+    }
+
+    static void set_rate(float steps_per_s)
+    {
+        LOG_MODULE_DECLARE(ThrottleValve);
+
+        const int new_direction = steps_per_s > 0.0f ? 1 : (steps_per_s < 0.0f ? -1 : 0);
+        const uint64_t requested_period = new_direction != 0
+            ? static_cast<uint64_t>(static_cast<double>(pwm_cycles_per_sec) / std::abs(static_cast<double>(steps_per_s)) + 0.5)
+            : 0;
+        const bool reverse = new_direction != 0 && new_direction != (dir_level ? 1 : -1);
+        bool stop = new_direction == 0 || requested_period > UINT32_MAX || reverse;
+
+        uint64_t now_cycle = k_cycle_get_64();
+
+        // Once the output has been quiet since the segment started, switch DIR and resume pulses in the same call.
+        // Until then, the last period of the previous segment is still running.
+        if (reverse && direction == 0 && now_cycle >= segment_start_cycle) {
+            gpio_pin_set_dt(&dir_gpio, new_direction > 0 ? 1 : 0);
+            dir_level = new_direction > 0 ? 1 : 0;
+            stop = requested_period > UINT32_MAX;
+            now_cycle = k_cycle_get_64();
+        }
+
+        // Taken after any DIR change, so DIR leads the first rising edge by at least UPDATE_GUARD_NS
+        const uint64_t boundary = next_boundary(now_cycle);
+        if (stop && direction == 0) {
+            return;
+        }
+
+        const uint32_t new_period = stop ? idle_period_cycles : static_cast<uint32_t>(std::max<uint64_t>(requested_period, 2));
+        int err = set_output(new_period, stop ? 0 : new_period / 2);
+        if (err) [[unlikely]] {
+            LOG_ERR("%s Failed to set pulse PWM: err %d", prefix, err);
+            return;
+        }
+
+        // Close the current segment. The period in progress finishes, so its rising edge counts.
+        if (direction != 0) {
+            base_steps += direction * static_cast<int>(periods_started(now_cycle, period_cycles));
+        }
+        segment_start_cycle = boundary;
+        direction = stop ? 0 : new_direction;
+        period_cycles = new_period;
+    }
+
+    static int steps()
+    {
+        if (direction == 0) {
+            return base_steps;
+        }
+        return base_steps + direction * static_cast<int>(periods_started(k_cycle_get_64(), period_cycles));
+    }
+
+    static void set_steps(int steps) { base_steps += steps - PwmStepGenerator::steps(); }
+
+    static uint64_t nsec_per_pulse() { return direction != 0 ? period_cycles * NSEC_PER_SEC / pwm_cycles_per_sec : 0; }
+};
+
+#endif  // CONFIG_THROTTLE_VALVE_PWM_STEPS
+
+#ifdef CONFIG_PLANT_SIM
+
+// -----------------------------------------------------------------------------
+// SimStepGenerator
+// -----------------------------------------------------------------------------
+// Ideal step generator for the native_sim plant simulator. No pulses are produced: steps accrue at exactly the
+// commanded rate from the moment set_rate() is called, and the plant moves its valve model by steps_sent(), which
+// set_steps() does not rebase. channel only tells the fuel and lox instances apart.
+// -----------------------------------------------------------------------------
+template <int channel> class SimStepGenerator {
+private:
+    inline static k_spinlock lock = {};
+    inline static float rate = 0;
+    inline static double base_position = 0;       // Steps sent before the current rate was set
+    inline static uint64_t rate_start_cycle = 0;
+    inline static int offset = 0;                 // Added by set_steps()
+
+    static int sent(uint64_t now_cycle)
+    {
+        const double elapsed_s = static_cast<double>(now_cycle - rate_start_cycle) / sys_clock_hw_cycles_per_sec();
+        return static_cast<int>(std::floor(base_position + static_cast<double>(rate) * elapsed_s));
+    }
+
+public:
+    SimStepGenerator() = delete;
+
+    static std::expected<void, Error> init(const char*)
+    {
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        rate = 0;
+        rate_start_cycle = k_cycle_get_64();
+        k_spin_unlock(&lock, key);
+        return {};
+    }
+
+    static void set_rate(float steps_per_s)
+    {
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        const uint64_t now_cycle = k_cycle_get_64();
+        const double elapsed_s = static_cast<double>(now_cycle - rate_start_cycle) / sys_clock_hw_cycles_per_sec();
+        base_position += static_cast<double>(rate) * elapsed_s;
+        rate_start_cycle = now_cycle;
+        rate = steps_per_s;
+        k_spin_unlock(&lock, key);
+    }
+
+    static int steps()
+    {
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        const int steps = sent(k_cycle_get_64()) + offset;
+        k_spin_unlock(&lock, key);
+        return steps;
+    }
+
+    static void set_steps(int steps)
+    {
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        offset = steps - sent(k_cycle_get_64());
+        k_spin_unlock(&lock, key);
+    }
+
+    static uint64_t nsec_per_pulse() { return rate != 0 ? static_cast<uint64_t>(1e9 / std::abs(static_cast<double>(rate))) : 0; }
+
+    /// Steps sent since boot, read by the plant.
+    static int steps_sent()
+    {
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        const int steps = sent(k_cycle_get_64());
+        k_spin_unlock(&lock, key);
+        return steps;
+    }
+};
+
+#endif  // CONFIG_PLANT_SIM
+
+#endif  // CONFIG_THROTTLE_VALVES
@@ -2,13 +2,17 @@
 
 #include "Error.h"
 #include "MutexGuard.h"
+#include "QuadratureEncoder.h"
+#include "SCurveTrajectory.h"
+#include "StepGenerator.h"
 #include "clover.pb.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <expected>
-#include <zephyr/drivers/counter.h>
+#include <limits>
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
 #ifdef CONFIG_THROTTLE_VALVES
@@ -21,19 +25,31 @@ constexpr float DEG_PER_STEP = 360.0f / STEPS_PER_REVOLUTION / GEARBOX_RATIO / M
 constexpr float MAX_VELOCITY = 225.0f * 4;
 constexpr float MAX_ACCELERATION = 12000.0f * 40;
 
+#ifdef CONFIG_THROTTLE_VALVE_SCURVE
+// The sub-tick update sets the step rate from a timer interrupt, which only the counter and simulated step generators
+// support: PwmStepGenerator::set_rate() can busy-wait out a PWM period boundary.
+static_assert(!IS_ENABLED(CONFIG_THROTTLE_VALVE_PWM_STEPS), "S-curve sub-ticks need a step generator safe to use from an interrupt");
+
+// Acceleration ramps to its limit in 0.25 ms.
+constexpr float MAX_JERK = MAX_ACCELERATION / 0.00025f;
+// The trajectory and step rate are updated this often between control ticks.
+constexpr uint32_t TRAJECTORY_SUBTICK_USEC = 200;
+// Time constant the steps sent are pulled onto the trajectory with.
+constexpr float STEP_FEEDBACK_TIME = 0.0004f;
+// Steps the encoder shows were missed are added back onto the target. The estimate is low-passed over ~20 ticks so it
+// ignores the motor's lag while accelerating, and limited so a stalled valve (e.g. against a hardstop) is not pushed
+// further and further.
+constexpr float ENCODER_SLIP_FILTER = 0.05f;
+constexpr float ENCODER_SLIP_DEADBAND_DEG = 0.1f;
+constexpr float MAX_ENCODER_SLIP_CORRECTION_DEG = 1.0f;
+#endif  // CONFIG_THROTTLE_VALVE_SCURVE
+
 constexpr float ENCODER_CPR = 4000.0f;
 constexpr float DEG_PER_ENCODER_COUNT = 360.0f / (ENCODER_CPR * GEARBOX_RATIO);
 
 enum class ValveKind { FUEL, LOX };
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
 class ThrottleValve {
 private:
     enum class ValveState {
@@ -41,12 +57,7 @@ private:
         OFF,
     };
 
-    constexpr static gpio_dt_spec pul_gpio = pul_dt_init;
     constexpr static gpio_dt_spec ena_gpio = ena_dt_init;
-    constexpr static gpio_dt_spec dir_gpio = dir_dt_init;
-    constexpr static gpio_dt_spec enc_a_gpio = enc_a_dt_init;
-    constexpr static gpio_dt_spec enc_b_gpio = enc_b_dt_init;
-    constexpr static const device* control_counter = control_counter_dt_init;
 
     static consteval const char* kind_to_prefix(ValveKind valve_kind);
 
@@ -56,22 +67,32 @@ private:
 
     inline static float velocity = 0;
     inline static float acceleration = 0;
-    inline static volatile int steps = 0;
-    inline static volatile uint64_t last_pulse_cycle = 0;
-    inline static volatile uint64_t pulse_interval_cycles = 0;
 
     inline static float current_encoder_position = 0.0f;
     inline static float previous_encoder_position = 0.0f;
 
-    static void control_pulse_isr(const device*, void*);
-
-    inline static volatile int encoder_count = 0;
-    inline static volatile uint8_t prev_encoder_state = 0;
-    inline static gpio_callback encoder_a_callback = {};
-    inline static gpio_callback encoder_b_callback = {};
-    static void encoder_update_isr(const device*, gpio_callback*, gpio_port_pins_t);
-
-    static uint8_t read_encoder_state();
+    inline static bool has_calibration = false;
+    inline static ThrottleValveCalibration calibration = ThrottleValveCalibration_init_default;
+
+#ifdef CONFIG_THROTTLE_VALVE_SCURVE
+    // Trajectory state is shared with the sub-tick timer interrupt.
+    inline static k_spinlock trajectory_lock = {};
+    inline static k_timer trajectory_timer = {};
+    inline static SCurveTrajectory trajectory{{MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK}};
+    inline static bool trajectory_running = false;
+    inline static uint64_t last_subtick_cycle = 0;
+
+    // Only used by the control tick. Commands may be held over several ticks by the module's rate group, so the
+    // target's velocity is measured between changes and extrapolated for as long as the last change took to arrive.
+    inline static float previous_target_deg = std::numeric_limits<float>::quiet_NaN();
+    inline static float target_velocity = 0.0f;
+    inline static uint32_t ticks_since_target_change = 0;
+    inline static uint32_t target_change_interval = 1;
+    inline static float encoder_slip_deg = 0.0f;
+
+    static void trajectory_subtick(k_timer*);
+    static void stop_trajectory();
+#endif  // CONFIG_THROTTLE_VALVE_SCURVE
 
 public:
     ThrottleValve() = delete;
@@ -83,6 +104,7 @@ public:
     static void move(float target_deg);
     static void reset_pos(float new_pos);
     static void power_on(bool on);
+    static void set_calibration(const ThrottleValveCalibration& result);
 
     static float get_pos_internal();
     static float get_pos_encoder();
@@ -93,16 +115,9 @@ public:
     static bool get_power_on();
 };
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
 consteval const char*
-ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::kind_to_prefix(ValveKind valve_kind)
+ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::kind_to_prefix(ValveKind valve_kind)
 {
     switch (valve_kind) {
     case ValveKind::FUEL:
@@ -112,212 +127,59 @@ ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_
     }
 }
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-void ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::control_pulse_isr(
-    const struct device*, void*)
-{
-    LOG_MODULE_DECLARE(ThrottleValve);
-
-    uint64_t now_cycles = k_cycle_get_64();
-    pulse_interval_cycles = now_cycles - last_pulse_cycle;
-    last_pulse_cycle = now_cycles;
-
-    int prev_dir_state = gpio_pin_get_dt(&dir_gpio);
-    if (prev_dir_state < 0) [[unlikely]] {
-        prev_dir_state = 0;
-    }
-    int prev_pul_state = gpio_pin_get_dt(&pul_gpio);
-    if (prev_pul_state < 0) [[unlikely]] {
-        prev_pul_state = 0;
-    }
-    // Switch direction, if we must. Positive velocity -> dir gpio should be high. Negative velocity -> dir gpio should
-    // be low.
-    if ((!prev_dir_state && velocity > 0) || (prev_dir_state && velocity < 0)) {
-        gpio_pin_toggle_dt(&dir_gpio);
-        return;
-    }
-    // About to switch low -> high. This is a rising edge, so count a step.
-    if (!prev_pul_state) {
-        if (!prev_dir_state) {
-            steps = steps - 1;
-        }
-        else {
-            steps = steps + 1;
-        }
-    }
-    gpio_pin_toggle_dt(&pul_gpio);
-}
-
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-void ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::encoder_update_isr(
-    const device*, struct gpio_callback*, gpio_port_pins_t)
-{
-    constexpr int8_t ENCODER_STEP_TABLE[4][4] = {
-        {0, +1, -1, 0},
-        {-1, 0, 0, +1},
-        {+1, 0, 0, -1},
-        {0, -1, +1, 0},
-    };
-
-    uint8_t new_state = read_encoder_state();
-    if constexpr (kind == ValveKind::FUEL) {
-        encoder_count -= ENCODER_STEP_TABLE[prev_encoder_state][new_state];
-    }
-    else {
-        encoder_count += ENCODER_STEP_TABLE[prev_encoder_state][new_state];
-    }
-    prev_encoder_state = new_state;
-}
-
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-uint8_t ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::read_encoder_state()
-{
-    LOG_MODULE_DECLARE(ThrottleValve);
-
-    int a = gpio_pin_get_dt(&enc_a_gpio);
-    if (a < 0) [[unlikely]] {
-        a = 0;
-    }
-    int b = gpio_pin_get_dt(&enc_b_gpio);
-    if (b < 0) [[unlikely]] {
-        b = 0;
-    }
-    return (static_cast<uint8_t>(b) << 1) | static_cast<uint8_t>(a);
-}
-
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-std::expected<void, Error> ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::init()
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+std::expected<void, Error> ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::init()
 {
     LOG_MODULE_DECLARE(ThrottleValve);
     LOG_INF("%s Initializing throttle valve...", kind_to_prefix(kind));
 
-    if (!device_is_ready(pul_gpio.port)) {
-        LOG_ERR("%s Pulse GPIO not ready", kind_to_prefix(kind));
-        return std::unexpected(Error::from_device_not_ready(pul_gpio.port).context("pulse GPIO not ready on %s valve", kind_to_prefix(kind)));
+    if (auto ret = StepGenerator::init(kind_to_prefix(kind)); !ret.has_value()) {
+        return std::unexpected(ret.error());
     }
-    if (!device_is_ready(dir_gpio.port)) {
-        LOG_ERR("%s Direction GPIO not ready", kind_to_prefix(kind));
-        return std::unexpected(Error::from_device_not_ready(dir_gpio.port).context("direction GPIO not ready on %s valve", kind_to_prefix(kind)));
+    if (auto ret = Encoder::init(kind_to_prefix(kind)); !ret.has_value()) {
+        return std::unexpected(ret.error());
     }
     if (!device_is_ready(ena_gpio.port)) {
         LOG_ERR("%s Enable GPIO not ready", kind_to_prefix(kind));
         return std::unexpected(Error::from_device_not_ready(ena_gpio.port).context("enable GPIO not ready on %s valve", kind_to_prefix(kind)));
     }
-    if (!device_is_ready(enc_a_gpio.port)) {
-        LOG_ERR("%s Encoder A GPIO not ready", kind_to_prefix(kind));
-        return std::unexpected(Error::from_device_not_ready(enc_a_gpio.port).context("encoder A GPIO not ready on %s valve", kind_to_prefix(kind)));
-    }
-    if (!device_is_ready(enc_b_gpio.port)) {
-        LOG_ERR("%s Encoder B GPIO not ready", kind_to_prefix(kind));
-        return std::unexpected(Error::from_device_not_ready(enc_b_gpio.port).context("encoder B GPIO not ready on %s valve", kind_to_prefix(kind)));
-    }
-    if (!device_is_ready(control_counter)) {
-        LOG_ERR("%s Stepper counter not ready", kind_to_prefix(kind));
-        return std::unexpected(Error::from_device_not_ready(control_counter).context("stepper counter not ready on %s valve", kind_to_prefix(kind)));
-    }
 
     int err;
-    err = gpio_pin_configure_dt(&pul_gpio, GPIO_OUTPUT_INACTIVE);
-    if (err) {
-        LOG_ERR("%s Failed to configure pulse GPIO: err %d", kind_to_prefix(kind), err);
-        return std::unexpected(Error::from_code(err).context("failed to configure pulse GPIO on %s valve", kind_to_prefix(kind)));
-    }
-    err = gpio_pin_configure_dt(&dir_gpio, GPIO_OUTPUT_INACTIVE);
-    if (err) {
-        LOG_ERR("%s Failed to configure direction GPIO: err %d", kind_to_prefix(kind), err);
-        return std::unexpected(Error::from_code(err).context("failed to configure direction GPIO on %s valve", kind_to_prefix(kind)));
-    }
     err = gpio_pin_configure_dt(&ena_gpio, GPIO_OUTPUT_ACTIVE);
     if (err) {
         LOG_ERR("%s Failed to configure enable GPIO: err %d", kind_to_prefix(kind), err);
         return std::unexpected(Error::from_code(err).context("failed to configure enable GPIO on %s valve", kind_to_prefix(kind)));
     }
-    err = gpio_pin_configure_dt(&enc_a_gpio, GPIO_INPUT);
-    if (err) {
-        LOG_ERR("%s Failed to configure encoder A GPIO: err %d", kind_to_prefix(kind), err);
-        return std::unexpected(Error::from_code(err).context("failed to configure encoder A GPIO on %s valve", kind_to_prefix(kind)));
-    }
-    err = gpio_pin_configure_dt(&enc_b_gpio, GPIO_INPUT);
-    if (err) {
-        LOG_ERR("%s Failed to configure encoder B GPIO: err %d", kind_to_prefix(kind), err);
-        return std::unexpected(Error::from_code(err).context("failed to configure encoder B GPIO on %s valve", kind_to_prefix(kind)));
-    }
-
-    prev_encoder_state = read_encoder_state();
-
-    err = gpio_pin_interrupt_configure_dt(&enc_a_gpio, GPIO_INT_EDGE_BOTH);
-    if (err) {
-        LOG_ERR("%s Failed to enable encoder A interrupts: err %d", kind_to_prefix(kind), err);
-        return std::unexpected(Error::from_code(err).context("failed to enable encoder A interrupts on %s valve", kind_to_prefix(kind)));
-    }
-    err = gpio_pin_interrupt_configure_dt(&enc_b_gpio, GPIO_INT_EDGE_BOTH);
-    if (err) {
-        LOG_ERR("%s Failed to enable encoder B interrupts: err %d", kind_to_prefix(kind), err);
-        return std::unexpected(Error::from_code(err).context("failed to enable encoder B interrupts on %s valve", kind_to_prefix(kind)));
-    }
-
-    gpio_init_callback(&encoder_a_callback, encoder_update_isr, BIT(enc_a_gpio.pin));
-    gpio_add_callback_dt(&enc_a_gpio, &encoder_a_callback);
-    gpio_init_callback(&encoder_b_callback, encoder_update_isr, BIT(enc_b_gpio.pin));
-    gpio_add_callback_dt(&enc_b_gpio, &encoder_b_callback);
 
     k_mutex_init(&motor_lock);
+#ifdef CONFIG_THROTTLE_VALVE_SCURVE
+    k_timer_init(&trajectory_timer, trajectory_subtick, nullptr);
+#endif
 
     LOG_INF("%s Throttle valve initialized.", kind_to_prefix(kind));
     return {};
 }
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-ThrottleValveStatus ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::status()
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+ThrottleValveStatus ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::status()
 {
-    return ThrottleValveStatus{.encoder_pos_deg = get_pos_encoder(), .is_on = get_power_on()};
+    MutexGuard motor_guard{&motor_lock};
+    return ThrottleValveStatus{
+        .encoder_pos_deg = get_pos_encoder(), .is_on = get_power_on(), .has_calibration = has_calibration, .calibration = calibration};
 }
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
+/// Keep a calibration result to report in the valve's status.
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+void ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::set_calibration(const ThrottleValveCalibration& result)
+{
+    MutexGuard motor_guard{&motor_lock};
+    calibration = result;
+    has_calibration = true;
+}
+
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
 std::expected<void, Error>
-ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::tick(const ThrottleValveCommand& command)
+ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::tick(const ThrottleValveCommand& command)
 {
     const auto& on = command.enable;
     const auto& target_deg = command.target_deg;
@@ -337,6 +199,9 @@ ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_
     switch (state) {
     case ValveState::OFF:
         power_on(false);
+#ifdef CONFIG_THROTTLE_VALVE_SCURVE
+        stop_trajectory();
+#endif
         break;
     case ValveState::RUNNING:
         move(target_deg);
@@ -346,21 +211,53 @@ ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_
     return {};
 }
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-void ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::move(float target_deg)
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+void ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::move(float target_deg)
 {
     LOG_MODULE_DECLARE(ThrottleValve);
 
     power_on(true);
     constexpr float CONTROL_TIME = 0.001;
 
+#ifdef CONFIG_THROTTLE_VALVE_SCURVE
+    // Follow the target on a jerk-limited profile that the sub-tick timer advances and turns into a step rate.
+    encoder_slip_deg += ENCODER_SLIP_FILTER * ((get_pos_internal() - current_encoder_position) - encoder_slip_deg);
+    const float slip_correction = std::abs(encoder_slip_deg) > ENCODER_SLIP_DEADBAND_DEG
+        ? std::clamp(encoder_slip_deg, -MAX_ENCODER_SLIP_CORRECTION_DEG, MAX_ENCODER_SLIP_CORRECTION_DEG)
+        : 0.0f;
+
+    ticks_since_target_change++;
+    if (std::isnan(previous_target_deg)) {
+        previous_target_deg = target_deg;
+        ticks_since_target_change = 0;
+    }
+    else if (target_deg != previous_target_deg) {
+        target_velocity = (target_deg - previous_target_deg) / (static_cast<float>(ticks_since_target_change) * CONTROL_TIME);
+        target_change_interval = ticks_since_target_change;
+        previous_target_deg = target_deg;
+        ticks_since_target_change = 0;
+    }
+    else if (ticks_since_target_change >= target_change_interval) {
+        target_velocity = 0.0f;
+    }
+    const float extrapolated_target_deg = target_deg + target_velocity * static_cast<float>(ticks_since_target_change) * CONTROL_TIME;
+
+    k_spinlock_key_t key = k_spin_lock(&trajectory_lock);
+    const bool start = !trajectory_running;
+    if (start) {
+        trajectory.reset(get_pos_internal());
+        last_subtick_cycle = k_cycle_get_64();
+        trajectory_running = true;
+    }
+    trajectory.set_target(extrapolated_target_deg + slip_correction, target_velocity);
+    velocity = trajectory.velocity();
+    acceleration = trajectory.acceleration();
+    k_spin_unlock(&trajectory_lock, key);
+
+    if (start) {
+        k_timer_start(&trajectory_timer, K_NO_WAIT, K_USEC(TRAJECTORY_SUBTICK_USEC));
+    }
+#else
     float target_velocity = (target_deg - get_pos_internal()) / CONTROL_TIME;
 
     float required_acceleration = (target_velocity - velocity) / CONTROL_TIME;
@@ -373,38 +270,61 @@ void ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, e
 
     target_velocity = std::clamp(target_velocity, -MAX_VELOCITY, MAX_VELOCITY);
 
-    // Based on velocity, calculate pulse interval. Must divide by two as each counter trigger
-    // only toggles pulse, so two triggers are needed for full step on rising edge.
-    auto usec_per_pulse = static_cast<uint64_t>(1e6 / static_cast<double>(std::abs(target_velocity)) * static_cast<double>(DEG_PER_STEP) / 2.0);
-
     acceleration = (target_velocity - velocity) / CONTROL_TIME;
     velocity = target_velocity;
 
-    uint32_t ticks = std::min(counter_us_to_ticks(control_counter, usec_per_pulse), counter_get_max_top_value(control_counter));
-    counter_top_cfg pulse_counter_config{.ticks = ticks, .callback = control_pulse_isr, .user_data = nullptr, .flags = 0};
+    StepGenerator::set_rate(target_velocity / DEG_PER_STEP);
+#endif  // CONFIG_THROTTLE_VALVE_SCURVE
+}
 
-    int err = counter_set_top_value(control_counter, &pulse_counter_config);
-    if (err) [[unlikely]] {
-        LOG_ERR("%s Failed to set pulse counter top value: err %d", kind_to_prefix(kind), err);
+#ifdef CONFIG_THROTTLE_VALVE_SCURVE
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+void ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::trajectory_subtick(k_timer*)
+{
+    const uint64_t now_cycle = k_cycle_get_64();
+
+    k_spinlock_key_t key = k_spin_lock(&trajectory_lock);
+    if (trajectory_running) {
+        // A late timer moves the trajectory further rather than slowing it down, up to a control tick.
+        const float dt = std::min(static_cast<float>(now_cycle - last_subtick_cycle) / static_cast<float>(sys_clock_hw_cycles_per_sec()), 0.001f);
+        last_subtick_cycle = now_cycle;
+        trajectory.advance(dt);
+
+        // Pull the steps sent back onto the trajectory, ignoring errors within half a step.
+        float step_error = trajectory.position() - get_pos_internal();
+        if (std::abs(step_error) < 0.5f * DEG_PER_STEP) {
+            step_error = 0.0f;
+        }
+        const float rate = std::clamp(trajectory.velocity() + step_error / STEP_FEEDBACK_TIME, -MAX_VELOCITY, MAX_VELOCITY);
+        StepGenerator::set_rate(rate / DEG_PER_STEP);
     }
+    k_spin_unlock(&trajectory_lock, key);
+}
 
-    err = counter_start(control_counter);
-    if (err) [[unlikely]] {
-        LOG_ERR("%s Failed to start pulse counter: err %d", kind_to_prefix(kind), err);
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+void ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::stop_trajectory()
+{
+    k_timer_stop(&trajectory_timer);
+
+    k_spinlock_key_t key = k_spin_lock(&trajectory_lock);
+    if (trajectory_running) {
+        trajectory_running = false;
+        StepGenerator::set_rate(0.0f);
     }
+    velocity = 0.0f;
+    acceleration = 0.0f;
+    k_spin_unlock(&trajectory_lock, key);
+
+    previous_target_deg = std::numeric_limits<float>::quiet_NaN();
+    target_velocity = 0.0f;
+    encoder_slip_deg = 0.0f;
 }
+#endif  // CONFIG_THROTTLE_VALVE_SCURVE
 
 /// Reset internal and encoder positions to a new value without moving the motor. The current physical valve position
 /// will be set as the input new position.
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-void ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::reset_pos(float new_pos)
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+void ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::reset_pos(float new_pos)
 {
     LOG_MODULE_DECLARE(ThrottleValve);
 
@@ -416,20 +336,20 @@ void ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, e
     // }
 
     int new_steps = static_cast<int>(std::round(new_pos / DEG_PER_STEP));
-    steps = new_steps;
+    StepGenerator::set_steps(new_steps);
     int new_encoder_count = static_cast<int>(std::round(new_pos / DEG_PER_ENCODER_COUNT));
-    encoder_count = new_encoder_count;
+    Encoder::set_count(new_encoder_count);
+
+#ifdef CONFIG_THROTTLE_VALVE_SCURVE
+    k_spinlock_key_t key = k_spin_lock(&trajectory_lock);
+    trajectory.reset(get_pos_internal());
+    k_spin_unlock(&trajectory_lock, key);
+    encoder_slip_deg = 0.0f;
+#endif
 }
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-void ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::power_on(bool on)
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+void ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::power_on(bool on)
 {
     LOG_MODULE_DECLARE(ThrottleValve);
     MutexGuard motor_guard{&motor_lock};
@@ -449,119 +369,115 @@ void ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, e
 }
 
 /// Get internal motor position via how many pulses we sent to the controller.
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-float ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::get_pos_internal()
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+float ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::get_pos_internal()
 {
-    return static_cast<float>(steps) * DEG_PER_STEP;
+    return static_cast<float>(StepGenerator::steps()) * DEG_PER_STEP;
 }
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-float ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::get_pos_encoder()
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+float ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::get_pos_encoder()
 {
-    return static_cast<float>(encoder_count) * DEG_PER_ENCODER_COUNT;
+    return static_cast<float>(Encoder::count()) * DEG_PER_ENCODER_COUNT;
 }
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-float ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::get_velocity()
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+float ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::get_velocity()
 {
     return velocity;
 }
 
 /// Get the current velocity in deg/s. It is only updated per call to
 /// throttle_valve_move. NOT A MEASUREMENT OF ENCODER
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-float ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::get_encoder_velocity()
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+float ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::get_encoder_velocity()
 {
     return (previous_encoder_position - current_encoder_position) / 0.001f;
 }
 
 /// Get the current acceleration in deg/s^2. It is only updated per call to
 /// throttle_valve_move.
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-float ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::get_acceleration()
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+float ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::get_acceleration()
 {
     return acceleration;
 }
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-uint64_t ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::get_nsec_per_pulse()
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+uint64_t ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::get_nsec_per_pulse()
 {
-    return k_cyc_to_ns_near64(pulse_interval_cycles);
+    return StepGenerator::nsec_per_pulse();
 }
 
-template <
-    ValveKind kind,
-    gpio_dt_spec pul_dt_init,
-    gpio_dt_spec dir_dt_init,
-    gpio_dt_spec ena_dt_init,
-    gpio_dt_spec enc_a_dt_init,
-    gpio_dt_spec enc_b_dt_init,
-    const device* control_counter_dt_init>
-bool ThrottleValve<kind, pul_dt_init, dir_dt_init, ena_dt_init, enc_a_dt_init, enc_b_dt_init, control_counter_dt_init>::get_power_on()
+template <ValveKind kind, typename StepGenerator, typename Encoder, gpio_dt_spec ena_dt_init>
+bool ThrottleValve<kind, StepGenerator, Encoder, ena_dt_init>::get_power_on()
 {
     return state != ValveState::OFF;
 }
 
-typedef ThrottleValve<
-    ValveKind::FUEL,
+#ifdef CONFIG_PLANT_SIM
+typedef SimStepGenerator<0> FuelValveStepGenerator;
+typedef SimStepGenerator<1> LoxValveStepGenerator;
+#elifdef CONFIG_THROTTLE_VALVE_PWM_STEPS
+typedef PwmStepGenerator<
+    PWM_DT_SPEC_GET_BY_NAME(DT_PATH(zephyr_user), fuel_valve_stepper_pul),
+    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_stepper_dir_gpios)>
+    FuelValveStepGenerator;
+
+typedef PwmStepGenerator<
+    PWM_DT_SPEC_GET_BY_NAME(DT_PATH(zephyr_user), lox_valve_stepper_pul),
+    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), lox_valve_stepper_dir_gpios)>
+    LoxValveStepGenerator;
+#else
+typedef CounterStepGenerator<
     GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_stepper_pul_gpios),
     GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_stepper_dir_gpios),
-    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_stepper_ena_gpios),
-    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_encoder_a_gpios),
-    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_encoder_b_gpios),
     DEVICE_DT_GET(DT_ALIAS(fuel_valve_stepper_pulse_counter))>
-    FuelValve;
+    FuelValveStepGenerator;
 
-typedef ThrottleValve<
-    ValveKind::LOX,
+typedef CounterStepGenerator<
     GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), lox_valve_stepper_pul_gpios),
     GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), lox_valve_stepper_dir_gpios),
-    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), lox_valve_stepper_ena_gpios),
+    DEVICE_DT_GET(DT_ALIAS(lox_valve_stepper_pulse_counter))>
+    LoxValveStepGenerator;
+#endif  // CONFIG_THROTTLE_VALVE_PWM_STEPS
+
+// Fuel encoder counts are negated to match the direction of its steps.
+#ifdef CONFIG_PLANT_SIM
+typedef SimQuadratureEncoder<0> FuelValveEncoder;
+typedef SimQuadratureEncoder<1> LoxValveEncoder;
+#elifdef CONFIG_THROTTLE_VALVE_QDEC
+typedef QdecQuadratureEncoder<DEVICE_DT_GET(DT_ALIAS(fuel_valve_encoder_qdec)), static_cast<int>(ENCODER_CPR), true>
+    FuelValveEncoder;
+
+typedef QdecQuadratureEncoder<DEVICE_DT_GET(DT_ALIAS(lox_valve_encoder_qdec)), static_cast<int>(ENCODER_CPR), false>
+    LoxValveEncoder;
+#else
+typedef GpioQuadratureEncoder<
+    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_encoder_a_gpios),
+    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_encoder_b_gpios),
+    true>
+    FuelValveEncoder;
+
+typedef GpioQuadratureEncoder<
     GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), lox_valve_encoder_a_gpios),
     GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), lox_valve_encoder_b_gpios),
-    DEVICE_DT_GET(DT_ALIAS(lox_valve_stepper_pulse_counter))>
+    false>
+    LoxValveEncoder;
+#endif  // CONFIG_THROTTLE_VALVE_QDEC
+
+typedef ThrottleValve<
+    ValveKind::FUEL,
+    FuelValveStepGenerator,
+    FuelValveEncoder,
+    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_stepper_ena_gpios)>
+    FuelValve;
+
+typedef ThrottleValve<
+    ValveKind::LOX,
+    LoxValveStepGenerator,
+    LoxValveEncoder,
+    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), lox_valve_stepper_ena_gpios)>
     LoxValve;
 
 #endif  // CONFIG_THROTTLE_VALVES
@@ -0,0 +1,51 @@
+#ifndef APP_TRIPLE_BUFFER_H
+#define APP_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// Wait-free single-writer, single-reader snapshot of the newest value.
+///
+/// The writer fills its back buffer and swaps it with the shared middle buffer, and the reader swaps the middle buffer
+/// with its front buffer when a newer value has been published. Each side does one atomic exchange and never waits or
+/// retries, so a high-priority reader is never held up by a preempted writer (and vice versa). Values the reader did
+/// not get to are overwritten; only the newest one matters.
+template <typename T> class TripleBuffer {
+public:
+    /// Buffer the writer may fill before calling publish(). Writer only.
+    T& back() { return buffers[back_index]; }
+
+    /// Make the back buffer the newest value. Writer only.
+    void publish()
+    {
+        back_index = middle.exchange(back_index | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /// Copy a value into the back buffer and publish it. Writer only.
+    void write(const T& value)
+    {
+        back() = value;
+        publish();
+    }
+
+    /// Newest published value, or a default-constructed T before the first publish. Reader only.
+    const T& read()
+    {
+        if (middle.load(std::memory_order_relaxed) & FRESH) {
+            front_index = middle.exchange(front_index, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+        return buffers[front_index];
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;  // Set while the middle buffer holds a value the reader has not taken
+
+    std::array<T, 3> buffers{};
+    std::atomic<uint8_t> middle{1};
+    uint8_t back_index = 0;
+    uint8_t front_index = 2;
+};
+
+#endif  // APP_TRIPLE_BUFFER_H
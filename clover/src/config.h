@@ -1,15 +1,23 @@
 #ifndef APP_CONFIG_H
 #define APP_CONFIG_H
 
+#include "RateGroup.h"
+#include <cstdint>
 #include <limits>
 
+constexpr int PLANT_SIM_THREAD_PRIORITY = -12;  // native_sim plant steps ahead of everything it feeds
 constexpr int CONTROLLER_STEP_WORK_Q_PRIORITY = -10;
 constexpr int ANALOG_SENSORS_THREAD_PRIORITY = -5;
 constexpr int LIDAR_1_THREAD_PRIORITY = -5;
 constexpr int LIDAR_2_THREAD_PRIORITY = -5;
 constexpr int VECTORNAV_THREAD_PRIORITY = -5;
 constexpr int GNSS_THREAD_PRIORITY = -5;
+constexpr int SENSOR_HUB_THREAD_PRIORITY = -5;
+constexpr int SENSOR_HUB_STACK_SIZE = 4096;
+constexpr int STATE_ESTIMATOR_THREAD_PRIORITY = -7;  // Above the sensors it consumes, below the controller tick
+constexpr int STATE_ESTIMATOR_STACK_SIZE = 4096;
 constexpr int BLINK_THREAD_PRIORITY = -1;
+constexpr int CONTROLLER_BENCHMARK_THREAD_PRIORITY = 5;  // Drives states from below everything it measures
 
 // Unit conversion
 constexpr float DEG2RAD_F = 0.0174532925f;
@@ -24,8 +32,34 @@ constexpr uint32_t MAX_PWM_PULSE_US = 2000;
 // RCS Hornet PWM Throttle
 constexpr uint32_t HORNET_RCS_THROTTLE_PERCENT = 1.0f; // 100% throttle corresponds to 2000 µs pulse
 
-// Flight controller outer loop runs every Nth inner-loop tick
-constexpr uint32_t FLIGHT_OUTER_LOOP_DIVISOR = 3;
+// Controller rate groups: {name, run every Nth control tick, on ticks where tick % N == phase, CPU budget [ns]}.
+// The state estimator is not listed here; it runs in its own thread at the IMU rate.
+constexpr RateGroupConfig FLIGHT_OUTER_RATE_GROUP = {"flight_outer", 4, 1, 150'000};  // 250 Hz position loop
+constexpr RateGroupConfig FLIGHT_INNER_RATE_GROUP = {"flight_inner", 2, 0, 150'000};  // 500 Hz attitude/velocity loop
+constexpr RateGroupConfig THROTTLE_RATE_GROUP = {"throttle", 1, 0, 50'000};
+constexpr RateGroupConfig TVC_RATE_GROUP = {"tvc", 1, 0, 50'000};
+constexpr RateGroupConfig RCS_RATE_GROUP = {"rcs", 4, 3, 50'000};
+static_assert(rate_groups_staggered(FLIGHT_OUTER_RATE_GROUP, FLIGHT_INNER_RATE_GROUP));
+static_assert(rate_groups_staggered(FLIGHT_OUTER_RATE_GROUP, RCS_RATE_GROUP));
+static_assert(rate_groups_staggered(FLIGHT_INNER_RATE_GROUP, RCS_RATE_GROUP));
+
+// StateEstimator flags a sensor stale once its newest sample is older than this
+constexpr uint64_t IMU_STALE_AFTER_NS = 20'000'000;     // 8 missed samples at 400 Hz
+constexpr uint64_t LIDAR_STALE_AFTER_NS = 100'000'000;  // 10 missed frames at the TF factory 100 Hz
+constexpr uint64_t GNSS_STALE_AFTER_NS = 500'000'000;
+
+// StateEstimator error-state Kalman filter tuning. Noise densities are continuous-time, measurement sigmas are 1-sigma.
+constexpr float ESTIMATOR_ACCEL_NOISE_M_S2 = 0.05f;           // per sqrt(s)
+constexpr float ESTIMATOR_GYRO_NOISE_RAD_S = 0.005f;          // per sqrt(s)
+constexpr float ESTIMATOR_ACCEL_BIAS_WALK_M_S3 = 0.001f;      // per sqrt(s)
+constexpr float ESTIMATOR_GYRO_BIAS_WALK_RAD_S2 = 0.0001f;    // per sqrt(s)
+constexpr float ESTIMATOR_ATTITUDE_SIGMA_RAD = 0.01f;         // VN-300 attitude solution
+constexpr float ESTIMATOR_LIDAR_SIGMA_M = 0.03f;
+constexpr float ESTIMATOR_LIDAR_MIN_DISTANCE_M = 0.1f;        // TF lidars report ~0 without a target
+constexpr float ESTIMATOR_LIDAR_MIN_TILT_COS = 0.866f;        // Ignore lidar beyond 30 deg of tilt
+constexpr float ESTIMATOR_GNSS_MIN_POS_SIGMA_M = 0.02f;
+constexpr float ESTIMATOR_GNSS_MIN_VEL_SIGMA_M_S = 0.02f;
+constexpr float ESTIMATOR_MAX_PREDICT_DT_S = 0.01f;           // Longer gaps are clamped rather than integrated
 
 // Inifinity and negative infinity for floats
 constexpr float FLOAT_INFINITY = std::numeric_limits<float>::infinity();
@@ -56,6 +90,10 @@ constexpr float FLIGHT_PID_Z_VEL_KP = 0.1f;
 constexpr float FLIGHT_PID_Z_VEL_KI = 0.0f;
 constexpr float FLIGHT_PID_Z_VEL_KD = 0.0f;
 
+// FlightController gain schedule grid, over measured thrust and altitude. Must match FlightGainTable's max_count.
+constexpr int FLIGHT_GAIN_SCHEDULE_THRUST_LEN = 4;
+constexpr int FLIGHT_GAIN_SCHEDULE_ALTITUDE_LEN = 4;
+
 // HornetRcs PID gains
 constexpr float HORNET_RCS_ROLL_KP = 2.0f;
 constexpr float HORNET_RCS_ROLL_KI = 0.0f;
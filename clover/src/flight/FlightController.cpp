@@ -1,10 +1,15 @@
 #include "FlightController.h"
 #include "../MutexGuard.h"
+#include "../FastMath.h"
+#include "../LookupTable2D.h"
+#include "../Matrix.h"
 #include "../PID.h"
 #include "../math_util.h"
 #include "../config.h"
 #include <zephyr/kernel.h>
+#include <atomic>
 #include <cmath>
+#include <optional>
 
 
 K_MUTEX_DEFINE(flight_controller_lock);
@@ -12,27 +17,195 @@ K_MUTEX_DEFINE(flight_controller_lock);
 static const float maxGimble = 12.0;   // degrees, this is an estimate
 static const float maxTiltRad = 8.0f * DEG2RAD_F;  // 8 degrees in radians – max intentional tilt
 
+/// Gains and limits of one PID. Unset limits are infinite and a 0 Hz cutoff disables the derivative filter.
+struct PidSettings {
+    float kp;
+    float ki;
+    float kd;
+    float min_out = FLOAT_NEG_INFINITY;
+    float max_out = FLOAT_INFINITY;
+    float min_integral = FLOAT_NEG_INFINITY;
+    float max_integral = FLOAT_INFINITY;
+    float integral_zone = FLOAT_INFINITY;
+    float deriv_lp_hz = 0.0f;
+};
+
+using GainScheduleGrid = LookupGrid2D<FLIGHT_GAIN_SCHEDULE_THRUST_LEN, FLIGHT_GAIN_SCHEDULE_ALTITUDE_LEN>;
+
+/// Scheduled gains of one PID over measured thrust [N] and altitude [m].
+struct GainTables {
+    GainScheduleGrid::Table kp;
+    GainScheduleGrid::Table ki;
+    GainScheduleGrid::Table kd;
+};
+
+/// PIDs without tables keep their configured gains.
+struct GainSchedule {
+    GainScheduleGrid grid;
+    std::optional<GainTables> x_tilt;
+    std::optional<GainTables> y_tilt;
+    std::optional<GainTables> z;
+};
+
+/// Settings of every flight controller PID, published as a whole.
+struct GainBank {
+    PidSettings x_tilt;
+    PidSettings y_tilt;
+    PidSettings x;
+    PidSettings y;
+    PidSettings z;
+    PidSettings z_velocity;
+    GainSchedule schedule;
+    // Integrator resets requested so far. Carried into every later bank, so a reset published over by another update
+    // before the tick saw it is still acted on.
+    uint32_t integrator_resets;
+};
+
 // TODO: Tune, including adding integral terms (is requried)
-// reference: kp, ki, kd, min out, max out, min integral, max integral, integral zone, deriv filter
-// integral cant command more than 1/3rd output range, with 10 Hz derivative lowpass
-static PID pidXTilt(FLIGHT_PID_X_TILT_KP, FLIGHT_PID_X_TILT_KI, FLIGHT_PID_X_TILT_KD, FLOAT_NEG_INFINITY, FLOAT_INFINITY, -maxGimble / 3, maxGimble / 3, FLOAT_INFINITY, 10.0);   // about the X axis
-static PID pidYTilt(FLIGHT_PID_Y_TILT_KP, FLIGHT_PID_Y_TILT_KI, FLIGHT_PID_Y_TILT_KD, FLOAT_NEG_INFINITY, FLOAT_INFINITY, -maxGimble / 3, maxGimble / 3, FLOAT_INFINITY, 10.0);   // about the Y axis
-static PID pidX(FLIGHT_PID_X_KP, FLIGHT_PID_X_KI, FLIGHT_PID_X_KD);              // needs tuning, these are complete guesses
-static PID pidY(FLIGHT_PID_Y_KP, FLIGHT_PID_Y_KI, FLIGHT_PID_Y_KD);              // needs tuning, these are complete guesses
-// only use integral within 5 cm of target.
-static PID pidZ(FLIGHT_PID_Z_KP, FLIGHT_PID_Z_KI, FLIGHT_PID_Z_KD, FLOAT_NEG_INFINITY, FLOAT_INFINITY, FLOAT_NEG_INFINITY, FLOAT_INFINITY, 0.05);
-// TODO: add max and min out
-static PID pidZVelocity(FLIGHT_PID_Z_VEL_KP, FLIGHT_PID_Z_VEL_KI, FLIGHT_PID_Z_VEL_KD);      // needs tuning
+static constexpr GainBank DEFAULT_GAINS = {
+    // integral cant command more than 1/3rd output range, with 10 Hz derivative lowpass
+    .x_tilt = {FLIGHT_PID_X_TILT_KP, FLIGHT_PID_X_TILT_KI, FLIGHT_PID_X_TILT_KD, FLOAT_NEG_INFINITY, FLOAT_INFINITY, -maxGimble / 3, maxGimble / 3, FLOAT_INFINITY, 10.0f},
+    .y_tilt = {FLIGHT_PID_Y_TILT_KP, FLIGHT_PID_Y_TILT_KI, FLIGHT_PID_Y_TILT_KD, FLOAT_NEG_INFINITY, FLOAT_INFINITY, -maxGimble / 3, maxGimble / 3, FLOAT_INFINITY, 10.0f},
+    .x = {FLIGHT_PID_X_KP, FLIGHT_PID_X_KI, FLIGHT_PID_X_KD},  // needs tuning, these are complete guesses
+    .y = {FLIGHT_PID_Y_KP, FLIGHT_PID_Y_KI, FLIGHT_PID_Y_KD},  // needs tuning, these are complete guesses
+    // only use integral within 5 cm of target.
+    .z = {FLIGHT_PID_Z_KP, FLIGHT_PID_Z_KI, FLIGHT_PID_Z_KD, FLOAT_NEG_INFINITY, FLOAT_INFINITY, FLOAT_NEG_INFINITY, FLOAT_INFINITY, 0.05f},
+    // TODO: add max and min out
+    .z_velocity = {FLIGHT_PID_Z_VEL_KP, FLIGHT_PID_Z_VEL_KI, FLIGHT_PID_Z_VEL_KD},  // needs tuning
+    .schedule = {},
+    .integrator_resets = 0,
+};
+
+static PID make_pid(const PidSettings& s)
+{
+    return PID(s.kp, s.ki, s.kd, s.min_out, s.max_out, s.min_integral, s.max_integral, s.integral_zone, s.deriv_lp_hz);
+}
 
-static uint32_t loopCount = 0;
+static PID pidXTilt = make_pid(DEFAULT_GAINS.x_tilt);  // about the X axis
+static PID pidYTilt = make_pid(DEFAULT_GAINS.y_tilt);  // about the Y axis
+static PID pidX = make_pid(DEFAULT_GAINS.x);
+static PID pidY = make_pid(DEFAULT_GAINS.y);
+static PID pidZ = make_pid(DEFAULT_GAINS.z);
+static PID pidZVelocity = make_pid(DEFAULT_GAINS.z_velocity);
+
+// Gain updates are double buffered so the command handler never blocks the tick. The handler fills the bank the tick
+// is not reading and publishes it by bumping gains_sequence, whose low bit is the active bank. gains_writes_started is
+// bumped before a bank is overwritten, so the tick can tell if a second update reused the bank while it was copying.
+K_MUTEX_DEFINE(flight_controller_gains_lock);  // Serializes command handlers only; never taken by the tick
+static GainBank gain_banks[2] = {DEFAULT_GAINS, DEFAULT_GAINS};
+static std::atomic<uint32_t> gains_sequence{0};
+static std::atomic<uint32_t> gains_writes_started{0};
+static uint32_t applied_gains_sequence = 0;  // Owned by the tick
+static uint32_t applied_integrator_resets = 0;  // Owned by the tick
+static GainBank published_gains_copy;        // Owned by the tick, may be torn until checked
+static GainSchedule gain_schedule;           // Owned by the tick
+
+// Fills the inactive gain bank and publishes it. update() is given a copy of the active bank to modify.
+template <typename Update>
+static void publish_gains(Update&& update)
+{
+    MutexGuard gains_guard(&flight_controller_gains_lock);
+
+    const uint32_t sequence = gains_sequence.load(std::memory_order_relaxed);
+    gains_writes_started.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
 
-static float dt = 0.01; // TODO: make this an actual DT measurement ( or at least research if i should)
+    GainBank& bank = gain_banks[(sequence + 1) & 1];
+    bank = gain_banks[sequence & 1];
+    update(bank);
 
-static FlightControllerDesiredState des_state = FlightControllerDesiredState_init_default;
+    gains_sequence.store(sequence + 1, std::memory_order_release);
+}
 
+// Scheduled PIDs take their gains from the schedule instead, at the next outer loop update.
+static void apply_pid_settings(PID& pid, const PidSettings& s, bool scheduled, bool reset_integrator)
+{
+    if (!scheduled) {
+        pid.setP(s.kp);
+        pid.setI(s.ki);
+        pid.setD(s.kd);
+    }
+    pid.setOutputLimits(s.min_out, s.max_out);
+    pid.setIntegralLimits(s.min_integral, s.max_integral);
+    pid.setIntegralZone(s.integral_zone);
+    if (s.deriv_lp_hz > 0.0f) {
+        pid.setDerivativeLowPass(s.deriv_lp_hz);
+    }
+    else {
+        pid.clearDerivativeLowPass();
+    }
+    if (reset_integrator) {
+        pid.reset();
+    }
+}
+
+/// Picks up a newly published gain bank at the start of a tick. Must be called with flight_controller_lock held.
+static void apply_published_gains()
+{
+    const uint32_t sequence = gains_sequence.load(std::memory_order_acquire);
+    if (sequence == applied_gains_sequence) {
+        return;
+    }
+
+    published_gains_copy = gain_banks[sequence & 1];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (gains_writes_started.load(std::memory_order_relaxed) - sequence >= 2) {
+        // A later update started overwriting this bank mid-copy; its publish is picked up next tick.
+        return;
+    }
+
+    const GainBank& bank = published_gains_copy;
+    const bool reset_integrators = bank.integrator_resets != applied_integrator_resets;
+    apply_pid_settings(pidXTilt, bank.x_tilt, bank.schedule.x_tilt.has_value(), reset_integrators);
+    apply_pid_settings(pidYTilt, bank.y_tilt, bank.schedule.y_tilt.has_value(), reset_integrators);
+    apply_pid_settings(pidX, bank.x, false, reset_integrators);
+    apply_pid_settings(pidY, bank.y, false, reset_integrators);
+    apply_pid_settings(pidZ, bank.z, bank.schedule.z.has_value(), reset_integrators);
+    apply_pid_settings(pidZVelocity, bank.z_velocity, false, reset_integrators);
+    gain_schedule = bank.schedule;
+    applied_integrator_resets = bank.integrator_resets;
+    applied_gains_sequence = sequence;
+}
+
+static void apply_scheduled_gains(PID& pid, const std::optional<GainTables>& tables, const LookupCell2D& cell)
+{
+    if (tables.has_value()) {
+        pid.setP(GainScheduleGrid::interpolate(tables->kp, cell));
+        pid.setI(GainScheduleGrid::interpolate(tables->ki, cell));
+        pid.setD(GainScheduleGrid::interpolate(tables->kd, cell));
+    }
+}
+
+/// Samples the gain schedule at the measured thrust and altitude. All tables share a grid, so the point is located
+/// once. Changing gains keeps the PIDs' state.
+static void apply_gain_schedule(float thrust_N, float altitude_m)
+{
+    if (!gain_schedule.x_tilt.has_value() && !gain_schedule.y_tilt.has_value() && !gain_schedule.z.has_value()) {
+        return;
+    }
+
+    const LookupCell2D cell = gain_schedule.grid.locate(thrust_N, altitude_m);
+    apply_scheduled_gains(pidXTilt, gain_schedule.x_tilt, cell);
+    apply_scheduled_gains(pidYTilt, gain_schedule.y_tilt, cell);
+    apply_scheduled_gains(pidZ, gain_schedule.z, cell);
+}
+
+// Returns desired world tilt angles from the lateral position error
+static std::pair<float, float> lateralOuterPID(EstimatedState state, const FlightControllerDesiredState& desired, float dt)
+{
+    auto [world_tilt_x, world_tilt_y] = PID::calculate<2>(
+        {&pidX, &pidY},
+        {desired.position.x, desired.position.y},
+        {state.position.x, state.position.y},
+        {state.velocity.x, state.velocity.y},
+        dt);
+
+    // Clamp if needed
+    return {std::clamp(world_tilt_x, -maxTiltRad, maxTiltRad), std::clamp(world_tilt_y, -maxTiltRad, maxTiltRad)};
+}
 
 // returns {pitch acceleration, yaw acceleration}
-static std::pair<float, float> lateralPID(EstimatedState state, FlightControllerMetrics& metrics)
+static std::pair<float, float> lateralPID(EstimatedState state, const FlightControllerDesiredState& desired, float dt, FlightControllerMetrics& metrics)
 {
     std::pair<float, float> output_accelerations{};
 
@@ -44,41 +217,25 @@ static std::pair<float, float> lateralPID(EstimatedState state, FlightController
     );
     q_wb = math_util::normalizeQuaternion(q_wb);
 
-    Quaternion q_bw = math_util::conjugateQuaternion(q_wb);
-
-    // Outer loop: desired literal tilt angles
-    if (loopCount % FLIGHT_OUTER_LOOP_DIVISOR == 0)
-    {
-        float outer_dt = FLIGHT_OUTER_LOOP_DIVISOR * dt;
-
-        des_state.world_tilt_x = pidX.calculate(des_state.position.x, state.position.x, state.velocity.x, outer_dt);
-        des_state.world_tilt_y = pidY.calculate(des_state.position.y, state.position.y, state.velocity.y, outer_dt);
-
-        // Clamp if needed
-        des_state.world_tilt_x = std::clamp(des_state.world_tilt_x, -maxTiltRad, maxTiltRad);
-        des_state.world_tilt_y = std::clamp(des_state.world_tilt_y, -maxTiltRad, maxTiltRad);
-    }
+    // Rotates world vectors into the body frame; its transpose rotates body vectors into the world frame
+    const Matrix<3, 3> R_wb = math_util::quaternionToRotationMatrix(q_wb);
 
     // Actual vertical axis in world
-    Vector3D z_act_w = math_util::multiplyQuaternionVector(q_bw, math_util::unitZ());
-    metrics.actual_world_tilt_x_rad = std::atan2(z_act_w.x, z_act_w.z);
-    metrics.actual_world_tilt_y_rad = std::atan2(z_act_w.y, z_act_w.z);
+    const Vec<3> unit_z = {{0.0f, 0.0f, 1.0f}};
+    const Vec<3> z_act_w = transpose(R_wb) * unit_z;
+    metrics.actual_world_tilt_x_rad = GncMath::atan2(z_act_w[0], z_act_w[2]);
+    metrics.actual_world_tilt_y_rad = GncMath::atan2(z_act_w[1], z_act_w[2]);
 
     // Desired thrust axis in world from desired literal tilt angles
-    Vector3D z_des_w = math_util::createVector3D(
-        std::tan(des_state.world_tilt_x),
-        std::tan(des_state.world_tilt_y),
-        1.0
-    );
-    // Normalize the vector
-    z_des_w = math_util::normalizeVector3D(z_des_w);
+    const Vec<3> z_des_unnormalized = {{GncMath::tan(desired.world_tilt_x), GncMath::tan(desired.world_tilt_y), 1.0f}};
+    const Vec<3> z_des_w = z_des_unnormalized * GncMath::rsqrt(dot(z_des_unnormalized, z_des_unnormalized));
 
     // Desired thrust axis expressed in body frame
-    Vector3D z_des_b = math_util::multiplyQuaternionVector(q_wb, z_des_w);
+    const Vec<3> z_des_b = R_wb * z_des_w;
 
     // Body-frame reduced attitude error
     // Unit Z because we are in body frame
-    Vector3D axis_error_b = math_util::crossProduct(math_util::unitZ(), z_des_b);
+    const Vec<3> axis_error_b = cross(unit_z, z_des_b);
 
     // Inner loop on body-axis tilt error
     // TODO: Check if this needs a negative sign.
@@ -86,30 +243,25 @@ static std::pair<float, float> lateralPID(EstimatedState state, FlightController
     // TODO: find angular rates to feed to derivative
 
     // Feed body-axis error
-    output_accelerations.first  = pidXTilt.calculate(0.0f, axis_error_b.x, dt);
-    output_accelerations.second = pidYTilt.calculate(0.0f, axis_error_b.y, dt);
+    auto [pitch_acceleration, yaw_acceleration] =
+        PID::calculate<2>({&pidXTilt, &pidYTilt}, {0.0f, 0.0f}, {axis_error_b[0], axis_error_b[1]}, dt);
+    output_accelerations = {pitch_acceleration, yaw_acceleration};
 
-    metrics.desired_world_tilt_x_rad = des_state.world_tilt_x;
-    metrics.desired_world_tilt_y_rad = des_state.world_tilt_y;
+    metrics.desired_world_tilt_x_rad = desired.world_tilt_x;
+    metrics.desired_world_tilt_y_rad = desired.world_tilt_y;
     metrics.commanded_pitch_acceleration_rad_s2 = output_accelerations.first;
     metrics.commanded_yaw_acceleration_rad_s2 = output_accelerations.second;
 
     return output_accelerations;
 }
 
-static float verticalPID(EstimatedState state, FlightControllerMetrics& metrics){
-
-    // outerloop on position
-    if (loopCount % FLIGHT_OUTER_LOOP_DIVISOR == 0)
-    {
-        des_state.vz_m_s = pidZ.calculate(des_state.position.z, state.position.z, dt);
-    }
+static float verticalPID(EstimatedState state, const FlightControllerDesiredState& desired, float dt, FlightControllerMetrics& metrics){
 
-    metrics.desired_vertical_velocity_m_s = des_state.vz_m_s;
+    metrics.desired_vertical_velocity_m_s = desired.vz_m_s;
 
     //TODO: make this an acceleration delta
     // innerloop on velocity
-    float desired_acceleration = pidZVelocity.calculate(des_state.vz_m_s, state.velocity.z, dt);
+    float desired_acceleration = pidZVelocity.calculate(desired.vz_m_s, state.velocity.z, dt);
     metrics.commanded_vertical_acceleration_m_s2 = desired_acceleration;
     return desired_acceleration;
 }
@@ -124,167 +276,147 @@ void FlightController::reset()
     pidY.reset();
     pidZ.reset();
     pidZVelocity.reset();
-    loopCount = 0;
-    des_state = FlightControllerDesiredState_init_default;
 }
 
-/// Called every tick in FLIGHT state. Returns a tuple of:
+/// Outer loop, run by the flight outer rate group. Turns position commands into the desired world tilt and vertical
+/// velocity that the inner loop tracks until the next outer tick. Scheduled gains are sampled here, at the measured
+/// thrust and altitude, and held until the next outer tick.
+std::expected<FlightControllerDesiredState, Error> FlightController::tick_outer(
+    EstimatedState state, float x_command_m, float y_command_m, float z_command_m, float thrust_N, float dt_s)
+{
+    MutexGuard flight_controller_guard(&flight_controller_lock);
+    apply_published_gains();
+    apply_gain_schedule(thrust_N, state.position.z);
+
+    FlightControllerDesiredState desired = FlightControllerDesiredState_init_default;
+    desired.position.x = x_command_m;
+    desired.position.y = y_command_m;
+    desired.position.z = z_command_m;
+
+    std::tie(desired.world_tilt_x, desired.world_tilt_y) = lateralOuterPID(state, desired, dt_s);
+    desired.vz_m_s = pidZ.calculate(desired.position.z, state.position.z, dt_s);
+
+    return desired;
+}
+
+/// Inner loop, run by the flight inner rate group. Returns a tuple of:
 /// - pitch_angular_accel_rad_s2
 /// - yaw_angular_accel_rad_s2
 /// - z_accel_m_s2
 /// - FlightControllerMetrics
 std::expected<std::tuple<float, float, float, FlightControllerMetrics>, Error>
-FlightController::tick(EstimatedState state, float x_command_m, float y_command_m, float z_command_m)
+FlightController::tick_inner(EstimatedState state, const FlightControllerDesiredState& desired, float dt_s)
 {
     MutexGuard flight_controller_guard(&flight_controller_lock);
-
-    des_state.position.x = x_command_m;
-    des_state.position.y = y_command_m;
-    des_state.position.z = z_command_m;
+    apply_published_gains();
 
     FlightControllerMetrics metrics = FlightControllerMetrics_init_default;
 
-    float z_accel_m_s2 = verticalPID(state, metrics) + GRAVITY_M_S2;
-    auto angular_accelerations = lateralPID(state, metrics);
+    float z_accel_m_s2 = verticalPID(state, desired, dt_s, metrics) + GRAVITY_M_S2;
+    auto angular_accelerations = lateralPID(state, desired, dt_s, metrics);
     float pitch_accel_rad_s2 = angular_accelerations.first;
     float yaw_accel_rad_s2 = angular_accelerations.second;
 
-    loopCount++;
     return {{pitch_accel_rad_s2, yaw_accel_rad_s2, z_accel_m_s2, metrics}};
 }
 
-/// Configure controller gains.
+// Applies the fields present in a gains request to one PID's settings.
+#define UPDATE_PID_SETTINGS(settings, req, name)                                                                        \
+    do {                                                                                                               \
+        if ((req).has_##name##_kp) (settings).kp = (req).name##_kp;                                                    \
+        if ((req).has_##name##_ki) (settings).ki = (req).name##_ki;                                                    \
+        if ((req).has_##name##_kd) (settings).kd = (req).name##_kd;                                                    \
+        if ((req).has_##name##_min_out && (req).has_##name##_max_out) {                                                \
+            (settings).min_out = std::min((req).name##_min_out, (req).name##_max_out);                                 \
+            (settings).max_out = std::max((req).name##_min_out, (req).name##_max_out);                                 \
+        }                                                                                                              \
+        if ((req).has_##name##_min_integral && (req).has_##name##_max_integral) {                                      \
+            (settings).min_integral = std::min((req).name##_min_integral, (req).name##_max_integral);                  \
+            (settings).max_integral = std::max((req).name##_min_integral, (req).name##_max_integral);                  \
+        }                                                                                                              \
+        if ((req).has_##name##_integral_zone) (settings).integral_zone = (req).name##_integral_zone;                   \
+        if ((req).has_##name##_deriv_lp_hz) (settings).deriv_lp_hz = (req).name##_deriv_lp_hz;                         \
+    } while (0)
+
+/// Configure controller gains. Fills the inactive gain bank and publishes it; the tick applies it at its next start.
+/// Integrators keep their state unless the request asks for a reset, so gains can be tuned in flight without a
+/// transient.
 std::expected<void, Error> FlightController::handle_configure_gains(const ConfigureFlightControllerGainsRequest& req)
 {
-    MutexGuard flight_controller_guard(&flight_controller_lock);
-
-    // Update PID gains if provided
-    pidXTilt.setGains(
-        req.has_pidXTilt_kp ? req.pidXTilt_kp : pidXTilt.getP(),
-        req.has_pidXTilt_ki ? req.pidXTilt_ki : pidXTilt.getI(),
-        req.has_pidXTilt_kd ? req.pidXTilt_kd : pidXTilt.getD()
-    );
-
-    pidYTilt.setGains(
-        req.has_pidYTilt_kp ? req.pidYTilt_kp : pidYTilt.getP(),
-        req.has_pidYTilt_ki ? req.pidYTilt_ki : pidYTilt.getI(),
-        req.has_pidYTilt_kd ? req.pidYTilt_kd : pidYTilt.getD()
-    );
-
-    pidX.setGains(
-        req.has_pidX_kp ? req.pidX_kp : pidX.getP(),
-        req.has_pidX_ki ? req.pidX_ki : pidX.getI(),
-        req.has_pidX_kd ? req.pidX_kd : pidX.getD()
-    );
-
-    pidY.setGains(
-        req.has_pidY_kp ? req.pidY_kp : pidY.getP(),
-        req.has_pidY_ki ? req.pidY_ki : pidY.getI(),
-        req.has_pidY_kd ? req.pidY_kd : pidY.getD()
-    );
-
-    pidZ.setGains(
-        req.has_pidZ_kp ? req.pidZ_kp : pidZ.getP(),
-        req.has_pidZ_ki ? req.pidZ_ki : pidZ.getI(),
-        req.has_pidZ_kd ? req.pidZ_kd : pidZ.getD()
-    );
-
-    pidZVelocity.setGains(
-        req.has_pidZVelocity_kp ? req.pidZVelocity_kp : pidZVelocity.getP(),
-        req.has_pidZVelocity_ki ? req.pidZVelocity_ki : pidZVelocity.getI(),
-        req.has_pidZVelocity_kd ? req.pidZVelocity_kd : pidZVelocity.getD()
-    );
-
-
+    publish_gains([&](GainBank& bank) {
+        UPDATE_PID_SETTINGS(bank.x_tilt, req, pidXTilt);
+        UPDATE_PID_SETTINGS(bank.y_tilt, req, pidYTilt);
+        UPDATE_PID_SETTINGS(bank.x, req, pidX);
+        UPDATE_PID_SETTINGS(bank.y, req, pidY);
+        UPDATE_PID_SETTINGS(bank.z, req, pidZ);
+        UPDATE_PID_SETTINGS(bank.z_velocity, req, pidZVelocity);
+        if (req.has_reset_integrators && req.reset_integrators) {
+            bank.integrator_resets++;
+        }
+    });
+    return {};
+}
 
-    if ((req.has_pidXTilt_min_out && req.has_pidXTilt_max_out)) {
-        pidXTilt.setOutputLimits(req.pidXTilt_min_out, req.pidXTilt_max_out);
-    }
-    if ((req.has_pidYTilt_min_out && req.has_pidYTilt_max_out)) {
-        pidYTilt.setOutputLimits(req.pidYTilt_min_out, req.pidYTilt_max_out);
-    }
-    if ((req.has_pidX_min_out && req.has_pidX_max_out)) {
-        pidX.setOutputLimits(req.pidX_min_out, req.pidX_max_out);
-    }
-    if ((req.has_pidY_min_out && req.has_pidY_max_out)) {
-        pidY.setOutputLimits(req.pidY_min_out, req.pidY_max_out);
-    }
-    if ((req.has_pidZ_min_out && req.has_pidZ_max_out)) {
-        pidZ.setOutputLimits(req.pidZ_min_out, req.pidZ_max_out);
-    }
-    if ((req.has_pidZVelocity_min_out && req.has_pidZVelocity_max_out)) {
-        pidZVelocity.setOutputLimits(req.pidZVelocity_min_out, req.pidZVelocity_max_out);
+static std::expected<std::optional<GainTables>, Error>
+gain_tables_from_request(bool has_table, const FlightGainTable& table, const char* name)
+{
+    if (!has_table) {
+        return std::nullopt;
     }
 
-    // Update integral limits if provided
-    if ((req.has_pidXTilt_min_integral && req.has_pidXTilt_max_integral)) {
-        pidXTilt.setIntegralLimits(req.pidXTilt_min_integral, req.pidXTilt_max_integral);
-    }
-    if ((req.has_pidYTilt_min_integral && req.has_pidYTilt_max_integral)) {
-        pidYTilt.setIntegralLimits(req.pidYTilt_min_integral, req.pidYTilt_max_integral);
-    }
-    if ((req.has_pidX_min_integral && req.has_pidX_max_integral)) {
-        pidX.setIntegralLimits(req.pidX_min_integral, req.pidX_max_integral);
-    }
-    if ((req.has_pidY_min_integral && req.has_pidY_max_integral)) {
-        pidY.setIntegralLimits(req.pidY_min_integral, req.pidY_max_integral);
-    }
-    if ((req.has_pidZ_min_integral && req.has_pidZ_max_integral)) {
-        pidZ.setIntegralLimits(req.pidZ_min_integral, req.pidZ_max_integral);
-    }
-    if ((req.has_pidZVelocity_min_integral && req.has_pidZVelocity_max_integral)) {
-        pidZVelocity.setIntegralLimits(req.pidZVelocity_min_integral, req.pidZVelocity_max_integral);
+    constexpr pb_size_t breakpoints = FLIGHT_GAIN_SCHEDULE_THRUST_LEN * FLIGHT_GAIN_SCHEDULE_ALTITUDE_LEN;
+    if (table.kp_count != breakpoints || table.ki_count != breakpoints || table.kd_count != breakpoints) {
+        return std::unexpected(Error::from_cause(
+            "%s gain tables need %d breakpoints each, got kp %d, ki %d, kd %d",
+            name,
+            breakpoints,
+            table.kp_count,
+            table.ki_count,
+            table.kd_count));
     }
 
-    // Update integral zones if provided
-    if (req.has_pidXTilt_integral_zone) {
-        pidXTilt.setIntegralZone(req.pidXTilt_integral_zone);
-    }
-    if (req.has_pidYTilt_integral_zone) {
-        pidYTilt.setIntegralZone(req.pidYTilt_integral_zone);
-    }
-    if (req.has_pidX_integral_zone) {
-        pidX.setIntegralZone(req.pidX_integral_zone);
-    }
-    if (req.has_pidY_integral_zone) {
-        pidY.setIntegralZone(req.pidY_integral_zone);
-    }
-    if (req.has_pidZ_integral_zone) {
-        pidZ.setIntegralZone(req.pidZ_integral_zone);
-    }
-    if (req.has_pidZVelocity_integral_zone) {
-        pidZVelocity.setIntegralZone(req.pidZVelocity_integral_zone);
+    GainTables tables;
+    for (int i = 0; i < FLIGHT_GAIN_SCHEDULE_THRUST_LEN; i++) {
+        for (int j = 0; j < FLIGHT_GAIN_SCHEDULE_ALTITUDE_LEN; j++) {
+            const int idx = i * FLIGHT_GAIN_SCHEDULE_ALTITUDE_LEN + j;
+            if (!std::isfinite(table.kp[idx]) || !std::isfinite(table.ki[idx]) || !std::isfinite(table.kd[idx])) {
+                return std::unexpected(Error::from_cause("%s gain tables must be finite", name));
+            }
+            tables.kp[i][j] = table.kp[idx];
+            tables.ki[i][j] = table.ki[idx];
+            tables.kd[i][j] = table.kd[idx];
+        }
     }
+    return tables;
+}
 
-    // Update derivative low-pass filter if provided
-    if (req.has_pidXTilt_deriv_lp_hz) {
-        pidXTilt.setDerivativeLowPass(req.pidXTilt_deriv_lp_hz);
-    }
-    if (req.has_pidYTilt_deriv_lp_hz) {
-        pidYTilt.setDerivativeLowPass(req.pidYTilt_deriv_lp_hz);
-    }
-    if (req.has_pidX_deriv_lp_hz) {
-        pidX.setDerivativeLowPass(req.pidX_deriv_lp_hz);
+/// Load a gain schedule, replacing any previous one. Published like a gain update, so PIDs keep their state.
+std::expected<void, Error> FlightController::handle_load_gain_schedule(const LoadFlightGainScheduleRequest& req)
+{
+    if (!(req.thrust_gap_N > 0.0f) || !(req.altitude_gap_m > 0.0f) || !std::isfinite(req.thrust_min_N) ||
+        !std::isfinite(req.altitude_min_m) || !std::isfinite(req.thrust_gap_N) || !std::isfinite(req.altitude_gap_m)) {
+        return std::unexpected(Error::from_cause("gain schedule axes must be finite with positive gaps"));
     }
-    if (req.has_pidY_deriv_lp_hz) {
-        pidY.setDerivativeLowPass(req.pidY_deriv_lp_hz);
+
+    GainSchedule schedule;
+    schedule.grid = GainScheduleGrid(req.thrust_min_N, req.thrust_gap_N, req.altitude_min_m, req.altitude_gap_m);
+
+    auto x_tilt = gain_tables_from_request(req.has_pidXTilt, req.pidXTilt, "pidXTilt");
+    if (!x_tilt.has_value()) {
+        return std::unexpected(x_tilt.error());
     }
-    if (req.has_pidZ_deriv_lp_hz) {
-        pidZ.setDerivativeLowPass(req.pidZ_deriv_lp_hz);
+    auto y_tilt = gain_tables_from_request(req.has_pidYTilt, req.pidYTilt, "pidYTilt");
+    if (!y_tilt.has_value()) {
+        return std::unexpected(y_tilt.error());
     }
-    if (req.has_pidZVelocity_deriv_lp_hz) {
-        pidZVelocity.setDerivativeLowPass(req.pidZVelocity_deriv_lp_hz);
+    auto z = gain_tables_from_request(req.has_pidZ, req.pidZ, "pidZ");
+    if (!z.has_value()) {
+        return std::unexpected(z.error());
     }
+    schedule.x_tilt = *x_tilt;
+    schedule.y_tilt = *y_tilt;
+    schedule.z = *z;
 
+    publish_gains([&](GainBank& bank) { bank.schedule = schedule; });
     return {};
 }
-
-#if CONFIG_TEST
-void FlightController::set_desired_state_for_testing(const FlightControllerDesiredState& state) {
-    des_state = state;
-}
-
-void FlightController::set_loop_count_for_testing(uint32_t count) {
-    loopCount = count;
-}
-#endif
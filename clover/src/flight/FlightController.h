@@ -7,16 +7,19 @@
 
 namespace FlightController {
 void reset();
-/// Returns (pitch_angular_accel_rad_s2, yaw_angular_accel_rad_s2, z_accel_m_s2, FlightControllerMetrics)
+
+/// Returns the desired world tilt and vertical velocity for the position commands. Runs in the flight outer rate group.
+/// thrust_N is the latest measured thrust, for gain scheduling.
+std::expected<FlightControllerDesiredState, Error>
+tick_outer(EstimatedState state, float x_command_m, float y_command_m, float z_command_m, float thrust_N, float dt_s);
+
+/// Returns (pitch_angular_accel_rad_s2, yaw_angular_accel_rad_s2, z_accel_m_s2, FlightControllerMetrics) tracking the
+/// latest outer loop output. Runs in the flight inner rate group.
 std::expected<std::tuple<float, float, float, FlightControllerMetrics>, Error>
-tick(EstimatedState state, float x_command_m, float y_command_m, float z_command_m);
+tick_inner(EstimatedState state, const FlightControllerDesiredState& desired, float dt_s);
 
 std::expected<void, Error> handle_configure_gains(const ConfigureFlightControllerGainsRequest& req);
-
-#if CONFIG_TEST
-    void set_desired_state_for_testing(const FlightControllerDesiredState& state);
-    void set_loop_count_for_testing(uint32_t count);
-#endif
+std::expected<void, Error> handle_load_gain_schedule(const LoadFlightGainScheduleRequest& req);
 
 }  // namespace FlightController
 
@@ -1,18 +1,273 @@
 #include "StateEstimator.h"
 #include "Error.h"
+#include "Matrix.h"
+#include "TripleBuffer.h"
+#include "config.h"
+#include "math_util.h"
+#include <algorithm>
+#include <cmath>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+#ifdef CONFIG_FLIGHT
+#include "sensors/Gnss.h"
+#include "sensors/Lidar.h"
+#include "sensors/VectornavIMU.h"
+#endif
+
 LOG_MODULE_REGISTER(StateEstimator, LOG_LEVEL_INF);
 
+// Error-state Kalman filter. The nominal state (position, velocity, attitude, accelerometer and gyro biases) is
+// propagated by pre-integrated IMU increments, while a 15-element error state and its covariance absorb the lidar, GNSS and
+// VN-300 attitude corrections before being folded back into the nominal state.
+//
+// The filter runs in NED like the VN-300 so its quaternion and specific force can be used directly. The estimate
+// reports position and velocity as north/east/up, matching GNSS and the flight controller.
+//
+// The filter runs in its own thread, once per IMU sample, and publishes each estimate through a triple buffer. The
+// controller tick reads the newest one without waiting, so filter cost never lands on the control deadline.
+//
+// Every measurement observes one error-state element directly, so updates are fused one scalar at a time: no matrix
+// inverse, O(N^2) each. Covariance propagation is the only O(N^3) step. All matrices are fixed-size and static.
+
+namespace {
+
+constexpr int N = 15;
+constexpr int IDX_POS = 0;
+constexpr int IDX_VEL = 3;
+constexpr int IDX_ATT = 6;
+constexpr int IDX_ACCEL_BIAS = 9;
+constexpr int IDX_GYRO_BIAS = 12;
+
+using ErrorState = Vec<N>;
+using Covariance = Matrix<N, N>;
+
+struct NominalState {
+    Vec<3> pos_ned;
+    Vec<3> vel_ned;
+    Quaternion q_nb;  // Body to NED
+    Vec<3> accel_bias;
+    Vec<3> gyro_bias;
+};
+
+// Newest sample consumed from one sensor. Readings are matched by sample counter, 0 meaning "no reading this tick".
+struct SensorTrack {
+    uint32_t last_sample_counter;
+    uint64_t last_capture_time_ns;
+};
+
+}  // namespace
 
 static EstimatedState current_estimate = EstimatedState_init_default;
-static float update_timestamp_ns = 0;
-static bool has_update_timestamp_ns = false;
-static float lidar_1_update_timestamp_ns = 0;
-static float lidar_2_update_timestamp_ns = 0;
-static float imu_update_timestamp_ns = 0;
-static float gnss_update_timestamp_ns = 0;
+static SensorTrack lidar_1_track = {};
+static SensorTrack lidar_2_track = {};
+static SensorTrack imu_track = {};
+static SensorTrack gnss_track = {};
+static bool was_stale = false;
+
+static NominalState nominal = {};
+static ErrorState error_state = {};
+static Covariance covariance = {};
+static bool attitude_initialized = false;
+static uint64_t last_predict_ns = 0;
+
+static TripleBuffer<StateEstimator::Snapshot> snapshots;
+static uint32_t estimate_counter = 0;
+
+// Latest raw IMU sample, held between calls when readings are not pre-integrated
+static Vec<3> imu_specific_force = {};
+static Vec<3> imu_angular_rate = {};
+
+// Scratch space for covariance propagation, kept off the controller stack
+static Covariance transition;
+static Covariance scratch;
+static Covariance propagated;
+
+/// Returns true if the reading is a sample not yet consumed, and records it.
+static bool consume_sample(SensorTrack& track, uint32_t sample_counter, uint64_t capture_time_ns)
+{
+    if (sample_counter == 0 || sample_counter == track.last_sample_counter) {
+        return false;
+    }
+    track.last_sample_counter = sample_counter;
+    track.last_capture_time_ns = capture_time_ns;
+    return true;
+}
+
+/// Age of the newest consumed sample, infinite if the sensor has never produced one.
+static float sample_age_ns(const SensorTrack& track, uint64_t now_ns)
+{
+    if (track.last_sample_counter == 0) {
+        return FLOAT_INFINITY;
+    }
+    return static_cast<float>(now_ns - track.last_capture_time_ns);
+}
+
+static Quaternion multiply(const Quaternion& a, const Quaternion& b)
+{
+    return math_util::createQuaternion(
+        a.qw * b.qw - a.qx * b.qx - a.qy * b.qy - a.qz * b.qz,
+        a.qw * b.qx + a.qx * b.qw + a.qy * b.qz - a.qz * b.qy,
+        a.qw * b.qy - a.qx * b.qz + a.qy * b.qw + a.qz * b.qx,
+        a.qw * b.qz + a.qx * b.qy - a.qy * b.qx + a.qz * b.qw);
+}
+
+/// Quaternion for a rotation vector, exact for large angles and first order near zero.
+static Quaternion quaternion_from_rotation(float x, float y, float z)
+{
+    float angle = std::sqrt(x * x + y * y + z * z);
+    if (angle < 1e-6f) {
+        return math_util::normalizeQuaternion(math_util::createQuaternion(1.0f, 0.5f * x, 0.5f * y, 0.5f * z));
+    }
+    float s = std::sin(0.5f * angle) / angle;
+    return math_util::createQuaternion(std::cos(0.5f * angle), s * x, s * y, s * z);
+}
+
+static void reset_covariance()
+{
+    constexpr float INITIAL_POS_SIGMA_M = 10.0f;
+    constexpr float INITIAL_VEL_SIGMA_M_S = 1.0f;
+    constexpr float INITIAL_ATT_SIGMA_RAD = 0.1f;
+    constexpr float INITIAL_ACCEL_BIAS_SIGMA_M_S2 = 0.2f;
+    constexpr float INITIAL_GYRO_BIAS_SIGMA_RAD_S = 0.01f;
+
+    covariance = Covariance::zeros();
+    for (int i = 0; i < 3; i++) {
+        covariance(IDX_POS + i, IDX_POS + i) = INITIAL_POS_SIGMA_M * INITIAL_POS_SIGMA_M;
+        covariance(IDX_VEL + i, IDX_VEL + i) = INITIAL_VEL_SIGMA_M_S * INITIAL_VEL_SIGMA_M_S;
+        covariance(IDX_ATT + i, IDX_ATT + i) = INITIAL_ATT_SIGMA_RAD * INITIAL_ATT_SIGMA_RAD;
+        covariance(IDX_ACCEL_BIAS + i, IDX_ACCEL_BIAS + i) = INITIAL_ACCEL_BIAS_SIGMA_M_S2 * INITIAL_ACCEL_BIAS_SIGMA_M_S2;
+        covariance(IDX_GYRO_BIAS + i, IDX_GYRO_BIAS + i) = INITIAL_GYRO_BIAS_SIGMA_RAD_S * INITIAL_GYRO_BIAS_SIGMA_RAD_S;
+    }
+}
+
+/// Propagate the nominal state and error covariance over dt [s] by IMU delta-angle and delta-velocity increments, in
+/// the body frame at the start of the interval.
+static void predict(const Vec<3>& delta_angle, const Vec<3>& delta_velocity, float dt)
+{
+    const Vec<3> d_theta_b = delta_angle - nominal.gyro_bias * dt;
+    const Vec<3> d_v_b = delta_velocity - nominal.accel_bias * dt;
+
+    // Mean rates over the interval, for the error-state Jacobian
+    const Vec<3> f_b = d_v_b / dt;
+    const Vec<3> w_b = d_theta_b / dt;
+
+    // Nominal state
+    const Matrix<3, 3> R = math_util::quaternionToRotationMatrix(nominal.q_nb);
+    Vec<3> d_v_ned = R * d_v_b;
+    d_v_ned[2] += GRAVITY_M_S2 * dt;
+
+    axpy(nominal.pos_ned, dt, nominal.vel_ned);
+    axpy(nominal.pos_ned, 0.5f * dt, d_v_ned);
+    nominal.vel_ned += d_v_ned;
+    nominal.q_nb = math_util::normalizeQuaternion(multiply(nominal.q_nb, quaternion_from_rotation(d_theta_b[0], d_theta_b[1], d_theta_b[2])));
+
+    // Error-state transition F = I + A dt:
+    //   dp' = dv
+    //   dv' = -R [f]x dtheta - R dba
+    //   dtheta' = -[w]x dtheta - dbg
+    transition = Covariance::identity();
+    set_block<IDX_POS, IDX_VEL>(transition, Matrix<3, 3>::identity() * dt);
+    set_block<IDX_VEL, IDX_ATT>(transition, R * skew(f_b) * -dt);
+    set_block<IDX_VEL, IDX_ACCEL_BIAS>(transition, R * -dt);
+    set_block<IDX_ATT, IDX_ATT>(transition, Matrix<3, 3>::identity() - skew(w_b) * dt);
+    set_block<IDX_ATT, IDX_GYRO_BIAS>(transition, Matrix<3, 3>::identity() * -dt);
+
+    // P = F P F^T + Q
+    sandwich(propagated, transition, covariance, scratch);
+    covariance = propagated;
+
+    const float q_vel = ESTIMATOR_ACCEL_NOISE_M_S2 * ESTIMATOR_ACCEL_NOISE_M_S2 * dt;
+    const float q_att = ESTIMATOR_GYRO_NOISE_RAD_S * ESTIMATOR_GYRO_NOISE_RAD_S * dt;
+    const float q_accel_bias = ESTIMATOR_ACCEL_BIAS_WALK_M_S3 * ESTIMATOR_ACCEL_BIAS_WALK_M_S3 * dt;
+    const float q_gyro_bias = ESTIMATOR_GYRO_BIAS_WALK_RAD_S2 * ESTIMATOR_GYRO_BIAS_WALK_RAD_S2 * dt;
+    for (int i = 0; i < 3; i++) {
+        covariance(IDX_VEL + i, IDX_VEL + i) += q_vel;
+        covariance(IDX_ATT + i, IDX_ATT + i) += q_att;
+        covariance(IDX_ACCEL_BIAS + i, IDX_ACCEL_BIAS + i) += q_accel_bias;
+        covariance(IDX_GYRO_BIAS + i, IDX_GYRO_BIAS + i) += q_gyro_bias;
+    }
+}
+
+/// Fuse a direct measurement of one error-state element. residual is the measurement minus the nominal state.
+static void update_scalar(int index, float residual, float sigma)
+{
+    const float innovation = residual - error_state[index];
+    const float innovation_variance = covariance(index, index) + sigma * sigma;
+    if (!(innovation_variance > 0.0f)) {
+        return;
+    }
+
+    // K = P H^T / s, where P H^T is column `index` of P, which by symmetry equals row `index`
+    ErrorState observed;
+    for (int i = 0; i < N; i++) {
+        observed[i] = covariance(index, i);
+    }
+    axpy(error_state, innovation / innovation_variance, observed);
+
+    // P = P - K H P
+    rank1_update(covariance, -1.0f / innovation_variance, observed, observed);
+}
+
+/// Fold the error state into the nominal state and zero it.
+static void inject_error_state()
+{
+    nominal.pos_ned += block<IDX_POS, 0, 3, 1>(error_state);
+    nominal.vel_ned += block<IDX_VEL, 0, 3, 1>(error_state);
+    nominal.accel_bias += block<IDX_ACCEL_BIAS, 0, 3, 1>(error_state);
+    nominal.gyro_bias += block<IDX_GYRO_BIAS, 0, 3, 1>(error_state);
+    nominal.q_nb = math_util::normalizeQuaternion(multiply(
+        nominal.q_nb, quaternion_from_rotation(error_state[IDX_ATT + 0], error_state[IDX_ATT + 1], error_state[IDX_ATT + 2])));
+    error_state = ErrorState::zeros();
+}
+
+/// VN-300 attitude solution as a measurement of the attitude error.
+static void fuse_attitude(const ImuReading& imu)
+{
+    Quaternion q_meas = math_util::normalizeQuaternion(math_util::createQuaternion(imu.quat_w, imu.quat_x, imu.quat_y, imu.quat_z));
+    if (!attitude_initialized) {
+        nominal.q_nb = q_meas;
+        attitude_initialized = true;
+        return;
+    }
+
+    // Small-angle rotation from the nominal attitude to the measured one, in the body frame
+    Quaternion dq = multiply(math_util::conjugateQuaternion(nominal.q_nb), q_meas);
+    float sign = dq.qw < 0.0f ? -2.0f : 2.0f;
+    update_scalar(IDX_ATT + 0, sign * dq.qx, ESTIMATOR_ATTITUDE_SIGMA_RAD);
+    update_scalar(IDX_ATT + 1, sign * dq.qy, ESTIMATOR_ATTITUDE_SIGMA_RAD);
+    update_scalar(IDX_ATT + 2, sign * dq.qz, ESTIMATOR_ATTITUDE_SIGMA_RAD);
+}
+
+/// Tilt-compensated lidar range as a measurement of height above the pad, which is taken as GNSS up = 0.
+static void fuse_lidar(const LidarReading& lidar)
+{
+    if (lidar.distance_m < ESTIMATOR_LIDAR_MIN_DISTANCE_M) {
+        return;
+    }
+    // Down component of the body z axis, the lidar's pointing direction
+    const Quaternion& q = nominal.q_nb;
+    const float tilt_cos = 1.0f - 2.0f * (q.qx * q.qx + q.qy * q.qy);
+    if (tilt_cos < ESTIMATOR_LIDAR_MIN_TILT_COS) {
+        return;
+    }
+    update_scalar(IDX_POS + 2, -lidar.distance_m * tilt_cos - nominal.pos_ned[2], ESTIMATOR_LIDAR_SIGMA_M);
+}
+
+static void fuse_gnss(const GnssReadings& gnss)
+{
+    const float h_sigma = std::max(gnss.hrms_m > 0.0f ? gnss.hrms_m : gnss.pos_sigma_m, ESTIMATOR_GNSS_MIN_POS_SIGMA_M);
+    const float v_sigma = std::max(gnss.vrms_m > 0.0f ? gnss.vrms_m : gnss.pos_sigma_m, ESTIMATOR_GNSS_MIN_POS_SIGMA_M);
+    const float hvel_sigma = std::max(gnss.hvel_rms_ms > 0.0f ? gnss.hvel_rms_ms : gnss.vel_sigma_ms, ESTIMATOR_GNSS_MIN_VEL_SIGMA_M_S);
+    const float vvel_sigma = std::max(gnss.vvel_rms_ms > 0.0f ? gnss.vvel_rms_ms : gnss.vel_sigma_ms, ESTIMATOR_GNSS_MIN_VEL_SIGMA_M_S);
+
+    update_scalar(IDX_POS + 0, gnss.north_m - nominal.pos_ned[0], h_sigma);
+    update_scalar(IDX_POS + 1, gnss.east_m - nominal.pos_ned[1], h_sigma);
+    update_scalar(IDX_POS + 2, -gnss.up_m - nominal.pos_ned[2], v_sigma);
+    update_scalar(IDX_VEL + 0, gnss.vx_ms - nominal.vel_ned[0], hvel_sigma);
+    update_scalar(IDX_VEL + 1, gnss.vy_ms - nominal.vel_ned[1], hvel_sigma);
+    update_scalar(IDX_VEL + 2, -gnss.vz_ms - nominal.vel_ned[2], vvel_sigma);
+}
 
 
 void StateEstimator::init()
@@ -24,12 +279,23 @@ void StateEstimator::reset()
 {
     current_estimate = EstimatedState_init_default;
     current_estimate.R_WB.qw = 1.0f; // to get identity q
-    update_timestamp_ns = 0;
-    has_update_timestamp_ns = false;
-    lidar_1_update_timestamp_ns = 0;
-    lidar_2_update_timestamp_ns = 0;
-    imu_update_timestamp_ns = 0;
-    gnss_update_timestamp_ns = 0;
+    lidar_1_track = {};
+    lidar_2_track = {};
+    imu_track = {};
+    gnss_track = {};
+    was_stale = false;
+
+    nominal = {};
+    nominal.q_nb.qw = 1.0f;
+    error_state = {};
+    reset_covariance();
+    attitude_initialized = false;
+    last_predict_ns = 0;
+    imu_specific_force = {};
+    imu_angular_rate = {};
+
+    estimate_counter = 0;
+    snapshots.write({});
 }
 
 std::optional<EstimatedState> StateEstimator::estimate(
@@ -39,51 +305,139 @@ std::optional<EstimatedState> StateEstimator::estimate(
     GnssReadings& gnss
 )
 {
-    update_timestamp_ns = static_cast<float>(k_cycle_get_64()) / sys_clock_hw_cycles_per_sec() * 1e9f;
-    has_update_timestamp_ns = true;
+    uint64_t start_cycle = k_cycle_get_64();
+    uint64_t now_ns = k_cyc_to_ns_floor64(start_cycle);
 
-    bool lidar_1_updated = false;
-    bool lidar_2_updated = false;
-    bool gnss_updated = false;
+    bool imu_updated = consume_sample(imu_track, imu.sample_counter, imu.capture_time_ns);
+    bool lidar_1_updated = consume_sample(lidar_1_track, lidar_1.sample_counter, lidar_1.capture_time_ns);
+    bool lidar_2_updated = consume_sample(lidar_2_track, lidar_2.sample_counter, lidar_2.capture_time_ns);
+    bool gnss_updated = consume_sample(gnss_track, gnss.sample_counter, gnss.capture_time_ns);
 
-    // IMU: update quaternion if timestamp changed.
-    if (imu.sense_time_ns > imu_update_timestamp_ns) {
-        imu_update_timestamp_ns = imu.sense_time_ns;
-        current_estimate.R_WB.qw = imu.quat_w;
-        current_estimate.R_WB.qx = imu.quat_x;
-        current_estimate.R_WB.qy = imu.quat_y;
-        current_estimate.R_WB.qz = imu.quat_z;
+    if (imu_updated) {
+        imu_specific_force = {{imu.accel_x, imu.accel_y, imu.accel_z}};
+        imu_angular_rate = {{imu.gyro_x, imu.gyro_y, imu.gyro_z}};
     }
 
-    // GNSS: update x/y position and x/y/z velocity if timestamp changed.
-    if (gnss.sense_time_ns > gnss_update_timestamp_ns) {
-        gnss_update_timestamp_ns = gnss.sense_time_ns;
-        gnss_updated = true;
-        current_estimate.position.x = gnss.north_m;
-        current_estimate.position.y = gnss.east_m;
-        current_estimate.position.z = gnss.up_m; // will remove after adding filter
-        current_estimate.velocity.x = gnss.vx_ms;
-        current_estimate.velocity.y = gnss.vy_ms;
-        current_estimate.velocity.z = gnss.vz_ms;
-    }
+    // Staleness: either lidar is enough for height.
+    current_estimate.imu_age_ns = sample_age_ns(imu_track, now_ns);
+    current_estimate.lidar_age_ns = std::min(sample_age_ns(lidar_1_track, now_ns), sample_age_ns(lidar_2_track, now_ns));
+    current_estimate.gnss_age_ns = sample_age_ns(gnss_track, now_ns);
+    current_estimate.stale = current_estimate.imu_age_ns > IMU_STALE_AFTER_NS || current_estimate.lidar_age_ns > LIDAR_STALE_AFTER_NS
+        || current_estimate.gnss_age_ns > GNSS_STALE_AFTER_NS;
 
-    // Lidar 1: track timestamp.
-    if (lidar_1.sense_time_ns > lidar_1_update_timestamp_ns) {
-        lidar_1_update_timestamp_ns = lidar_1.sense_time_ns;
-        lidar_1_updated = true;
+    // Never dead-reckon on a stale IMU. Pre-integrated readings carry every sample since the last one, so predict by
+    // their increments; raw readings are held and integrated over the time since the last call.
+    const bool imu_fresh = current_estimate.imu_age_ns <= IMU_STALE_AFTER_NS;
+    if (imu.has_delta_time_s) {
+        if (imu_updated && attitude_initialized && imu_fresh && imu.delta_time_s > 0.0f) {
+            float dt = std::min(imu.delta_time_s, ESTIMATOR_MAX_PREDICT_DT_S);
+            float scale = dt / imu.delta_time_s;
+            predict(math_util::toVec3(imu.delta_angle_rad) * scale, math_util::toVec3(imu.delta_velocity_m_s) * scale, dt);
+        }
     }
+    else if (attitude_initialized && last_predict_ns != 0 && imu_fresh) {
+        float dt = std::min(static_cast<float>(now_ns - last_predict_ns) * 1e-9f, ESTIMATOR_MAX_PREDICT_DT_S);
+        if (dt > 0.0f) {
+            predict(imu_angular_rate * dt, imu_specific_force * dt, dt);
+        }
+    }
+    last_predict_ns = now_ns;
 
-    // Lidar 2: track timestamp.
-    if (lidar_2.sense_time_ns > lidar_2_update_timestamp_ns) {
-        lidar_2_update_timestamp_ns = lidar_2.sense_time_ns;
-        lidar_2_updated = true;
+    if (imu_updated) {
+        fuse_attitude(imu);
+    }
+    if (lidar_1_updated) {
+        fuse_lidar(lidar_1);
+    }
+    if (lidar_2_updated) {
+        fuse_lidar(lidar_2);
     }
+    if (gnss_updated) {
+        fuse_gnss(gnss);
+    }
+    inject_error_state();
 
-    // TODO: Z position filter
-    {
+    current_estimate.R_WB = nominal.q_nb;
+    current_estimate.position.x = nominal.pos_ned[0];
+    current_estimate.position.y = nominal.pos_ned[1];
+    current_estimate.position.z = -nominal.pos_ned[2];
+    current_estimate.velocity.x = nominal.vel_ned[0];
+    current_estimate.velocity.y = nominal.vel_ned[1];
+    current_estimate.velocity.z = -nominal.vel_ned[2];
 
+    if (current_estimate.stale && !was_stale) {
+        LOG_WRN(
+            "Estimate is stale, sample ages: imu %.1f ms, lidar %.1f ms, gnss %.1f ms",
+            (double)current_estimate.imu_age_ns * 1e-6,
+            (double)current_estimate.lidar_age_ns * 1e-6,
+            (double)current_estimate.gnss_age_ns * 1e-6);
     }
+    was_stale = current_estimate.stale;
+
+    StateEstimator::Snapshot& snapshot = snapshots.back();
+    snapshot.state = current_estimate;
+    snapshot.time_ns = now_ns;
+    snapshot.update_time_ns = static_cast<float>(k_cyc_to_ns_floor64(k_cycle_get_64() - start_cycle));
+    snapshot.estimate_counter = ++estimate_counter;
+    snapshots.publish();
 
     return current_estimate;
 }
 
+std::optional<StateEstimator::Snapshot> StateEstimator::latest()
+{
+    const Snapshot& snapshot = snapshots.read();
+    if (snapshot.estimate_counter == 0) {
+        return std::nullopt;
+    }
+    return snapshot;
+}
+
+#ifdef CONFIG_FLIGHT
+
+K_SEM_DEFINE(state_estimator_ready_sem, 0, 1);
+
+void StateEstimator::start()
+{
+    k_sem_give(&state_estimator_ready_sem);
+}
+
+/// Runs the filter on each new IMU sample, fusing whatever lidar and GNSS samples have arrived since. Samples that
+/// arrive while the filter is busy are folded into the next reading's increments rather than lost. If IMU samples stop,
+/// runs at the IMU staleness limit instead so the published estimate reports itself stale.
+void StateEstimator::run()
+{
+    // Await initialization
+    k_sem_take(&state_estimator_ready_sem, K_FOREVER);
+    LOG_INF("Estimator loop initiated");
+
+    ImuReading imu = ImuReading_init_default;
+    while (true) {
+        k_sem_take(VectornavImu::sample_ready(), K_NSEC(IMU_STALE_AFTER_NS));
+
+        // The IMU is read so its increments cover every sample since the last run; the previous reading is kept
+        // when there is none. Other sensors are peeked so the controller still gets every reading for telemetry,
+        // and the filter skips samples it has already fused by their sample counters.
+        LidarReading lidar_1 = LidarReading_init_default;
+        LidarReading lidar_2 = LidarReading_init_default;
+        GnssReadings gnss = GnssReadings_init_default;
+        if (auto reading = Lidar1::latest()) {
+            lidar_1 = *reading;
+        }
+        if (auto reading = Lidar2::latest()) {
+            lidar_2 = *reading;
+        }
+        if (auto reading = VectornavImu::read()) {
+            imu = *reading;
+        }
+        if (auto reading = Gnss::latest()) {
+            gnss = Gnss::to_proto(*reading);
+        }
+
+        estimate(lidar_1, lidar_2, imu, gnss);
+    }
+}
+
+K_THREAD_DEFINE(state_estimator, STATE_ESTIMATOR_STACK_SIZE, StateEstimator::run, nullptr, nullptr, nullptr, STATE_ESTIMATOR_THREAD_PRIORITY, 0, 0);
+
+#endif  // CONFIG_FLIGHT
@@ -8,8 +8,18 @@
 
 namespace StateEstimator {
 
+    // Newest published estimate, the time it is valid for, and how long the filter took to produce it.
+    struct Snapshot {
+        EstimatedState state;
+        uint64_t time_ns;
+        float update_time_ns;
+        uint32_t estimate_counter;  // Increments once per estimate, 0 meaning none published yet
+    };
+
     void init();
     void reset();
+
+    // Run the filter on the given readings and publish the result. Only ever called from one thread at a time.
     std::optional<EstimatedState> estimate(
         LidarReading& lidar_1,
         LidarReading& lidar_2,
@@ -17,6 +27,15 @@ namespace StateEstimator {
         GnssReadings& gnss
     );
 
+    // Newest published estimate, wait-free. Only ever called from one thread (the controller tick).
+    std::optional<Snapshot> latest();
+
+    // Let the estimator thread start running the filter on new IMU samples.
+    void start();
+
+    // Estimator thread, do not call directly.
+    void run();
+
 
 }
 
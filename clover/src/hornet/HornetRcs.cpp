@@ -6,7 +6,7 @@
 
 K_MUTEX_DEFINE(hornet_rcs_lock);
 
-static PID roll_pid(HORNET_RCS_ROLL_KP, HORNET_RCS_ROLL_KI, HORNET_RCS_ROLL_KD);
+static SimplePID roll_pid(HORNET_RCS_ROLL_KP, HORNET_RCS_ROLL_KI, HORNET_RCS_ROLL_KD);
 static int64_t previous_timestamp = 0;
 static int64_t p_timer = 0;
 static int8_t p_valve = 0;
@@ -1,5 +1,6 @@
 #include "HornetTvc.h"
 #include "../MutexGuard.h"
+#include "../FastMath.h"
 #include "../config.h"
 #include <zephyr/kernel.h>
 #include <cmath>
@@ -42,18 +43,18 @@ std::expected<std::tuple<float, float, HornetTvcMetrics>, Error> HornetTvc::tick
     pitch_sin = std::clamp(pitch_sin, -1.0f, 1.0f);
     yaw_sin   = std::clamp(yaw_sin,   -1.0f, 1.0f);
 
-    float pitch_gimbal_deg = std::asin(pitch_sin) * RAD2DEG_F;
-    float yaw_gimbal_deg   = std::asin(yaw_sin)   * RAD2DEG_F;
+    float pitch_gimbal_deg = GncMath::asin(pitch_sin) * RAD2DEG_F;
+    float yaw_gimbal_deg   = GncMath::asin(yaw_sin)   * RAD2DEG_F;
 
     pitch_gimbal_deg = std::clamp(pitch_gimbal_deg, -HORNET_MAX_GIMBLE_DEG, HORNET_MAX_GIMBLE_DEG);
     yaw_gimbal_deg   = std::clamp(yaw_gimbal_deg,   -HORNET_MAX_GIMBLE_DEG, HORNET_MAX_GIMBLE_DEG);
 
     // TODO: plug in the real inverse kinematics
     // Convert gimbal angle to servo angle via linkage geometry
-    float servo_pitch_angle = std::asin(HORNET_TVC_R_GIMBLE / HORNET_TVC_R_SERVO)
-                              * std::sin(pitch_gimbal_deg * DEG2RAD_F) * RAD2DEG_F;
-    float servo_yaw_angle   = std::asin(HORNET_TVC_R_GIMBLE / HORNET_TVC_R_SERVO)
-                              * std::sin(yaw_gimbal_deg   * DEG2RAD_F) * RAD2DEG_F;
+    float servo_pitch_angle = GncMath::asin(HORNET_TVC_R_GIMBLE / HORNET_TVC_R_SERVO)
+                              * GncMath::sin(pitch_gimbal_deg * DEG2RAD_F) * RAD2DEG_F;
+    float servo_yaw_angle   = GncMath::asin(HORNET_TVC_R_GIMBLE / HORNET_TVC_R_SERVO)
+                              * GncMath::sin(yaw_gimbal_deg   * DEG2RAD_F) * RAD2DEG_F;
 
     servo_pitch_angle = std::clamp(servo_pitch_angle, -90.0f, 90.0f);
     servo_yaw_angle   = std::clamp(servo_yaw_angle,   -90.0f, 90.0f);
@@ -16,6 +16,8 @@
 #include "sensors/Lidar.h"
 #include "sensors/VectornavIMU.h"
 #include "server.h"
+#include "sim/ControllerBenchmark.h"
+#include "sim/PlantSim.h"
 
 LOG_MODULE_REGISTER(main, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -57,6 +59,14 @@ int main(void)
     }
 #endif
 
+#ifdef CONFIG_PLANT_SIM
+    LOG_INF("Initializing plant simulation");
+    if (auto result = PlantSim::init(); !result) {
+        LOG_ERR("Failed to initialize plant simulation: %s", result.error().build_message().c_str());
+        return 0;
+    }
+#endif
+
 #ifdef CONFIG_LIDAR
     LOG_INF("Initializing Lidar 1");
     if (auto result = Lidar1::init(); !result) {
@@ -124,6 +134,14 @@ int main(void)
         return 0;
     }
 
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+    LOG_INF("Starting controller benchmark");
+    if (auto result = ControllerBenchmark::start(); !result) {
+        LOG_ERR("Failed to start controller benchmark: %s", result.error().build_message().c_str());
+        return 0;
+    }
+#endif
+
     k_sleep(K_MSEC(500));
     LOG_INF("Starting server");
     serve_connections();
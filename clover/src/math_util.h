@@ -5,6 +5,8 @@
 #include <algorithm>
 
 
+#include "FastMath.h"
+#include "Matrix.h"
 #include "clover.pb.h"
 
 namespace math_util
@@ -58,17 +60,17 @@ namespace math_util
       // Roll (x-axis rotation)
       const float sinr_cosp = 2.0f * (qw * qx + qy * qz);
       const float cosr_cosp = 1.0f - 2.0f * (qx * qx + qy * qy);
-      const float roll = std::atan2(sinr_cosp, cosr_cosp);
+      const float roll = GncMath::atan2(sinr_cosp, cosr_cosp);
 
       // Pitch (y-axis rotation)
       const float sinp = 2.0f * (qw * qy - qz * qx);
       const float pi = 3.14159265358979323846f;
-      const float pitch = std::abs(sinp) >= 1.0f ? std::copysignf(pi / 2.0f, sinp) : std::asin(sinp);
+      const float pitch = std::abs(sinp) >= 1.0f ? std::copysignf(pi / 2.0f, sinp) : GncMath::asin(sinp);
 
       // Yaw (z-axis rotation)
       const float siny_cosp = 2.0f * (qw * qz + qx * qy);
       const float cosy_cosp = 1.0f - 2.0f * (qy * qy + qz * qz);
-      const float yaw = std::atan2(siny_cosp, cosy_cosp);
+      const float yaw = GncMath::atan2(siny_cosp, cosy_cosp);
 
       return createVector3D(yaw, pitch, roll);
   }
@@ -171,5 +173,30 @@ namespace math_util
 
         return out;
     }
+
+    inline Vec<3> toVec3(const Vector3D& v)
+    {
+        return {{v.x, v.y, v.z}};
+    }
+
+    inline Vector3D toVector3D(const Vec<3>& v)
+    {
+        return createVector3D(v[0], v[1], v[2]);
+    }
+
+    // Rotation matrix of a unit quaternion, R * v rotates v the same way as multiplyQuaternionVector(q, v).
+    // Converting once is cheaper than rotating several vectors by the quaternion.
+    inline Matrix<3, 3> quaternionToRotationMatrix(const Quaternion& q)
+    {
+        const float w = q.qw;
+        const float x = q.qx;
+        const float y = q.qy;
+        const float z = q.qz;
+        return {{
+            1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z), 2.0f * (x * z + w * y),
+            2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x),
+            2.0f * (x * z - w * y), 2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + y * y),
+        }};
+    }
 }
 #endif
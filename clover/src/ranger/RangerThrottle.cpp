@@ -4,10 +4,13 @@
 #include "MutexGuard.h"
 // #include "../lut/thrust_to_fuel_1.5.h"
 // #include "../lut/thrust_to_lox_1.5.h"
-#include "../lut/cea_lut.h"
+#include "../lut/thrust_per_mass_flow.h"
 #include "../lut/thrust_to_fuel.h"
 #include "../lut/thrust_to_lox.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <optional>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
@@ -23,7 +26,10 @@ static constexpr float LOX_ENGINE_INLET_LINE_LOSS_PSI = 41.0f;
 
 // Physics constants
 static constexpr float EFFICIENCY = 0.93f;
-static constexpr float LBF_CONVERSION = 0.224809f;
+static constexpr float DESIGN_OF = 1.4f;
+static_assert(
+    EFFICIENCY == THRUST_PER_MASS_FLOW_EFFICIENCY && DESIGN_OF == THRUST_PER_MASS_FLOW_OF,
+    "thrust_per_mass_flow.h was generated for another efficiency or O/F, re-run gen_thrust_per_mass_flow_table.py");
 static constexpr float K_SLOPE = -2.438665784714502e-04f;
 static constexpr float K_OFFSET = 0.233994229898658f;
 static constexpr float ALPHA = 1.183054065574921e+02f;
@@ -52,149 +58,172 @@ static constexpr float MAX_THRUST_LBF = 675.0f;
 static constexpr float MIN_PT_THRESHOLD = 50.0f;
 static constexpr float MAX_PT_THRESHOLD = 950.0f;
 
-static float prev_p_ch = 0.0f;
-static float prev_p_inj_fuel = 0.0f;
-static float prev_p_inj_lox = 0.0f;
+// Engine observer. A Kalman filter over chamber pressure and the propellant mass flows, each modelled as a random walk,
+// as the engine moves little in one tick next to the noise on a single PT sample. Chamber pressure is measured directly
+// and each flow through its injector model, from the drop between the injector PTs and the filtered chamber pressure,
+// so a flow's measurement noise is the PT noise times the model's slope. With the chamber pressure filtered the flow
+// errors hardly correlate, so the covariance stays diagonal and each state updates on its own, and as the noise varies
+// little over the throttle range the gains are the filter's steady state, one per number of redundant transducers in
+// range. A state whose transducers are all out of range holds its estimate.
+enum EngineState {
+    P_CH,
+    MDOT_FUEL,
+    MDOT_LOX,
+    NUM_ENGINE_STATES,
+};
+
+static constexpr float PT_NOISE_PSI = 1.5f;  // 1-sigma of a single PT sample
+// Injector model slopes dmdot/ddP = mdot / (2 dP) at 500 lbf: 0.54 kg/s fuel over 360 psi, 0.62 kg/s lox over 165 psi
+static constexpr float FUEL_FLOW_SLOPE_KG_S_PER_PSI = 7.5e-4f;
+static constexpr float LOX_FLOW_SLOPE_KG_S_PER_PSI = 1.9e-3f;
+// 1-sigma change per tick [psi, kg/s, kg/s]
+static constexpr std::array<float, NUM_ENGINE_STATES> ENGINE_PROCESS_NOISE = {0.1f, 2.0e-4f, 4.0e-4f};
+// 1-sigma of a measurement from one transducer of each pair
+static constexpr std::array<float, NUM_ENGINE_STATES> ENGINE_MEASUREMENT_NOISE = {
+    PT_NOISE_PSI, FUEL_FLOW_SLOPE_KG_S_PER_PSI * PT_NOISE_PSI, LOX_FLOW_SLOPE_KG_S_PER_PSI * PT_NOISE_PSI};
+
+/// Kalman gain a random walk settles to, by running its covariance through predict and update until it stops changing.
+static constexpr float steady_state_gain(float process_noise, float measurement_noise, int sources)
+{
+    const float q = process_noise * process_noise;
+    const float r = measurement_noise * measurement_noise / static_cast<float>(sources);
+    float prior_variance = q;
+    for (int i = 0; i < 1000; i++) {
+        prior_variance = prior_variance * r / (prior_variance + r) + q;
+    }
+    return prior_variance / (prior_variance + r);
+}
+
+static constexpr std::array<std::array<float, 2>, NUM_ENGINE_STATES> ENGINE_GAINS = [] {
+    std::array<std::array<float, 2>, NUM_ENGINE_STATES> gains = {};
+    for (size_t i = 0; i < NUM_ENGINE_STATES; i++) {
+        gains[i] = {
+            steady_state_gain(ENGINE_PROCESS_NOISE[i], ENGINE_MEASUREMENT_NOISE[i], 1),
+            steady_state_gain(ENGINE_PROCESS_NOISE[i], ENGINE_MEASUREMENT_NOISE[i], 2)};
+    }
+    return gains;
+}();
+
+static inline std::array<float, NUM_ENGINE_STATES> engine_estimate = {};
+static inline std::array<bool, NUM_ENGINE_STATES> engine_observed = {};  // Measured at least once since reset
+
+static inline float prev_thrust_command_lbf = 0.0f;
 
+// Throttle valve calibration. Each pass drives toward the hardstop at a constant velocity until the encoder falls
+// behind the command, which is the valve stalling against the stop, then backs off until the valve settles. Passes
+// slow down after the coarse ones, and the fine passes give the result and its repeatability. Every phase ends on an
+// event rather than after a fixed time.
 enum class CalPhase {
-    SEEK_HARDSTOP,
+    SEEK,
     BACK_OFF,
-    END_MOVEMENT,
-    POWER_OFF,
-    REPOWER,
     COMPLETE,
-    MEASURE,
-    ERROR,
 };
 
-static inline CalPhase cal_phase = CalPhase::SEEK_HARDSTOP;
-
-static inline float cal_fuel_target_position = 0.0f;
-static inline float cal_fuel_hardstop_position = 0.0f;
-static inline bool cal_fuel_found_stop = false;
-static inline float cal_lox_target_position = 0.0f;
-static inline float cal_lox_hardstop_position = 0.0f;
-static inline bool cal_lox_found_stop = false;
-static inline float cal_step_size = 0.002f;
-static inline int cal_rep_counter = 0;
-static inline float cal_pos_error_limit = 0.2f;
-static inline float cal_fuel_starting_error = 0.0f;
-static inline float cal_lox_starting_error = 0.0f;
-static inline uint32_t cal_power_cycle_timestamp = 0;
-
-struct CalibrationValveRefs {
-    float& target_position;
-    float& hardstop_position;
-    bool& found_stop;
-    float& starting_error;
-};
+static constexpr float CAL_SEEK_DIRECTION = 1.0f;  // Towards the hardstop at the open end
+static constexpr std::array<float, 5> CAL_PASS_VELOCITIES_DEG_S = {90.0f, 20.0f, 5.0f, 5.0f, 5.0f};
+static constexpr size_t CAL_COARSE_PASSES = 2;  // Not counted towards the result
+static constexpr float CAL_STALL_DIVERGENCE_DEG = 0.25f;
+static constexpr int CAL_STALL_TICKS = 3;
+static constexpr float CAL_BACK_OFF_DEG = 2.0f;
+static constexpr float CAL_BACK_OFF_VELOCITY_DEG_S = 90.0f;
+static constexpr float CAL_SETTLED_ERROR_DEG = 0.05f;
+static constexpr float CAL_SETTLED_VELOCITY_DEG_S = 1.0f;
+static constexpr int CAL_SETTLED_TICKS = 5;
+static constexpr float CAL_MAX_SEEK_TRAVEL_DEG = 120.0f;
+static constexpr uint32_t CAL_TIMEOUT_MS = 30000;
+
+static_assert(CAL_COARSE_PASSES < CAL_PASS_VELOCITIES_DEG_S.size());
+
+static inline CalPhase cal_phase = CalPhase::COMPLETE;
+static inline size_t cal_pass = 0;
+static inline float cal_target_deg = 0.0f;      // Commanded position
+static inline float cal_pass_start_deg = 0.0f;  // Encoder position the seek started from
+static inline float cal_back_off_deg = 0.0f;    // Position to back off to
+static inline float cal_prev_enc_deg = 0.0f;
+static inline int cal_event_ticks = 0;          // Consecutive ticks the current phase's exit condition has held
+static inline uint32_t cal_start_ms = 0;
+static inline std::array<float, CAL_PASS_VELOCITIES_DEG_S.size()> cal_stop_positions_deg = {};
+static inline std::optional<ThrottleValveCalibration> cal_result;
 
 static bool is_supported_valve(ThrottleValveType valve)
 {
     return valve == ThrottleValveType_FUEL || valve == ThrottleValveType_LOX;
 }
 
-static CalibrationValveRefs get_valve_refs(ThrottleValveType valve)
+static void calibration_start_seek(float valve_pos_enc)
 {
-    if (valve == ThrottleValveType_FUEL) {
-        return CalibrationValveRefs{cal_fuel_target_position, cal_fuel_hardstop_position, cal_fuel_found_stop, cal_fuel_starting_error};
-    }
-    return CalibrationValveRefs{cal_lox_target_position, cal_lox_hardstop_position, cal_lox_found_stop, cal_lox_starting_error};
+    cal_phase = CalPhase::SEEK;
+    cal_target_deg = valve_pos_enc;
+    cal_pass_start_deg = valve_pos_enc;
+    cal_event_ticks = 0;
 }
 
-static void calibration_seek_hardstop(ThrottleValveCommand& command, float valve_pos, float valve_pos_enc, CalibrationValveRefs refs)
+static ThrottleValveCalibration calibration_summarize(uint32_t timestamp)
 {
-    command.enable = true;
-
-    if (!refs.found_stop && std::abs(valve_pos - (refs.starting_error + valve_pos_enc)) <= cal_pos_error_limit) {
-        refs.target_position += cal_step_size / (cal_rep_counter + 1);
-        command.target_deg = refs.target_position;
-    }
-    else {
-        refs.found_stop = true;
-        refs.hardstop_position = valve_pos_enc;
-        command.target_deg = valve_pos_enc;
-    }
-
-    if (refs.found_stop) {
-        refs.found_stop = false;
-        cal_rep_counter++;
-        cal_phase = CalPhase::END_MOVEMENT;
+    const auto first = cal_stop_positions_deg.begin() + CAL_COARSE_PASSES;
+    const auto last = cal_stop_positions_deg.end();
+    float sum = 0.0f;
+    for (auto it = first; it != last; ++it) {
+        sum += *it;
     }
+    const auto [min_it, max_it] = std::minmax_element(first, last);
+
+    ThrottleValveCalibration result = ThrottleValveCalibration_init_default;
+    result.fine_passes = static_cast<uint32_t>(last - first);
+    result.hardstop_deg = sum / static_cast<float>(result.fine_passes);
+    result.repeatability_deg = *max_it - *min_it;
+    result.duration_ms = timestamp - cal_start_ms;
+    return result;
 }
 
-static void calibration_end_movement(ThrottleValveCommand& command, uint32_t timestamp)
+static std::expected<void, Error> calibration_seek(float valve_pos_enc)
 {
-    command.enable = false;
-    if (cal_power_cycle_timestamp == 0) {
-        cal_power_cycle_timestamp = timestamp;
-    }
-    else if (timestamp - cal_power_cycle_timestamp >= 1000) {
-        cal_phase = CalPhase::POWER_OFF;
+    // Compare against the command the valve has been following, before this tick's step.
+    const float divergence = CAL_SEEK_DIRECTION * (cal_target_deg - valve_pos_enc);
+    cal_event_ticks = divergence > CAL_STALL_DIVERGENCE_DEG ? cal_event_ticks + 1 : 0;
+
+    if (cal_event_ticks >= CAL_STALL_TICKS) {
+        LOG_INF("Calibration pass %zu found hardstop at %f deg", cal_pass + 1, static_cast<double>(valve_pos_enc));
+        cal_stop_positions_deg[cal_pass] = valve_pos_enc;
+        cal_pass++;
+
+        cal_phase = CalPhase::BACK_OFF;
+        cal_target_deg = valve_pos_enc;
+        cal_back_off_deg = valve_pos_enc - CAL_SEEK_DIRECTION * CAL_BACK_OFF_DEG;
+        cal_event_ticks = 0;
+        return {};
     }
-}
 
-static void calibration_power_off(ThrottleValveCommand& command, uint32_t timestamp)
-{
-    command.enable = false;
-    if (timestamp - cal_power_cycle_timestamp >= 4000) {
-        cal_phase = CalPhase::REPOWER;
-    }
-}
-
-static void calibration_repower(ThrottleValveCommand& command, uint32_t timestamp)
-{
-    command.enable = true;
-    if (timestamp - cal_power_cycle_timestamp >= 5000) {
-        cal_phase = CalPhase::COMPLETE;
+    if (CAL_SEEK_DIRECTION * (cal_target_deg - cal_pass_start_deg) > CAL_MAX_SEEK_TRAVEL_DEG) {
+        return std::unexpected(Error::from_cause("no hardstop within %f deg on calibration pass %zu",
+            static_cast<double>(CAL_MAX_SEEK_TRAVEL_DEG), cal_pass + 1));
     }
-}
-
-static void calibration_complete(ThrottleValveCommand& command, uint32_t timestamp, CalibrationValveRefs refs)
-{
-    command.enable = true;
-    command.target_deg = 95.0f;
-
-    refs.found_stop = false;
-    refs.starting_error = 0.0f;
-    refs.target_position = 95.0f;
 
-    if (timestamp - cal_power_cycle_timestamp >= 6500) {
-        cal_phase = CalPhase::SEEK_HARDSTOP;
-    }
+    cal_target_deg += CAL_SEEK_DIRECTION * CAL_PASS_VELOCITIES_DEG_S[cal_pass] * Controller::SEC_PER_CONTROL_TICK;
+    return {};
 }
 
-static void calibration_error(ThrottleValveCommand& command, uint32_t timestamp)
+static void calibration_back_off(uint32_t timestamp, float valve_pos_enc, float enc_velocity)
 {
-    command.enable = false;
+    constexpr float MAX_STEP = CAL_BACK_OFF_VELOCITY_DEG_S * Controller::SEC_PER_CONTROL_TICK;
+    cal_target_deg += std::clamp(cal_back_off_deg - cal_target_deg, -MAX_STEP, MAX_STEP);
 
-    if (cal_power_cycle_timestamp == 0) {
-        cal_power_cycle_timestamp = timestamp;
+    const bool settled = cal_target_deg == cal_back_off_deg && std::abs(valve_pos_enc - cal_target_deg) <= CAL_SETTLED_ERROR_DEG &&
+                         std::abs(enc_velocity) <= CAL_SETTLED_VELOCITY_DEG_S;
+    cal_event_ticks = settled ? cal_event_ticks + 1 : 0;
+    if (cal_event_ticks < CAL_SETTLED_TICKS) {
+        return;
     }
-}
-
-static void calibration_measure(ThrottleValveCommand& command, float valve_pos, float valve_pos_enc, CalibrationValveRefs refs)
-{
-    command.enable = true;
 
-    if (valve_pos_enc > 10.0f) {
-        refs.target_position -= cal_step_size * 3;
-        command.target_deg = refs.target_position;
-    }
-    else if (!refs.found_stop && std::abs(valve_pos - (refs.starting_error + valve_pos_enc)) <= cal_pos_error_limit) {
-        refs.target_position -= cal_step_size;
-        command.target_deg = refs.target_position;
-    }
-    else {
-        refs.found_stop = true;
-        refs.hardstop_position = valve_pos_enc;
-        command.target_deg = valve_pos_enc;
+    if (cal_pass < CAL_PASS_VELOCITIES_DEG_S.size()) {
+        calibration_start_seek(valve_pos_enc);
+        return;
     }
 
-    if (refs.found_stop) {
-        refs.target_position = refs.hardstop_position;
-        cal_phase = CalPhase::SEEK_HARDSTOP;
-    }
+    cal_result = calibration_summarize(timestamp);
+    cal_phase = CalPhase::COMPLETE;
+    LOG_INF("Calibration complete in %u ms: hardstop at %f deg, repeatability %f deg", cal_result->duration_ms,
+        static_cast<double>(cal_result->hardstop_deg), static_cast<double>(cal_result->repeatability_deg));
 }
 
 // Track duration of low chamber pressure for abort logic.
@@ -219,56 +248,45 @@ void RangerThrottle::reset()
 {
     MutexGuard ranger_throttle_guard{&ranger_throttle_lock};
     alpha = -1.0f;
-    prev_p_ch = 0.0f;
-    prev_p_inj_fuel = 0.0f;
-    prev_p_inj_lox = 0.0f;
+    engine_estimate = {};
+    engine_observed = {};
+    prev_thrust_command_lbf = 0.0f;
 }
 
-// TODO: test the re-done single valve calibration. Also, make it not super slow
-std::expected<ThrottleValveCommand, Error> RangerThrottle::calibration_tick(ThrottleValveType valve, uint32_t timestamp, float valve_pos, float valve_pos_enc)
+std::expected<ThrottleValveCommand, Error> RangerThrottle::calibration_tick(ThrottleValveType valve, uint32_t timestamp, float valve_pos_enc)
 {
     MutexGuard ranger_throttle_guard{&ranger_throttle_lock};
 
     if (!is_supported_valve(valve)) {
         return std::unexpected(Error::from_cause("unknown valve passed to calibration_tick"));
     }
+    if (cal_phase != CalPhase::COMPLETE && timestamp - cal_start_ms > CAL_TIMEOUT_MS) {
+        return std::unexpected(Error::from_cause("calibration timed out after %u ms on pass %zu", CAL_TIMEOUT_MS, cal_pass + 1));
+    }
 
-    auto refs = get_valve_refs(valve);
-    ThrottleValveCommand command = ThrottleValveCommand_init_default;
-    command.enable = true;
+    const float enc_velocity = (valve_pos_enc - cal_prev_enc_deg) / Controller::SEC_PER_CONTROL_TICK;
+    cal_prev_enc_deg = valve_pos_enc;
 
     switch (cal_phase) {
-    case CalPhase::SEEK_HARDSTOP:
-        calibration_seek_hardstop(command, valve_pos, valve_pos_enc, refs);
+    case CalPhase::SEEK:
+        if (auto result = calibration_seek(valve_pos_enc); !result) {
+            return std::unexpected(result.error());
+        }
         break;
     case CalPhase::BACK_OFF:
-        break;
-    case CalPhase::END_MOVEMENT:
-        calibration_end_movement(command, timestamp);
-        break;
-    case CalPhase::POWER_OFF:
-        calibration_power_off(command, timestamp);
-        break;
-    case CalPhase::REPOWER:
-        calibration_repower(command, timestamp);
+        calibration_back_off(timestamp, valve_pos_enc, enc_velocity);
         break;
     case CalPhase::COMPLETE:
-        calibration_complete(command, timestamp, refs);
-        break;
-    case CalPhase::MEASURE:
-        calibration_measure(command, valve_pos, valve_pos_enc, refs);
-        break;
-    case CalPhase::ERROR:
-        calibration_error(command, timestamp);
-        break;
-    default:
         break;
     }
 
+    ThrottleValveCommand command = ThrottleValveCommand_init_default;
+    command.enable = true;
+    command.target_deg = cal_target_deg;
     return command;
 }
 
-void RangerThrottle::calibration_reset(ThrottleValveType valve, float valve_pos, float valve_pos_enc)
+void RangerThrottle::calibration_reset(ThrottleValveType valve, uint32_t timestamp, float valve_pos_enc)
 {
     MutexGuard ranger_throttle_guard{&ranger_throttle_lock};
 
@@ -276,130 +294,137 @@ void RangerThrottle::calibration_reset(ThrottleValveType valve, float valve_pos,
         return;
     }
 
-    auto refs = get_valve_refs(valve);
+    cal_pass = 0;
+    cal_start_ms = timestamp;
+    cal_prev_enc_deg = valve_pos_enc;
+    cal_stop_positions_deg = {};
+    cal_result.reset();
+    calibration_start_seek(valve_pos_enc);
+}
 
-    cal_phase = CalPhase::SEEK_HARDSTOP;
-    cal_rep_counter = 0;
-    refs.found_stop = false;
-    refs.hardstop_position = 0.0f;
-    cal_power_cycle_timestamp = 0;
+std::optional<ThrottleValveCalibration> RangerThrottle::calibration_result()
+{
+    MutexGuard ranger_throttle_guard{&ranger_throttle_lock};
+    return cal_result;
+}
 
-    refs.target_position = valve_pos_enc;
+/// A redundant pair of transducers read as one: their average when both are in range, and whichever one is otherwise.
+struct PressureReading {
+    float psi;
+    int sources;  // Transducers in range, 0 if neither is
+};
 
-    refs.starting_error = valve_pos - valve_pos_enc;
-}
+struct EnginePressures {
+    PressureReading p_ch;
+    PressureReading p_inj_fuel;
+    PressureReading p_inj_lox;
+};
 
-static std::expected<float, Error> thrust_predictor(AnalogSensorReadings& analog_sensors, RangerThrottleMetrics& metrics)
+static bool pt_in_range(float psi, bool has_pt)
 {
+    return has_pt && psi >= MIN_PT_THRESHOLD && psi <= MAX_PT_THRESHOLD;
+}
 
-    // 2. Read pressures
-    float pt103_val = analog_sensors.pt103;
-    float pt203_val = analog_sensors.pt203;
-    float ptc401_val = analog_sensors.ptc401;
-    float ptc402_val = analog_sensors.ptc402;
-    float pto401_val = analog_sensors.pto401 + LOX_ENGINE_INLET_LINE_LOSS_PSI;
-    float ptf401_val = analog_sensors.ptf401 + FUEL_ENGINE_INLET_LINE_LOSS_PSI;
-
-    bool ptc401_valid = (analog_sensors.ptc401 >= MIN_PT_THRESHOLD && analog_sensors.ptc401 <= MAX_PT_THRESHOLD) && analog_sensors.has_ptc401;
-    bool ptc402_valid = (analog_sensors.ptc402 >= MIN_PT_THRESHOLD && analog_sensors.ptc402 <= MAX_PT_THRESHOLD) && analog_sensors.has_ptc402;
-    bool pto401_valid = (analog_sensors.pto401 >= MIN_PT_THRESHOLD && analog_sensors.pto401 <= MAX_PT_THRESHOLD) && analog_sensors.has_pto401;
-    bool pt103_valid = (analog_sensors.pt103 >= MIN_PT_THRESHOLD && analog_sensors.pt103 <= MAX_PT_THRESHOLD) && analog_sensors.has_pt103;
-    bool ptf401_valid = (analog_sensors.ptf401 >= MIN_PT_THRESHOLD && analog_sensors.ptf401 <= MAX_PT_THRESHOLD) && analog_sensors.has_ptf401;
-    bool pt203_valid = (analog_sensors.pt203 >= MIN_PT_THRESHOLD && analog_sensors.pt203 <= MAX_PT_THRESHOLD) && analog_sensors.has_pt203;
-
-    float p_ch;
-    if (ptc401_valid && ptc402_valid) {
-        // Both are healthy: Take the average
-        p_ch = (ptc401_val + ptc402_val) / 2.0f;
-    }
-    else if (ptc401_valid) {
-        // Only primary is healthy
-        p_ch = ptc401_val;
+static PressureReading read_redundant_pts(float primary_psi, bool primary_valid, float backup_psi, bool backup_valid)
+{
+    if (primary_valid && backup_valid) {
+        return {.psi = (primary_psi + backup_psi) / 2.0f, .sources = 2};
     }
-    else if (ptc402_valid) {
-        // Only backup is healthy
-        p_ch = ptc402_val;
+    if (primary_valid) {
+        return {.psi = primary_psi, .sources = 1};
     }
-    else {
-        p_ch = prev_p_ch;
-        // return std::unexpected(
-        //     Error::from_cause("missing PTC-401 / PTC-402 -- PTC-401 has %f, PTC-402 has %f", static_cast<double>(ptc401_val),
-        //     static_cast<double>(ptc402_val)));
+    if (backup_valid) {
+        return {.psi = backup_psi, .sources = 1};
     }
-    prev_p_ch = p_ch;
+    return {.psi = 0.0f, .sources = 0};
+}
 
-    float p_inj_fuel;
-    if (pt203_valid && ptf401_valid) {
-        // Both are healthy: Take the average
-        p_inj_fuel = (pt203_val + ptf401_val) / 2.0f;
-    }
-    else if (pt203_valid) {
-        // Only primary is healthy
-        p_inj_fuel = pt203_val;
-    }
-    else if (ptf401_valid) {
-        // Only backup is healthy
-        p_inj_fuel = ptf401_val;
-    }
-    else {
-        p_inj_fuel = prev_p_inj_fuel;
-        // Both failed: Trigger Abort
-        // return std::unexpected(
-        //     Error::from_cause("missing PT-203 / PTF-401 -- PT-203 has %f, PTF-401 has %f", static_cast<double>(pt203_val), static_cast<double>(ptf401_val)));
-    }
-    prev_p_inj_fuel = p_inj_fuel;
+static EnginePressures read_engine_pressures(const AnalogSensorReadings& analog_sensors)
+{
+    // The engine inlet PTs sit downstream of line losses, and are range checked before correcting for them
+    return {
+        .p_ch = read_redundant_pts(
+            analog_sensors.ptc401,
+            pt_in_range(analog_sensors.ptc401, analog_sensors.has_ptc401),
+            analog_sensors.ptc402,
+            pt_in_range(analog_sensors.ptc402, analog_sensors.has_ptc402)),
+        .p_inj_fuel = read_redundant_pts(
+            analog_sensors.pt203,
+            pt_in_range(analog_sensors.pt203, analog_sensors.has_pt203),
+            analog_sensors.ptf401 + FUEL_ENGINE_INLET_LINE_LOSS_PSI,
+            pt_in_range(analog_sensors.ptf401, analog_sensors.has_ptf401)),
+        .p_inj_lox = read_redundant_pts(
+            analog_sensors.pt103,
+            pt_in_range(analog_sensors.pt103, analog_sensors.has_pt103),
+            analog_sensors.pto401 + LOX_ENGINE_INLET_LINE_LOSS_PSI,
+            pt_in_range(analog_sensors.pto401, analog_sensors.has_pto401)),
+    };
+}
 
-    float p_inj_lox;
-    if (pt103_valid && pto401_valid) {
-        // Both are healthy: Take the average
-        p_inj_lox = (pt103_val + pto401_val) / 2.0f;
+/// Fuse a measurement from the given number of redundant transducers. The first one since reset is taken as is.
+static void observer_update(EngineState state, float measurement, int sources)
+{
+    if (!engine_observed[state]) {
+        engine_estimate[state] = measurement;
+        engine_observed[state] = true;
+        return;
     }
-    else if (pt103_valid) {
-        // Only primary is healthy
-        p_inj_lox = pt103_val;
+    engine_estimate[state] += ENGINE_GAINS[state][sources - 1] * (measurement - engine_estimate[state]);
+}
+
+static void observe_engine(const AnalogSensorReadings& analog_sensors)
+{
+    const EnginePressures pressures = read_engine_pressures(analog_sensors);
+
+    if (pressures.p_ch.sources > 0) {
+        observer_update(P_CH, pressures.p_ch.psi, pressures.p_ch.sources);
     }
-    else if (pto401_valid) {
-        // Only backup is healthy
-        p_inj_lox = pto401_val;
+    const float p_ch = engine_estimate[P_CH];
+    if (pressures.p_inj_fuel.sources > 0) {
+        observer_update(MDOT_FUEL, calculate_fuel_mass_flow(pressures.p_inj_fuel.psi, p_ch), pressures.p_inj_fuel.sources);
     }
-    else {
-        p_inj_lox = prev_p_inj_lox;
-        // Both failed: Trigger Abort
-        // return std::unexpected(
-        //     Error::from_cause("missing PT-103 / PTO-401 -- PT-103 has %f, PTO-401 has %f", static_cast<double>(pt103_val), static_cast<double>(pto401_val)));
+    if (pressures.p_inj_lox.sources > 0) {
+        observer_update(MDOT_LOX, calculate_lox_mass_flow(pressures.p_inj_lox.psi, p_ch), pressures.p_inj_lox.sources);
     }
-    prev_p_inj_lox = p_inj_lox;
-
-    // 3. Calculate mass flows
-    float mdot_f = calculate_fuel_mass_flow(p_inj_fuel, p_ch);
-    float mdot_lox = calculate_lox_mass_flow(p_inj_lox, p_ch);
+}
 
-    // 4. Clamp fuel mass flow to avoid division by zero
+static float predict_thrust(float p_ch, float mdot_f, float mdot_lox, RangerThrottleMetrics& metrics)
+{
+    // Clamp fuel mass flow to avoid division by zero
     float mdot_f_safe = std::max(mdot_f, 0.001f);
 
-    // 5. Calculate O/F
+    // Calculate O/F
     float predicted_of = mdot_lox / mdot_f_safe;
-    float constant_of = 1.4f;
 
-    // 6. Clamp O/F for lookup
+    // Clamp O/F for lookup
     [[maybe_unused]] float of_safe = std::clamp(predicted_of, MIN_SAFE_OF, MAX_SAFE_OF);
 
-    // TODO: add lut for cea
-    // 7. Predict Isp using chamber pressure and O/F
-    float predicted_isp = PcOfCea::sample(p_ch, constant_of);
-
-    // 8. Predict thrust (convert to lbf-equivalent)
-    float predicted_thrust_lbf = (mdot_f + mdot_lox) * predicted_isp * EFFICIENCY * LBF_CONVERSION;
+    // Predict thrust from chamber pressure, with Isp taken from CEA at the design O/F and scaled by efficiency to lbf
+    // offline rather than sampled from the full CEA table every tick
+    float predicted_thrust_lbf = (mdot_f + mdot_lox) * ThrustPerMassFlow::sample(p_ch);
 
-    metrics.predicted_thrust_lbf = 0;
     metrics.predicted_thrust_lbf = predicted_thrust_lbf;
-
     metrics.predicted_of = predicted_of;
     metrics.mdot_fuel = mdot_f;
     metrics.mdot_lox = mdot_lox;
 
     return predicted_thrust_lbf;
-    // return 0.0f;
+}
+
+/// Alpha whose point on the thrust LUTs' contour is the commanded thrust.
+static float feedforward_alpha(float thrust_command_lbf)
+{
+    return std::clamp((thrust_command_lbf - MIN_THRUST_LBF) / (MAX_THRUST_LBF - MIN_THRUST_LBF), MIN_ALPHA, MAX_ALPHA);
+}
+
+/// Move alpha along with the command, so a change in command takes the valves straight to the LUTs' operating point for
+/// it. The proportional term is left to integrate only the model error, rather than every change at its rate limit.
+static void apply_feedforward(float& alpha_state, float thrust_command_lbf)
+{
+    if (alpha_state != -1.0f) {
+        alpha_state += feedforward_alpha(thrust_command_lbf) - feedforward_alpha(prev_thrust_command_lbf);
+    }
+    prev_thrust_command_lbf = thrust_command_lbf;
 }
 
 static std::tuple<ThrottleValveCommand, ThrottleValveCommand>
@@ -414,8 +439,7 @@ active_control(float& alpha_state, float predicted_thrust_lbf, float thrust_comm
     // 10. Integrate PID to get alpha
     if (alpha_state == -1.0f) {
         // Initialize alpha to starting guess based on Mprime
-        // alpha_state = 0.5f;
-        alpha_state = (thrust_command_lbf - MIN_THRUST_LBF) / (MAX_THRUST_LBF - MIN_THRUST_LBF);
+        alpha_state = feedforward_alpha(thrust_command_lbf);
     }
     alpha_state += clamped_change_alpha_cmd;
     alpha_state = std::clamp(alpha_state, MIN_ALPHA, MAX_ALPHA);
@@ -445,13 +469,11 @@ RangerThrottle::tick(AnalogSensorReadings& analog_sensors, float thrust_command_
     MutexGuard ranger_throttle_guard{&ranger_throttle_lock};
     RangerThrottleMetrics metrics = RangerThrottleMetrics_init_default;
 
-    auto predicted_thrust = ::thrust_predictor(analog_sensors, metrics);
-    if (!predicted_thrust) {
-        LOG_INF("Thrust predictor failed");
-        return std::unexpected(predicted_thrust.error());
-    }
+    observe_engine(analog_sensors);
+    float predicted_thrust_lbf = predict_thrust(engine_estimate[P_CH], engine_estimate[MDOT_FUEL], engine_estimate[MDOT_LOX], metrics);
 
-    auto [fuel_command, lox_command] = active_control(alpha, *predicted_thrust, thrust_command_lbf, metrics);
+    apply_feedforward(alpha, thrust_command_lbf);
+    auto [fuel_command, lox_command] = active_control(alpha, predicted_thrust_lbf, thrust_command_lbf, metrics);
 
     return {{fuel_command, lox_command, metrics}};
 }
@@ -465,6 +487,18 @@ RangerThrottle::active_control_test(float& alpha_state, float predicted_thrust_l
 
 std::expected<float, Error> RangerThrottle::thrust_predictor(AnalogSensorReadings& analog_sensors, RangerThrottleMetrics& metrics)
 {
-    return ::thrust_predictor(analog_sensors, metrics);
+    const EnginePressures pressures = read_engine_pressures(analog_sensors);
+    const float p_ch = pressures.p_ch.psi;
+    return ::predict_thrust(
+        p_ch, calculate_fuel_mass_flow(pressures.p_inj_fuel.psi, p_ch), calculate_lox_mass_flow(pressures.p_inj_lox.psi, p_ch), metrics);
+}
+
+RangerThrottle::EngineEstimate RangerThrottle::engine_estimate_test()
+{
+    return {
+        .p_ch_psi = engine_estimate[P_CH],
+        .mdot_fuel = engine_estimate[MDOT_FUEL],
+        .mdot_lox = engine_estimate[MDOT_LOX],
+    };
 }
 #endif
@@ -4,17 +4,28 @@
 #include "clover.pb.h"
 #include <cstdint>
 #include <expected>
+#include <optional>
 #include <tuple>
 
 namespace RangerThrottle {
 void reset();
 std::expected<std::tuple<ThrottleValveCommand, ThrottleValveCommand, RangerThrottleMetrics>, Error> tick(AnalogSensorReadings& analog_sensors, float thrust_command_lbf);
-std::expected<ThrottleValveCommand, Error>
-calibration_tick(ThrottleValveType valve, uint32_t timestamp, float valve_pos, float valve_pos_enc);
-void calibration_reset(ThrottleValveType valve, float valve_pos, float valve_pos_enc);
+std::expected<ThrottleValveCommand, Error> calibration_tick(ThrottleValveType valve, uint32_t timestamp, float valve_pos_enc);
+void calibration_reset(ThrottleValveType valve, uint32_t timestamp, float valve_pos_enc);
+// Result of the latest calibration, once it has completed.
+std::optional<ThrottleValveCalibration> calibration_result();
 
 #if CONFIG_TEST
+struct EngineEstimate {
+    float p_ch_psi;
+    float mdot_fuel;
+    float mdot_lox;
+};
+
 std::tuple<ThrottleValveCommand, ThrottleValveCommand> active_control_test(float& alpha_state, float predicted_thrust_lbf, float thrust_command_lbf, RangerThrottleMetrics& metrics);
+// Thrust from a single sample of the PTs, without the observer.
 std::expected<float, Error> thrust_predictor(AnalogSensorReadings& analog_sensors, RangerThrottleMetrics& metrics);
+// The observer's estimate after the latest tick.
+EngineEstimate engine_estimate_test();
 #endif
 }  // namespace RangerThrottle
@@ -119,6 +119,7 @@ static std::array<std::optional<AnalogSensorConfig>, NUM_ANALOG_CHANNELS> sensor
 static bool has_reading = false;
 static AnalogSensorReadings sensor_readings = AnalogSensorReadings_init_default;
 static float sense_time_ns = 0.0f;
+static uint32_t sample_counter = 0;
 
 LOG_MODULE_REGISTER(AnalogSensors, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -147,6 +148,10 @@ static void sense()
             MutexGuard analog_sensors_guard{&analog_sensors_mutex};
 
             sense_time_ns = static_cast<float>(k_cycle_get_64() - start_read_cycle) / sys_clock_hw_cycles_per_sec() * 1e9f;
+            sensor_readings.has_capture_time_ns = true;
+            sensor_readings.capture_time_ns = k_cyc_to_ns_floor64(start_read_cycle);
+            sensor_readings.has_sample_counter = true;
+            sensor_readings.sample_counter = ++sample_counter;
 
             has_reading = true;
 
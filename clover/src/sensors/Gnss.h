@@ -2,7 +2,9 @@
 
 #include "Error.h"
 #include "MutexGuard.h"
+#include "clover.pb.h"
 #include "config.h"
+#include "sensors/UartDmaRx.h"
 #include <expected>
 #include <optional>
 #include <stdint.h>
@@ -41,6 +43,8 @@ struct GnssReading {
     uint8_t sol_type;
 
     float sense_time_ns;
+    uint64_t capture_time_ns;  // Arrival of the epoch's [~~] message [ns since boot]
+    uint32_t sample_counter;   // Increments once per epoch
 };
 
 extern k_sem gnss_ready_sem;  // Must be static-initialized as the sense thread waits on this
@@ -48,7 +52,11 @@ extern k_sem gnss_ready_sem;  // Must be static-initialized as the sense thread
 namespace Gnss {
 
 constexpr int RING_BUF_SIZE = 512;
+constexpr int DMA_BUF_SIZE = 128;
 constexpr int MAX_BODY_LENGTH = 256;
+constexpr int32_t RX_IDLE_TIMEOUT_US = 200;
+
+using Rx = UartDmaRx<DEVICE_DT_GET(DT_ALIAS(gnss_uart)), DMA_BUF_SIZE, RING_BUF_SIZE>;
 
 inline const device* uart_dev;
 inline k_sem* const ready_sem = &gnss_ready_sem;  // Must be static-initialized as the sense thread waits on this
@@ -56,16 +64,24 @@ inline k_sem* const ready_sem = &gnss_ready_sem;  // Must be static-initialized
 inline GnssReading current_reading = {};
 inline float sense_time_ns = 0.0f;
 inline uint64_t last_cycle = 0;
+inline uint32_t sample_counter = 0;
 inline bool has_reading = false;
 
+// Frame parser state, persists across ring buffer claims
+enum class RxState { SYNC, LENGTH, BODY };
+inline RxState rx_state = RxState::SYNC;
+inline char rx_id[2] = {0, 0};
+inline char rx_length_buf[4] = {0, 0, 0, 0};
+inline uint8_t rx_body[MAX_BODY_LENGTH];
+inline int rx_sync_count = 0;
+inline int rx_length_count = 0;
+inline int rx_body_length = 0;
+inline int rx_body_count = 0;
+inline uint32_t rx_msg_index = 0;  // Stream index of the current message's first ID byte
+
 // Initialized in init()
 inline k_mutex reading_mutex;
 inline k_sem data_ready_sem;
-inline uint8_t gnss_ring_buf_data[RING_BUF_SIZE];
-inline ring_buf uart_ringbuf;
-
-// UART interrupt callback
-void uart_handler(const device*, void*);
 
 // Little-endian binary reads
 float read_f4(const uint8_t* p);
@@ -86,30 +102,20 @@ uint8_t calculate_checksum(const char id[2], const char length_buf[4], const uin
 std::expected<void, Error> init();
 void start_sense();
 std::optional<GnssReading> read();
+std::optional<GnssReading> latest();
+
+// Telemetry and state estimator representation of a reading
+GnssReadings to_proto(const GnssReading& reading);
+
+// Decode everything received so far. Called from sense(), or from the sensor hub thread when CONFIG_SENSOR_HUB is set.
+void service();
+k_sem* data_ready();
 
 // Main sense loop thread, do not call directly.
 void sense();
 
 }  // namespace Gnss
 
-/// UART interrupt handler
-inline void Gnss::uart_handler(const device* dev, void*)
-{
-    LOG_MODULE_DECLARE(Gnss);
-    if (!uart_irq_update(dev)) {
-        return;
-    }
-    uint8_t byte;
-    while (uart_irq_rx_ready(dev) > 0) {
-        int bytes_read = uart_fifo_read(dev, &byte, 1);
-        if (bytes_read <= 0) {
-            break;
-        }
-        ring_buf_put(&uart_ringbuf, &byte, 1);
-    }
-    k_sem_give(&data_ready_sem);
-}
-
 inline float Gnss::read_f4(const uint8_t* p)
 {
     float v;
@@ -138,11 +144,14 @@ inline void Gnss::decode_RT(const uint8_t* body, int length)
         return;
     }
     uint32_t tod = read_u4(body);
+    uint64_t capture_cycle = Rx::capture_cycle(rx_msg_index);
     MutexGuard g{&reading_mutex};
     uint64_t curr_cycle = k_cycle_get_64();
     sense_time_ns = static_cast<float>(curr_cycle - last_cycle) / sys_clock_hw_cycles_per_sec() * 1e9f;
     last_cycle = curr_cycle;
     current_reading.receiver_time_ms = tod;
+    current_reading.capture_time_ns = k_cyc_to_ns_floor64(capture_cycle);
+    current_reading.sample_counter = ++sample_counter;
     has_reading = true;
 }
 
@@ -267,103 +276,111 @@ inline uint8_t Gnss::calculate_checksum(const char id[2], const char length_buf[
     return rot_left(res);
 }
 
-/// Continuously accumulates GNSS readings from the receiver over UART. Runs in dedicated thread.
 // GREIS frame format:
 //   [2-char ASCII ID][3-char ASCII hex length][N bytes binary body][0x0A opt]
 //
 // States:
 //   SYNC   — collecting 2 valid ASCII bytes as message ID
 //   LENGTH — reading 3 ASCII hex chars for body length
-//   BODY   — accumulating body bytes
-inline void Gnss::sense()
+//   BODY   — accumulating body bytes, copied from the claimed span in bulk
+//
+// CR/LF are only skipped between messages; inside a binary body they are ordinary data bytes.
+inline void Gnss::service()
 {
     LOG_MODULE_DECLARE(Gnss);
 
-    k_sem_take(ready_sem, K_FOREVER);
-    LOG_INF("[Gnss] Sense loop initiated");
-
-    enum { SYNC, LENGTH, BODY } state = SYNC;
-
-    char id[2] = {0, 0};
-    char length_buf[4] = {0, 0, 0, 0};
-    uint8_t body[MAX_BODY_LENGTH];
-    int sync_count = 0;
-    int length_count = 0;
-    int body_length = 0;
-    int body_count = 0;
-
-    while (1) {
-        k_sem_take(&data_ready_sem, K_MSEC(1000));
-
-        uint8_t byte;
-        while (ring_buf_get(&uart_ringbuf, &byte, 1) > 0) {
-            if (byte == 0x0A || byte == 0x0D) {
+    uint8_t* data;
+    uint32_t len;
+
+    while ((len = Rx::claim(&data)) > 0) {
+        uint32_t pos = 0;
+        while (pos < len) {
+            if (rx_state == RxState::BODY) {
+                uint32_t copy_len = MIN(static_cast<uint32_t>(rx_body_length - rx_body_count), len - pos);
+                memcpy(rx_body + rx_body_count, data + pos, copy_len);
+                rx_body_count += copy_len;
+                pos += copy_len;
+
+                if (rx_body_count == rx_body_length) {
+                    uint8_t calc_cs = calculate_checksum(rx_id, rx_length_buf, rx_body, rx_body_length);
+                    uint8_t expected_cs = rx_body[rx_body_length - 1];
+                    if (calc_cs != expected_cs) {
+                        LOG_WRN("[Gnss] [%c%c] bad checksum (calc 0x%02X, got 0x%02X)", rx_id[0], rx_id[1], calc_cs, expected_cs);
+                    }
+                    else {
+                        decode(rx_id, rx_body, rx_body_length);
+                    }
+                    rx_state = RxState::SYNC;
+                }
                 continue;
             }
 
-            switch (state) {
+            uint8_t byte = data[pos++];
 
-            case SYNC:
+            if (rx_state == RxState::SYNC) {
+                if (byte == 0x0A || byte == 0x0D) {
+                    continue;
+                }
                 if (byte >= 0x30 && byte <= 0x7E) {
-                    if (sync_count == 0) {
-                        id[0] = (char)byte;
-                        sync_count = 1;
+                    if (rx_sync_count == 0) {
+                        rx_msg_index = Rx::stream_index(pos - 1);
+                        rx_id[0] = (char)byte;
+                        rx_sync_count = 1;
                     }
                     else {
-                        id[1] = (char)byte;
-                        sync_count = 0;
-                        length_count = 0;
-                        state = LENGTH;
+                        rx_id[1] = (char)byte;
+                        rx_sync_count = 0;
+                        rx_length_count = 0;
+                        rx_state = RxState::LENGTH;
                     }
                 }
                 else {
-                    sync_count = 0;
-                }
-                break;
-
-            case LENGTH:
-                if ((byte >= '0' && byte <= '9') || (byte >= 'A' && byte <= 'F') || (byte >= 'a' && byte <= 'f')) {
-                    length_buf[length_count++] = (char)byte;
-                    if (length_count == 3) {
-                        length_buf[3] = '\0';
-                        body_length = (int)strtol(length_buf, nullptr, 16);
-                        body_count = 0;
-                        length_count = 0;
-                        if (body_length > 0 && body_length <= MAX_BODY_LENGTH) {
-                            state = BODY;
-                        }
-                        else {
-                            LOG_WRN("[Gnss] invalid body length %d for id %c%c", body_length, id[0], id[1]);
-                            state = SYNC;
-                        }
-                    }
+                    rx_sync_count = 0;
                 }
-                else {
-                    state = SYNC;
-                    sync_count = 0;
-                }
-                break;
+                continue;
+            }
 
-            case BODY:
-                body[body_count++] = byte;
-                if (body_count == body_length) {
-                    uint8_t calc_cs = calculate_checksum(id, length_buf, body, body_length);
-                    uint8_t expected_cs = body[body_length - 1];
-                    if (calc_cs != expected_cs) {
-                        LOG_WRN("[Gnss] [%c%c] bad checksum (calc 0x%02X, got 0x%02X)", id[0], id[1], calc_cs, expected_cs);
+            // LENGTH
+            if ((byte >= '0' && byte <= '9') || (byte >= 'A' && byte <= 'F') || (byte >= 'a' && byte <= 'f')) {
+                rx_length_buf[rx_length_count++] = (char)byte;
+                if (rx_length_count == 3) {
+                    rx_length_buf[3] = '\0';
+                    rx_body_length = (int)strtol(rx_length_buf, nullptr, 16);
+                    rx_body_count = 0;
+                    rx_length_count = 0;
+                    if (rx_body_length > 0 && rx_body_length <= MAX_BODY_LENGTH) {
+                        rx_state = RxState::BODY;
                     }
                     else {
-                        decode(id, body, body_length);
+                        LOG_WRN("[Gnss] invalid body length %d for id %c%c", rx_body_length, rx_id[0], rx_id[1]);
+                        rx_state = RxState::SYNC;
                     }
-                    state = SYNC;
                 }
-                break;
+            }
+            else {
+                rx_state = RxState::SYNC;
+                rx_sync_count = 0;
             }
         }
+        Rx::finish(len);
+    }
+}
+
+/// Continuously accumulates GNSS readings from the receiver over UART. Runs in dedicated thread.
+inline void Gnss::sense()
+{
+    LOG_MODULE_DECLARE(Gnss);
+
+    k_sem_take(ready_sem, K_FOREVER);
+    LOG_INF("[Gnss] Sense loop initiated");
+
+    while (1) {
+        k_sem_take(&data_ready_sem, K_MSEC(1000));
+        service();
     }
 }
 
-/// Initialize GNSS: set up ring buffer, configure UART, attach IRQ.
+/// Initialize GNSS: reset the frame parser and start DMA reception.
 inline std::expected<void, Error> Gnss::init()
 {
     LOG_MODULE_DECLARE(Gnss);
@@ -371,19 +388,19 @@ inline std::expected<void, Error> Gnss::init()
 
     k_mutex_init(&reading_mutex);
     k_sem_init(&data_ready_sem, 0, 1);
-    ring_buf_init(&uart_ringbuf, RING_BUF_SIZE, gnss_ring_buf_data);
+    rx_state = RxState::SYNC;
+    rx_sync_count = 0;
 
     uart_dev = DEVICE_DT_GET(DT_ALIAS(gnss_uart));
     if (!device_is_ready(uart_dev)) {
         return std::unexpected(Error::from_device_not_ready(uart_dev).context("[Gnss] UART is not ready"));
     }
 
-    int err = uart_irq_callback_user_data_set(uart_dev, uart_handler, nullptr);
-    if (err < 0) {
-        return std::unexpected(Error::from_code(err).context("[Gnss] Failed to attach UART interrupt handler"));
+    auto rx_result = Rx::init(&data_ready_sem, RX_IDLE_TIMEOUT_US);
+    if (!rx_result) {
+        return std::unexpected(rx_result.error().context("[Gnss] Failed to start UART reception"));
     }
 
-    uart_irq_rx_enable(uart_dev);
     LOG_INF("[Gnss] Initialized");
     return {};
 }
@@ -393,6 +410,12 @@ inline void Gnss::start_sense()
     k_sem_give(ready_sem);
 }
 
+/// Semaphore given whenever received data is waiting to be serviced.
+inline k_sem* Gnss::data_ready()
+{
+    return &data_ready_sem;
+}
+
 /// Returns the latest complete GNSS epoch reading and sense cycle time [ns], if available.
 inline std::optional<GnssReading> Gnss::read()
 {
@@ -405,4 +428,38 @@ inline std::optional<GnssReading> Gnss::read()
     return {current_reading};
 }
 
+inline std::optional<GnssReading> Gnss::latest()
+{
+    MutexGuard g{&reading_mutex};
+    if (sample_counter == 0) {
+        return std::nullopt;
+    }
+    current_reading.sense_time_ns = sense_time_ns;
+    return {current_reading};
+}
+
+inline GnssReadings Gnss::to_proto(const GnssReading& reading)
+{
+    GnssReadings out = GnssReadings_init_default;
+    out.north_m = reading.north_m;
+    out.east_m = reading.east_m;
+    out.up_m = reading.up_m;
+    out.pos_sigma_m = reading.pos_sigma_m;
+    out.vx_ms = reading.vx_ms;
+    out.vy_ms = reading.vy_ms;
+    out.vz_ms = reading.vz_ms;
+    out.vel_sigma_ms = reading.vel_sigma_ms;
+    out.hrms_m = reading.hrms_m;
+    out.vrms_m = reading.vrms_m;
+    out.hvel_rms_ms = reading.hvel_rms_ms;
+    out.vvel_rms_ms = reading.vvel_rms_ms;
+    out.solution_time_ms = reading.solution_time_ms;
+    out.receiver_time_ms = reading.receiver_time_ms;
+    out.sol_type = reading.sol_type;
+    out.sense_time_ns = reading.sense_time_ns;
+    out.capture_time_ns = reading.capture_time_ns;
+    out.sample_counter = reading.sample_counter;
+    return out;
+}
+
 #endif  // CONFIG_GNSS
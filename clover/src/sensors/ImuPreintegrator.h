@@ -0,0 +1,60 @@
+#ifndef APP_SENSORS_IMU_PREINTEGRATOR_H
+#define APP_SENSORS_IMU_PREINTEGRATOR_H
+
+#include "Matrix.h"
+#include <cstdint>
+
+/// Accumulates IMU samples into delta-angle and delta-velocity increments, expressed in the body frame at the start of
+/// the interval, so a consumer running slower than the IMU still uses every sample.
+///
+/// Each sample is treated as constant over its dt. Naively summing rate * dt loses the effect of the body rotating
+/// while it integrates, so the increments carry the usual recursive corrections (Savage, two-sample form):
+///   - coning: rotation of the rotation axis during the interval, which summed delta angles miss.
+///   - sculling: rotation of the specific force during the interval, plus the rotation of the summed velocity increment
+///     into the start frame.
+/// Both vanish for a constant rotation axis and a non-rotating body respectively, leaving the plain sums.
+class ImuPreintegrator {
+public:
+    /// Add one sample of angular rate [rad/s] and specific force [m/s^2] held over dt [s].
+    void add(const Vec<3>& angular_rate, const Vec<3>& specific_force, float dt)
+    {
+        const Vec<3> d_alpha = angular_rate * dt;
+        const Vec<3> d_nu = specific_force * dt;
+
+        const Vec<3> alpha_term = alpha + prev_d_alpha * (1.0f / 6.0f);
+        const Vec<3> nu_term = nu + prev_d_nu * (1.0f / 6.0f);
+        axpy(coning, 0.5f, cross(alpha_term, d_alpha));
+        axpy(sculling, 0.5f, cross(alpha_term, d_nu) + cross(nu_term, d_alpha));
+
+        alpha += d_alpha;
+        nu += d_nu;
+        prev_d_alpha = d_alpha;
+        prev_d_nu = d_nu;
+        time_s += dt;
+        count++;
+    }
+
+    /// Start a new interval.
+    void reset() { *this = {}; }
+
+    /// Rotation of the body over the interval, as a rotation vector in the body frame at its start [rad].
+    Vec<3> delta_angle() const { return alpha + coning; }
+
+    /// Velocity change from specific force, in the body frame at the start of the interval [m/s].
+    Vec<3> delta_velocity() const { return nu + cross(alpha, nu) * 0.5f + sculling; }
+
+    float delta_time() const { return time_s; }
+    uint32_t sample_count() const { return count; }
+
+private:
+    Vec<3> alpha;  // Summed delta angles
+    Vec<3> nu;     // Summed delta velocities
+    Vec<3> coning;
+    Vec<3> sculling;
+    Vec<3> prev_d_alpha;
+    Vec<3> prev_d_nu;
+    float time_s = 0.0f;
+    uint32_t count = 0;
+};
+
+#endif  // APP_SENSORS_IMU_PREINTEGRATOR_H
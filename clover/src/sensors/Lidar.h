@@ -3,8 +3,10 @@
 #include "Error.h"
 #include "MutexGuard.h"
 #include "config.h"
+#include "sensors/UartDmaRx.h"
 #include <expected>
 #include <optional>
+#include <string.h>
 #include <zephyr/drivers/uart.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -28,62 +30,136 @@ consteval static const char* kind_to_prefix(LidarKind name)
 
 template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> class Lidar {
 private:
-    constexpr static int RING_BUF_SIZE = 64;
+    constexpr static int RING_BUF_SIZE = 128;
+    constexpr static int DMA_BUF_SIZE = 32;
     constexpr static int MAX_MSG_SIZE = 9;
+    constexpr static uint8_t FRAME_HEADER = 0x59;
+    constexpr static uint32_t DEFAULT_BAUD_RATE = 115200; // TF-series factory default
+    constexpr static uint32_t UART_BAUD_RATE = CONFIG_LIDAR_BAUD_RATE;
+    constexpr static int32_t RX_IDLE_TIMEOUT_US = 3 * 10 * 1'000'000 / UART_BAUD_RATE + 1; // ~3 character times
+    static_assert(CONFIG_LIDAR_FRAME_RATE_HZ * MAX_MSG_SIZE * 10 < UART_BAUD_RATE, "Lidar baud rate too low for the frame rate");
+
+    // TF-series command frames: 0x5A, length, command id, payload, checksum (sum of the preceding bytes)
+    constexpr static uint8_t CMD_HEADER = 0x5A;
+    constexpr static uint8_t CMD_SYSTEM_RESET = 0x02;
+    constexpr static uint8_t CMD_FRAME_RATE = 0x03;
+    constexpr static uint8_t CMD_BAUD_RATE = 0x06;
+    constexpr static uint8_t CMD_SAVE_SETTINGS = 0x11;
 
     constexpr static const device* uart_dev = uart_dt_init;
+    using Rx = UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>;
     constexpr static k_sem* ready_sem = ready_sem_ptr;  // Must be static-initialized as the sense thread waits on this
 
     static inline LidarReading reading = LidarReading_init_default;
     static inline float sense_time_ns = 0.0f;
     static inline uint64_t last_reading_cycle = 0;
+    static inline uint32_t sample_counter = 0;
     static inline bool has_reading = false;
 
+    // Frame straddling the end of a ring buffer claim, completed on the next claim
+    static inline uint8_t partial_frame[MAX_MSG_SIZE];
+    static inline int partial_frame_len = 0;
+    static inline uint32_t partial_frame_index = 0;
+
+    // Link quality, only touched by service()
+    static inline bool in_sync = false;
+    static inline uint32_t frame_error_count = 0;
+    static inline uint32_t checksum_error_count = 0;
+
     // Initialized in init()
     static inline k_mutex reading_mutex;
     static inline k_sem data_ready_sem;
-    static inline uint8_t lidar_ring_buf_data[RING_BUF_SIZE];
-    static inline ring_buf uart_ringbuf;
 
-    // Interrupt-driven UART callback
-    static void uart_handler(const device*, void*);
+    // Send a command frame in poll mode, filling in its length and trailing checksum
+    static void send_command(uint8_t id, const uint8_t* payload, size_t payload_len);
+
+    // Reconfigure the host side of the link
+    static std::expected<void, Error> set_host_baud(uint32_t baud);
+
+    // Command the configured frame rate and baud rate
+    static std::expected<void, Error> configure();
 
-    // Decode a UART message
-    static std::expected<void, Error> decode(uint8_t msg[MAX_MSG_SIZE]);
+    // Count a loss of frame sync once per run of discarded bytes
+    static void lose_sync();
+
+    // Check a frame's header and checksum, counting a checksum error if it is bad
+    static bool validate(const uint8_t msg[MAX_MSG_SIZE]);
+
+    // Publish a validated frame, start_index is the stream index of its first byte
+    static void publish(const uint8_t msg[MAX_MSG_SIZE], uint32_t start_index);
 
 public:
     static std::expected<void, Error> init();
     static void start_sense();
     static std::optional<LidarReading> read();
+    static std::optional<LidarReading> latest();
+
+    // Decode everything received so far. Called from sense(), or from the sensor hub thread when CONFIG_SENSOR_HUB is set.
+    static void service();
+    static k_sem* data_ready();
 
     // Main sense loop thread, do not call directly.
     static void sense();
 };
 
-/// UART interrupt handler
-template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> void Lidar<kind, uart_dt_init, ready_sem_ptr>::uart_handler(const device*, void*)
+/// Consume everything currently in the receive ring buffer. While in sync, frames are validated back to back in place
+/// from the claimed span and only the newest valid one is published; the scan falls back to memchr for the next header
+/// only after a bad frame. A frame split across the buffer wrap is completed through partial_frame.
+template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> void Lidar<kind, uart_dt_init, ready_sem_ptr>::service()
 {
-    LOG_MODULE_DECLARE(Lidar);
-    int err = uart_irq_update(uart_dev);
-    if (err < 0) {
-        LOG_ERR("%s Failed to start processing UART interrupts: %s", kind_to_prefix(kind), Error::from_code(err).build_message().c_str());
-        return;
-    }
-
-    // Populate ringbuf from UART fifo.
-    while (uart_irq_rx_ready(uart_dev) > 0) {
-        uint8_t received_byte;
-        int bytes_read = uart_fifo_read(uart_dev, &received_byte, 1);
-        if (bytes_read < 0) {
-            LOG_ERR("%s Failed to read from UART fifo: %s", kind_to_prefix(kind), Error::from_code(bytes_read).build_message().c_str());
-            return;
+    uint8_t* data;
+    uint32_t len;
+
+    while ((len = Rx::claim(&data)) > 0) {
+        uint32_t pos = 0;
+
+        // Complete the frame left over from the previous claim
+        while (partial_frame_len > 0 && pos < len) {
+            uint8_t byte = data[pos++];
+            if (partial_frame_len == 1 && byte != FRAME_HEADER) {
+                partial_frame_len = 0;
+                lose_sync();
+                break;
+            }
+            partial_frame[partial_frame_len++] = byte;
+            if (partial_frame_len == MAX_MSG_SIZE) {
+                partial_frame_len = 0;
+                if (validate(partial_frame)) {
+                    publish(partial_frame, partial_frame_index);
+                }
+            }
+        }
+
+        const uint8_t* newest = nullptr;
+        uint32_t newest_pos = 0;
+        while (pos < len) {
+            uint32_t remaining = len - pos;
+            if (data[pos] == FRAME_HEADER && (remaining == 1 || data[pos + 1] == FRAME_HEADER)) {
+                if (remaining < MAX_MSG_SIZE) {
+                    memcpy(partial_frame, data + pos, remaining);
+                    partial_frame_len = remaining;
+                    partial_frame_index = Rx::stream_index(pos);
+                    break;
+                }
+                if (validate(data + pos)) {
+                    newest = data + pos;
+                    newest_pos = pos;
+                    pos += MAX_MSG_SIZE;
+                    continue;
+                }
+            }
+
+            // Out of sync, skip ahead to the next header candidate
+            lose_sync();
+            const uint8_t* header = static_cast<const uint8_t*>(memchr(data + pos + 1, FRAME_HEADER, remaining - 1));
+            pos = header != nullptr ? header - data : len;
         }
-        if (bytes_read == 0) {
-            break;
+
+        if (newest != nullptr) {
+            publish(newest, Rx::stream_index(newest_pos));
         }
-        ring_buf_put(&uart_ringbuf, &received_byte, 1);
+        Rx::finish(len);
     }
-    k_sem_give(&data_ready_sem);
 }
 
 /// Continuously populates sensor reading from LiDAR over UART. Runs in dedicated thread.
@@ -95,63 +171,141 @@ template <LidarKind kind, const device* uart_dt_init, k_sem* read_sem_ptr> void
     k_sem_take(ready_sem, K_FOREVER);
     LOG_INF("%s Sense loop initiated", kind_to_prefix(kind));
     LOG_INF("%s Running on thread %p", kind_to_prefix(kind), k_current_get());
-    uint8_t msg[MAX_MSG_SIZE];
-    int i = 0;
 
     while (1) {
         k_sem_take(&data_ready_sem, K_FOREVER);
+        service();
+    }
+}
 
-        uint8_t byte;
-        while (ring_buf_get(&uart_ringbuf, &byte, 1) > 0) {
-            if (i == 0 && byte != 0x59)
-                continue;
-            if (i == 1 && byte != 0x59) {
-                i = 0;
-                continue;
-            }
+template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> void Lidar<kind, uart_dt_init, ready_sem_ptr>::lose_sync()
+{
+    if (in_sync) {
+        in_sync = false;
+        frame_error_count++;
+    }
+}
 
-            msg[i++] = byte;
-            if (i == 9) {
-                i = 0;
-                decode(msg);
-            }
-        }
+template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> bool Lidar<kind, uart_dt_init, ready_sem_ptr>::validate(const uint8_t msg[MAX_MSG_SIZE])
+{
+    if (msg[0] != FRAME_HEADER || msg[1] != FRAME_HEADER) {
+        return false;
     }
+
+    uint8_t calculated_checksum = 0;
+    for (int i = 0; i < MAX_MSG_SIZE - 1; i++) {
+        calculated_checksum += msg[i];
+    }
+    if (calculated_checksum != msg[MAX_MSG_SIZE - 1]) {
+        checksum_error_count++;
+        in_sync = false;
+        return false;
+    }
+
+    in_sync = true;
+    return true;
 }
 
 template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
-std::expected<void, Error> Lidar<kind, uart_dt_init, ready_sem_ptr>::decode(uint8_t msg[MAX_MSG_SIZE])
+void Lidar<kind, uart_dt_init, ready_sem_ptr>::publish(const uint8_t msg[MAX_MSG_SIZE], uint32_t start_index)
 {
-    uint16_t strength;
-    uint16_t temp;
-    uint16_t checksum;
+    uint16_t distance = msg[2] | (msg[3] << 8);
+    uint16_t strength = msg[4] | (msg[5] << 8);
+
+    float distance_meters = distance / 100.0f;
+    uint64_t capture_cycle = Rx::capture_cycle(start_index);
 
-    if (msg[0] != 0x59 || msg[1] != 0x59) {
-        return std::unexpected(Error::from_cause("Invalid LiDAR message header, byte 0: %d, byte 1: %d", msg[0], msg[1]));
+    MutexGuard reading_guard{&reading_mutex};
+    uint64_t curr_cycle = k_cycle_get_64();
+    sense_time_ns = static_cast<float>(curr_cycle - last_reading_cycle) / sys_clock_hw_cycles_per_sec() * 1e9f;
+    last_reading_cycle = curr_cycle;
+    sample_counter++;
+    reading = LidarReading{
+        .distance_m = distance_meters,
+        .strength = static_cast<float>(strength),
+        .capture_time_ns = k_cyc_to_ns_floor64(capture_cycle),
+        .sample_counter = sample_counter,
+        .frame_error_count = frame_error_count,
+        .checksum_error_count = checksum_error_count,
+    };
+    has_reading = true;
+}
+
+template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
+void Lidar<kind, uart_dt_init, ready_sem_ptr>::send_command(uint8_t id, const uint8_t* payload, size_t payload_len)
+{
+    uint8_t cmd[16] = {CMD_HEADER, static_cast<uint8_t>(payload_len + 4), id};
+    if (payload_len > 0) {
+        memcpy(cmd + 3, payload, payload_len);
     }
 
-    uint16_t distance = msg[2] | (msg[3] << 8);
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < payload_len + 3; i++) {
+        checksum += cmd[i];
+    }
+    cmd[payload_len + 3] = checksum;
 
-    strength = msg[4] | (msg[5] << 8);
-    temp = msg[6] | (msg[7] << 8);
-    checksum = msg[8];
+    for (size_t i = 0; i < payload_len + 4; i++) {
+        uart_poll_out(uart_dev, cmd[i]);
+    }
+    k_msleep(50);
+}
 
-    uint8_t calculated_checksum = (msg[0] + msg[1] + msg[2] + msg[3] + msg[4] + msg[5] + msg[6] + msg[7]) & 0xFF;
-    if (checksum != calculated_checksum) {
-        return std::unexpected(Error::from_cause("Invalid checksum, got %d but expected %d", calculated_checksum, checksum));
+template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
+std::expected<void, Error> Lidar<kind, uart_dt_init, ready_sem_ptr>::set_host_baud(uint32_t baud)
+{
+    struct uart_config cfg = {
+        .baudrate = baud,
+        .parity = UART_CFG_PARITY_NONE,
+        .stop_bits = UART_CFG_STOP_BITS_1,
+        .data_bits = UART_CFG_DATA_BITS_8,
+        .flow_ctrl = UART_CFG_FLOW_CTRL_NONE,
+    };
+
+    int err = uart_configure(uart_dev, &cfg);
+    if (err) {
+        return std::unexpected(Error::from_code(err).context("%s Failed to configure UART for %u baud", kind_to_prefix(kind), baud));
     }
+    return {};
+}
 
-    float distance_meters = distance / 100.0f;
+/// Command the configured frame rate and baud rate. A sensor at its factory 115200 gets both, then saves and resets
+/// since some TF models only apply a new baud rate after a restart. The frame rate is sent again at the new baud rate,
+/// which also covers a sensor that kept its settings from an earlier boot and ignored the 115200 commands as noise.
+template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> std::expected<void, Error> Lidar<kind, uart_dt_init, ready_sem_ptr>::configure()
+{
+    LOG_MODULE_DECLARE(Lidar);
 
-    {
-        MutexGuard reading_guard{&reading_mutex};
-        uint64_t curr_cycle = k_cycle_get_64();
-        sense_time_ns = static_cast<float>(curr_cycle - last_reading_cycle) / sys_clock_hw_cycles_per_sec() * 1e9f;
-        last_reading_cycle = curr_cycle;
-        reading = LidarReading{.distance_m = distance_meters, .strength = static_cast<float>(strength)};
-        has_reading = true;
+    const uint8_t frame_rate[] = {
+        static_cast<uint8_t>(CONFIG_LIDAR_FRAME_RATE_HZ & 0xFF),
+        static_cast<uint8_t>((CONFIG_LIDAR_FRAME_RATE_HZ >> 8) & 0xFF),
+    };
+    const uint8_t baud_rate[] = {
+        static_cast<uint8_t>(UART_BAUD_RATE & 0xFF),
+        static_cast<uint8_t>((UART_BAUD_RATE >> 8) & 0xFF),
+        static_cast<uint8_t>((UART_BAUD_RATE >> 16) & 0xFF),
+        static_cast<uint8_t>((UART_BAUD_RATE >> 24) & 0xFF),
+    };
+
+    auto result = set_host_baud(DEFAULT_BAUD_RATE);
+    if (!result) {
+        return result;
+    }
+    send_command(CMD_FRAME_RATE, frame_rate, sizeof(frame_rate));
+    if constexpr (UART_BAUD_RATE != DEFAULT_BAUD_RATE) {
+        send_command(CMD_BAUD_RATE, baud_rate, sizeof(baud_rate));
+        send_command(CMD_SAVE_SETTINGS, nullptr, 0);
+        send_command(CMD_SYSTEM_RESET, nullptr, 0);
+        k_msleep(200);
+
+        result = set_host_baud(UART_BAUD_RATE);
+        if (!result) {
+            return result;
+        }
+        send_command(CMD_FRAME_RATE, frame_rate, sizeof(frame_rate));
     }
 
+    LOG_INF("%s Configured for %d Hz at %u baud", kind_to_prefix(kind), CONFIG_LIDAR_FRAME_RATE_HZ, UART_BAUD_RATE);
     return {};
 }
 
@@ -164,22 +318,27 @@ template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> std:
 
     k_mutex_init(&reading_mutex);
     k_sem_init(&data_ready_sem, 0, 1);
-    ring_buf_init(&uart_ringbuf, RING_BUF_SIZE, lidar_ring_buf_data);
+    partial_frame_len = 0;
+    in_sync = false;
+    frame_error_count = 0;
+    checksum_error_count = 0;
 
     LOG_INF("%s Checking uart readiness", kind_to_prefix(kind));
     if (!device_is_ready(uart_dev)) {
         return std::unexpected(Error::from_device_not_ready(uart_dev).context("%s UART is not ready", kind_to_prefix(kind)));
     }
 
-    LOG_INF("%s Setting UART IRQ", kind_to_prefix(kind));
-    int err = uart_irq_callback_user_data_set(uart_dev, uart_handler, nullptr);
-    if (err < 0) {
-        LOG_INF("%s error", kind_to_prefix(kind));
-        return std::unexpected(Error::from_code(err).context("%s Failed to attach UART interrupt handler", kind_to_prefix(kind)));
+    LOG_INF("%s Configuring frame rate and baud rate", kind_to_prefix(kind));
+    auto config_result = configure();
+    if (!config_result) {
+        return std::unexpected(config_result.error().context("%s Failed to configure lidar", kind_to_prefix(kind)));
     }
 
-    LOG_INF("%s Enabling UART RX interrupt", kind_to_prefix(kind));
-    uart_irq_rx_enable(uart_dev);
+    LOG_INF("%s Starting UART DMA reception", kind_to_prefix(kind));
+    auto rx_result = Rx::init(&data_ready_sem, RX_IDLE_TIMEOUT_US);
+    if (!rx_result) {
+        return std::unexpected(rx_result.error().context("%s Failed to start UART reception", kind_to_prefix(kind)));
+    }
     LOG_INF("%s Lidar initialized", kind_to_prefix(kind));
 
     return {};
@@ -190,6 +349,12 @@ template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> void
     k_sem_give(ready_sem);
 }
 
+/// Semaphore given whenever received data is waiting to be serviced.
+template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> k_sem* Lidar<kind, uart_dt_init, ready_sem_ptr>::data_ready()
+{
+    return &data_ready_sem;
+}
+
 /// Returns a lidar reading and the time it took to acquire, if there's a reading.
 template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> std::optional<LidarReading> Lidar<kind, uart_dt_init, ready_sem_ptr>::read()
 {
@@ -206,6 +371,19 @@ template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> std:
     return {reading};
 }
 
+/// Returns the newest reading without consuming it, for readers that track sample counters themselves.
+template <LidarKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> std::optional<LidarReading> Lidar<kind, uart_dt_init, ready_sem_ptr>::latest()
+{
+    MutexGuard reading_guard{&reading_mutex};
+
+    if (sample_counter == 0) {
+        return std::nullopt;
+    }
+
+    reading.sense_time_ns = sense_time_ns;
+    return {reading};
+}
+
 extern k_sem lidar_1_ready_sem;
 typedef Lidar<LidarKind::LIDAR_1, DEVICE_DT_GET(DT_ALIAS(lidar_1_uart)), &lidar_1_ready_sem> Lidar1;
 
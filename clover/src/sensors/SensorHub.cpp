@@ -0,0 +1,63 @@
+#include "config.h"
+#include "sensors/Gnss.h"
+#include "sensors/Lidar.h"
+#include "sensors/VectornavIMU.h"
+#include <array>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(SensorHub);
+
+// A UART sensor serviced by the hub. Replaces that sensor's own sense thread.
+struct HubSensor {
+    k_sem* start_sem;
+    k_sem* (*data_ready)();
+    void (*service)();
+};
+
+// Order matches the k_poll event array; on simultaneous events earlier sensors are serviced first.
+static constexpr auto hub_sensors = std::to_array<HubSensor>({
+#ifdef CONFIG_IMU
+    {&vectornav_ready_sem, VectornavImu::data_ready, VectornavImu::service},
+#endif
+#ifdef CONFIG_LIDAR
+    {&lidar_1_ready_sem, Lidar1::data_ready, Lidar1::service},
+    {&lidar_2_ready_sem, Lidar2::data_ready, Lidar2::service},
+#endif
+#ifdef CONFIG_GNSS
+    {&gnss_ready_sem, Gnss::data_ready, Gnss::service},
+#endif
+});
+
+/// Services every UART sensor from one thread, waking on whichever has data. Runs in dedicated thread.
+static void sensor_hub()
+{
+    // Await initialization of every sensor, as each sense loop would
+    for (const HubSensor& sensor : hub_sensors) {
+        k_sem_take(sensor.start_sem, K_FOREVER);
+    }
+
+    std::array<k_poll_event, hub_sensors.size()> events;
+    for (size_t i = 0; i < hub_sensors.size(); ++i) {
+        k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, hub_sensors[i].data_ready());
+    }
+    LOG_INF("Sense loop initiated for %d sensors", static_cast<int>(hub_sensors.size()));
+
+    while (true) {
+        int err = k_poll(events.data(), events.size(), K_FOREVER);
+        if (err) {
+            LOG_ERR("Failed to poll sensors: %s", Error::from_code(err).build_message().c_str());
+            continue;
+        }
+
+        for (size_t i = 0; i < hub_sensors.size(); ++i) {
+            if (events[i].state == K_POLL_STATE_SEM_AVAILABLE) {
+                k_sem_take(events[i].sem, K_NO_WAIT);
+                hub_sensors[i].service();
+            }
+            events[i].state = K_POLL_STATE_NOT_READY;
+        }
+    }
+}
+
+K_THREAD_DEFINE(sensor_hub_tid, SENSOR_HUB_STACK_SIZE, sensor_hub, nullptr, nullptr, nullptr, SENSOR_HUB_THREAD_PRIORITY, 0, 0);
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "Error.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/ring_buffer.h>
+
+/// DMA-backed UART receiver built on the Zephyr async UART API.
+///
+/// The UART driver ping-pongs between two DMA buffers and raises UART_RX_RDY on idle-line (or when a buffer fills),
+/// so the callback runs once per burst instead of once per byte. Each burst is bulk-copied into a ring buffer, which the
+/// owning decoder consumes in place through claim()/finish().
+///
+/// Every burst also records when its last byte arrived, so a decoder can recover the capture time of any byte it parses
+/// (typically a frame's first byte) by its position in the stream, see capture_cycle().
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE> class UartDmaRx {
+private:
+    constexpr static const device* uart_dev = uart_dt_init;
+
+    static inline uint8_t dma_bufs[2][DMA_BUF_SIZE];
+    static inline int next_dma_buf = 0;
+    static inline int32_t idle_timeout_us = 0;
+
+    static inline uint8_t rx_ring_buf_data[RING_BUF_SIZE];
+    static inline ring_buf rx_ringbuf;
+
+    // Given every time new bytes land in the ring buffer.
+    static inline k_sem* data_ready_sem = nullptr;
+
+    static inline volatile uint32_t dropped_bytes = 0;
+    static inline volatile uint32_t rx_errors = 0;
+
+    // Arrival marks, written by the callback. end_index is the stream index one past the burst's last byte.
+    struct RxMark {
+        uint32_t end_index;
+        uint32_t cycle;
+    };
+    constexpr static uint32_t NUM_RX_MARKS = 16;
+    static inline RxMark rx_marks[NUM_RX_MARKS];
+    static inline std::atomic<uint32_t> rx_mark_count = 0;
+    static inline uint32_t bytes_received = 0;  // Stream index of the next byte put into the ring buffer
+    static inline uint32_t bytes_consumed = 0;  // Stream index of the first byte of the current claim
+
+    // Cycles per character (start + 8 data + stop bits) and for the idle timeout, set in init()
+    static inline uint32_t char_cycles = 0;
+    static inline uint32_t idle_timeout_cycles = 0;
+
+    static int enable_rx();
+
+    // Async UART event callback, runs in ISR context.
+    static void uart_callback(const device*, uart_event* evt, void*);
+
+public:
+    UartDmaRx() = delete;
+
+    static std::expected<void, Error> init(k_sem* data_ready, int32_t idle_timeout);
+
+    static uint32_t claim(uint8_t** data);
+    static void finish(uint32_t len);
+    static uint32_t stream_index(uint32_t claim_offset);
+    static uint64_t capture_cycle(uint32_t index);
+    static uint32_t get_dropped_bytes();
+    static uint32_t get_rx_errors();
+};
+
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE> int UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>::enable_rx()
+{
+    next_dma_buf = 1;
+    return uart_rx_enable(uart_dev, dma_bufs[0], DMA_BUF_SIZE, idle_timeout_us);
+}
+
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE>
+void UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>::uart_callback(const device*, uart_event* evt, void*)
+{
+    switch (evt->type) {
+    case UART_RX_RDY: {
+        const uint8_t* chunk = evt->data.rx.buf + evt->data.rx.offset;
+        uint32_t written = ring_buf_put(&rx_ringbuf, chunk, evt->data.rx.len);
+        if (written < evt->data.rx.len) [[unlikely]] {
+            dropped_bytes = dropped_bytes + (evt->data.rx.len - written);
+        }
+
+        // A burst that ended on idle is reported one idle timeout after its last byte, while one that filled the DMA
+        // buffer is reported as its last byte lands
+        const bool ended_on_idle = evt->data.rx.offset + evt->data.rx.len < DMA_BUF_SIZE;
+        const uint32_t end_cycle = k_cycle_get_32() - (ended_on_idle ? idle_timeout_cycles : 0);
+        bytes_received += written;
+        uint32_t mark = rx_mark_count.load(std::memory_order_relaxed);
+        rx_marks[mark % NUM_RX_MARKS] = {.end_index = bytes_received, .cycle = end_cycle};
+        rx_mark_count.store(mark + 1, std::memory_order_release);
+
+        k_sem_give(data_ready_sem);
+        break;
+    }
+
+    case UART_RX_BUF_REQUEST:
+        // Hand the driver the idle half of the double buffer so reception continues seamlessly.
+        uart_rx_buf_rsp(uart_dev, dma_bufs[next_dma_buf], DMA_BUF_SIZE);
+        next_dma_buf ^= 1;
+        break;
+
+    case UART_RX_STOPPED:
+        rx_errors = rx_errors + 1;
+        break;
+
+    case UART_RX_DISABLED:
+        // Reception stops after a line error; restart so the sensor keeps streaming.
+        enable_rx();
+        break;
+
+    default:
+        break;
+    }
+}
+
+/// Attach the async callback and start reception. idle_timeout is the line-idle period [us] after which received data
+/// is flushed to the ring buffer, and should be a couple of character times so each sensor frame arrives in one event.
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE>
+std::expected<void, Error> UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>::init(k_sem* data_ready, int32_t idle_timeout)
+{
+    data_ready_sem = data_ready;
+    idle_timeout_us = idle_timeout;
+    dropped_bytes = 0;
+    rx_errors = 0;
+    bytes_received = 0;
+    bytes_consumed = 0;
+    rx_mark_count.store(0);
+    ring_buf_init(&rx_ringbuf, RING_BUF_SIZE, rx_ring_buf_data);
+
+    uart_config cfg;
+    int err = uart_config_get(uart_dev, &cfg);
+    if (err) {
+        return std::unexpected(Error::from_code(err).context("failed to get UART config for %s", uart_dev->name));
+    }
+    char_cycles = static_cast<uint32_t>(10ULL * sys_clock_hw_cycles_per_sec() / cfg.baudrate);
+    idle_timeout_cycles = static_cast<uint32_t>(static_cast<uint64_t>(idle_timeout) * sys_clock_hw_cycles_per_sec() / 1000000);
+
+    err = uart_callback_set(uart_dev, uart_callback, nullptr);
+    if (err) {
+        return std::unexpected(Error::from_code(err).context("failed to attach async UART callback for %s", uart_dev->name));
+    }
+
+    err = enable_rx();
+    if (err) {
+        return std::unexpected(Error::from_code(err).context("failed to enable async UART reception for %s", uart_dev->name));
+    }
+
+    return {};
+}
+
+/// Claim the next contiguous span of received bytes for in-place parsing. Must be released with finish().
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE> uint32_t UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>::claim(uint8_t** data)
+{
+    return ring_buf_get_claim(&rx_ringbuf, data, RING_BUF_SIZE);
+}
+
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE> void UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>::finish(uint32_t len)
+{
+    ring_buf_get_finish(&rx_ringbuf, len);
+    bytes_consumed += len;
+}
+
+/// Stream index of a byte in the current claim, stable across claims so frames can be timestamped after reassembly.
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE>
+uint32_t UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>::stream_index(uint32_t claim_offset)
+{
+    return bytes_consumed + claim_offset;
+}
+
+/// Estimated cycle at which the byte at a stream index finished arriving, back-computed from its burst's arrival mark
+/// at one character time per byte. Falls back to the current cycle if the burst's mark has already been overwritten.
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE>
+uint64_t UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>::capture_cycle(uint32_t index)
+{
+    uint64_t now = k_cycle_get_64();
+    uint32_t count = rx_mark_count.load(std::memory_order_acquire);
+    uint32_t oldest = count > NUM_RX_MARKS ? count - NUM_RX_MARKS : 0;
+
+    for (uint32_t i = oldest; i < count; i++) {
+        RxMark mark = rx_marks[i % NUM_RX_MARKS];
+        int32_t bytes_after = static_cast<int32_t>(mark.end_index - 1 - index);
+        if (bytes_after >= 0) {
+            uint32_t cycle = mark.cycle - static_cast<uint32_t>(bytes_after) * char_cycles;
+            return now - static_cast<uint32_t>(static_cast<uint32_t>(now) - cycle);
+        }
+    }
+    return now;
+}
+
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE>
+uint32_t UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>::get_dropped_bytes()
+{
+    return dropped_bytes;
+}
+
+template <const device* uart_dt_init, size_t DMA_BUF_SIZE, size_t RING_BUF_SIZE> uint32_t UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>::get_rx_errors()
+{
+    return rx_errors;
+}
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "Error.h"
+#include "MaxLengthString.h"
 #include "MutexGuard.h"
 #include "config.h"
+#include "math_util.h"
+#include "sensors/ImuPreintegrator.h"
+#include "sensors/UartDmaRx.h"
 #include <expected>
 #include <optional>
 #include <string.h>
@@ -28,161 +32,392 @@ consteval static const char* kind_to_prefix(VectornavKind kind)
 template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> class Vectornav {
 private:
     constexpr static int RING_BUF_SIZE = 2048;
+    constexpr static int DMA_BUF_SIZE = 256;
     constexpr static int MAX_LINE_SIZE = 256;
-    constexpr static uint32_t UART_BAUD_RATE = 115200;
+    constexpr static uint32_t DEFAULT_BAUD_RATE = 115200; // VN-300 factory default
+
+#ifdef CONFIG_IMU_VN_BINARY_OUTPUT
+    constexpr static uint32_t UART_BAUD_RATE = CONFIG_IMU_VN_BAUD_RATE;
+    constexpr static int32_t RX_IDLE_TIMEOUT_US = 50;
+
+    // Binary output 1, common group only: TimeStartup, Quaternion, AngularRate, Accel, MagPres, InsStatus.
+    constexpr static uint8_t BIN_SYNC = 0xFA;
+    constexpr static uint8_t BIN_GROUPS = 0x01;
+    constexpr static uint16_t BIN_COMMON_FIELDS = 0x1531;
+    constexpr static int BIN_PACKET_SIZE = 76; // sync + group + field mask + 70 byte payload + crc
+
+    // Byte offsets of each field from the sync byte
+    constexpr static int BIN_OFFSET_TIME_STARTUP = 4;
+    constexpr static int BIN_OFFSET_QUATERNION = 12; // x, y, z, w
+    constexpr static int BIN_OFFSET_ANGULAR_RATE = 28;
+    constexpr static int BIN_OFFSET_ACCEL = 40;
+    constexpr static int BIN_OFFSET_MAG = 52;
+    constexpr static int BIN_OFFSET_INS_STATUS = 72;
+
+    constexpr static int VN_IMU_RATE_HZ = 800;
+    static_assert(VN_IMU_RATE_HZ % CONFIG_IMU_VN_OUTPUT_RATE_HZ == 0, "VN-300 output rate must divide the 800 Hz IMU rate");
+    constexpr static int BIN_RATE_DIVISOR = VN_IMU_RATE_HZ / CONFIG_IMU_VN_OUTPUT_RATE_HZ;
+#else
+    constexpr static uint32_t UART_BAUD_RATE = DEFAULT_BAUD_RATE;
+    constexpr static int32_t RX_IDLE_TIMEOUT_US = 300; // ~3 character times at 115200 baud
+#endif
 
     constexpr static const device* uart_dev = uart_dt_init;
+    using Rx = UartDmaRx<uart_dt_init, DMA_BUF_SIZE, RING_BUF_SIZE>;
     constexpr static k_sem* ready_sem = ready_sem_ptr;  // Must be static-initialized as the sense thread waits on this
 
     static inline ImuReading reading = ImuReading_init_default;
     static inline float sense_time_ns = 0.0f;
     static inline uint64_t last_reading_cycle = 0;
+    static inline uint32_t sample_counter = 0;
     static inline bool has_reading = false;
 
+    // Samples further apart than this are not integrated across, e.g. after a dropped link
+    constexpr static float MAX_PREINTEGRATION_DT_S = 0.05f;
+
+    // Every sample since the last read(), guarded by reading_mutex
+    static inline ImuPreintegrator preintegrator;
+    static inline uint64_t last_sample_time_ns = 0;
+
+#ifdef CONFIG_IMU_VN_BINARY_OUTPUT
+    // Packet straddling the end of a ring buffer claim, completed on the next claim
+    static inline uint8_t partial_packet[BIN_PACKET_SIZE];
+    static inline int partial_packet_len = 0;
+    static inline uint32_t partial_packet_index = 0;
+    static inline uint32_t crc_error_count = 0;
+#else
+    // Line being assembled across ring buffer claims
+    static inline char rx_line[MAX_LINE_SIZE];
+    static inline int line_len = 0;
+    static inline uint32_t line_index = 0;
+#endif
+
     // Initialized in init()
     static inline k_mutex reading_mutex;
     static inline k_sem data_ready_sem;
-    static inline uint8_t vn_ring_buf_data[RING_BUF_SIZE];
-    static inline ring_buf uart_ringbuf;
-
-    // Interrupt-driven UART callback
-    static void uart_handler(const device*, void*);
+    static inline k_sem sample_ready_sem;
 
     // Send raw bytes over UART (poll mode - only used for configuration commands)
     static void uart_send(const uint8_t* data, size_t len);
+    static void uart_send(const char* cmd);
+
+    // Reconfigure the host side of the link
+    static std::expected<void, Error> set_host_baud(uint32_t baud);
 
     // Send output configuration commands to the VN-300
-    static void configure_outputs();
+    static std::expected<void, Error> configure_outputs();
+
+    // Publish a freshly decoded reading, start_index is the stream index of the frame's first byte
+    static void publish(ImuReading& new_reading, uint32_t start_index);
+
+#ifdef CONFIG_IMU_VN_BINARY_OUTPUT
+    // Consume binary packets from a claimed span
+    static void consume_binary(const uint8_t* data, uint32_t len);
+
+    // VectorNav CRC16-CCITT, runs to zero over a packet including its trailing CRC
+    static uint16_t crc16(const uint8_t* data, int len);
+
+    // Validate and decode a full binary packet starting at its sync byte
+    static bool decode_binary(const uint8_t* packet, uint32_t start_index);
+#else
+    // Consume ASCII lines from a claimed span
+    static void consume_ascii(const uint8_t* data, uint32_t len);
 
     // Dispatch a single null-terminated NMEA-style line to the appropriate parser
-    static std::expected<void, Error> decode_line(char line[MAX_LINE_SIZE]);
+    static std::expected<void, Error> decode_line(char line[MAX_LINE_SIZE], uint32_t start_index);
 
     // Parse a $VNQMR sentence into an ImuReading. Returns true on success.
     static bool parse_vnqmr(const char* line, ImuReading* out);
+#endif
 
 public:
     static std::expected<void, Error> init();
     static void start_sense();
     static std::optional<ImuReading> read();
+    static std::optional<ImuReading> latest();
+    static k_sem* sample_ready();
+
+    // Decode everything received so far. Called from sense(), or from the sensor hub thread when CONFIG_SENSOR_HUB is set.
+    static void service();
+    static k_sem* data_ready();
 
     // Main sense loop thread, do not call directly.
     static void sense();
 };
 
-/// UART interrupt handler
+/// Send bytes over UART using poll mode. Only used during initialization for configuration commands.
 template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
-void Vectornav<kind, uart_dt_init, ready_sem_ptr>::uart_handler(const device*, void*)
+void Vectornav<kind, uart_dt_init, ready_sem_ptr>::uart_send(const uint8_t* data, size_t len)
 {
-    LOG_MODULE_DECLARE(VectornavIMU);
-
-    int err = uart_irq_update(uart_dev);
-    if (err < 0) {
-        LOG_ERR("%s Failed to update UART IRQ state: %s", kind_to_prefix(kind), Error::from_code(err).build_message().c_str());
-        return;
+    for (size_t i = 0; i < len; i++) {
+        uart_poll_out(uart_dev, data[i]);
     }
+}
 
-    while (true) {
-        int is_ready = uart_irq_rx_ready(uart_dev);
-        if (is_ready < 0) {
-            LOG_ERR("%s UART RX ready check failed: %s", kind_to_prefix(kind), Error::from_code(is_ready).build_message().c_str());
-            return;
-        }
-        if (!is_ready) {
-            break;
-        }
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> void Vectornav<kind, uart_dt_init, ready_sem_ptr>::uart_send(const char* cmd)
+{
+    uart_send(reinterpret_cast<const uint8_t*>(cmd), strlen(cmd));
+    k_msleep(100);
+}
 
-        uint8_t byte;
-        int bytes_read = uart_fifo_read(uart_dev, &byte, 1);
-        if (bytes_read < 0) {
-            LOG_ERR("%s Failed to read from UART FIFO: %s", kind_to_prefix(kind), Error::from_code(bytes_read).build_message().c_str());
-            return;
-        }
-        if (bytes_read == 0) {
-            break;
-        }
-        if (ring_buf_put(&uart_ringbuf, &byte, 1) == 0) {
-            LOG_WRN("%s Ring buffer full, byte dropped: 0x%02x", kind_to_prefix(kind), byte);
-        }
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
+std::expected<void, Error> Vectornav<kind, uart_dt_init, ready_sem_ptr>::set_host_baud(uint32_t baud)
+{
+    struct uart_config cfg = {
+        .baudrate = baud,
+        .parity = UART_CFG_PARITY_NONE,
+        .stop_bits = UART_CFG_STOP_BITS_1,
+        .data_bits = UART_CFG_DATA_BITS_8,
+        .flow_ctrl = UART_CFG_FLOW_CTRL_NONE,
+    };
+
+    int err = uart_configure(uart_dev, &cfg);
+    if (err) {
+        return std::unexpected(Error::from_code(err).context("%s Failed to configure UART for %u baud", kind_to_prefix(kind), baud));
     }
-    k_sem_give(&data_ready_sem);
+    return {};
 }
 
-/// Send bytes over UART using poll mode. Only used during initialization for configuration commands.
+#ifdef CONFIG_IMU_VN_BINARY_OUTPUT
+
+/// Switch the VN-300 to binary output on a faster link. Register writes are volatile, so a power-cycled sensor is
+/// back at 115200 while one that survived an MCU reset is still at the fast rate; ASCII output is turned off at both.
+/// Binary output is only enabled once both ends are at the fast rate, as 115200 cannot carry it.
 template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
-void Vectornav<kind, uart_dt_init, ready_sem_ptr>::uart_send(const uint8_t* data, size_t len)
+std::expected<void, Error> Vectornav<kind, uart_dt_init, ready_sem_ptr>::configure_outputs()
 {
-    for (size_t i = 0; i < len; i++) {
-        uart_poll_out(uart_dev, data[i]);
+    LOG_MODULE_DECLARE(VectornavIMU);
+
+    MaxLengthString<48> binary_cmd{"$VNWRG,75,3,%d,%02X,%04X*XX\r\n", BIN_RATE_DIVISOR, BIN_GROUPS, BIN_COMMON_FIELDS};
+    MaxLengthString<32> baud_cmd{"$VNWRG,05,%u*XX\r\n", UART_BAUD_RATE};
+    const char* ascii_off_cmd = "$VNWRG,06,0*XX\r\n";
+
+    auto result = set_host_baud(DEFAULT_BAUD_RATE);
+    if (!result) {
+        return result;
+    }
+    uart_send(ascii_off_cmd);
+    uart_send(baud_cmd.c_str());
+
+    result = set_host_baud(UART_BAUD_RATE);
+    if (!result) {
+        return result;
     }
+    uart_send(ascii_off_cmd);
+    uart_send(binary_cmd.c_str());
+
+    LOG_INF("%s Binary output configured at %d Hz, %u baud", kind_to_prefix(kind), CONFIG_IMU_VN_OUTPUT_RATE_HZ, UART_BAUD_RATE);
+    return {};
 }
 
+#else
+
 /// Send NMEA configuration commands to enable YPR, IMU, GPS, INS, and magnetometer outputs.
-template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> void Vectornav<kind, uart_dt_init, ready_sem_ptr>::configure_outputs()
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
+std::expected<void, Error> Vectornav<kind, uart_dt_init, ready_sem_ptr>::configure_outputs()
 {
     LOG_MODULE_DECLARE(VectornavIMU);
-    const char* type_cmd = "$VNWRG,06,08*XX\r\n";  // VNQMR: quat, mag, accel, gyro
-    const char* rate_cmd = "$VNWRG,07,40*XX\r\n";  // 40 Hz
 
-    uart_send((const uint8_t*)type_cmd, strlen(type_cmd));
-    k_msleep(100);
-    uart_send((const uint8_t*)rate_cmd, strlen(rate_cmd));
-    k_msleep(100);
+    auto result = set_host_baud(UART_BAUD_RATE);
+    if (!result) {
+        return result;
+    }
+    uart_send("$VNWRG,06,08*XX\r\n"); // VNQMR: quat, mag, accel, gyro
+    uart_send("$VNWRG,07,40*XX\r\n"); // 40 Hz
 
     LOG_INF("%s Outputs configured", kind_to_prefix(kind));
+    return {};
 }
 
+#endif
+
 template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
-std::expected<void, Error> Vectornav<kind, uart_dt_init, ready_sem_ptr>::decode_line(char line[MAX_LINE_SIZE])
+void Vectornav<kind, uart_dt_init, ready_sem_ptr>::publish(ImuReading& new_reading, uint32_t start_index)
 {
-    LOG_MODULE_DECLARE(VectornavIMU);
-    LOG_INF("%s rx: %.12s", kind_to_prefix(kind), line);
-    ImuReading new_reading = ImuReading_init_default;
-    if (parse_vnqmr(line, &new_reading)) {
+    new_reading.capture_time_ns = k_cyc_to_ns_floor64(Rx::capture_cycle(start_index));
+
+    {
         MutexGuard guard{&reading_mutex};
         uint64_t curr_cycle = k_cycle_get_64();
         sense_time_ns = static_cast<float>(curr_cycle - last_reading_cycle) / sys_clock_hw_cycles_per_sec() * 1e9f;
         last_reading_cycle = curr_cycle;
+        sample_counter++;
+        new_reading.sample_counter = sample_counter;
         reading = new_reading;
         has_reading = true;
+
+        // Sample period from the VN-300 clock when it is output, else from arrival times
+        uint64_t sample_time_ns = new_reading.has_vn_time_startup_ns ? new_reading.vn_time_startup_ns : new_reading.capture_time_ns;
+        if (last_sample_time_ns != 0 && sample_time_ns > last_sample_time_ns) {
+            float dt = static_cast<float>(sample_time_ns - last_sample_time_ns) * 1e-9f;
+            if (dt <= MAX_PREINTEGRATION_DT_S) {
+                preintegrator.add(
+                    {{new_reading.gyro_x, new_reading.gyro_y, new_reading.gyro_z}},
+                    {{new_reading.accel_x, new_reading.accel_y, new_reading.accel_z}},
+                    dt);
+            }
+        }
+        last_sample_time_ns = sample_time_ns;
     }
-    return {};
+    k_sem_give(&sample_ready_sem);
 }
 
-/// Continuously accumulates sensor readings from the VN-300 over UART. Runs in dedicated thread.
-template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> void Vectornav<kind, uart_dt_init, ready_sem_ptr>::sense()
+#ifdef CONFIG_IMU_VN_BINARY_OUTPUT
+
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
+uint16_t Vectornav<kind, uart_dt_init, ready_sem_ptr>::crc16(const uint8_t* data, int len)
 {
-    LOG_MODULE_DECLARE(VectornavIMU);
+    uint16_t crc = 0;
+    for (int i = 0; i < len; i++) {
+        crc = static_cast<uint16_t>((crc >> 8) | (crc << 8));
+        crc ^= data[i];
+        crc ^= static_cast<uint8_t>(crc & 0xFF) >> 4;
+        crc ^= static_cast<uint16_t>(crc << 12);
+        crc ^= static_cast<uint16_t>((crc & 0x00FF) << 5);
+    }
+    return crc;
+}
 
-    // Await initialization
-    k_sem_take(ready_sem, K_FOREVER);
-    LOG_INF("%s Sense loop initiated", kind_to_prefix(kind));
+/// Decode a binary packet in place. Fields sit at fixed offsets because the output group is fixed at configuration time.
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
+bool Vectornav<kind, uart_dt_init, ready_sem_ptr>::decode_binary(const uint8_t* packet, uint32_t start_index)
+{
+    if (packet[1] != BIN_GROUPS || packet[2] != (BIN_COMMON_FIELDS & 0xFF) || packet[3] != (BIN_COMMON_FIELDS >> 8)) {
+        return false;
+    }
+    if (crc16(packet + 1, BIN_PACKET_SIZE - 1) != 0) {
+        crc_error_count++;
+        return false;
+    }
 
-    char line[MAX_LINE_SIZE];
-    int i = 0;
+    auto f4 = [packet](int offset) {
+        float v;
+        memcpy(&v, packet + offset, sizeof(v));
+        return v;
+    };
 
-    while (1) {
-        k_sem_take(&data_ready_sem, K_FOREVER);
+    ImuReading new_reading = ImuReading_init_default;
+    uint64_t time_startup_ns;
+    memcpy(&time_startup_ns, packet + BIN_OFFSET_TIME_STARTUP, sizeof(time_startup_ns));
+    new_reading.has_vn_time_startup_ns = true;
+    new_reading.vn_time_startup_ns = time_startup_ns;
 
-        uint8_t byte;
-        while (ring_buf_get(&uart_ringbuf, &byte, 1) > 0) {
-            if (i == 0 && byte != '$') {
-                continue;
+    new_reading.quat_x = f4(BIN_OFFSET_QUATERNION + 0);
+    new_reading.quat_y = f4(BIN_OFFSET_QUATERNION + 4);
+    new_reading.quat_z = f4(BIN_OFFSET_QUATERNION + 8);
+    new_reading.quat_w = f4(BIN_OFFSET_QUATERNION + 12);
+
+    new_reading.gyro_x = f4(BIN_OFFSET_ANGULAR_RATE + 0);
+    new_reading.gyro_y = f4(BIN_OFFSET_ANGULAR_RATE + 4);
+    new_reading.gyro_z = f4(BIN_OFFSET_ANGULAR_RATE + 8);
+
+    new_reading.accel_x = f4(BIN_OFFSET_ACCEL + 0);
+    new_reading.accel_y = f4(BIN_OFFSET_ACCEL + 4);
+    new_reading.accel_z = f4(BIN_OFFSET_ACCEL + 8);
+
+    new_reading.mag_x = f4(BIN_OFFSET_MAG + 0);
+    new_reading.mag_y = f4(BIN_OFFSET_MAG + 4);
+    new_reading.mag_z = f4(BIN_OFFSET_MAG + 8);
+
+    new_reading.has_ins_status = true;
+    new_reading.ins_status = packet[BIN_OFFSET_INS_STATUS] | (packet[BIN_OFFSET_INS_STATUS + 1] << 8);
+
+    new_reading.has_crc_error_count = true;
+    new_reading.crc_error_count = crc_error_count;
+
+    publish(new_reading, start_index);
+    return true;
+}
+
+/// Whole packets are decoded directly from the claimed span; only a packet split across the buffer wrap is copied.
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
+void Vectornav<kind, uart_dt_init, ready_sem_ptr>::consume_binary(const uint8_t* data, uint32_t len)
+{
+    uint32_t pos = 0;
+    while (pos < len) {
+        if (partial_packet_len == 0) {
+            const uint8_t* sync = static_cast<const uint8_t*>(memchr(data + pos, BIN_SYNC, len - pos));
+            if (sync == nullptr) {
+                return;
             }
-            if (byte == '\r') {
+            pos = sync - data;
+
+            if (len - pos >= BIN_PACKET_SIZE) {
+                // On a bad packet only skip the sync byte, the real sync may be inside it
+                pos += decode_binary(data + pos, Rx::stream_index(pos)) ? BIN_PACKET_SIZE : 1;
                 continue;
             }
-            if (byte == '\n') {
-                if (i > 0) {
-                    line[i] = '\0';
+        }
 
-                    decode_line(line);
+        if (partial_packet_len == 0) {
+            partial_packet_index = Rx::stream_index(pos);
+        }
+        uint32_t copy_len = MIN(static_cast<uint32_t>(BIN_PACKET_SIZE - partial_packet_len), len - pos);
+        memcpy(partial_packet + partial_packet_len, data + pos, copy_len);
+        partial_packet_len += copy_len;
+        pos += copy_len;
+
+        if (partial_packet_len == BIN_PACKET_SIZE) {
+            partial_packet_len = 0;
+            if (!decode_binary(partial_packet, partial_packet_index)) {
+                // Rescan the rejected packet for a later sync byte
+                const uint8_t* sync = static_cast<const uint8_t*>(memchr(partial_packet + 1, BIN_SYNC, BIN_PACKET_SIZE - 1));
+                if (sync != nullptr) {
+                    partial_packet_len = partial_packet + BIN_PACKET_SIZE - sync;
+                    partial_packet_index += sync - partial_packet;
+                    memmove(partial_packet, sync, partial_packet_len);
                 }
-                i = 0;
-                continue;
             }
-            if (i < MAX_LINE_SIZE - 1) {
-                line[i++] = static_cast<char>(byte);
+        }
+    }
+}
+
+#else
+
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
+std::expected<void, Error> Vectornav<kind, uart_dt_init, ready_sem_ptr>::decode_line(char line[MAX_LINE_SIZE], uint32_t start_index)
+{
+    LOG_MODULE_DECLARE(VectornavIMU);
+    LOG_DBG("%s rx: %.12s", kind_to_prefix(kind), line);
+    ImuReading new_reading = ImuReading_init_default;
+    if (parse_vnqmr(line, &new_reading)) {
+        publish(new_reading, start_index);
+    }
+    return {};
+}
+
+/// Lines are located with memchr and copied out of the claimed span in bulk rather than byte by byte.
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
+void Vectornav<kind, uart_dt_init, ready_sem_ptr>::consume_ascii(const uint8_t* data, uint32_t len)
+{
+    uint32_t pos = 0;
+    while (pos < len) {
+        if (line_len == 0) {
+            const uint8_t* start = static_cast<const uint8_t*>(memchr(data + pos, '$', len - pos));
+            if (start == nullptr) {
+                return;
             }
+            pos = start - data;
+            line_index = Rx::stream_index(pos);
+        }
+
+        const uint8_t* newline = static_cast<const uint8_t*>(memchr(data + pos, '\n', len - pos));
+        uint32_t chunk_end = newline != nullptr ? newline - data : len;
+
+        // Overlong lines are truncated, matching the previous byte-wise behaviour
+        uint32_t copy_len = MIN(chunk_end - pos, static_cast<uint32_t>(MAX_LINE_SIZE - 1 - line_len));
+        memcpy(rx_line + line_len, data + pos, copy_len);
+        line_len += copy_len;
+        pos = chunk_end;
+
+        if (newline != nullptr) {
+            if (line_len > 0 && rx_line[line_len - 1] == '\r') {
+                line_len--;
+            }
+            rx_line[line_len] = '\0';
+            decode_line(rx_line, line_index);
+            line_len = 0;
+            pos++;
         }
     }
 }
@@ -250,7 +485,40 @@ bool Vectornav<kind, uart_dt_init, ready_sem_ptr>::parse_vnqmr(const char* line,
     return true;
 }
 
-/// Initialize VN-300: set up ring buffer, configure UART, attach IRQ, send output config commands.
+#endif // CONFIG_IMU_VN_BINARY_OUTPUT
+
+/// Consume everything currently in the receive ring buffer, parsing in place from each claimed span.
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> void Vectornav<kind, uart_dt_init, ready_sem_ptr>::service()
+{
+    uint8_t* data;
+    uint32_t len;
+
+    while ((len = Rx::claim(&data)) > 0) {
+#ifdef CONFIG_IMU_VN_BINARY_OUTPUT
+        consume_binary(data, len);
+#else
+        consume_ascii(data, len);
+#endif
+        Rx::finish(len);
+    }
+}
+
+/// Continuously accumulates sensor readings from the VN-300 over UART. Runs in dedicated thread.
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> void Vectornav<kind, uart_dt_init, ready_sem_ptr>::sense()
+{
+    LOG_MODULE_DECLARE(VectornavIMU);
+
+    // Await initialization
+    k_sem_take(ready_sem, K_FOREVER);
+    LOG_INF("%s Sense loop initiated", kind_to_prefix(kind));
+
+    while (1) {
+        k_sem_take(&data_ready_sem, K_FOREVER);
+        service();
+    }
+}
+
+/// Initialize VN-300: configure UART, send output config commands, start DMA reception.
 template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> std::expected<void, Error> Vectornav<kind, uart_dt_init, ready_sem_ptr>::init()
 {
     LOG_MODULE_DECLARE(VectornavIMU);
@@ -259,38 +527,33 @@ template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
 
     k_mutex_init(&reading_mutex);
     k_sem_init(&data_ready_sem, 0, 1);
-    ring_buf_init(&uart_ringbuf, RING_BUF_SIZE, vn_ring_buf_data);
+    k_sem_init(&sample_ready_sem, 0, 1);
+    preintegrator.reset();
+    last_sample_time_ns = 0;
+#ifdef CONFIG_IMU_VN_BINARY_OUTPUT
+    partial_packet_len = 0;
+    crc_error_count = 0;
+#else
+    line_len = 0;
+#endif
 
     LOG_INF("%s Checking UART readiness", kind_to_prefix(kind));
     if (!device_is_ready(uart_dev)) {
         return std::unexpected(Error::from_device_not_ready(uart_dev).context("%s UART is not ready", kind_to_prefix(kind)));
     }
 
-    struct uart_config cfg = {
-        .baudrate = UART_BAUD_RATE,
-        .parity = UART_CFG_PARITY_NONE,
-        .stop_bits = UART_CFG_STOP_BITS_1,
-        .data_bits = UART_CFG_DATA_BITS_8,
-        .flow_ctrl = UART_CFG_FLOW_CTRL_NONE,
-    };
-
-    LOG_INF("%s Configuring UART", kind_to_prefix(kind));
-    int err = uart_configure(uart_dev, &cfg);
-    if (err) {
-        return std::unexpected(Error::from_code(err).context("%s Failed to configure UART", kind_to_prefix(kind)));
+    LOG_INF("%s Configuring outputs", kind_to_prefix(kind));
+    auto config_result = configure_outputs();
+    if (!config_result) {
+        return std::unexpected(config_result.error().context("%s Failed to configure outputs", kind_to_prefix(kind)));
     }
 
-    configure_outputs();
-
-    LOG_INF("%s Setting UART IRQ", kind_to_prefix(kind));
-    err = uart_irq_callback_user_data_set(uart_dev, uart_handler, nullptr);
-    if (err) {
-        return std::unexpected(Error::from_code(err).context("%s Failed to attach UART interrupt handler", kind_to_prefix(kind)));
+    LOG_INF("%s Starting UART DMA reception", kind_to_prefix(kind));
+    auto rx_result = Rx::init(&data_ready_sem, RX_IDLE_TIMEOUT_US);
+    if (!rx_result) {
+        return std::unexpected(rx_result.error().context("%s Failed to start UART reception", kind_to_prefix(kind)));
     }
 
-    LOG_INF("%s Enabling UART RX interrupt", kind_to_prefix(kind));
-    uart_irq_rx_enable(uart_dev);
-
     LOG_INF("%s Initialized", kind_to_prefix(kind));
 
     return {};
@@ -301,7 +564,14 @@ template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
     k_sem_give(ready_sem);
 }
 
-/// Returns the latest accumulated sensor reading and the YMR cycle time in nanoseconds, if available.
+/// Semaphore given whenever received data is waiting to be serviced.
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> k_sem* Vectornav<kind, uart_dt_init, ready_sem_ptr>::data_ready()
+{
+    return &data_ready_sem;
+}
+
+/// Returns the latest accumulated sensor reading and the YMR cycle time in nanoseconds, if available, along with every
+/// sample since the previous read() integrated into delta-angle and delta-velocity increments.
 template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> std::optional<ImuReading> Vectornav<kind, uart_dt_init, ready_sem_ptr>::read()
 {
     MutexGuard guard{&reading_mutex};
@@ -313,10 +583,40 @@ template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr>
     // Consume reading
     has_reading = false;
 
+    reading.sense_time_ns = sense_time_ns;
+    ImuReading out = reading;
+    out.has_delta_angle_rad = true;
+    out.delta_angle_rad = math_util::toVector3D(preintegrator.delta_angle());
+    out.has_delta_velocity_m_s = true;
+    out.delta_velocity_m_s = math_util::toVector3D(preintegrator.delta_velocity());
+    out.has_delta_time_s = true;
+    out.delta_time_s = preintegrator.delta_time();
+    out.has_integrated_sample_count = true;
+    out.integrated_sample_count = preintegrator.sample_count();
+    preintegrator.reset();
+    return {out};
+}
+
+/// Returns the newest reading without consuming it or its integrated increments, for readers that track sample counters
+/// themselves.
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> std::optional<ImuReading> Vectornav<kind, uart_dt_init, ready_sem_ptr>::latest()
+{
+    MutexGuard guard{&reading_mutex};
+
+    if (sample_counter == 0) {
+        return std::nullopt;
+    }
+
     reading.sense_time_ns = sense_time_ns;
     return {reading};
 }
 
+/// Semaphore given whenever a new reading is published.
+template <VectornavKind kind, const device* uart_dt_init, k_sem* ready_sem_ptr> k_sem* Vectornav<kind, uart_dt_init, ready_sem_ptr>::sample_ready()
+{
+    return &sample_ready_sem;
+}
+
 extern k_sem vectornav_ready_sem;
 
 typedef Vectornav<VectornavKind::VECTORNAV, DEVICE_DT_GET(DT_ALIAS(imu_uart)), &vectornav_ready_sem> VectornavImu;
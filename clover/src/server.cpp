@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <climits>
 #include <cstdint>
 #include <pb_decode.h>
 #include <pb_encode.h>
+#include <span>
 #include <sstream>
 #include <string>
 #include <zephyr/logging/log.h>
@@ -30,25 +32,48 @@ static_assert(Request_size <= MAX_MESSAGE_SIZE);
 static_assert(Response_size <= MAX_MESSAGE_SIZE);
 
 /// Max number of connected clients.
-#define MAX_OPEN_CLIENTS 3
-
-/// Main server thread must acquire one of these before accepting a connection. It must then scan through the thread
-/// array to find an open slot.
-K_SEM_DEFINE(num_open_connections, MAX_OPEN_CLIENTS, MAX_OPEN_CLIENTS);
-
-bool has_thread[MAX_OPEN_CLIENTS] = {false};
-K_MUTEX_DEFINE(has_thread_lock);
-
-static k_thread client_threads[MAX_OPEN_CLIENTS] = {nullptr};
-#define CONNECTION_THREAD_STACK_SIZE (6 * 1024)
-K_THREAD_STACK_ARRAY_DEFINE(client_stacks, MAX_OPEN_CLIENTS, CONNECTION_THREAD_STACK_SIZE);
-
-constexpr int MAX_THREAD_NAME_LENGTH = 10;
-static std::array<std::string, MAX_OPEN_CLIENTS> thread_names;
-K_MUTEX_DEFINE(thread_info_lock);
+constexpr int MAX_OPEN_CLIENTS = CONFIG_COMMAND_SERVER_MAX_CLIENTS;
+static_assert(CONFIG_ZVFS_POLL_MAX >= MAX_OPEN_CLIENTS + 1, "The command server polls every client and its listen socket at once");
+
+/// Longest varint length prefix of a request, and longest request with its prefix.
+constexpr size_t MAX_LENGTH_PREFIX_SIZE = 5;
+constexpr size_t MAX_REQUEST_FRAME_SIZE = MAX_LENGTH_PREFIX_SIZE + Request_size;
+
+/// Longest a client may take to send the rest of a request once it has started sending it.
+constexpr int64_t REQUEST_TIMEOUT_MS = CONFIG_COMMAND_SERVER_REQUEST_TIMEOUT_MS;
+
+/// A connected command client. Its requests are received into a buffer, reading exactly the rest of each request once
+/// its length prefix is in, and decoded from memory once whole. Responses are sent without blocking, and a client that
+/// stalls partway through a request or stops reading its responses is disconnected, so one slow client never holds up
+/// the others for long. Only touched by the command server thread.
+struct Connection {
+    int sock = -1;
+    /// Bytes received but not yet decoded, in rx_buf or in large_frame_buf if this connection owns it.
+    size_t rx_len = 0;
+    /// Size of the request being received with its length prefix, and of the prefix. 0 until the prefix is in.
+    size_t frame_size = 0;
+    size_t prefix_size = 0;
+    /// Waiting on large_frame_buf for a request longer than rx_buf, with its socket left unread until then.
+    bool wants_large_frame_buf = false;
+    /// When the rest of the buffered request must be in by, while rx_len is not 0. Not counted while waiting on
+    /// large_frame_buf.
+    int64_t request_deadline_ms = 0;
+    std::array<uint8_t, CONFIG_COMMAND_SERVER_CONNECTION_BUFFER_SIZE> rx_buf = {};
+};
+
+static std::array<Connection, MAX_OPEN_CLIENTS> connections;
+
+/// Requests longer than a connection's own buffer, such as sequence loads, are received here by one connection at a
+/// time. They are rare enough that sizing every connection's buffer for them would waste most of it.
+static std::array<uint8_t, MAX_REQUEST_FRAME_SIZE> large_frame_buf;
+static int large_frame_buf_owner = -1;
+
+/// Decoded in place and encoded whole before sending, as the command server only ever handles one request at a time.
+static Request decoded_request;
+static std::array<uint8_t, MAX_LENGTH_PREFIX_SIZE + Response_size> response_buf;
 
 /// Tracks when DAQ last pinged (AKA, ID'd itself)
-static int daq_thread_index = -1;
+static int daq_connection_index = -1;
 static int64_t daq_last_pinged_ms = 0;
 K_MUTEX_DEFINE(daq_status_lock);
 
@@ -62,69 +87,12 @@ K_MUTEX_DEFINE(data_client_info_lock);
 /// done (i.e., when serve_connections() is called).
 K_SEM_DEFINE(allow_serve_connections_sem, 0, 2);
 
-/// Internal callback for pb_istream, used to read from socket to internal buffer and manage count.
-bool pb_socket_write_callback(pb_ostream_t* stream, const uint8_t* buf, size_t count)
-{
-    int sock = reinterpret_cast<int>(stream->state);
-
-    int bytes_sent = zsock_send(sock, buf, count, 0);
-    if (bytes_sent < 0) {
-        LOG_ERR("Error while sending data over socket %d: %s", sock, strerror(bytes_sent));
-        return false;
-    }
-
-    if (bytes_sent != static_cast<int>(count)) {
-        LOG_ERR("zsock_send only partially wrote its buffer from socket %d, this should be impossible - sent: %d, requested: %d", sock, bytes_sent, count);
-        return false;
-    }
-
-    return true;
-}
-
-pb_ostream_t pb_ostream_from_socket(int sock)
-{
-    return pb_ostream_t{.callback = pb_socket_write_callback, .state = reinterpret_cast<void*>(sock), .max_size = SIZE_MAX, .bytes_written = 0};
-}
-
-/// Internal callback for pb_istream, used to read from socket to internal buffer.
-bool pb_socket_read_callback(pb_istream_t* stream, uint8_t* buf, size_t count)
-{
-    int sock = reinterpret_cast<int>(stream->state);
-
-    int bytes_read = zsock_recv(sock, buf, count, ZSOCK_MSG_WAITALL);
-
-    // Hit EOF
-    if (bytes_read == 0) {
-        stream->bytes_left = 0;
-        return false;
-    }
-
-    if (bytes_read != static_cast<int>(count)) {
-        LOG_ERR(
-            "zsock_recv only partially filled its buffer from sock %d, this should be impossible as we pass ZSOCK_MSG_WAITALL - got: %d, requested: %d - errno "
-            "%d",
-            sock,
-            bytes_read,
-            count,
-            errno);
-        return false;
-    }
-
-    return true;
-}
-
-/// Create a nanopb input stream from socket fd.
-pb_istream_t pb_istream_from_socket(int sock)
-{
-    return pb_istream_t{.callback = pb_socket_read_callback, .state = reinterpret_cast<void*>(sock), .bytes_left = SIZE_MAX};
-}
-
-static std::expected<void, Error> handle_identify_client(const IdentifyClientRequest& req, int thread_index)
+static std::expected<void, Error> handle_identify_client(const IdentifyClientRequest& req, int connection_index)
 {
     switch (req.client) {
     case ClientType_DAQ: {
         MutexGuard daq_status_guard{&daq_status_lock};
-        daq_thread_index = thread_index;
+        daq_connection_index = connection_index;
         daq_last_pinged_ms = k_uptime_get();
         return {};
     }
@@ -140,325 +108,524 @@ static std::expected<void, Error> handle_identify_client(const IdentifyClientReq
 daq_client_status get_daq_client_status()
 {
     MutexGuard daq_status_guard{&daq_status_lock};
-    return daq_client_status{.connected = daq_thread_index != -1, .last_pinged_ms = daq_thread_index != -1 ? k_uptime_get() - daq_last_pinged_ms : 0};
+    return daq_client_status{.connected = daq_connection_index != -1, .last_pinged_ms = daq_connection_index != -1 ? k_uptime_get() - daq_last_pinged_ms : 0};
 }
 
-/// Handles a client connection. Should run in its own thread.
-static void handle_client(void* p1_thread_index, void* p2_client_socket, void*)
+/// Runs a decoded request from the client in the given connection slot.
+static std::expected<void, Error> handle_request(const Request& request, int connection_index, int sock)
 {
-    int thread_index = reinterpret_cast<int>(p1_thread_index);
-    int client_socket = reinterpret_cast<int>(p2_client_socket);
-    LOG_INF("Handling socket: %d", client_socket);
-
-    pb_istream_t pb_input = pb_istream_from_socket(client_socket);
-    pb_ostream_t pb_output = pb_ostream_from_socket(client_socket);
-
-    while (true) {
-        Request request = Request_init_default;
-        bool valid = pb_decode_ex(&pb_input, Request_fields, &request, PB_DECODE_DELIMITED);
-        if (!valid) {
-            LOG_ERR("Failed to decode next message: errno=%d pb_err='%s'", errno, PB_GET_ERROR(&pb_input));
-            break;
-        }
-
-        std::expected<void, Error> cmd_result = {};
-
-        // Handle request
-        switch (request.which_payload) {
-        case Request_subscribe_data_stream_tag: {
-            LOG_INF("Subscribe data stream");
-            MutexGuard daq_status_guard{&data_client_info_lock};
-
-            bool found_data_client_slot = false;
-            for (int i = 0; i < MAX_DATA_CLIENTS; ++i) {
-                if (data_client_slot_indexes[i] != -1) {
-                    continue;
-                }
-                found_data_client_slot = true;
-                data_client_slot_indexes[i] = thread_index;
+    std::expected<void, Error> cmd_result = {};
 
-                int err = getpeername(client_socket, &data_client_addrs[i], &data_client_addr_lens[i]);
-                if (err) {
-                    LOG_ERR("Failed to get peername when subscribing to data stream: err %d", err);
-                }
+    switch (request.which_payload) {
+    case Request_subscribe_data_stream_tag: {
+        LOG_INF("Subscribe data stream");
+        MutexGuard daq_status_guard{&data_client_info_lock};
 
-                // Set client port
-                reinterpret_cast<sockaddr_in*>(&data_client_addrs[i])->sin_port = htons(19691);
-
-                break;
+        bool found_data_client_slot = false;
+        for (int i = 0; i < MAX_DATA_CLIENTS; ++i) {
+            if (data_client_slot_indexes[i] != -1) {
+                continue;
             }
+            found_data_client_slot = true;
+            data_client_slot_indexes[i] = connection_index;
 
-            if (!found_data_client_slot) {
-                LOG_ERR("Did not find a data client slot");
+            int err = getpeername(sock, &data_client_addrs[i], &data_client_addr_lens[i]);
+            if (err) {
+                LOG_ERR("Failed to get peername when subscribing to data stream: err %d", err);
             }
 
+            // Set client port
+            reinterpret_cast<sockaddr_in*>(&data_client_addrs[i])->sin_port = htons(19691);
+
             break;
         }
-        case Request_identify_client_tag: {
-            LOG_INF("Identify client");
-            cmd_result = handle_identify_client(request.payload.identify_client, thread_index);
-            break;
+
+        if (!found_data_client_slot) {
+            LOG_ERR("Did not find a data client slot");
         }
 
-        // Provided by AnalogSensors
-        case Request_configure_analog_sensors_tag: {
-            LOG_INF("Configure analog sensors");
+        break;
+    }
+    case Request_identify_client_tag: {
+        LOG_INF("Identify client");
+        cmd_result = handle_identify_client(request.payload.identify_client, connection_index);
+        break;
+    }
+
+    // Provided by AnalogSensors
+    case Request_configure_analog_sensors_tag: {
+        LOG_INF("Configure analog sensors");
 #ifdef CONFIG_ANALOG_SENSORS
-            cmd_result = AnalogSensors::handle_configure_analog_sensors(request.payload.configure_analog_sensors);
+        cmd_result = AnalogSensors::handle_configure_analog_sensors(request.payload.configure_analog_sensors);
 #else
-            cmd_result = std::unexpected(ERROR_FROM_KCONFIG(CONFIG_ANALOG_SENSORS));
+        cmd_result = std::unexpected(ERROR_FROM_KCONFIG(CONFIG_ANALOG_SENSORS));
 #endif  // CONFIG_ANALOG_SENSORS
-            break;
-        }
+        break;
+    }
 
-        // Provided by Valves
-        case Request_configure_valves_request_tag: {
-            LOG_INF("configure_valves_request");
+    // Provided by Valves
+    case Request_configure_valves_request_tag: {
+        LOG_INF("configure_valves_request");
 #ifdef CONFIG_VALVES
-            cmd_result = Valves::handle_configure_valves_request(request.payload.configure_valves_request);
+        cmd_result = Valves::handle_configure_valves_request(request.payload.configure_valves_request);
 #else
-            cmd_result = std::unexpected(ERROR_FROM_KCONFIG(CONFIG_VALVES));
+        cmd_result = std::unexpected(ERROR_FROM_KCONFIG(CONFIG_VALVES));
 #endif  // CONFIG_VALVES
-            break;
-        }
+        break;
+    }
 
-        case Request_actuate_valve_request_tag: {
-            LOG_INF("actuate_valve_request");
+    case Request_actuate_valve_request_tag: {
+        LOG_INF("actuate_valve_request");
 #ifdef CONFIG_VALVES
-            cmd_result = Valves::handle_actuate_valve_request(request.payload.actuate_valve_request);
+        cmd_result = Valves::handle_actuate_valve_request(request.payload.actuate_valve_request);
 #else
-            cmd_result = std::unexpected(ERROR_FROM_KCONFIG(CONFIG_VALVES));
+        cmd_result = std::unexpected(ERROR_FROM_KCONFIG(CONFIG_VALVES));
 #endif  // CONFIG_VALVES
-            break;
-        }
+        break;
+    }
 
-        case Request_throttle_reset_valve_position_tag: {
-            cmd_result = Controller::handle_throttle_reset_valve_position(request.payload.throttle_reset_valve_position);
-            break;
-        }
+    case Request_throttle_reset_valve_position_tag: {
+        cmd_result = Controller::handle_throttle_reset_valve_position(request.payload.throttle_reset_valve_position);
+        break;
+    }
 
-        case Request_abort_tag: {
-            LOG_INF("abort command");
-            cmd_result = Controller::handle_abort(request.payload.abort);
-            break;
-        }
+    case Request_abort_tag: {
+        LOG_INF("abort command");
+        cmd_result = Controller::handle_abort(request.payload.abort);
+        break;
+    }
 
-        case Request_halt_tag: {
-            LOG_INF("halt command");
-            cmd_result = Controller::handle_halt(request.payload.halt);
-            break;
-        }
+    case Request_halt_tag: {
+        LOG_INF("halt command");
+        cmd_result = Controller::handle_halt(request.payload.halt);
+        break;
+    }
 
-        case Request_unprime_tag: {
-            LOG_INF("unprime command");
-            cmd_result = Controller::handle_unprime(request.payload.unprime);
-            break;
-        }
+    case Request_unprime_tag: {
+        LOG_INF("unprime command");
+        cmd_result = Controller::handle_unprime(request.payload.unprime);
+        break;
+    }
 
-        case Request_calibrate_throttle_valve_tag: {
-            LOG_INF("calibrate_throttle_valve command");
-            cmd_result = Controller::handle_calibrate_throttle_valve(request.payload.calibrate_throttle_valve);
-            break;
-        }
+    case Request_calibrate_throttle_valve_tag: {
+        LOG_INF("calibrate_throttle_valve command");
+        cmd_result = Controller::handle_calibrate_throttle_valve(request.payload.calibrate_throttle_valve);
+        break;
+    }
 
-        case Request_load_throttle_valve_sequence_tag: {
-            LOG_INF("load_throttle_valve_sequence command");
-            cmd_result = Controller::handle_load_throttle_valve_sequence(request.payload.load_throttle_valve_sequence);
-            break;
-        }
+    case Request_load_throttle_valve_sequence_tag: {
+        LOG_INF("load_throttle_valve_sequence command");
+        cmd_result = Controller::handle_load_throttle_valve_sequence(request.payload.load_throttle_valve_sequence);
+        break;
+    }
 
-        case Request_start_throttle_valve_sequence_tag: {
-            LOG_INF("start_throttle_valve_sequence command");
-            cmd_result = Controller::handle_start_throttle_valve_sequence(request.payload.start_throttle_valve_sequence);
-            break;
-        }
+    case Request_start_throttle_valve_sequence_tag: {
+        LOG_INF("start_throttle_valve_sequence command");
+        cmd_result = Controller::handle_start_throttle_valve_sequence(request.payload.start_throttle_valve_sequence);
+        break;
+    }
 
-        case Request_load_throttle_sequence_tag: {
-            LOG_INF("load_throttle_sequence command");
-            cmd_result = Controller::handle_load_throttle_sequence(request.payload.load_throttle_sequence);
-            break;
-        }
+    case Request_load_throttle_sequence_tag: {
+        LOG_INF("load_throttle_sequence command");
+        cmd_result = Controller::handle_load_throttle_sequence(request.payload.load_throttle_sequence);
+        break;
+    }
 
-        case Request_start_throttle_sequence_tag: {
-            LOG_INF("start_throttle_sequence command");
-            cmd_result = Controller::handle_start_throttle_sequence(request.payload.start_throttle_sequence);
-            break;
-        }
+    case Request_start_throttle_sequence_tag: {
+        LOG_INF("start_throttle_sequence command");
+        cmd_result = Controller::handle_start_throttle_sequence(request.payload.start_throttle_sequence);
+        break;
+    }
 
-        case Request_calibrate_tvc_tag: {
-            LOG_INF("calibrate_tvc command");
-            cmd_result = Controller::handle_calibrate_tvc(request.payload.calibrate_tvc);
-            break;
-        }
+    case Request_calibrate_tvc_tag: {
+        LOG_INF("calibrate_tvc command");
+        cmd_result = Controller::handle_calibrate_tvc(request.payload.calibrate_tvc);
+        break;
+    }
 
-        case Request_load_tvc_sequence_tag: {
-            LOG_INF("load_tvc_sequence command");
-            cmd_result = Controller::handle_load_tvc_sequence(request.payload.load_tvc_sequence);
-            break;
-        }
+    case Request_load_tvc_sequence_tag: {
+        LOG_INF("load_tvc_sequence command");
+        cmd_result = Controller::handle_load_tvc_sequence(request.payload.load_tvc_sequence);
+        break;
+    }
 
-        case Request_start_tvc_sequence_tag: {
-            LOG_INF("start_tvc_sequence command");
-            cmd_result = Controller::handle_start_tvc_sequence(request.payload.start_tvc_sequence);
-            break;
-        }
+    case Request_start_tvc_sequence_tag: {
+        LOG_INF("start_tvc_sequence command");
+        cmd_result = Controller::handle_start_tvc_sequence(request.payload.start_tvc_sequence);
+        break;
+    }
 
-        case Request_load_rcs_valve_sequence_tag: {
-            LOG_INF("load_rcs_valve_sequence command");
-            cmd_result = Controller::handle_load_rcs_valve_sequence(request.payload.load_rcs_valve_sequence);
-            break;
-        }
+    case Request_load_rcs_valve_sequence_tag: {
+        LOG_INF("load_rcs_valve_sequence command");
+        cmd_result = Controller::handle_load_rcs_valve_sequence(request.payload.load_rcs_valve_sequence);
+        break;
+    }
 
-        case Request_start_rcs_valve_sequence_tag: {
-            LOG_INF("start_rcs_valve_sequence command");
-            cmd_result = Controller::handle_start_rcs_valve_sequence(request.payload.start_rcs_valve_sequence);
-            break;
-        }
+    case Request_start_rcs_valve_sequence_tag: {
+        LOG_INF("start_rcs_valve_sequence command");
+        cmd_result = Controller::handle_start_rcs_valve_sequence(request.payload.start_rcs_valve_sequence);
+        break;
+    }
 
-        case Request_load_rcs_sequence_tag: {
-            LOG_INF("load_rcs_sequence command");
-            cmd_result = Controller::handle_load_rcs_sequence(request.payload.load_rcs_sequence);
-            break;
-        }
+    case Request_load_rcs_sequence_tag: {
+        LOG_INF("load_rcs_sequence command");
+        cmd_result = Controller::handle_load_rcs_sequence(request.payload.load_rcs_sequence);
+        break;
+    }
 
-        case Request_start_rcs_sequence_tag: {
-            LOG_INF("start_rcs_sequence command");
-            cmd_result = Controller::handle_start_rcs_sequence(request.payload.start_rcs_sequence);
-            break;
-        }
+    case Request_start_rcs_sequence_tag: {
+        LOG_INF("start_rcs_sequence command");
+        cmd_result = Controller::handle_start_rcs_sequence(request.payload.start_rcs_sequence);
+        break;
+    }
 
-        case Request_load_static_fire_sequence_tag: {
-            LOG_INF("load_static_fire_sequence command");
-            cmd_result = Controller::handle_load_static_fire_sequence(request.payload.load_static_fire_sequence);
-            break;
-        }
+    case Request_load_static_fire_sequence_tag: {
+        LOG_INF("load_static_fire_sequence command");
+        cmd_result = Controller::handle_load_static_fire_sequence(request.payload.load_static_fire_sequence);
+        break;
+    }
 
-        case Request_start_static_fire_sequence_tag: {
-            LOG_INF("start_static_fire_sequence command");
-            cmd_result = Controller::handle_start_static_fire_sequence(request.payload.start_static_fire_sequence);
-            break;
-        }
+    case Request_start_static_fire_sequence_tag: {
+        LOG_INF("start_static_fire_sequence command");
+        cmd_result = Controller::handle_start_static_fire_sequence(request.payload.start_static_fire_sequence);
+        break;
+    }
 
-        case Request_load_flight_sequence_tag: {
-            LOG_INF("load_flight_sequence command");
-            cmd_result = Controller::handle_load_flight_sequence(request.payload.load_flight_sequence);
-            break;
-        }
+    case Request_load_flight_sequence_tag: {
+        LOG_INF("load_flight_sequence command");
+        cmd_result = Controller::handle_load_flight_sequence(request.payload.load_flight_sequence);
+        break;
+    }
 
-        case Request_start_flight_sequence_tag: {
-            LOG_INF("start_flight_sequence command");
-            cmd_result = Controller::handle_start_flight_sequence(request.payload.start_flight_sequence);
-            break;
-        }
+    case Request_start_flight_sequence_tag: {
+        LOG_INF("start_flight_sequence command");
+        cmd_result = Controller::handle_start_flight_sequence(request.payload.start_flight_sequence);
+        break;
+    }
 
-        case Request_configure_flight_controller_gains_tag: {
-            LOG_INF("configure_flight_controller_gains command");
+    case Request_configure_flight_controller_gains_tag: {
+        LOG_INF("configure_flight_controller_gains command");
 #ifdef CONFIG_FLIGHT
-            cmd_result = FlightController::handle_configure_gains(request.payload.configure_flight_controller_gains);
+        cmd_result = FlightController::handle_configure_gains(request.payload.configure_flight_controller_gains);
 #else
-            cmd_result = std::unexpected(ERROR_FROM_KCONFIG(CONFIG_FLIGHT));
+        cmd_result = std::unexpected(ERROR_FROM_KCONFIG(CONFIG_FLIGHT));
 #endif  // CONFIG_FLIGHT
-            break;
-        }
+        break;
+    }
 
-        default: {
-            LOG_ERR(
-                "Request has invalid tag, this should be impossible as pb_decode should have produced a valid Request - got tag: %u", request.which_payload);
-            break;
-        }
-        }
+    case Request_load_flight_gain_schedule_tag: {
+        LOG_INF("load_flight_gain_schedule command");
+#ifdef CONFIG_FLIGHT
+        cmd_result = FlightController::handle_load_gain_schedule(request.payload.load_flight_gain_schedule);
+#else
+        cmd_result = std::unexpected(ERROR_FROM_KCONFIG(CONFIG_FLIGHT));
+#endif  // CONFIG_FLIGHT
+        break;
+    }
 
-        Response response = Response_init_default;
+    default: {
+        LOG_ERR(
+            "Request has invalid tag, this should be impossible as pb_decode should have produced a valid Request - got tag: %u", request.which_payload);
+        break;
+    }
+    }
 
-        // Populate error message in response if required.
-        if (!cmd_result.has_value()) {
-            response.has_err = true;
-            MaxLengthString<MAX_ERR_MESSAGE_SIZE> err_msg = cmd_result.error().build_message();
+    return cmd_result;
+}
+
+/// Sends the response to a request without blocking. Returns false if the client is not keeping up with its responses
+/// and should be disconnected.
+static bool respond(int sock, std::expected<void, Error> cmd_result)
+{
+    Response response = Response_init_default;
+
+    // Populate error message in response if required.
+    if (!cmd_result.has_value()) {
+        response.has_err = true;
+        MaxLengthString<MAX_ERR_MESSAGE_SIZE> err_msg = cmd_result.error().build_message();
 
-            err_msg.copy_buf(response.err, sizeof(response.err));
+        err_msg.copy_buf(response.err, sizeof(response.err));
 
-            LOG_ERR("Command failed with error: %s", response.err);
+        LOG_ERR("Command failed with error: %s", response.err);
+    }
+    else {
+        LOG_INF("Command OK");
+    }
+
+    // Send message over TCP with varint length prefix.
+    pb_ostream_t pb_output = pb_ostream_from_buffer(response_buf.data(), response_buf.size());
+    bool ok = pb_encode_ex(&pb_output, Response_fields, &response, PB_ENCODE_DELIMITED);
+    if (!ok) {
+        LOG_ERR("Failed to encode command response: %s", pb_output.errmsg);
+        return true;
+    }
+
+    // A response that does not fit the socket's send buffer whole means the client has stopped reading. Waiting for it
+    // would hold up every other client, and the rest of a partly sent response cannot be resent later without
+    // buffering it, so the client is dropped instead.
+    int bytes_sent = zsock_send(sock, response_buf.data(), pb_output.bytes_written, ZSOCK_MSG_DONTWAIT);
+    if (bytes_sent < 0) {
+        LOG_ERR("Error while sending response over socket %d: errno=%d", sock, errno);
+        return false;
+    }
+    if (bytes_sent != static_cast<int>(pb_output.bytes_written)) {
+        LOG_ERR(
+            "Socket %d is not reading its responses, only %d of %zu bytes fit its send buffer",
+            sock,
+            bytes_sent,
+            pb_output.bytes_written);
+        return false;
+    }
+    return true;
+}
+
+/// Reads the varint length prefix the connection has buffered into its frame and prefix sizes, leaving them 0 if the
+/// prefix is not all in yet.
+static std::expected<void, Error> parse_length_prefix(Connection& connection, const uint8_t* buf)
+{
+    uint32_t message_size = 0;
+    for (size_t i = 0; i < std::min(connection.rx_len, MAX_LENGTH_PREFIX_SIZE); ++i) {
+        message_size |= static_cast<uint32_t>(buf[i] & 0x7f) << (7 * i);
+        if ((buf[i] & 0x80) == 0) {
+            if (message_size > Request_size) {
+                return std::unexpected(Error::from_cause("Request of %u bytes is longer than any valid request", message_size));
+            }
+            connection.prefix_size = i + 1;
+            connection.frame_size = connection.prefix_size + message_size;
+            return {};
         }
-        else {
-            LOG_INF("Command OK");
+    }
+    if (connection.rx_len >= MAX_LENGTH_PREFIX_SIZE) {
+        return std::unexpected(Error::from_cause("Request length prefix is malformed"));
+    }
+    return {};
+}
+
+/// Buffer the given connection is receiving into.
+static std::span<uint8_t> rx_buffer(int connection_index)
+{
+    if (large_frame_buf_owner == connection_index) {
+        return large_frame_buf;
+    }
+    return connections[connection_index].rx_buf;
+}
+
+/// Moves the connection's buffered bytes into large_frame_buf if it is free, otherwise leaves the connection waiting
+/// for it.
+static void claim_large_frame_buf(int connection_index)
+{
+    Connection& connection = connections[connection_index];
+    if (large_frame_buf_owner != -1) {
+        connection.wants_large_frame_buf = true;
+        return;
+    }
+    std::copy_n(connection.rx_buf.begin(), connection.rx_len, large_frame_buf.begin());
+    large_frame_buf_owner = connection_index;
+    connection.wants_large_frame_buf = false;
+    // Time spent waiting for the buffer is not the client's
+    connection.request_deadline_ms = k_uptime_get() + REQUEST_TIMEOUT_MS;
+}
+
+/// Hands large_frame_buf back once what the connection has left in it fits its own buffer.
+static void release_large_frame_buf(int connection_index)
+{
+    Connection& connection = connections[connection_index];
+    if (large_frame_buf_owner != connection_index || connection.rx_len > connection.rx_buf.size()) {
+        return;
+    }
+    std::copy_n(large_frame_buf.begin(), connection.rx_len, connection.rx_buf.begin());
+    large_frame_buf_owner = -1;
+}
+
+static void close_connection(int connection_index)
+{
+    Connection& connection = connections[connection_index];
+    zsock_close(connection.sock);
+    LOG_INF("Closed socket %d in slot %d", connection.sock, connection_index);
+
+    // Clean up potential data client subscription
+    {
+        MutexGuard data_client_info_guard{&data_client_info_lock};
+        for (int j = 0; j < MAX_DATA_CLIENTS; ++j) {
+            if (data_client_slot_indexes[j] == connection_index) {
+                data_client_slot_indexes[j] = -1;
+                data_client_addr_lens[j] = sizeof(sockaddr);
+            }
         }
+    }
 
-        // Send message over TCP with varint length prefix.
-        bool ok = pb_encode_ex(&pb_output, Response_fields, &response, PB_ENCODE_DELIMITED);
-        if (!ok) {
-            LOG_ERR("Failed to encode command response: %s", pb_output.errmsg);
+    // Clean up potential DAQ connection
+    {
+        MutexGuard daq_status_guard{&daq_status_lock};
+        if (daq_connection_index == connection_index) {
+            daq_connection_index = -1;
+            daq_last_pinged_ms = k_uptime_get();
         }
     }
-    zsock_close(client_socket);
+
+    if (large_frame_buf_owner == connection_index) {
+        large_frame_buf_owner = -1;
+    }
+    connection.sock = -1;
+    connection.rx_len = 0;
+    connection.frame_size = 0;
+    connection.prefix_size = 0;
+    connection.wants_large_frame_buf = false;
 }
 
-/// Attempts to join connection handler threads, allowing the thread slots to be reused to service new connection.
-[[noreturn]] static void reap_dead_connections(void*, void*, void*)
+/// Handles every whole request the connection has buffered, in order. Returns false if the connection was closed.
+static bool handle_buffered_requests(int connection_index)
 {
-    bool freed_threads[MAX_OPEN_CLIENTS] = {false};
+    Connection& connection = connections[connection_index];
     while (true) {
-        {
-            MutexGuard has_thread_guard{&has_thread_lock};
-            for (int i = 0; i < MAX_OPEN_CLIENTS; ++i) {
-                if (has_thread[i]) {
-                    int ret = k_thread_join(&client_threads[i], K_NO_WAIT);
-                    if (ret == -EBUSY) {
-                        // Thread still running
-                        continue;
-                    }
-                    else if (ret != 0) {
-                        LOG_ERR("Unexpected code from joining client thread: err %d", ret);
-                        continue;
-                    }
-
-                    {
-                        MutexGuard thread_info_guard{&thread_info_lock};
-                        thread_names[i].clear();
-                    }
-
-                    // Clean up potential data client subscription
-                    {
-                        MutexGuard data_client_info_guard{&data_client_info_lock};
-                        for (int j = 0; j < MAX_DATA_CLIENTS; ++j) {
-                            if (data_client_slot_indexes[j] == i) {
-                                data_client_slot_indexes[j] = -1;
-                                data_client_addr_lens[j] = sizeof(sockaddr);
-                            }
-                        }
-                    }
-
-                    // Clean up potential DAQ connection
-                    {
-                        MutexGuard daq_status_guard{&daq_status_lock};
-                        if (daq_thread_index == i) {
-                            daq_thread_index = -1;
-                            daq_last_pinged_ms = k_uptime_get();
-                        }
-                    }
-
-                    has_thread[i] = false;
-                    freed_threads[i] = true;
-                    k_sem_give(&num_open_connections);
-                }
+        std::span<uint8_t> buf = rx_buffer(connection_index);
+        if (connection.frame_size == 0) {
+            std::expected<void, Error> parsed = parse_length_prefix(connection, buf.data());
+            if (!parsed.has_value()) {
+                LOG_ERR("Bad request from socket %d: %s", connection.sock, parsed.error().build_message().c_str());
+                close_connection(connection_index);
+                return false;
+            }
+            if (connection.frame_size == 0) {
+                return true;
             }
+            if (connection.frame_size > buf.size()) {
+                claim_large_frame_buf(connection_index);
+                return true;
+            }
+        }
+        if (connection.rx_len < connection.frame_size) {
+            return true;
         }
 
-        // Log freed threads outside mutex
-        for (int i = 0; i < MAX_OPEN_CLIENTS; ++i) {
-            if (freed_threads[i]) {
-                LOG_INF("Freed thread at slot %d", i);
-                freed_threads[i] = false;
-            }
+        pb_istream_t pb_input = pb_istream_from_buffer(buf.data() + connection.prefix_size, connection.frame_size - connection.prefix_size);
+        bool valid = pb_decode(&pb_input, Request_fields, &decoded_request);
+        if (!valid) {
+            LOG_ERR("Failed to decode request from socket %d: pb_err='%s'", connection.sock, PB_GET_ERROR(&pb_input));
+            close_connection(connection_index);
+            return false;
+        }
+        if (!respond(connection.sock, handle_request(decoded_request, connection_index, connection.sock))) {
+            close_connection(connection_index);
+            return false;
+        }
+
+        // Keep whatever of the next requests was read along with this one
+        std::copy(buf.begin() + connection.frame_size, buf.begin() + connection.rx_len, buf.begin());
+        connection.rx_len -= connection.frame_size;
+        connection.frame_size = 0;
+        connection.prefix_size = 0;
+        connection.request_deadline_ms = k_uptime_get() + REQUEST_TIMEOUT_MS;
+        release_large_frame_buf(connection_index);
+    }
+}
+
+/// Receives what the client has sent of its current request without blocking, and handles the request once whole.
+static void service_connection(int connection_index, int revents)
+{
+    Connection& connection = connections[connection_index];
+    if (revents & ZSOCK_POLLNVAL) {
+        close_connection(connection_index);
+        return;
+    }
+    if (connection.wants_large_frame_buf) {
+        // Input stays unread until the buffer frees up, but the client may have gone in the meantime
+        if (revents & (ZSOCK_POLLERR | ZSOCK_POLLHUP)) {
+            close_connection(connection_index);
+        }
+        return;
+    }
+
+    // Until the length prefix is in, read whatever fits so a request that arrived whole takes one receive. Once it is
+    // in, read exactly the rest of the request.
+    std::span<uint8_t> buf = rx_buffer(connection_index);
+    size_t bytes_wanted = (connection.frame_size != 0 ? connection.frame_size : buf.size()) - connection.rx_len;
+    int bytes_read = zsock_recv(connection.sock, buf.data() + connection.rx_len, bytes_wanted, ZSOCK_MSG_DONTWAIT);
+    if (bytes_read == 0) {
+        LOG_INF("Client on socket %d disconnected", connection.sock);
+        close_connection(connection_index);
+        return;
+    }
+    if (bytes_read < 0) {
+        if (errno == EAGAIN) {
+            return;
+        }
+        LOG_ERR("Error while receiving from socket %d: errno=%d", connection.sock, errno);
+        close_connection(connection_index);
+        return;
+    }
+
+    if (connection.rx_len == 0) {
+        connection.request_deadline_ms = k_uptime_get() + REQUEST_TIMEOUT_MS;
+    }
+    connection.rx_len += bytes_read;
+    handle_buffered_requests(connection_index);
+}
+
+/// Whether the connection has started sending a request and is expected to send the rest of it.
+static bool is_receiving_request(const Connection& connection)
+{
+    return connection.sock != -1 && connection.rx_len != 0 && !connection.wants_large_frame_buf;
+}
+
+/// Disconnects clients that have stalled partway through a request, so that none of them can hold large_frame_buf or
+/// a slot indefinitely.
+static void expire_stalled_requests()
+{
+    const int64_t now_ms = k_uptime_get();
+    for (int i = 0; i < MAX_OPEN_CLIENTS; ++i) {
+        Connection& connection = connections[i];
+        if (is_receiving_request(connection) && now_ms >= connection.request_deadline_ms) {
+            LOG_ERR(
+                "Socket %d did not send the rest of its request within %lld ms, only %zu bytes of it arrived",
+                connection.sock,
+                static_cast<long long>(REQUEST_TIMEOUT_MS),
+                connection.rx_len);
+            close_connection(i);
         }
+    }
+}
 
-        k_sleep(K_MSEC(50));
+/// How long to poll for before the next request deadline passes [ms], or -1 if no request is being received.
+static int request_poll_timeout_ms()
+{
+    const int64_t now_ms = k_uptime_get();
+    int64_t timeout_ms = -1;
+    for (const Connection& connection : connections) {
+        if (is_receiving_request(connection)) {
+            const int64_t remaining_ms = std::max<int64_t>(connection.request_deadline_ms - now_ms, 0);
+            timeout_ms = timeout_ms == -1 ? remaining_ms : std::min(timeout_ms, remaining_ms);
+        }
     }
+    return static_cast<int>(timeout_ms);
 }
 
-K_THREAD_DEFINE(server_reaper, 1024, reap_dead_connections, nullptr, nullptr, nullptr, 1, 0, 0);
+static void accept_connection(int server_socket)
+{
+    int client_socket = zsock_accept(server_socket, nullptr, nullptr);
+    if (client_socket < 0) {
+        LOG_ERR("zsock_accept failed: errno=%d", errno);
+        return;
+    }
+
+    // The listen socket is only polled while a slot is open
+    auto slot = std::ranges::find_if(connections, [](const Connection& connection) { return connection.sock == -1; });
+    if (slot == connections.end()) {
+        LOG_ERR("Consistency error: Server accepted a connection but no slots were open");
+        zsock_close(client_socket);
+        return;
+    }
+
+    // Set TCP keepalive to detect connection break.
+    int optval = 1;  // non-zero to enable this the flag
+    zsock_setsockopt(client_socket, SOL_SOCKET, SO_KEEPALIVE, (void*)&optval, sizeof(optval));
+
+    slot->sock = client_socket;
+    LOG_INF("Serving socket %d in slot %d", client_socket, static_cast<int>(slot - connections.begin()));
+}
 
-/// Opens a TCP server, listens for incoming clients, and spawns new threads to serve these connections. This function
-/// blocks indefinitely.
+/// Opens a TCP server, and serves it and every client connection from this one thread, polling them all for input.
+/// This function blocks indefinitely.
 void serve_command_connections()
 {
     k_sem_take(&allow_serve_connections_sem, K_FOREVER);
@@ -489,58 +656,41 @@ void serve_command_connections()
         return;
     }
 
-    // Serve new connections indefinitely
-    while (true) {
-        // Wait for free thread slot
-        err = k_sem_take(&num_open_connections, K_FOREVER);
-        if (err) {
-            LOG_INF("Failed to acquire semaphore: %d", err);
-            return;
-        }
+    // Slots first, then the listen socket. Negative fds are skipped by zsock_poll.
+    std::array<zsock_pollfd, MAX_OPEN_CLIENTS + 1> fds;
+    zsock_pollfd& server_fd = fds[MAX_OPEN_CLIENTS];
 
-        // Find open connection index
-        int connection_index;
-        {
-            MutexGuard has_thread_guard{&has_thread_lock};
-            for (connection_index = 0; connection_index < MAX_OPEN_CLIENTS; ++connection_index) {
-                if (!has_thread[connection_index]) {
-                    break;
-                }
+    // Serve connections indefinitely
+    while (true) {
+        // Stalled clients are closed before large_frame_buf is handed on, so a waiting client can claim it right away
+        expire_stalled_requests();
+        bool has_open_slot = false;
+        for (int i = 0; i < MAX_OPEN_CLIENTS; ++i) {
+            Connection& connection = connections[i];
+            if (connection.wants_large_frame_buf && large_frame_buf_owner == -1) {
+                claim_large_frame_buf(i);
             }
+            has_open_slot |= connection.sock == -1;
+            fds[i] = {.fd = connection.sock, .events = static_cast<short>(connection.wants_large_frame_buf ? 0 : ZSOCK_POLLIN), .revents = 0};
         }
-        if (connection_index == MAX_OPEN_CLIENTS) {
-            LOG_ERR("Consistency error: Server acquired connection semaphore but no thread slots were open");
-            return;
-        }
 
-        // Spawn thread to service client connection
-        int client_socket = zsock_accept(server_socket, nullptr, nullptr);
-        if (client_socket < 0) {
-            LOG_ERR("zsock_accept failed: errno=%d — releasing slot and retrying", errno);
-            k_sem_give(&num_open_connections);
+        // Further clients wait in the listen backlog while every slot is taken
+        server_fd = {.fd = has_open_slot ? server_socket : -1, .events = ZSOCK_POLLIN, .revents = 0};
+
+        int ready = zsock_poll(fds.data(), fds.size(), request_poll_timeout_ms());
+        if (ready < 0) {
+            LOG_ERR("zsock_poll failed: errno=%d", errno);
+            k_sleep(K_MSEC(10));
             continue;
         }
 
-        // Set TCP keepalive to detect connection break.
-        int optval = 1;  // non-zero to enable this the flag
-        zsock_setsockopt(client_socket, SOL_SOCKET, SO_KEEPALIVE, (void*)&optval, sizeof(optval));
-
-        LOG_INF("Spawning thread in slot %d to serve socket %d", connection_index, client_socket);
-        k_thread_create(
-            &client_threads[connection_index],
-            reinterpret_cast<k_thread_stack_t*>(&client_stacks[connection_index]),
-            CONNECTION_THREAD_STACK_SIZE,
-            handle_client,
-            reinterpret_cast<void*>(connection_index),
-            reinterpret_cast<void*>(client_socket),
-            nullptr,
-            5,
-            0,
-            K_NO_WAIT);
-
-        {
-            MutexGuard has_thread_guard{&has_thread_lock};
-            has_thread[connection_index] = true;
+        for (int i = 0; i < MAX_OPEN_CLIENTS; ++i) {
+            if (fds[i].revents != 0) {
+                service_connection(i, fds[i].revents);
+            }
+        }
+        if (server_fd.revents & ZSOCK_POLLIN) {
+            accept_connection(server_socket);
         }
     }
 }
@@ -0,0 +1,491 @@
+#include "ControllerBenchmark.h"
+#include "../Controller.h"
+#include "../config.h"
+#include "LatencyHistogram.h"
+#include <array>
+#include <atomic>
+#include <nsi_main.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/printk.h>
+
+#ifdef CONFIG_RANGER
+#include "controller_benchmark_baseline_ranger.h"
+static constexpr const char* VARIANT = "ranger";
+#elif CONFIG_HORNET
+#include "controller_benchmark_baseline_hornet.h"
+static constexpr const char* VARIANT = "hornet";
+#endif
+
+LOG_MODULE_REGISTER(ControllerBenchmark, CONFIG_LOG_DEFAULT_LEVEL);
+
+// Implemented in host_clock.c, inside the native simulator runner
+extern "C" uint64_t plant_sim_host_thread_cpu_ns(void);
+
+using ControllerBenchmark::Phase;
+
+static constexpr size_t NUM_STATES = _SystemState_ARRAYSIZE;
+static constexpr size_t NUM_PHASES = static_cast<size_t>(Phase::COUNT);
+
+// How long the benchmark holds each kind of state [ms of simulated time]
+static constexpr uint32_t IDLE_MS = 2000;
+static constexpr uint32_t PRIMED_MS = 1000;
+static constexpr uint32_t TRACE_MS = 4000;
+static constexpr uint32_t CALIBRATE_TVC_MS = 1000;
+static constexpr uint32_t ABORT_AFTER_MS = 1500;
+static constexpr uint32_t CALIBRATION_TIMEOUT_MS = 30'000;
+static constexpr uint32_t POLL_MS = 10;
+
+/// Guards the histograms between the controller tick and the final report.
+static k_spinlock benchmark_lock;
+static std::array<std::array<LatencyHistogram, NUM_PHASES>, NUM_STATES> histograms;
+static bool recording = true;
+
+/// State of the latest tick, which is how the driver follows the controller through its transitions.
+static std::atomic<SystemState> tick_state = SystemState_STATE_UNKNOWN;
+
+K_SEM_DEFINE(controller_benchmark_ready_sem, 0, 1);
+
+const char* ControllerBenchmark::phase_name(Phase phase)
+{
+    switch (phase) {
+    case Phase::TICK:
+        return "tick";
+    case Phase::SENSE:
+        return "sense";
+    case Phase::CONTROL:
+        return "control";
+    case Phase::ACTUATE:
+        return "actuate";
+    case Phase::TELEMETRY:
+        return "telemetry";
+    case Phase::FLIGHT_OUTER:
+        return "flight_outer";
+    case Phase::FLIGHT_INNER:
+        return "flight_inner";
+    case Phase::THROTTLE:
+        return "throttle";
+    case Phase::TVC:
+        return "tvc";
+    case Phase::RCS:
+        return "rcs";
+    case Phase::COUNT:
+        break;
+    }
+    return "unknown";
+}
+
+static const char* state_name(SystemState state)
+{
+    switch (state) {
+    case SystemState_STATE_UNKNOWN:
+        return "STATE_UNKNOWN";
+    case SystemState_STATE_IDLE:
+        return "STATE_IDLE";
+    case SystemState_STATE_ABORT:
+        return "STATE_ABORT";
+    case SystemState_STATE_CALIBRATE_THROTTLE_VALVE:
+        return "STATE_CALIBRATE_THROTTLE_VALVE";
+    case SystemState_STATE_THROTTLE_VALVE:
+        return "STATE_THROTTLE_VALVE";
+    case SystemState_STATE_THROTTLE_VALVE_PRIMED:
+        return "STATE_THROTTLE_VALVE_PRIMED";
+    case SystemState_STATE_THROTTLE:
+        return "STATE_THROTTLE";
+    case SystemState_STATE_THROTTLE_PRIMED:
+        return "STATE_THROTTLE_PRIMED";
+    case SystemState_STATE_CALIBRATE_TVC:
+        return "STATE_CALIBRATE_TVC";
+    case SystemState_STATE_TVC:
+        return "STATE_TVC";
+    case SystemState_STATE_TVC_PRIMED:
+        return "STATE_TVC_PRIMED";
+    case SystemState_STATE_RCS_VALVE:
+        return "STATE_RCS_VALVE";
+    case SystemState_STATE_RCS_VALVE_PRIMED:
+        return "STATE_RCS_VALVE_PRIMED";
+    case SystemState_STATE_RCS:
+        return "STATE_RCS";
+    case SystemState_STATE_RCS_PRIMED:
+        return "STATE_RCS_PRIMED";
+    case SystemState_STATE_STATIC_FIRE:
+        return "STATE_STATIC_FIRE";
+    case SystemState_STATE_STATIC_FIRE_PRIMED:
+        return "STATE_STATIC_FIRE_PRIMED";
+    case SystemState_STATE_FLIGHT:
+        return "STATE_FLIGHT";
+    case SystemState_STATE_FLIGHT_PRIMED:
+        return "STATE_FLIGHT_PRIMED";
+    }
+    return "STATE_UNKNOWN";
+}
+
+uint64_t ControllerBenchmark::now_ns()
+{
+    return plant_sim_host_thread_cpu_ns();
+}
+
+void ControllerBenchmark::record(SystemState state, Phase phase, uint64_t elapsed_ns)
+{
+    const auto index = static_cast<size_t>(state);
+    if (index >= NUM_STATES) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&benchmark_lock);
+    if (recording) {
+        histograms[index][static_cast<size_t>(phase)].add(elapsed_ns);
+    }
+    k_spin_unlock(&benchmark_lock, key);
+
+    if (phase == Phase::TICK) {
+        tick_state = state;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Sequences
+// -----------------------------------------------------------------------------
+static ControlTrace linear_trace(float start_val, float end_val, uint32_t length_ms)
+{
+    ControlTrace trace = ControlTrace_init_default;
+    trace.total_time_ms = length_ms;
+    trace.segments_count = 1;
+    trace.segments[0].start_ms = 0;
+    trace.segments[0].length_ms = length_ms;
+    trace.segments[0].which_type = Segment_linear_tag;
+    trace.segments[0].type.linear = LinearSegment{.start_val = start_val, .end_val = end_val};
+    return trace;
+}
+
+static ControlTrace sine_trace(float amplitude, float period_ms, uint32_t length_ms)
+{
+    ControlTrace trace = ControlTrace_init_default;
+    trace.total_time_ms = length_ms;
+    trace.segments_count = 1;
+    trace.segments[0].start_ms = 0;
+    trace.segments[0].length_ms = length_ms;
+    trace.segments[0].which_type = Segment_sine_tag;
+    trace.segments[0].type.sine = SineSegment{.offset = 0.0f, .amplitude = amplitude, .period = period_ms, .phase_deg = 0.0f};
+    return trace;
+}
+
+/// Wait for the controller to return to IDLE on its own. False on timeout.
+static bool wait_for_idle(uint32_t timeout_ms)
+{
+    for (uint32_t waited_ms = 0; waited_ms < timeout_ms; waited_ms += POLL_MS) {
+        k_sleep(K_MSEC(POLL_MS));
+        if (tick_state == SystemState_STATE_IDLE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Hold a primed state, start it, and wait for its trace to run out.
+template <typename Start> static std::expected<void, Error> prime_and_run(Start start)
+{
+    k_sleep(K_MSEC(PRIMED_MS));
+    if (auto result = start(); !result) {
+        return result;
+    }
+    if (!wait_for_idle(TRACE_MS + ABORT_AFTER_MS + static_cast<uint32_t>(Controller::ABORT_TIME_MSEC))) {
+        return std::unexpected(Error::from_cause("sequence did not finish"));
+    }
+    return {};
+}
+
+static std::expected<void, Error> run_calibrate_throttle_valve(ThrottleValveType valve)
+{
+    if (auto result = Controller::handle_calibrate_throttle_valve(CalibrateThrottleValveRequest{.valve = valve}); !result) {
+        return result;
+    }
+    if (!wait_for_idle(CALIBRATION_TIMEOUT_MS)) {
+        return std::unexpected(Error::from_cause("calibration did not finish"));
+    }
+    return {};
+}
+
+static std::expected<void, Error> run_calibrate_fuel_valve()
+{
+    return run_calibrate_throttle_valve(ThrottleValveType_FUEL);
+}
+
+static std::expected<void, Error> run_calibrate_lox_valve()
+{
+    return run_calibrate_throttle_valve(ThrottleValveType_LOX);
+}
+
+static std::expected<void, Error> run_throttle_valve()
+{
+    LoadThrottleValveSequenceRequest req = LoadThrottleValveSequenceRequest_init_default;
+    req.has_fuel_trace_deg = true;
+    req.fuel_trace_deg = linear_trace(10.0f, 80.0f, TRACE_MS);
+    req.has_lox_trace_deg = true;
+    req.lox_trace_deg = linear_trace(10.0f, 70.0f, TRACE_MS);
+    if (auto result = Controller::handle_load_throttle_valve_sequence(req); !result) {
+        return result;
+    }
+    return prime_and_run([] { return Controller::handle_start_throttle_valve_sequence(StartThrottleValveSequenceRequest_init_default); });
+}
+
+static std::expected<void, Error> run_throttle()
+{
+    LoadThrottleSequenceRequest req = LoadThrottleSequenceRequest_init_default;
+    req.thrust_lbf = linear_trace(450.0f, 650.0f, TRACE_MS);
+    if (auto result = Controller::handle_load_throttle_sequence(req); !result) {
+        return result;
+    }
+    return prime_and_run([] { return Controller::handle_start_throttle_sequence(StartThrottleSequenceRequest_init_default); });
+}
+
+static std::expected<void, Error> run_tvc()
+{
+    LoadTvcSequenceRequest req = LoadTvcSequenceRequest_init_default;
+    req.pitch_trace_deg = sine_trace(5.0f, 1000.0f, TRACE_MS);
+    req.yaw_trace_deg = sine_trace(5.0f, 1500.0f, TRACE_MS);
+    if (auto result = Controller::handle_load_tvc_sequence(req); !result) {
+        return result;
+    }
+    return prime_and_run([] { return Controller::handle_start_tvc_sequence(StartTvcSequenceRequest_init_default); });
+}
+
+static std::expected<void, Error> run_rcs_valve()
+{
+    LoadRcsValveSequenceRequest req = LoadRcsValveSequenceRequest_init_default;
+    req.rcs_cw_valve_trace = linear_trace(0.0f, 1.0f, TRACE_MS);
+    req.rcs_ccw_valve_trace = linear_trace(1.0f, 0.0f, TRACE_MS);
+    if (auto result = Controller::handle_load_rcs_valve_sequence(req); !result) {
+        return result;
+    }
+    return prime_and_run([] { return Controller::handle_start_rcs_valve_sequence(StartRcsValveSequenceRequest_init_default); });
+}
+
+static std::expected<void, Error> run_rcs()
+{
+    LoadRcsSequenceRequest req = LoadRcsSequenceRequest_init_default;
+    req.trace_deg = sine_trace(10.0f, 2000.0f, TRACE_MS);
+    if (auto result = Controller::handle_load_rcs_sequence(req); !result) {
+        return result;
+    }
+    return prime_and_run([] { return Controller::handle_start_rcs_sequence(StartRcsSequenceRequest_init_default); });
+}
+
+static std::expected<void, Error> load_static_fire()
+{
+    LoadStaticFireSequenceRequest req = LoadStaticFireSequenceRequest_init_default;
+    req.thrust_lbf = linear_trace(450.0f, 650.0f, TRACE_MS);
+    req.pitch_trace_deg = sine_trace(3.0f, 1000.0f, TRACE_MS);
+    req.yaw_trace_deg = sine_trace(3.0f, 1500.0f, TRACE_MS);
+    return Controller::handle_load_static_fire_sequence(req);
+}
+
+static std::expected<void, Error> run_static_fire()
+{
+    if (auto result = load_static_fire(); !result) {
+        return result;
+    }
+    return prime_and_run([] { return Controller::handle_start_static_fire_sequence(StartStaticFireSequenceRequest_init_default); });
+}
+
+static std::expected<void, Error> load_flight()
+{
+    // Lift off to 1 m and hold
+    LoadFlightSequenceRequest req = LoadFlightSequenceRequest_init_default;
+    req.x_position_trace_m = linear_trace(0.0f, 0.0f, TRACE_MS);
+    req.y_position_trace_m = linear_trace(0.0f, 0.0f, TRACE_MS);
+    req.z_position_trace_m = linear_trace(0.0f, 1.0f, TRACE_MS);
+    req.roll_angle_trace_deg = linear_trace(0.0f, 0.0f, TRACE_MS);
+    return Controller::handle_load_flight_sequence(req);
+}
+
+static std::expected<void, Error> run_flight()
+{
+    if (auto result = load_flight(); !result) {
+        return result;
+    }
+    return prime_and_run([] { return Controller::handle_start_flight_sequence(StartFlightSequenceRequest_init_default); });
+}
+
+static std::expected<void, Error> run_calibrate_tvc()
+{
+    // TVC calibration does not finish yet, so it is aborted after a while
+    if (auto result = Controller::handle_calibrate_tvc(CalibrateTvcRequest_init_default); !result) {
+        return result;
+    }
+    k_sleep(K_MSEC(CALIBRATE_TVC_MS));
+    if (auto result = Controller::handle_abort(AbortRequest_init_default); !result) {
+        return result;
+    }
+    if (!wait_for_idle(static_cast<uint32_t>(Controller::ABORT_TIME_MSEC) + ABORT_AFTER_MS)) {
+        return std::unexpected(Error::from_cause("abort did not finish"));
+    }
+    return {};
+}
+
+/// Abort the most demanding active state partway through.
+static std::expected<void, Error> run_abort()
+{
+#ifdef CONFIG_FLIGHT
+    auto load = load_flight();
+    auto start = [] { return Controller::handle_start_flight_sequence(StartFlightSequenceRequest_init_default); };
+#else
+    auto load = load_static_fire();
+    auto start = [] { return Controller::handle_start_static_fire_sequence(StartStaticFireSequenceRequest_init_default); };
+#endif
+    if (!load) {
+        return load;
+    }
+    if (auto result = start(); !result) {
+        return result;
+    }
+    k_sleep(K_MSEC(ABORT_AFTER_MS));
+    if (auto result = Controller::handle_abort(AbortRequest_init_default); !result) {
+        return result;
+    }
+    if (!wait_for_idle(static_cast<uint32_t>(Controller::ABORT_TIME_MSEC) + ABORT_AFTER_MS)) {
+        return std::unexpected(Error::from_cause("abort did not finish"));
+    }
+    return {};
+}
+
+struct Scenario {
+    const char* name;
+    std::expected<void, Error> (*run)();
+};
+
+// Every state this variant can reach, each scenario starting and ending in IDLE. Hornet's throttle and TVC only run
+// under the flight controller, so they are covered by the flight.
+static constexpr Scenario SCENARIOS[] = {
+#ifdef CONFIG_RANGER
+    {"calibrate fuel valve", run_calibrate_fuel_valve},
+    {"calibrate lox valve", run_calibrate_lox_valve},
+    {"throttle valve", run_throttle_valve},
+    {"throttle", run_throttle},
+    {"tvc", run_tvc},
+    {"calibrate tvc", run_calibrate_tvc},
+    {"static fire", run_static_fire},
+#endif
+#ifdef CONFIG_RCS
+    {"rcs valve", run_rcs_valve},
+    {"rcs", run_rcs},
+#endif
+#ifdef CONFIG_FLIGHT
+    {"flight", run_flight},
+#endif
+    {"abort", run_abort},
+};
+
+// -----------------------------------------------------------------------------
+// Report
+// -----------------------------------------------------------------------------
+static constexpr double P99 = 0.99;
+
+/// Print one JSON line per state and phase that ran.
+static void print_report()
+{
+    for (size_t state = 0; state < NUM_STATES; state++) {
+        for (size_t phase = 0; phase < NUM_PHASES; phase++) {
+            const LatencyHistogram& hist = histograms[state][phase];
+            if (hist.count() == 0) {
+                continue;
+            }
+            printk(
+                "bench: {\"variant\":\"%s\",\"state\":\"%s\",\"phase\":\"%s\",\"count\":%u,\"min_ns\":%u,\"mean_ns\":%.0f,"
+                "\"max_ns\":%u,\"p99_ns\":%u}\n",
+                VARIANT,
+                state_name(static_cast<SystemState>(state)),
+                ControllerBenchmark::phase_name(static_cast<Phase>(phase)),
+                hist.count(),
+                hist.min_ns(),
+                hist.mean_ns(),
+                hist.max_ns(),
+                hist.percentile_ns(P99));
+        }
+    }
+}
+
+/// Check every state's ticks against the control period and every baselined p99 against its tolerance. Returns the
+/// number of failures.
+static int check_report()
+{
+    int failures = 0;
+
+    for (size_t state = 0; state < NUM_STATES; state++) {
+        const LatencyHistogram& tick = histograms[state][static_cast<size_t>(Phase::TICK)];
+        if (tick.max_ns() > Controller::NSEC_PER_CONTROL_TICK) {
+            LOG_ERR(
+                "%s: worst tick %u ns exceeds the %llu ns control period",
+                state_name(static_cast<SystemState>(state)),
+                tick.max_ns(),
+                static_cast<unsigned long long>(Controller::NSEC_PER_CONTROL_TICK));
+            failures++;
+        }
+    }
+
+    // Without a baseline nothing could regress, so the gate fails rather than passing on the control period alone
+    if (CONTROLLER_BENCHMARK_BASELINE.empty()) {
+        LOG_ERR("No %s baseline. Generate one from this run on the CI host with scripts/gen_controller_benchmark_baseline.py", VARIANT);
+        failures++;
+    }
+    for (const ControllerBenchmark::Baseline& baseline : CONTROLLER_BENCHMARK_BASELINE) {
+        const LatencyHistogram& hist = histograms[baseline.state][static_cast<size_t>(baseline.phase)];
+        const uint64_t limit_ns = static_cast<uint64_t>(baseline.p99_ns) * (100 + CONFIG_CONTROLLER_BENCHMARK_TOLERANCE_PERCENT) / 100;
+        if (hist.count() == 0) {
+            LOG_ERR("%s %s: in the baseline but never ran", state_name(baseline.state), ControllerBenchmark::phase_name(baseline.phase));
+            failures++;
+        }
+        else if (hist.percentile_ns(P99) > limit_ns) {
+            LOG_ERR(
+                "%s %s: p99 %u ns regressed past %llu ns (baseline %u ns)",
+                state_name(baseline.state),
+                ControllerBenchmark::phase_name(baseline.phase),
+                hist.percentile_ns(P99),
+                static_cast<unsigned long long>(limit_ns),
+                baseline.p99_ns);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// -----------------------------------------------------------------------------
+// Driver thread
+// -----------------------------------------------------------------------------
+static void run()
+{
+    // Await initialization
+    k_sem_take(&controller_benchmark_ready_sem, K_FOREVER);
+    LOG_INF("Controller benchmark started (%s)", VARIANT);
+
+    int failures = 0;
+    k_sleep(K_MSEC(IDLE_MS));
+    for (const Scenario& scenario : SCENARIOS) {
+        LOG_INF("Benchmarking %s", scenario.name);
+        if (auto result = scenario.run(); !result) {
+            LOG_ERR("Benchmark of %s failed: %s", scenario.name, result.error().build_message().c_str());
+            failures++;
+            // Get back to IDLE for the next scenario, whatever state this one was left in
+            (void)Controller::handle_abort(AbortRequest_init_default);
+            wait_for_idle(static_cast<uint32_t>(Controller::ABORT_TIME_MSEC) + ABORT_AFTER_MS);
+        }
+        k_sleep(K_MSEC(IDLE_MS));
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&benchmark_lock);
+    recording = false;
+    k_spin_unlock(&benchmark_lock, key);
+
+    print_report();
+    failures += check_report();
+    printk("Controller benchmark %s\n", failures == 0 ? "PASSED" : "FAILED");
+    nsi_exit(failures == 0 ? 0 : 1);
+}
+
+K_THREAD_DEFINE(controller_benchmark, 8192, run, nullptr, nullptr, nullptr, CONTROLLER_BENCHMARK_THREAD_PRIORITY, 0, 0);
+
+std::expected<void, Error> ControllerBenchmark::start()
+{
+    k_sem_give(&controller_benchmark_ready_sem);
+    return {};
+}
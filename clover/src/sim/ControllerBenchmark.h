@@ -0,0 +1,58 @@
+#ifndef APP_SIM_CONTROLLER_BENCHMARK_H
+#define APP_SIM_CONTROLLER_BENCHMARK_H
+
+#include "../Error.h"
+#include "clover.pb.h"
+#include <cstdint>
+#include <expected>
+
+#ifdef CONFIG_CONTROLLER_BENCHMARK
+
+/// Execution time benchmark of the controller tick. A driver thread walks the controller through every state this
+/// build supports, with the plant simulator providing the sensors, while step_control_loop reports how long each phase
+/// of each tick took. At the end the min/mean/max/p99 per state and phase are printed as JSON lines, compared against
+/// the baseline in controller_benchmark_baseline_<variant>.h, and native_sim exits non-zero on a regression.
+///
+/// Times are host CPU time of the controller thread, as simulated time stands still while code runs on native_sim.
+/// They only compare against baselines taken on the same host.
+namespace ControllerBenchmark {
+
+/// Parts of a controller tick. SENSE through TELEMETRY partition the tick; the modules are part of CONTROL, timed
+/// only on ticks where their rate group runs.
+enum class Phase : uint8_t {
+    TICK,
+    SENSE,
+    CONTROL,
+    ACTUATE,
+    TELEMETRY,
+    FLIGHT_OUTER,
+    FLIGHT_INNER,
+    THROTTLE,
+    TVC,
+    RCS,
+    COUNT,
+};
+
+const char* phase_name(Phase phase);
+
+/// Reference p99 of one phase in one state, from gen_controller_benchmark_baseline.py.
+struct Baseline {
+    SystemState state;
+    Phase phase;
+    uint32_t p99_ns;
+};
+
+/// CPU time of the calling thread [ns].
+uint64_t now_ns();
+
+/// Record one phase of a tick that ran in the given state. Called from the controller tick only.
+void record(SystemState state, Phase phase, uint64_t elapsed_ns);
+
+/// Start driving the controller through its states. Call once Controller::init has started the ticks.
+std::expected<void, Error> start();
+
+}  // namespace ControllerBenchmark
+
+#endif  // CONFIG_CONTROLLER_BENCHMARK
+
+#endif  // APP_SIM_CONTROLLER_BENCHMARK_H
@@ -0,0 +1,85 @@
+#include "HornetPropulsionModel.h"
+#include "../config.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+static constexpr double N_PER_LBF = 4.44822;
+static constexpr double DEG_PER_RAD = 180.0 / std::numbers::pi;
+
+static constexpr double MOTOR_TIME_CONSTANT_S = 0.05;
+static constexpr double THRUST_ARM_M = 0.3;               // Propeller thrust line below the center of mass
+static constexpr double SERVO_SLEW_DEG_S = 600.0;         // 0.1 s per 60 deg hobby servo
+static constexpr double SERVO_US_PER_DEG = (MAX_PWM_PULSE_US - 1500.0) / 90.0;
+static constexpr double MAX_GIMBAL_DEG = 12.0;            // Mechanical stop
+static constexpr double ROLL_PROP_TIME_CONSTANT_S = 0.04;
+static constexpr double ROLL_PROP_TORQUE_N_M = 0.15;      // Each, at full throttle
+
+static double pulse_to_throttle(uint32_t pulse_us)
+{
+    return std::clamp((static_cast<double>(pulse_us) - MIN_PWM_PULSE_US) / (MAX_PWM_PULSE_US - MIN_PWM_PULSE_US), 0.0, 1.0);
+}
+
+static double lag(double value, double target, double time_constant, double dt)
+{
+    return value + (target - value) * std::min(1.0, dt / time_constant);
+}
+
+double HornetPropulsionModel::thrust_lbf(double throttle)
+{
+    if (throttle <= 0.0) {
+        return 0.0;
+    }
+    if (throttle < HORNET_THROTTLE_CROSSOVER_PERCENT) {
+        return throttle * HORNET_THROTTLE_LOW_SLOPE;
+    }
+    return throttle * HORNET_THROTTLE_HIGH_SLOPE - HORNET_THROTTLE_HIGH_OFFSET;
+}
+
+void HornetPropulsionModel::reset()
+{
+    thrust_n_ = 0.0;
+    servo_deg_ = {};
+    gimbal_deg_ = {};
+    roll_throttle_ = {};
+}
+
+HornetWrench HornetPropulsionModel::step(const std::array<uint32_t, NUM_CHANNELS>& pulses_us, double dt)
+{
+    // Channels in PwmKind order
+    constexpr int SERVO_X = 0;
+    constexpr int BETA_TOP = 2;
+    constexpr int MOTOR_TOP = 6;
+    constexpr int MOTOR_BOTTOM = 7;
+
+    // Both main propellers get the same command on the vehicle, so the pair is modelled as one
+    const double throttle = 0.5 * (pulse_to_throttle(pulses_us[MOTOR_TOP]) + pulse_to_throttle(pulses_us[MOTOR_BOTTOM]));
+    thrust_n_ = lag(thrust_n_, thrust_lbf(throttle) * N_PER_LBF, MOTOR_TIME_CONSTANT_S, dt);
+
+    std::array<double, 2> tilt_sin;
+    for (int i = 0; i < 2; i++) {
+        const double commanded_deg = std::clamp((static_cast<double>(pulses_us[SERVO_X + i]) - 1500.0) / SERVO_US_PER_DEG, -90.0, 90.0);
+        const double max_slew = SERVO_SLEW_DEG_S * dt;
+        servo_deg_[i] += std::clamp(commanded_deg - servo_deg_[i], -max_slew, max_slew);
+        gimbal_deg_[i] = std::clamp(std::asin(servo_deg_[i] / 90.0) * DEG_PER_RAD, -MAX_GIMBAL_DEG, MAX_GIMBAL_DEG);
+        tilt_sin[i] = std::sin(gimbal_deg_[i] / DEG_PER_RAD);
+    }
+
+    // BETA_TOP, BETA_BOTTOM, BETA_CW, BETA_CCW
+    constexpr std::array<double, 4> ROLL_DIRECTION = {1.0, -1.0, 1.0, -1.0};
+    double roll_torque = 0.0;
+    for (int i = 0; i < 4; i++) {
+        roll_throttle_[i] = lag(roll_throttle_[i], pulse_to_throttle(pulses_us[BETA_TOP + i]), ROLL_PROP_TIME_CONSTANT_S, dt);
+        roll_torque += ROLL_DIRECTION[i] * roll_throttle_[i] * ROLL_PROP_TORQUE_N_M;
+    }
+
+    const Vec<3, double> force_b = {{
+        thrust_n_ * tilt_sin[0],
+        thrust_n_ * tilt_sin[1],
+        -thrust_n_ * std::sqrt(std::max(0.0, 1.0 - tilt_sin[0] * tilt_sin[0] - tilt_sin[1] * tilt_sin[1])),
+    }};
+    return {
+        .force_b = force_b,
+        .torque_b = {{-THRUST_ARM_M * force_b[1], THRUST_ARM_M * force_b[0], roll_torque}},
+    };
+}
@@ -0,0 +1,43 @@
+#ifndef APP_SIM_HORNET_PROPULSION_MODEL_H
+#define APP_SIM_HORNET_PROPULSION_MODEL_H
+
+#include "../Matrix.h"
+#include <array>
+#include <cstdint>
+
+/// Force and torque of the Hornet's propellers in body axes, through the center of mass [N] [N m].
+struct HornetWrench {
+    Vec<3, double> force_b;
+    Vec<3, double> torque_b;
+};
+
+/// The Hornet's actuators as seen by the airframe, driven by the pulse widths [us] of its eight PWM channels in
+/// PwmKind order.
+///
+/// The coaxial main propellers make the thrust curve HornetThrottle inverts, after a first-order spin-up lag; their
+/// reaction torques cancel. The gimbal servos slew towards their commanded angle and tilt the thrust through the
+/// linkage HornetTvc inverts: SERVO_X tilts it towards body +x, a torque about +y, and SERVO_Y towards body +y, a
+/// torque about -x. The roll propellers each add a torque about body z, positive (clockwise seen from above) for
+/// BETA_TOP and BETA_CW and negative for BETA_BOTTOM and BETA_CCW.
+class HornetPropulsionModel {
+public:
+    static constexpr int NUM_CHANNELS = 8;
+
+    void reset();
+    HornetWrench step(const std::array<uint32_t, NUM_CHANNELS>& pulses_us, double dt);
+
+    double thrust_n() const { return thrust_n_; }
+    double gimbal_x_deg() const { return gimbal_deg_[0]; }
+    double gimbal_y_deg() const { return gimbal_deg_[1]; }
+
+    /// Total main propeller thrust at a steady throttle in [0, 1] [lbf].
+    static double thrust_lbf(double throttle);
+
+private:
+    double thrust_n_ = 0.0;
+    std::array<double, 2> servo_deg_{};
+    std::array<double, 2> gimbal_deg_{};
+    std::array<double, 4> roll_throttle_{};
+};
+
+#endif  // APP_SIM_HORNET_PROPULSION_MODEL_H
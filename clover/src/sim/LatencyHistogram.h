@@ -0,0 +1,82 @@
+#ifndef APP_SIM_LATENCY_HISTOGRAM_H
+#define APP_SIM_LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+/// Fixed-size log-linear histogram of durations [ns], for percentiles without keeping every sample. Durations below
+/// SUB_BUCKETS land in exact buckets; above that each power of two is split into SUB_BUCKETS equal buckets, so a
+/// bucket is never wider than 1/SUB_BUCKETS (6.25%) of the values in it. Durations saturate at 2^32 - 1 ns.
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr uint32_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr size_t NUM_BUCKETS = SUB_BUCKETS + (32 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    void add(uint64_t sample_ns)
+    {
+        const auto value = static_cast<uint32_t>(std::min<uint64_t>(sample_ns, std::numeric_limits<uint32_t>::max()));
+        buckets_[bucket_index(value)]++;
+        count_++;
+        total_ns_ += value;
+        min_ns_ = std::min(min_ns_, value);
+        max_ns_ = std::max(max_ns_, value);
+    }
+
+    void reset() { *this = {}; }
+
+    uint32_t count() const { return count_; }
+    uint32_t min_ns() const { return count_ ? min_ns_ : 0; }
+    uint32_t max_ns() const { return max_ns_; }
+    double mean_ns() const { return count_ ? static_cast<double>(total_ns_) / count_ : 0.0; }
+
+    /// Smallest bucket upper bound that at least a fraction q of the samples fall under, capped at the maximum. 0 if
+    /// empty.
+    uint32_t percentile_ns(double q) const
+    {
+        if (count_ == 0) {
+            return 0;
+        }
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * count_ + 0.999999));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; i++) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                return std::min(bucket_upper_ns(i), max_ns_);
+            }
+        }
+        return max_ns_;
+    }
+
+    static constexpr size_t bucket_index(uint32_t value)
+    {
+        if (value < SUB_BUCKETS) {
+            return value;
+        }
+        const uint32_t octave = static_cast<uint32_t>(std::bit_width(value)) - 1;  // >= SUB_BUCKET_BITS
+        const uint32_t shift = octave - SUB_BUCKET_BITS;
+        return SUB_BUCKETS + shift * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+    }
+
+    static constexpr uint32_t bucket_upper_ns(size_t index)
+    {
+        if (index < SUB_BUCKETS) {
+            return static_cast<uint32_t>(index);
+        }
+        const auto shift = static_cast<uint32_t>((index - SUB_BUCKETS) / SUB_BUCKETS);
+        const auto sub = static_cast<uint64_t>((index - SUB_BUCKETS) % SUB_BUCKETS);
+        return static_cast<uint32_t>((((SUB_BUCKETS + sub + 1) << shift) - 1));
+    }
+
+private:
+    std::array<uint32_t, NUM_BUCKETS> buckets_ = {};
+    uint32_t count_ = 0;
+    uint64_t total_ns_ = 0;
+    uint32_t min_ns_ = std::numeric_limits<uint32_t>::max();
+    uint32_t max_ns_ = 0;
+};
+
+#endif  // APP_SIM_LATENCY_HISTOGRAM_H
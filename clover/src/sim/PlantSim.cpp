@@ -0,0 +1,409 @@
+#include "PlantSim.h"
+#include "../config.h"
+#include "HornetPropulsionModel.h"
+#include "RangerEngineModel.h"
+#include "RigidBodyModel.h"
+#include "SensorFrames.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#ifdef CONFIG_ANALOG_SENSORS
+#include "../sensors/AnalogSensors.h"
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#endif
+
+#ifdef CONFIG_THROTTLE_VALVES
+#include "../ThrottleValve.h"
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#endif
+
+#ifdef CONFIG_PWM_ACTUATORS
+#include "../PwmActuator.h"
+#include <zephyr/drivers/pwm/pwm_fake.h>
+#include <zephyr/fff.h>
+#endif
+
+#if defined(CONFIG_LIDAR) || defined(CONFIG_IMU) || defined(CONFIG_GNSS)
+#include <zephyr/drivers/serial/uart_emul.h>
+#endif
+
+LOG_MODULE_REGISTER(PlantSim, CONFIG_LOG_DEFAULT_LEVEL);
+
+static constexpr uint64_t PLANT_STEP_NS = 250'000;
+static constexpr double PLANT_STEP_S = PLANT_STEP_NS * 1e-9;
+static constexpr uint64_t GNSS_EPOCH_NS = 100'000'000;  // 10 Hz, set in the receiver rather than by the driver
+
+// Sensor noise, 1-sigma
+static constexpr double PT_NOISE_PSI = 1.0;
+static constexpr double GYRO_NOISE_RAD_S = 0.002;
+static constexpr double ACCEL_NOISE_M_S2 = 0.02;
+static constexpr double LIDAR_NOISE_M = 0.01;
+static constexpr double GNSS_POS_NOISE_M = 0.02;
+static constexpr double GNSS_VEL_NOISE_M_S = 0.02;
+
+static constexpr double VALVE_CLOSED_STOP_DEG = -2.0;
+static constexpr double VALVE_OPEN_STOP_DEG = 93.0;
+
+static const RigidBodyParams VEHICLE_PARAMS = {
+    .mass_kg = 6.8,
+    .inertia_kg_m2 = {{0.12, 0.12, 0.05}},
+    .linear_drag_n_s_m = 0.1,
+    .angular_drag_n_m_s = 0.01,
+};
+
+// Earth field in NED [Gauss]
+static constexpr double MAG_NED_GAUSS[3] = {0.22, 0.0, 0.42};
+
+K_SEM_DEFINE(plant_sim_ready_sem, 0, 1);
+
+/// Guards what the emulated devices' callbacks share with the plant thread, as they run in their drivers' threads.
+static k_spinlock plant_lock;
+
+static RigidBodyModel vehicle{VEHICLE_PARAMS};
+
+// -----------------------------------------------------------------------------
+// Noise
+// -----------------------------------------------------------------------------
+// Fixed-seed xorshift, so a run is repeatable for the same inputs and timing.
+struct Noise {
+    uint64_t state;
+
+    double uniform()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return static_cast<double>((state * 0x2545F4914F6CDD1DULL) >> 11) * 0x1.0p-53;
+    }
+
+    double gaussian(double sigma)
+    {
+        const double u1 = std::max(uniform(), 1e-300);
+        const double u2 = uniform();
+        return sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::numbers::pi * u2);
+    }
+};
+
+static Noise sensor_noise{0x9E3779B97F4A7C15ULL};  // Plant thread only
+static Noise pt_noise{0xD1B54A32D192ED03ULL};      // Under plant_lock
+
+// -----------------------------------------------------------------------------
+// Ranger feed system and engine
+// -----------------------------------------------------------------------------
+#ifdef CONFIG_THROTTLE_VALVES
+static constexpr gpio_dt_spec FUEL_ENA_GPIO = GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), fuel_valve_stepper_ena_gpios);
+static constexpr gpio_dt_spec LOX_ENA_GPIO = GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), lox_valve_stepper_ena_gpios);
+
+static StepperValveModel fuel_valve{VALVE_CLOSED_STOP_DEG, VALVE_OPEN_STOP_DEG};
+static StepperValveModel lox_valve{VALVE_CLOSED_STOP_DEG, VALVE_OPEN_STOP_DEG};
+static RangerEngineModel engine;
+
+static void step_engine()
+{
+    const bool fuel_enabled = gpio_emul_output_get(FUEL_ENA_GPIO.port, FUEL_ENA_GPIO.pin) > 0;
+    const bool lox_enabled = gpio_emul_output_get(LOX_ENA_GPIO.port, LOX_ENA_GPIO.pin) > 0;
+    fuel_valve.step(FuelValveStepGenerator::steps_sent() * static_cast<double>(DEG_PER_STEP), fuel_enabled);
+    lox_valve.step(LoxValveStepGenerator::steps_sent() * static_cast<double>(DEG_PER_STEP), lox_enabled);
+    FuelValveEncoder::drive(static_cast<int>(std::lround(fuel_valve.position_deg() / DEG_PER_ENCODER_COUNT)));
+    LoxValveEncoder::drive(static_cast<int>(std::lround(lox_valve.position_deg() / DEG_PER_ENCODER_COUNT)));
+
+    k_spinlock_key_t key = k_spin_lock(&plant_lock);
+    engine.step(fuel_valve.position_deg(), lox_valve.position_deg(), PLANT_STEP_S);
+    k_spin_unlock(&plant_lock, key);
+}
+#endif  // CONFIG_THROTTLE_VALVES
+
+// -----------------------------------------------------------------------------
+// Engine PTs
+// -----------------------------------------------------------------------------
+#if defined(CONFIG_ANALOG_SENSORS) && defined(CONFIG_THROTTLE_VALVES)
+static constexpr float SIM_PT_RANGE_PSIG = 1000.0f;
+static constexpr int SIM_ADC_REF_MV = DT_PROP(DT_PHANDLE_BY_IDX(DT_PATH(zephyr_user), analog_sensor_adcs, 0), ref_internal_mv);
+
+struct SimPt {
+    uint32_t channel;  // Index into zephyr,user io-channels
+    AnalogSensor assignment;
+    double RangerEngineState::* psi;
+};
+
+// Default assignment, applied at init so a standalone run needs no ConfigureAnalogSensorsRequest
+static const SimPt SIM_PTS[] = {
+    {0, AnalogSensor_PTC401, &RangerEngineState::p_ch_psi},
+    {1, AnalogSensor_PTC402, &RangerEngineState::p_ch_psi},
+    {2, AnalogSensor_PTF401, &RangerEngineState::fuel_inlet_psi},
+    {3, AnalogSensor_PTO401, &RangerEngineState::lox_inlet_psi},
+    {4, AnalogSensor_PT203, &RangerEngineState::fuel_manifold_psi},
+    {5, AnalogSensor_PT103, &RangerEngineState::lox_manifold_psi},
+    {6, AnalogSensor_PT001, &RangerEngineState::fuel_tank_psi},
+    {7, AnalogSensor_PT002, &RangerEngineState::lox_tank_psi},
+};
+
+#define LAMBDA(node_id, prop, idx) ADC_DT_SPEC_GET_BY_IDX(node_id, idx)
+static constexpr adc_dt_spec SIM_ADC_CHANNELS[] = {DT_FOREACH_PROP_ELEM_SEP(DT_PATH(zephyr_user), io_channels, LAMBDA, (, ))};
+#undef LAMBDA
+
+/// Sampled by adc-emul on every read, so each reading gets fresh noise.
+static int sample_pt(const device*, unsigned int, void* data, uint32_t* result)
+{
+    const SimPt& pt = *static_cast<const SimPt*>(data);
+
+    k_spinlock_key_t key = k_spin_lock(&plant_lock);
+    const double psi = engine.state().*pt.psi + pt_noise.gaussian(PT_NOISE_PSI);
+    k_spin_unlock(&plant_lock, key);
+    *result = static_cast<uint32_t>(std::clamp(psi / SIM_PT_RANGE_PSIG * SIM_ADC_REF_MV, 0.0, static_cast<double>(SIM_ADC_REF_MV)));
+    return 0;
+}
+
+static std::expected<void, Error> init_pts()
+{
+    ConfigureAnalogSensorsRequest req = ConfigureAnalogSensorsRequest_init_default;
+    for (const SimPt& pt : SIM_PTS) {
+        const adc_dt_spec& spec = SIM_ADC_CHANNELS[pt.channel];
+        if (int err = adc_emul_value_func_set(spec.dev, spec.channel_id, sample_pt, const_cast<SimPt*>(&pt))) {
+            return std::unexpected(Error::from_code(err).context("failed to attach PT to emulated ADC channel %d", spec.channel_id));
+        }
+
+        AnalogSensorConfig& config = req.configs[req.configs_count++];
+        config.channel = pt.channel;
+        config.assignment = pt.assignment;
+        config.has_pt_range_psig = true;
+        config.pt_range_psig = SIM_PT_RANGE_PSIG;
+        config.has_pt_bias_psig = true;
+        config.pt_bias_psig = 0.0f;
+    }
+    return AnalogSensors::handle_configure_analog_sensors(req);
+}
+#endif  // CONFIG_ANALOG_SENSORS && CONFIG_THROTTLE_VALVES
+
+// -----------------------------------------------------------------------------
+// Hornet propellers
+// -----------------------------------------------------------------------------
+#ifdef CONFIG_PWM_ACTUATORS
+DEFINE_FFF_GLOBALS;
+
+static const device* const SIM_PWM = DEVICE_DT_GET(DT_PWMS_CTLR_BY_NAME(DT_PATH(zephyr_user), motor_top));
+static uint64_t pwm_cycles_per_sec = 0;
+static HornetPropulsionModel propulsion;
+static std::array<uint32_t, HornetPropulsionModel::NUM_CHANNELS> pulses_us = {
+    MIN_PWM_PULSE_US, MIN_PWM_PULSE_US, MIN_PWM_PULSE_US, MIN_PWM_PULSE_US,
+    MIN_PWM_PULSE_US, MIN_PWM_PULSE_US, MIN_PWM_PULSE_US, MIN_PWM_PULSE_US};
+
+/// Replaces the fake-pwm driver's set_cycles. Channel numbers are PwmKind indices in the devicetree.
+static int record_pwm(const device*, uint32_t channel, uint32_t, uint32_t pulse, pwm_flags_t)
+{
+    if (channel < pulses_us.size()) {
+        k_spinlock_key_t key = k_spin_lock(&plant_lock);
+        pulses_us[channel] = static_cast<uint32_t>(pulse * USEC_PER_SEC / pwm_cycles_per_sec);
+        k_spin_unlock(&plant_lock, key);
+    }
+    return 0;
+}
+
+static std::expected<void, Error> init_pwms()
+{
+    static_assert(static_cast<int>(PwmKind::MOTOR_BOTTOM) == HornetPropulsionModel::NUM_CHANNELS - 1);
+
+    if (int err = pwm_get_cycles_per_sec(SIM_PWM, 0, &pwm_cycles_per_sec)) {
+        return std::unexpected(Error::from_code(err).context("failed to get fake PWM frequency"));
+    }
+    fake_pwm_set_cycles_fake.custom_fake = record_pwm;
+    return {};
+}
+#endif  // CONFIG_PWM_ACTUATORS
+
+// -----------------------------------------------------------------------------
+// Vehicle
+// -----------------------------------------------------------------------------
+static void step_vehicle()
+{
+#ifdef CONFIG_PWM_ACTUATORS
+    k_spinlock_key_t key = k_spin_lock(&plant_lock);
+    const std::array<uint32_t, HornetPropulsionModel::NUM_CHANNELS> pulses = pulses_us;
+    k_spin_unlock(&plant_lock, key);
+
+    const HornetWrench wrench = propulsion.step(pulses, PLANT_STEP_S);
+    vehicle.step(wrench.force_b, wrench.torque_b, PLANT_STEP_S);
+#else
+    // On the test stand, held whatever the engine does
+    vehicle.step({}, {}, PLANT_STEP_S);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Serial sensors
+// -----------------------------------------------------------------------------
+#ifdef CONFIG_LIDAR
+static const device* const LIDAR_UARTS[] = {DEVICE_DT_GET(DT_ALIAS(lidar_1_uart)), DEVICE_DT_GET(DT_ALIAS(lidar_2_uart))};
+static constexpr uint64_t LIDAR_FRAME_NS = NSEC_PER_SEC / CONFIG_LIDAR_FRAME_RATE_HZ;
+static uint64_t next_lidar_ns = 0;
+
+static void send_lidar()
+{
+    // Pointing along body +z, reporting slant range to the pad or nothing once it is out of view
+    const double tilt_cos = vehicle.rotation()(2, 2);
+    for (const device* uart : LIDAR_UARTS) {
+        uint8_t frame[SensorFrames::TF_LIDAR_FRAME_SIZE];
+        if (tilt_cos > 0.1) {
+            const double distance = std::max(0.0, -vehicle.position_ned()[2] / tilt_cos + sensor_noise.gaussian(LIDAR_NOISE_M));
+            SensorFrames::encode_tf_lidar(frame, distance, 1000, 25.0);
+        }
+        else {
+            SensorFrames::encode_tf_lidar(frame, 0.0, 0, 25.0);
+        }
+        uart_emul_put_rx_data(uart, frame, sizeof(frame));
+        uart_emul_flush_tx_data(uart);
+    }
+}
+#endif  // CONFIG_LIDAR
+
+#ifdef CONFIG_IMU
+static const device* const IMU_UART = DEVICE_DT_GET(DT_ALIAS(imu_uart));
+static constexpr uint64_t IMU_SAMPLE_NS = NSEC_PER_SEC / CONFIG_IMU_VN_OUTPUT_RATE_HZ;
+static uint64_t next_imu_ns = 0;
+
+static void send_imu(uint64_t now_ns)
+{
+    const Matrix<3, 3, double> r = vehicle.rotation();
+    const Vec<4, double>& q = vehicle.attitude();
+    const Vec<3, double>& gyro = vehicle.angular_rate_b();
+    const Vec<3, double>& accel = vehicle.specific_force_b();
+
+    SensorFrames::VnBinarySample sample = {
+        .time_startup_ns = now_ns,
+        .quat = {static_cast<float>(q[1]), static_cast<float>(q[2]), static_cast<float>(q[3]), static_cast<float>(q[0])},
+        .gyro = {},
+        .accel = {},
+        .mag = {},
+        .temperature_c = 25.0f,
+        .pressure_kpa = 101.3f,
+        .ins_status = 0x0002,  // INS tracking
+    };
+    for (int i = 0; i < 3; i++) {
+        sample.gyro[i] = static_cast<float>(gyro[i] + sensor_noise.gaussian(GYRO_NOISE_RAD_S));
+        sample.accel[i] = static_cast<float>(accel[i] + sensor_noise.gaussian(ACCEL_NOISE_M_S2));
+        // Body axis i is column i of the body to NED rotation
+        sample.mag[i] = static_cast<float>(r(0, i) * MAG_NED_GAUSS[0] + r(1, i) * MAG_NED_GAUSS[1] + r(2, i) * MAG_NED_GAUSS[2]);
+    }
+
+    uint8_t packet[SensorFrames::VN_BINARY_PACKET_SIZE];
+    SensorFrames::encode_vn_binary(packet, sample);
+    uart_emul_put_rx_data(IMU_UART, packet, sizeof(packet));
+    uart_emul_flush_tx_data(IMU_UART);
+}
+#endif  // CONFIG_IMU
+
+#ifdef CONFIG_GNSS
+static const device* const GNSS_UART = DEVICE_DT_GET(DT_ALIAS(gnss_uart));
+static uint64_t next_gnss_ns = 0;
+
+static void send_gnss(uint64_t now_ns)
+{
+    const Vec<3, double>& position = vehicle.position_ned();
+    const Vec<3, double>& velocity = vehicle.velocity_ned();
+
+    const SensorFrames::GnssEpoch epoch = {
+        .time_ms = static_cast<uint32_t>(now_ns / NSEC_PER_MSEC % (24ULL * 3600 * MSEC_PER_SEC)),
+        .north_m = position[0] + sensor_noise.gaussian(GNSS_POS_NOISE_M),
+        .east_m = position[1] + sensor_noise.gaussian(GNSS_POS_NOISE_M),
+        .up_m = -position[2] + sensor_noise.gaussian(GNSS_POS_NOISE_M),
+        .velocity_m_s = {static_cast<float>(velocity[0] + sensor_noise.gaussian(GNSS_VEL_NOISE_M_S)),
+            static_cast<float>(velocity[1] + sensor_noise.gaussian(GNSS_VEL_NOISE_M_S)),
+            static_cast<float>(-velocity[2] + sensor_noise.gaussian(GNSS_VEL_NOISE_M_S))},
+        .pos_sigma_m = static_cast<float>(GNSS_POS_NOISE_M),
+        .vel_sigma_m_s = static_cast<float>(GNSS_VEL_NOISE_M_S),
+        .sol_type = 4,  // RTK fixed
+    };
+
+    uint8_t frames[SensorFrames::GREIS_EPOCH_MAX_SIZE];
+    const size_t len = SensorFrames::encode_greis_epoch(frames, epoch);
+    uart_emul_put_rx_data(GNSS_UART, frames, len);
+}
+#endif  // CONFIG_GNSS
+
+// -----------------------------------------------------------------------------
+// Plant thread
+// -----------------------------------------------------------------------------
+static void step(uint64_t now_ns)
+{
+#ifdef CONFIG_THROTTLE_VALVES
+    step_engine();
+#endif
+    step_vehicle();
+
+#ifdef CONFIG_LIDAR
+    if (now_ns >= next_lidar_ns) {
+        next_lidar_ns += LIDAR_FRAME_NS;
+        send_lidar();
+    }
+#endif
+#ifdef CONFIG_IMU
+    if (now_ns >= next_imu_ns) {
+        next_imu_ns += IMU_SAMPLE_NS;
+        send_imu(now_ns);
+    }
+#endif
+#ifdef CONFIG_GNSS
+    if (now_ns >= next_gnss_ns) {
+        next_gnss_ns += GNSS_EPOCH_NS;
+        send_gnss(now_ns);
+    }
+#endif
+}
+
+static void run()
+{
+    // Await initialization
+    k_sem_take(&plant_sim_ready_sem, K_FOREVER);
+    LOG_INF("Plant simulation started");
+
+    uint64_t now_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+#ifdef CONFIG_LIDAR
+    next_lidar_ns = now_ns;
+#endif
+#ifdef CONFIG_IMU
+    next_imu_ns = now_ns;
+#endif
+#ifdef CONFIG_GNSS
+    next_gnss_ns = now_ns;
+#endif
+
+    while (true) {
+        now_ns += PLANT_STEP_NS;
+        k_sleep(K_TIMEOUT_ABS_NS(now_ns));
+        step(now_ns);
+    }
+}
+
+K_THREAD_DEFINE(plant_sim, 4096, run, nullptr, nullptr, nullptr, PLANT_SIM_THREAD_PRIORITY, 0, 0);
+
+std::expected<void, Error> PlantSim::init()
+{
+    vehicle.reset();
+#ifdef CONFIG_THROTTLE_VALVES
+    fuel_valve.reset(0.0, 0.0);
+    lox_valve.reset(0.0, 0.0);
+    engine.reset();
+#endif
+
+#if defined(CONFIG_ANALOG_SENSORS) && defined(CONFIG_THROTTLE_VALVES)
+    if (auto result = init_pts(); !result) {
+        return result;
+    }
+#endif
+
+#ifdef CONFIG_PWM_ACTUATORS
+    propulsion.reset();
+    if (auto result = init_pwms(); !result) {
+        return result;
+    }
+#endif
+
+    k_sem_give(&plant_sim_ready_sem);
+    return {};
+}
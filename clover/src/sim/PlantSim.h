@@ -0,0 +1,30 @@
+#ifndef APP_SIM_PLANT_SIM_H
+#define APP_SIM_PLANT_SIM_H
+
+#include "../Error.h"
+#include <expected>
+
+#ifdef CONFIG_PLANT_SIM
+
+/// Closed-loop plant for native_sim. A thread steps the engine and vehicle models every PLANT_STEP_NS of simulated
+/// time, reading the actuators the controller drives and writing what the sensors would see back into the emulated
+/// devices:
+///   throttle valves  SimStepGenerator steps and the ENA GPIO in, SimQuadratureEncoder counts out
+///   PTs              adc-emul channels, sampled whenever AnalogSensors reads
+///   lidars, IMU, GNSS  frames pushed into uart-emul receive FIFOs at the rates the drivers configure
+///   Hornet PWMs      fake-pwm writes in
+///
+/// Ranger sits clamped to the test stand, so only its feed system and engine move. Hornet flies its 6-DOF body. The
+/// real controller, estimator and sensor drivers run unmodified on top, faster than real time unless native_sim is
+/// slowed down with --rt.
+namespace PlantSim {
+
+/// Attach to the emulated devices, assign the emulated PTs to their ADC channels and start stepping. Call before the
+/// sensors are initialized.
+std::expected<void, Error> init();
+
+}  // namespace PlantSim
+
+#endif  // CONFIG_PLANT_SIM
+
+#endif  // APP_SIM_PLANT_SIM_H
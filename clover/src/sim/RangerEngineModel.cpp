@@ -0,0 +1,132 @@
+#include "RangerEngineModel.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr double PA_PER_PSI = 6894.76;
+static constexpr double LBF_PER_N = 0.224809;
+
+// mdot [kg/s] = CV_TO_KG_S * Cv * sqrt(SG * dp [psi]), from Q [gpm] = Cv sqrt(dp / SG)
+static constexpr double CV_TO_KG_S = 0.06309;
+
+static constexpr double FUEL_TANK_PSI = 750.0;
+static constexpr double LOX_TANK_PSI = 750.0;
+static constexpr double FUEL_SG = 0.806;
+static constexpr double LOX_SG = 1.141;
+
+// Valve Cv rises as ((angle - CRACK) / (90 - CRACK))^EXPONENT to its full-open value at 90 deg
+static constexpr double FUEL_VALVE_CV_OPEN = 1.557;
+static constexpr double FUEL_VALVE_CRACK_DEG = 10.0;
+static constexpr double FUEL_VALVE_CV_EXPONENT = 2.0;
+static constexpr double LOX_VALVE_CV_OPEN = 0.976;
+static constexpr double LOX_VALVE_CRACK_DEG = 0.0;
+static constexpr double LOX_VALVE_CV_EXPONENT = 0.844;
+
+static constexpr double FUEL_INJECTOR_CV = 0.8;
+static constexpr double LOX_INJECTOR_CV = 0.9;
+
+// PTF-401 and PTO-401 read this far below the manifold PTs, matching RangerThrottle's engine inlet line losses
+static constexpr double FUEL_INLET_LINE_LOSS_PSI = 21.0;
+static constexpr double LOX_INLET_LINE_LOSS_PSI = 41.0;
+
+static constexpr double FEED_LINE_TIME_CONSTANT_S = 0.009;
+static constexpr double CHAMBER_TIME_CONSTANT_S = 0.003;
+
+static constexpr double THROAT_AREA_M2 = 7.78e-4;
+static constexpr double THRUST_COEFFICIENT = 1.4;
+static constexpr double PEAK_CSTAR_M_S = 1500.0;
+static constexpr double PEAK_CSTAR_OF = 1.4;
+
+static double valve_cv(double angle_deg, double cv_open, double crack_deg, double exponent)
+{
+    if (angle_deg <= crack_deg) {
+        return 0.0;
+    }
+    return cv_open * std::pow(std::min(1.0, (angle_deg - crack_deg) / (90.0 - crack_deg)), exponent);
+}
+
+static double series_cv(double valve_cv, double injector_cv)
+{
+    if (valve_cv <= 0.0) {
+        return 0.0;
+    }
+    return 1.0 / std::sqrt(1.0 / (valve_cv * valve_cv) + 1.0 / (injector_cv * injector_cv));
+}
+
+static double flow(double cv, double sg, double dp_psi)
+{
+    return CV_TO_KG_S * cv * std::sqrt(sg * std::max(0.0, dp_psi));
+}
+
+// Pressure drop across a flow coefficient at a mass flow [psi]
+static double pressure_drop(double mdot, double cv, double sg)
+{
+    const double q = mdot / (CV_TO_KG_S * cv);
+    return q * q / sg;
+}
+
+// Falls off either side of the best mixture ratio, floored at half so a lean or rich start still burns
+static double cstar(double of)
+{
+    const double off_peak = of - PEAK_CSTAR_OF;
+    return PEAK_CSTAR_M_S * std::max(0.5, 1.0 - 0.08 * off_peak * off_peak);
+}
+
+static double lag(double value, double target, double time_constant, double dt)
+{
+    return value + (target - value) * std::min(1.0, dt / time_constant);
+}
+
+void StepperValveModel::reset(double position_deg, double commanded_deg)
+{
+    position_deg_ = std::clamp(position_deg, closed_stop_deg_, open_stop_deg_);
+    last_commanded_deg_ = commanded_deg;
+}
+
+void StepperValveModel::step(double commanded_deg, bool enabled)
+{
+    const double delta = commanded_deg - last_commanded_deg_;
+    last_commanded_deg_ = commanded_deg;
+    if (enabled) {
+        position_deg_ = std::clamp(position_deg_ + delta, closed_stop_deg_, open_stop_deg_);
+    }
+}
+
+double RangerEngineModel::fuel_valve_cv(double angle_deg)
+{
+    return valve_cv(angle_deg, FUEL_VALVE_CV_OPEN, FUEL_VALVE_CRACK_DEG, FUEL_VALVE_CV_EXPONENT);
+}
+
+double RangerEngineModel::lox_valve_cv(double angle_deg)
+{
+    return valve_cv(angle_deg, LOX_VALVE_CV_OPEN, LOX_VALVE_CRACK_DEG, LOX_VALVE_CV_EXPONENT);
+}
+
+void RangerEngineModel::reset()
+{
+    state_ = {};
+    state_.fuel_tank_psi = FUEL_TANK_PSI;
+    state_.lox_tank_psi = LOX_TANK_PSI;
+}
+
+void RangerEngineModel::step(double fuel_valve_deg, double lox_valve_deg, double dt)
+{
+    // Flows respond to the chamber pressure of the previous step; the lags keep this explicit update stable for dt
+    // well below the chamber time constant.
+    const double fuel_cv = series_cv(fuel_valve_cv(fuel_valve_deg), FUEL_INJECTOR_CV);
+    const double lox_cv = series_cv(lox_valve_cv(lox_valve_deg), LOX_INJECTOR_CV);
+    const double fuel_target = flow(fuel_cv, FUEL_SG, state_.fuel_tank_psi - state_.p_ch_psi);
+    const double lox_target = flow(lox_cv, LOX_SG, state_.lox_tank_psi - state_.p_ch_psi);
+    state_.mdot_fuel = lag(state_.mdot_fuel, fuel_target, FEED_LINE_TIME_CONSTANT_S, dt);
+    state_.mdot_lox = lag(state_.mdot_lox, lox_target, FEED_LINE_TIME_CONSTANT_S, dt);
+
+    const double mdot = state_.mdot_fuel + state_.mdot_lox;
+    const double of = state_.mdot_lox / std::max(state_.mdot_fuel, 1e-3);
+    const double p_ch_target = mdot * cstar(of) / THROAT_AREA_M2 / PA_PER_PSI;
+    state_.p_ch_psi = lag(state_.p_ch_psi, p_ch_target, CHAMBER_TIME_CONSTANT_S, dt);
+
+    state_.fuel_manifold_psi = state_.p_ch_psi + pressure_drop(state_.mdot_fuel, FUEL_INJECTOR_CV, FUEL_SG);
+    state_.lox_manifold_psi = state_.p_ch_psi + pressure_drop(state_.mdot_lox, LOX_INJECTOR_CV, LOX_SG);
+    state_.fuel_inlet_psi = state_.fuel_manifold_psi - FUEL_INLET_LINE_LOSS_PSI;
+    state_.lox_inlet_psi = state_.lox_manifold_psi - LOX_INLET_LINE_LOSS_PSI;
+    state_.thrust_lbf = THRUST_COEFFICIENT * state_.p_ch_psi * PA_PER_PSI * THROAT_AREA_M2 * LBF_PER_N;
+}
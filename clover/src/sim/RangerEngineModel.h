@@ -0,0 +1,65 @@
+#ifndef APP_SIM_RANGER_ENGINE_MODEL_H
+#define APP_SIM_RANGER_ENGINE_MODEL_H
+
+/// Stepper-driven throttle valve between two hardstops. The shaft follows the commanded position exactly while the
+/// driver is enabled, and steps are lost, not queued, while it is disabled or pushing against a hardstop, just like a
+/// stalled stepper.
+class StepperValveModel {
+public:
+    constexpr StepperValveModel(double closed_stop_deg, double open_stop_deg)
+        : closed_stop_deg_(closed_stop_deg),
+          open_stop_deg_(open_stop_deg)
+    {
+    }
+
+    void reset(double position_deg, double commanded_deg);
+    void step(double commanded_deg, bool enabled);
+
+    double position_deg() const { return position_deg_; }
+
+private:
+    double closed_stop_deg_;
+    double open_stop_deg_;
+    double position_deg_ = 0.0;
+    double last_commanded_deg_ = 0.0;
+};
+
+/// Pressures and flows of the simulated engine. Pressures are gauge [psig], flows [kg/s].
+struct RangerEngineState {
+    double fuel_tank_psi;
+    double lox_tank_psi;
+    double fuel_manifold_psi;  // PT-203
+    double lox_manifold_psi;   // PT-103
+    double fuel_inlet_psi;     // PTF-401
+    double lox_inlet_psi;      // PTO-401
+    double p_ch_psi;
+    double mdot_fuel;
+    double mdot_lox;
+    double thrust_lbf;
+};
+
+/// Lumped feed-system and chamber model of the Ranger engine, driven by the two throttle valve angles.
+///
+/// Each propellant flows from a regulated tank through its throttle valve and injector in series, as incompressible
+/// liquid through two flow coefficients: mdot = 0.06309 Cv_eff sqrt(SG dp) with 1/Cv_eff^2 = 1/Cv_valve^2 +
+/// 1/Cv_injector^2. Line inertia delays each flow by a first-order lag, and the chamber fills towards
+/// mdot_total c*(OF) / A_t with another. Thrust is CF p_ch A_t.
+///
+/// Valve characteristics and c* were fitted so the steady state follows the thrust LUTs, 400 to 675 lbf along their
+/// contour at an OF of about 1.4 to 1.6. It is a plant for closing the throttle loop, not a performance prediction.
+class RangerEngineModel {
+public:
+    void reset();
+    void step(double fuel_valve_deg, double lox_valve_deg, double dt);
+
+    const RangerEngineState& state() const { return state_; }
+
+    /// Flow coefficient of a throttle valve at an angle [deg].
+    static double fuel_valve_cv(double angle_deg);
+    static double lox_valve_cv(double angle_deg);
+
+private:
+    RangerEngineState state_{};
+};
+
+#endif  // APP_SIM_RANGER_ENGINE_MODEL_H
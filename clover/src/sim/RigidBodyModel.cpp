@@ -0,0 +1,81 @@
+#include "RigidBodyModel.h"
+#include <cmath>
+
+static constexpr double GRAVITY_M_S2 = 9.80665;
+
+void RigidBodyModel::reset()
+{
+    position_ned_ = {};
+    velocity_ned_ = {};
+    attitude_ = {{1.0, 0.0, 0.0, 0.0}};
+    angular_rate_b_ = {};
+    specific_force_b_ = {{0.0, 0.0, -GRAVITY_M_S2}};
+    on_pad_ = true;
+}
+
+Matrix<3, 3, double> RigidBodyModel::rotation() const
+{
+    const double w = attitude_[0];
+    const double x = attitude_[1];
+    const double y = attitude_[2];
+    const double z = attitude_[3];
+    return {{
+        1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y - w * z), 2.0 * (x * z + w * y),
+        2.0 * (x * y + w * z), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z - w * x),
+        2.0 * (x * z - w * y), 2.0 * (y * z + w * x), 1.0 - 2.0 * (x * x + y * y),
+    }};
+}
+
+void RigidBodyModel::step(const Vec<3, double>& force_b, const Vec<3, double>& torque_b, double dt)
+{
+    const Matrix<3, 3, double> r = rotation();
+    const Vec<3, double> gravity_ned = {{0.0, 0.0, GRAVITY_M_S2}};
+    Vec<3, double> accel_ned = r * force_b / params_.mass_kg - velocity_ned_ * (params_.linear_drag_n_s_m / params_.mass_kg);
+    accel_ned += gravity_ned;
+
+    // Resting on the pad until the net force lifts the body off it
+    on_pad_ = position_ned_[2] >= 0.0 && accel_ned[2] >= 0.0;
+    if (on_pad_) {
+        position_ned_[2] = 0.0;
+        velocity_ned_ = {};
+        angular_rate_b_ = {};
+        specific_force_b_ = transpose(r) * -gravity_ned;
+        return;
+    }
+
+    // Semi-implicit Euler: velocity first, then position with the new velocity
+    velocity_ned_ += accel_ned * dt;
+    position_ned_ += velocity_ned_ * dt;
+    if (position_ned_[2] > 0.0) {
+        position_ned_[2] = 0.0;
+        velocity_ned_ = {};
+        angular_rate_b_ = {};
+    }
+    specific_force_b_ = transpose(r) * (accel_ned - gravity_ned);
+
+    // Euler's equations with diagonal inertia: I dw/dt = tau - w x (I w)
+    Vec<3, double> momentum;
+    for (int i = 0; i < 3; i++) {
+        momentum[i] = params_.inertia_kg_m2[i] * angular_rate_b_[i];
+    }
+    const Vec<3, double> net_torque = torque_b - cross(angular_rate_b_, momentum) - angular_rate_b_ * params_.angular_drag_n_m_s;
+    for (int i = 0; i < 3; i++) {
+        angular_rate_b_[i] += net_torque[i] / params_.inertia_kg_m2[i] * dt;
+    }
+
+    // q <- q * exp(w dt / 2), renormalized
+    const double w = attitude_[0];
+    const double x = attitude_[1];
+    const double y = attitude_[2];
+    const double z = attitude_[3];
+    const double hx = 0.5 * angular_rate_b_[0] * dt;
+    const double hy = 0.5 * angular_rate_b_[1] * dt;
+    const double hz = 0.5 * angular_rate_b_[2] * dt;
+    attitude_ = {{
+        w - x * hx - y * hy - z * hz,
+        x + w * hx + y * hz - z * hy,
+        y + w * hy + z * hx - x * hz,
+        z + w * hz + x * hy - y * hx,
+    }};
+    attitude_ = normalized(attitude_);
+}
@@ -0,0 +1,55 @@
+#ifndef APP_SIM_RIGID_BODY_MODEL_H
+#define APP_SIM_RIGID_BODY_MODEL_H
+
+#include "../Matrix.h"
+
+/// Mass and inertia of a simulated vehicle. Inertia is about the body axes through the center of mass, which are
+/// taken as principal.
+struct RigidBodyParams {
+    double mass_kg;
+    Vec<3, double> inertia_kg_m2;
+    double linear_drag_n_s_m;     // Opposes velocity
+    double angular_drag_n_m_s;    // Opposes angular rate
+};
+
+/// Six-degree-of-freedom rigid body over a flat pad, in the estimator's conventions: NED position with the pad at
+/// z = 0, and an attitude quaternion (w, x, y, z) rotating body to NED with body z down.
+///
+/// The pad holds the body until the applied force lifts it, and stops it dead if it comes back down. Attitude is held
+/// on the pad too, so a vehicle on its legs or on a test stand stays level whatever torque is applied.
+class RigidBodyModel {
+public:
+    explicit RigidBodyModel(const RigidBodyParams& params)
+        : params_(params)
+    {
+        reset();
+    }
+
+    /// At rest and level on the pad, facing north.
+    void reset();
+
+    /// Advance by dt under a force and torque in body axes, excluding gravity.
+    void step(const Vec<3, double>& force_b, const Vec<3, double>& torque_b, double dt);
+
+    const Vec<3, double>& position_ned() const { return position_ned_; }
+    const Vec<3, double>& velocity_ned() const { return velocity_ned_; }
+    const Vec<4, double>& attitude() const { return attitude_; }
+    const Vec<3, double>& angular_rate_b() const { return angular_rate_b_; }
+    /// What an accelerometer at the center of mass reads, acceleration minus gravity in body axes [m/s^2]
+    const Vec<3, double>& specific_force_b() const { return specific_force_b_; }
+    bool on_pad() const { return on_pad_; }
+
+    /// Body to NED rotation of the current attitude.
+    Matrix<3, 3, double> rotation() const;
+
+private:
+    RigidBodyParams params_;
+    Vec<3, double> position_ned_;
+    Vec<3, double> velocity_ned_;
+    Vec<4, double> attitude_;
+    Vec<3, double> angular_rate_b_;
+    Vec<3, double> specific_force_b_;
+    bool on_pad_ = true;
+};
+
+#endif  // APP_SIM_RIGID_BODY_MODEL_H
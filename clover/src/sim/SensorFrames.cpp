@@ -0,0 +1,132 @@
+#include "SensorFrames.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace SensorFrames {
+
+void encode_tf_lidar(uint8_t out[TF_LIDAR_FRAME_SIZE], double distance_m, uint16_t strength, double temperature_c)
+{
+    const auto distance_cm = static_cast<uint16_t>(std::clamp(std::lround(distance_m * 100.0), 0L, 65535L));
+    // Chip temperature is reported as (degC + 256) * 8
+    const auto temperature = static_cast<uint16_t>(std::clamp(std::lround((temperature_c + 256.0) * 8.0), 0L, 65535L));
+
+    out[0] = 0x59;
+    out[1] = 0x59;
+    out[2] = distance_cm & 0xFF;
+    out[3] = distance_cm >> 8;
+    out[4] = strength & 0xFF;
+    out[5] = strength >> 8;
+    out[6] = temperature & 0xFF;
+    out[7] = temperature >> 8;
+
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < TF_LIDAR_FRAME_SIZE - 1; i++) {
+        checksum += out[i];
+    }
+    out[8] = checksum;
+}
+
+uint16_t vn_crc16(const uint8_t* data, size_t len)
+{
+    uint16_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        crc = static_cast<uint16_t>((crc >> 8) | (crc << 8));
+        crc ^= data[i];
+        crc ^= static_cast<uint8_t>(crc & 0xFF) >> 4;
+        crc ^= static_cast<uint16_t>(crc << 12);
+        crc ^= static_cast<uint16_t>((crc & 0x00FF) << 5);
+    }
+    return crc;
+}
+
+void encode_vn_binary(uint8_t out[VN_BINARY_PACKET_SIZE], const VnBinarySample& sample)
+{
+    // Sync, group 1 (common), fields TimeStartup | Quaternion | AngularRate | Accel | MagPres | InsStatus
+    out[0] = 0xFA;
+    out[1] = 0x01;
+    out[2] = 0x31;
+    out[3] = 0x15;
+    memcpy(out + 4, &sample.time_startup_ns, 8);
+    memcpy(out + 12, sample.quat, 16);
+    memcpy(out + 28, sample.gyro, 12);
+    memcpy(out + 40, sample.accel, 12);
+    memcpy(out + 52, sample.mag, 12);
+    memcpy(out + 64, &sample.temperature_c, 4);
+    memcpy(out + 68, &sample.pressure_kpa, 4);
+    out[72] = sample.ins_status & 0xFF;
+    out[73] = sample.ins_status >> 8;
+
+    const uint16_t crc = vn_crc16(out + 1, VN_BINARY_PACKET_SIZE - 3);
+    out[74] = crc >> 8;
+    out[75] = crc & 0xFF;
+}
+
+uint8_t greis_checksum(const uint8_t* message, size_t len)
+{
+    auto rot_left = [](uint8_t val) -> uint8_t { return static_cast<uint8_t>((val << 2) | (val >> 6)); };
+    uint8_t res = 0;
+    for (size_t i = 0; i < len; i++) {
+        res = rot_left(res) ^ message[i];
+    }
+    return rot_left(res);
+}
+
+// Append one message: ID, body length as three hex digits, payload, checksum, line feed
+static size_t put_greis(uint8_t* out, const char id[2], const uint8_t* payload, size_t payload_len)
+{
+    const size_t body_len = payload_len + 1;
+    out[0] = static_cast<uint8_t>(id[0]);
+    out[1] = static_cast<uint8_t>(id[1]);
+    char length[4];
+    snprintf(length, sizeof(length), "%03X", static_cast<unsigned>(body_len));
+    memcpy(out + 2, length, 3);
+    memcpy(out + 5, payload, payload_len);
+    out[5 + payload_len] = greis_checksum(out, 5 + payload_len);
+    out[6 + payload_len] = '\n';
+    return 7 + payload_len;
+}
+
+size_t encode_greis_epoch(uint8_t out[GREIS_EPOCH_MAX_SIZE], const GnssEpoch& epoch)
+{
+    size_t len = 0;
+
+    // [ST] {6}: u4 time, u1 solType
+    uint8_t st[5];
+    memcpy(st, &epoch.time_ms, 4);
+    st[4] = epoch.sol_type;
+    len += put_greis(out + len, "ST", st, sizeof(st));
+
+    // [mp] {45}: f8 n, f8 e, f8 u, f8 sep, f4 pSigma, u1 solType, u1 grid, u1 geoid, u2 prj, u1 gridZone, u2 chIssue
+    uint8_t mp[44] = {};
+    memcpy(mp + 0, &epoch.north_m, 8);
+    memcpy(mp + 8, &epoch.east_m, 8);
+    memcpy(mp + 16, &epoch.up_m, 8);
+    memcpy(mp + 32, &epoch.pos_sigma_m, 4);
+    mp[36] = epoch.sol_type;
+    len += put_greis(out + len, "mp", mp, sizeof(mp));
+
+    // [VE] {18}: f4 x, f4 y, f4 z, f4 vSigma, u1 solType
+    uint8_t ve[17];
+    memcpy(ve, epoch.velocity_m_s, 12);
+    memcpy(ve + 12, &epoch.vel_sigma_m_s, 4);
+    ve[16] = epoch.sol_type;
+    len += put_greis(out + len, "VE", ve, sizeof(ve));
+
+    // [SG] {18}: f4 hpos, f4 vpos, f4 hvel, f4 vvel, u1 solType
+    uint8_t sg[17];
+    const float sigmas[4] = {epoch.pos_sigma_m, epoch.pos_sigma_m, epoch.vel_sigma_m_s, epoch.vel_sigma_m_s};
+    memcpy(sg, sigmas, 16);
+    sg[16] = epoch.sol_type;
+    len += put_greis(out + len, "SG", sg, sizeof(sg));
+
+    // [~~] {5}: u4 tod
+    uint8_t rt[4];
+    memcpy(rt, &epoch.time_ms, 4);
+    len += put_greis(out + len, "~~", rt, sizeof(rt));
+
+    return len;
+}
+
+}  // namespace SensorFrames
@@ -0,0 +1,54 @@
+#ifndef APP_SIM_SENSOR_FRAMES_H
+#define APP_SIM_SENSOR_FRAMES_H
+
+#include <cstddef>
+#include <cstdint>
+
+/// Encoders for the serial output of the simulated sensors, byte for byte what the real ones send in the modes the
+/// sensor drivers configure.
+namespace SensorFrames {
+
+constexpr size_t TF_LIDAR_FRAME_SIZE = 9;
+constexpr size_t VN_BINARY_PACKET_SIZE = 76;
+constexpr size_t GREIS_EPOCH_MAX_SIZE = 160;
+
+/// TF-series lidar data frame: header, distance [cm], signal strength, chip temperature, checksum.
+void encode_tf_lidar(uint8_t out[TF_LIDAR_FRAME_SIZE], double distance_m, uint16_t strength, double temperature_c);
+
+/// One VN-300 binary output packet of the group the IMU driver configures.
+struct VnBinarySample {
+    uint64_t time_startup_ns;
+    float quat[4];  // x, y, z, w, body to NED
+    float gyro[3];  // [rad/s]
+    float accel[3];  // Specific force [m/s^2]
+    float mag[3];  // [Gauss]
+    float temperature_c;
+    float pressure_kpa;
+    uint16_t ins_status;
+};
+void encode_vn_binary(uint8_t out[VN_BINARY_PACKET_SIZE], const VnBinarySample& sample);
+
+/// VectorNav CRC-16 (CCITT), big-endian in the packet so the CRC over a whole packet after the sync byte is zero.
+uint16_t vn_crc16(const uint8_t* data, size_t len);
+
+/// One GNSS receiver epoch, sent as the GREIS messages the GNSS driver decodes.
+struct GnssEpoch {
+    uint32_t time_ms;  // Receiver time of day
+    double north_m;
+    double east_m;
+    double up_m;
+    float velocity_m_s[3];  // North, east, up
+    float pos_sigma_m;
+    float vel_sigma_m_s;
+    uint8_t sol_type;
+};
+
+/// Encode [ST], [mp], [VE], [SG] and finally [~~], which completes the epoch in the driver. Returns the length.
+size_t encode_greis_epoch(uint8_t out[GREIS_EPOCH_MAX_SIZE], const GnssEpoch& epoch);
+
+/// GREIS checksum over the message ID, length field and body up to its last byte, where it goes.
+uint8_t greis_checksum(const uint8_t* message, size_t len);
+
+}  // namespace SensorFrames
+
+#endif  // APP_SIM_SENSOR_FRAMES_H
@@ -0,0 +1,19 @@
+/*
+>>> GENERATED FILE <<<
+
+Re-create this from a benchmark run on the CI host whenever the controller's cost changes on purpose, by running from the
+arty directory:
+
+```
+uv --project ~/arty/scripts run ~/arty/scripts/gen_controller_benchmark_baseline.py hornet bench.log ../clover/src/sim/controller_benchmark_baseline_hornet.h
+```
+
+No baseline has been taken on the CI host yet, so the benchmark fails until one is generated.
+*/
+
+#pragma once
+
+#include <array>
+#include "ControllerBenchmark.h"
+
+constexpr std::array<ControllerBenchmark::Baseline, 0> CONTROLLER_BENCHMARK_BASELINE {};
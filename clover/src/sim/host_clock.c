@@ -0,0 +1,14 @@
+/*
+ * Runs in the native simulator runner (host) context, not the embedded image, so it may use host libc directly.
+ */
+#include <stdint.h>
+#include <time.h>
+
+/* CPU time of the calling thread. Each Zephyr thread runs on its own host thread, so this leaves out the time the host
+ * spends on other threads and processes. */
+uint64_t plant_sim_host_thread_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
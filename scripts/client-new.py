@@ -72,11 +72,12 @@ RCS_VALVE_SEQ_DIR = pathlib.Path('sequences/rcs_valve')
 RCS_SEQ_DIR = pathlib.Path('sequences/rcs')
 STATIC_FIRE_SEQ_DIR = pathlib.Path('sequences/static_fire')
 FLIGHT_SEQ_DIR = pathlib.Path('sequences/flight')
+GAIN_SCHEDULE_DIR = pathlib.Path('sequences/gain_schedule')
 
 # Network
 # ZEPHYR_IP = '169.254.99.99'  # real board
 ZEPHYR_IP = '192.168.0.150'  # daq box router
-# ZEPHYR_IP = '127.0.0.1'  # fake_telemetry.py
+# ZEPHYR_IP = '127.0.0.1'  # fake_telemetry.py or native_sim plant simulator
 ZEPHYR_PORT = 19690
 DATA_IP = '0.0.0.0'  # Listen to UDP from anybody
 DATA_PORT = 19691
@@ -107,6 +108,7 @@ _csv_path: pathlib.Path | None = None  # set on first write
 _csv_fh = None  # open file handle
 _csv_writer = None  # csv.DictWriter bound to _csv_fh
 _csv_rows_written: int = 0
+_pb_fh = None  # raw_packets_*.pb next to the CSV: length-delimited DataPackets, replayable by tests/replay
 _seq_recording: bool = False
 
 _last_packet_time: float = 0.0
@@ -413,6 +415,23 @@ def _packet_to_csv_rows(recv_time: float, pkt: clover_pb2.DataPacket) -> list[di
     return rows
 
 
+def _open_recording():
+    """Open a new CSV and its raw packet file, named for the current time."""
+    global _csv_path, _csv_fh, _csv_writer, _pb_fh
+    stamp = time.strftime('%Y%m%d_%H%M%S')
+    _csv_path = pathlib.Path('data') / f'raw_sensors_{stamp}.csv'
+    _csv_path.parent.mkdir(exist_ok=True)
+    _csv_fh = open(_csv_path, 'w', newline='')
+    _csv_writer = csv.DictWriter(_csv_fh, fieldnames=CSV_COLUMNS)
+    _csv_writer.writeheader()
+    _pb_fh = open(_csv_path.parent / f'raw_packets_{stamp}.pb', 'wb')
+
+
+def _write_raw_packet(pkt: clover_pb2.DataPacket):
+    raw = pkt.SerializeToString()
+    _pb_fh.write(_VarintBytes(len(raw)) + raw)
+
+
 def _write_csv_on_exit():
     """Flush any remaining buffered packets to the CSV file and close it."""
     global _csv_fh, _csv_writer, _csv_path, _csv_rows_written
@@ -423,11 +442,7 @@ def _write_csv_on_exit():
 
     # Sequence started but flush_loop never ran — create the file now
     if remaining and _csv_fh is None:
-        _csv_path = pathlib.Path('data') / f'raw_sensors_{time.strftime("%Y%m%d_%H%M%S")}.csv'
-        _csv_path.parent.mkdir(exist_ok=True)
-        _csv_fh = open(_csv_path, 'w', newline='')
-        _csv_writer = csv.DictWriter(_csv_fh, fieldnames=CSV_COLUMNS)
-        _csv_writer.writeheader()
+        _open_recording()
 
     if _csv_fh is None:
         return
@@ -437,6 +452,7 @@ def _write_csv_on_exit():
             for row in _packet_to_csv_rows(recv_time, pkt):
                 _csv_writer.writerow(row)
                 _csv_rows_written += 1
+            _write_raw_packet(pkt)
         except Exception as e:
             console.print(f'  [bold red]CSV row error:[/bold red] {e}')
 
@@ -618,11 +634,13 @@ def _generate_plots(csv_path: pathlib.Path) -> None:
 
 
 def _close_csv():
-    global _csv_fh, _csv_path, _csv_writer, _csv_rows_written
+    global _csv_fh, _csv_path, _csv_writer, _csv_rows_written, _pb_fh
     if _csv_fh is None:
         return
     _csv_fh.close()
     _csv_fh = None
+    _pb_fh.close()
+    _pb_fh = None
     path = _csv_path
     console.print(
         f'\n  {THEME["icon_ok"]} [bold green]CSV saved →[/bold green] '
@@ -651,20 +669,16 @@ def _flush_loop():
         if csv_batch:
             global _csv_path, _csv_fh, _csv_writer, _csv_rows_written
             if _csv_fh is None and _seq_recording:
-                _csv_path = (
-                    pathlib.Path('data') / f'raw_sensors_{time.strftime("%Y%m%d_%H%M%S")}.csv'
-                )
-                _csv_path.parent.mkdir(exist_ok=True)
-                _csv_fh = open(_csv_path, 'w', newline='')
-                _csv_writer = csv.DictWriter(_csv_fh, fieldnames=CSV_COLUMNS)
-                _csv_writer.writeheader()
+                _open_recording()
             if _csv_fh is not None:
                 try:
                     for recv_time, pkt in csv_batch:
                         for row in _packet_to_csv_rows(recv_time, pkt):
                             _csv_writer.writerow(row)
                             _csv_rows_written += 1
+                        _write_raw_packet(pkt)
                     _csv_fh.flush()
+                    _pb_fh.flush()
                 except Exception as e:
                     console.print(f'  [bold red]CSV write error:[/bold red] {e}')
 
@@ -1963,11 +1977,31 @@ def cmd_configure_flight_controller_gains():
         console.print(
             f'\n  [{t["success"]}]Configured: {", ".join(sorted(configured_pids))}[/{t["success"]}]'
         )
+        if Confirm.ask('  Reset integrators?', default=False):
+            gains.reset_integrators = True
         send_request(req, 'CONFIGURE_FLIGHT_CONTROLLER_GAINS')
     else:
         console.print(f'  [{t["muted"]}]No gains configured.[/{t["muted"]}]')
 
 
+def cmd_load_flight_gain_schedule():
+    """Load a flight controller gain schedule from a saved textproto."""
+    t = THEME
+    console.print(f'\n  [{t["primary"]}]Load Flight Gain Schedule[/{t["primary"]}]')
+
+    if not _list_saved_sequences(GAIN_SCHEDULE_DIR):
+        console.print(
+            f'  [{t["muted"]}]No schedules found. Save a LoadFlightGainScheduleRequest textproto in '
+            f'{GAIN_SCHEDULE_DIR}/.[/{t["muted"]}]'
+        )
+        return
+
+    loaded = _pick_and_load_sequence(GAIN_SCHEDULE_DIR, clover_pb2.LoadFlightGainScheduleRequest)
+    req = clover_pb2.Request()
+    req.load_flight_gain_schedule.CopyFrom(loaded)
+    send_request(req, 'LOAD_FLIGHT_GAIN_SCHEDULE')
+
+
 # TODO: is this all that's needed?
 def cmd_calibrate_tvc():
     """Enter TVC calibration mode (IDLE → CALIBRATE_TVC)."""
@@ -2224,6 +2258,7 @@ MENU_ITEMS = [
     ('pon', 'poweron', 'Power ON stepper motor', cmd_power_on_valve),
     ('poff', 'poweroff', 'Power OFF stepper motor', cmd_power_off_valve),
     ('gains', 'gains', 'Configure flight controller gains', cmd_configure_flight_controller_gains),
+    ('gsched', 'gainschedule', 'Load flight controller gain schedule', cmd_load_flight_gain_schedule),
     (
         'cal',
         'calibrate',
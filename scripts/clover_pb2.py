@@ -13,143 +13,151 @@ _sym_db = _symbol_database.Default()
 
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0c\x63lover.proto\"\xda\r\n\x07Request\x12<\n\x15subscribe_data_stream\x18\x01 \x01(\x0b\x32\x1b.SubscribeDataStreamRequestH\x00\x12\x31\n\x0fidentify_client\x18\x06 \x01(\x0b\x32\x16.IdentifyClientRequestH\x00\x12\x36\n\x16is_not_aborted_request\x18\x1a \x01(\x0b\x32\x14.IsNotAbortedRequestH\x00\x12\x42\n\x18\x63onfigure_analog_sensors\x18\x19 \x01(\x0b\x32\x1e.ConfigureAnalogSensorsRequestH\x00\x12K\n\x1dthrottle_reset_valve_position\x18\x02 \x01(\x0b\x32\".ThrottleResetValvePositionRequestH\x00\x12\x36\n\x12throttle_power_off\x18\x18 \x01(\x0b\x32\x18.ThrottlePowerOffRequestH\x00\x12\x34\n\x11throttle_power_on\x18\x17 \x01(\x0b\x32\x17.ThrottlePowerOnRequestH\x00\x12;\n\x18\x63onfigure_valves_request\x18\x05 \x01(\x0b\x32\x17.ConfigureValvesRequestH\x00\x12\x35\n\x15\x61\x63tuate_valve_request\x18\' \x01(\x0b\x32\x14.ActuateValveRequestH\x00\x12\x1e\n\x05\x61\x62ort\x18\n \x01(\x0b\x32\r.AbortRequestH\x00\x12\x1c\n\x04halt\x18\" \x01(\x0b\x32\x0c.HaltRequestH\x00\x12\"\n\x07unprime\x18# \x01(\x0b\x32\x0f.UnprimeRequestH\x00\x12S\n!configure_flight_controller_gains\x18\x03 \x01(\x0b\x32&.ConfigureFlightControllerGainsRequestH\x00\x12\x42\n\x18\x63\x61librate_throttle_valve\x18! \x01(\x0b\x32\x1e.CalibrateThrottleValveRequestH\x00\x12I\n\x1cload_throttle_valve_sequence\x18\r \x01(\x0b\x32!.LoadThrottleValveSequenceRequestH\x00\x12K\n\x1dstart_throttle_valve_sequence\x18\x0f \x01(\x0b\x32\".StartThrottleValveSequenceRequestH\x00\x12>\n\x16load_throttle_sequence\x18\x0e \x01(\x0b\x32\x1c.LoadThrottleSequenceRequestH\x00\x12@\n\x17start_throttle_sequence\x18\x10 \x01(\x0b\x32\x1d.StartThrottleSequenceRequestH\x00\x12-\n\rcalibrate_tvc\x18\t \x01(\x0b\x32\x14.CalibrateTvcRequestH\x00\x12\x34\n\x11load_tvc_sequence\x18\x1d \x01(\x0b\x32\x17.LoadTvcSequenceRequestH\x00\x12\x36\n\x12start_tvc_sequence\x18\x1e \x01(\x0b\x32\x18.StartTvcSequenceRequestH\x00\x12?\n\x17load_rcs_valve_sequence\x18\x13 \x01(\x0b\x32\x1c.LoadRcsValveSequenceRequestH\x00\x12\x41\n\x18start_rcs_valve_sequence\x18\x14 \x01(\x0b\x32\x1d.StartRcsValveSequenceRequestH\x00\x12\x34\n\x11load_rcs_sequence\x18\x15 \x01(\x0b\x32\x17.LoadRcsSequenceRequestH\x00\x12\x36\n\x12start_rcs_sequence\x18\x16 \x01(\x0b\x32\x18.StartRcsSequenceRequestH\x00\x12\x43\n\x19load_static_fire_sequence\x18\x04 \x01(\x0b\x32\x1e.LoadStaticFireSequenceRequestH\x00\x12\x45\n\x1astart_static_fire_sequence\x18& \x01(\x0b\x32\x1f.StartStaticFireSequenceRequestH\x00\x12:\n\x14load_flight_sequence\x18\x1f \x01(\x0b\x32\x1a.LoadFlightSequenceRequestH\x00\x12<\n\x15start_flight_sequence\x18  \x01(\x0b\x32\x1b.StartFlightSequenceRequestH\x00\x42\t\n\x07payload\"\x17\n\x08Response\x12\x0b\n\x03\x65rr\x18\x01 \x01(\t\"\x1c\n\x1aSubscribeDataStreamRequest\"\x15\n\x13IsNotAbortedRequest\"4\n\x15IdentifyClientRequest\x12\x1b\n\x06\x63lient\x18\x01 \x02(\x0e\x32\x0b.ClientType\"E\n\x1d\x43onfigureAnalogSensorsRequest\x12$\n\x07\x63onfigs\x18\x01 \x03(\x0b\x32\x13.AnalogSensorConfig\"\xb8\x01\n\x12\x41nalogSensorConfig\x12\x0f\n\x07\x63hannel\x18\x01 \x02(\r\x12!\n\nassignment\x18\x02 \x02(\x0e\x32\r.AnalogSensor\x12\x15\n\rpt_range_psig\x18\x03 \x01(\x02\x12\x14\n\x0cpt_bias_psig\x18\x04 \x01(\x02\x12\x18\n\x07tc_type\x18\x05 \x01(\x0e\x32\x07.TCType\x12\x13\n\x0braw_range_v\x18\x06 \x01(\x02\x12\x12\n\nraw_bias_v\x18\x07 \x01(\x02\"7\n\x16\x43onfigureValvesRequest\x12\x1d\n\x07\x63onfigs\x18\x01 \x03(\x0b\x32\x0c.ValveConfig\"S\n\x0bValveConfig\x12\x0f\n\x07\x63hannel\x18\x01 \x02(\r\x12\x1a\n\nassignment\x18\x02 \x02(\x0e\x32\x06.Valve\x12\x17\n\x0fnormally_closed\x18\x03 \x01(\x08\"H\n\x13\x41\x63tuateValveRequest\x12\x15\n\x05valve\x18\x01 \x02(\x0e\x32\x06.Valve\x12\x1a\n\x05state\x18\x02 \x02(\x0e\x32\x0b.ValveState\"[\n!ThrottleResetValvePositionRequest\x12!\n\x05valve\x18\x01 \x02(\x0e\x32\x12.ThrottleValveType\x12\x13\n\x0bnew_pos_deg\x18\x02 \x02(\x02\"\x0e\n\x0c\x41\x62ortRequest\"\r\n\x0bHaltRequest\"\x10\n\x0eUnprimeRequest\";\n\x16ThrottlePowerOnRequest\x12!\n\x05valve\x18\x01 \x02(\x0e\x32\x12.ThrottleValveType\"<\n\x17ThrottlePowerOffRequest\x12!\n\x05valve\x18\x01 \x02(\x0e\x32\x12.ThrottleValveType\"B\n\x1d\x43\x61librateThrottleValveRequest\x12!\n\x05valve\x18\x01 \x02(\x0e\x32\x12.ThrottleValveType\"o\n LoadThrottleValveSequenceRequest\x12%\n\x0e\x66uel_trace_deg\x18\x01 \x01(\x0b\x32\r.ControlTrace\x12$\n\rlox_trace_deg\x18\x02 \x01(\x0b\x32\r.ControlTrace\"#\n!StartThrottleValveSequenceRequest\"@\n\x1bLoadThrottleSequenceRequest\x12!\n\nthrust_lbf\x18\x01 \x02(\x0b\x32\r.ControlTrace\"\x1e\n\x1cStartThrottleSequenceRequest\"t\n\x1bLoadRcsValveSequenceRequest\x12)\n\x12rcs_cw_valve_trace\x18\x01 \x02(\x0b\x32\r.ControlTrace\x12*\n\x13rcs_ccw_valve_trace\x18\x02 \x02(\x0b\x32\r.ControlTrace\"\x1e\n\x1cStartRcsValveSequenceRequest\":\n\x16LoadRcsSequenceRequest\x12 \n\ttrace_deg\x18\x01 \x02(\x0b\x32\r.ControlTrace\"\x19\n\x17StartRcsSequenceRequest\"\x90\x01\n\x1dLoadStaticFireSequenceRequest\x12!\n\nthrust_lbf\x18\x01 \x02(\x0b\x32\r.ControlTrace\x12&\n\x0fpitch_trace_deg\x18\x02 \x02(\x0b\x32\r.ControlTrace\x12$\n\ryaw_trace_deg\x18\x03 \x02(\x0b\x32\r.ControlTrace\" \n\x1eStartStaticFireSequenceRequest\"\x15\n\x13\x43\x61librateTvcRequest\"f\n\x16LoadTvcSequenceRequest\x12&\n\x0fpitch_trace_deg\x18\x01 \x02(\x0b\x32\r.ControlTrace\x12$\n\ryaw_trace_deg\x18\x02 \x02(\x0b\x32\r.ControlTrace\"\x19\n\x17StartTvcSequenceRequest\"\xc9\x01\n\x19LoadFlightSequenceRequest\x12)\n\x12x_position_trace_m\x18\x01 \x02(\x0b\x32\r.ControlTrace\x12)\n\x12y_position_trace_m\x18\x02 \x02(\x0b\x32\r.ControlTrace\x12)\n\x12z_position_trace_m\x18\x03 \x02(\x0b\x32\r.ControlTrace\x12+\n\x14roll_angle_trace_deg\x18\x04 \x02(\x0b\x32\r.ControlTrace\"\x1c\n\x1aStartFlightSequenceRequest\"\xf9\n\n%ConfigureFlightControllerGainsRequest\x12\x13\n\x0bpidXTilt_kp\x18\x01 \x01(\x02\x12\x13\n\x0bpidXTilt_ki\x18\x02 \x01(\x02\x12\x13\n\x0bpidXTilt_kd\x18\x03 \x01(\x02\x12\x13\n\x0bpidYTilt_kp\x18\x04 \x01(\x02\x12\x13\n\x0bpidYTilt_ki\x18\x05 \x01(\x02\x12\x13\n\x0bpidYTilt_kd\x18\x06 \x01(\x02\x12\x0f\n\x07pidX_kp\x18\x07 \x01(\x02\x12\x0f\n\x07pidX_ki\x18\x08 \x01(\x02\x12\x0f\n\x07pidX_kd\x18\t \x01(\x02\x12\x0f\n\x07pidY_kp\x18\n \x01(\x02\x12\x0f\n\x07pidY_ki\x18\x0b \x01(\x02\x12\x0f\n\x07pidY_kd\x18\x0c \x01(\x02\x12\x0f\n\x07pidZ_kp\x18\r \x01(\x02\x12\x0f\n\x07pidZ_ki\x18\x0e \x01(\x02\x12\x0f\n\x07pidZ_kd\x18\x0f \x01(\x02\x12\x17\n\x0fpidZVelocity_kp\x18\x10 \x01(\x02\x12\x17\n\x0fpidZVelocity_ki\x18\x11 \x01(\x02\x12\x17\n\x0fpidZVelocity_kd\x18\x12 \x01(\x02\x12\x18\n\x10pidXTilt_min_out\x18\x13 \x01(\x02\x12\x18\n\x10pidXTilt_max_out\x18\x14 \x01(\x02\x12\x18\n\x10pidYTilt_min_out\x18\x15 \x01(\x02\x12\x18\n\x10pidYTilt_max_out\x18\x16 \x01(\x02\x12\x14\n\x0cpidX_min_out\x18\x17 \x01(\x02\x12\x14\n\x0cpidX_max_out\x18\x18 \x01(\x02\x12\x14\n\x0cpidY_min_out\x18\x19 \x01(\x02\x12\x14\n\x0cpidY_max_out\x18\x1a \x01(\x02\x12\x14\n\x0cpidZ_min_out\x18\x1b \x01(\x02\x12\x14\n\x0cpidZ_max_out\x18\x1c \x01(\x02\x12\x1c\n\x14pidZVelocity_min_out\x18\x1d \x01(\x02\x12\x1c\n\x14pidZVelocity_max_out\x18\x1e \x01(\x02\x12\x1d\n\x15pidXTilt_min_integral\x18\x1f \x01(\x02\x12\x1d\n\x15pidXTilt_max_integral\x18  \x01(\x02\x12\x1d\n\x15pidYTilt_min_integral\x18! \x01(\x02\x12\x1d\n\x15pidYTilt_max_integral\x18\" \x01(\x02\x12\x19\n\x11pidX_min_integral\x18# \x01(\x02\x12\x19\n\x11pidX_max_integral\x18$ \x01(\x02\x12\x19\n\x11pidY_min_integral\x18% \x01(\x02\x12\x19\n\x11pidY_max_integral\x18& \x01(\x02\x12\x19\n\x11pidZ_min_integral\x18\' \x01(\x02\x12\x19\n\x11pidZ_max_integral\x18( \x01(\x02\x12!\n\x19pidZVelocity_min_integral\x18) \x01(\x02\x12!\n\x19pidZVelocity_max_integral\x18* \x01(\x02\x12\x1e\n\x16pidXTilt_integral_zone\x18+ \x01(\x02\x12\x1e\n\x16pidYTilt_integral_zone\x18, \x01(\x02\x12\x1a\n\x12pidX_integral_zone\x18- \x01(\x02\x12\x1a\n\x12pidY_integral_zone\x18. \x01(\x02\x12\x1a\n\x12pidZ_integral_zone\x18/ \x01(\x02\x12\"\n\x1apidZVelocity_integral_zone\x18\x30 \x01(\x02\x12\x1c\n\x14pidXTilt_deriv_lp_hz\x18\x31 \x01(\x02\x12\x1c\n\x14pidYTilt_deriv_lp_hz\x18\x32 \x01(\x02\x12\x18\n\x10pidX_deriv_lp_hz\x18\x33 \x01(\x02\x12\x18\n\x10pidY_deriv_lp_hz\x18\x34 \x01(\x02\x12\x18\n\x10pidZ_deriv_lp_hz\x18\x35 \x01(\x02\x12 \n\x18pidZVelocity_deriv_lp_hz\x18\x36 \x01(\x02\"A\n\x0c\x43ontrolTrace\x12\x15\n\rtotal_time_ms\x18\x01 \x02(\r\x12\x1a\n\x08segments\x18\x02 \x03(\x0b\x32\x08.Segment\"v\n\x07Segment\x12\x10\n\x08start_ms\x18\x01 \x02(\r\x12\x11\n\tlength_ms\x18\x02 \x02(\r\x12 \n\x06linear\x18\x03 \x01(\x0b\x32\x0e.LinearSegmentH\x00\x12\x1c\n\x04sine\x18\x04 \x01(\x0b\x32\x0c.SineSegmentH\x00\x42\x06\n\x04type\"3\n\rLinearSegment\x12\x11\n\tstart_val\x18\x01 \x02(\x02\x12\x0f\n\x07\x65nd_val\x18\x02 \x02(\x02\"S\n\x0bSineSegment\x12\x0e\n\x06offset\x18\x01 \x02(\x02\x12\x11\n\tamplitude\x18\x02 \x02(\x02\x12\x0e\n\x06period\x18\x03 \x02(\x02\x12\x11\n\tphase_deg\x18\x04 \x02(\x02\"\x90\r\n\nDataPacket\x12\x0f\n\x07time_ns\x18\x01 \x02(\x04\x12\x1b\n\x05state\x18\x06 \x02(\x0e\x32\x0c.SystemState\x12,\n\x11\x63ontroller_timing\x18\x14 \x02(\x0b\x32\x11.ControllerTiming\x12\x17\n\x0f\x64\x61ta_queue_size\x18\x02 \x02(\r\x12\x17\n\x0fsequence_number\x18\x08 \x02(\x04\x12\x15\n\rgnc_connected\x18\x0f \x02(\x08\x12\x1a\n\x12gnc_last_pinged_ns\x18\x10 \x02(\x02\x12\x15\n\rdaq_connected\x18\x11 \x02(\x08\x12\x1a\n\x12\x64\x61q_last_pinged_ns\x18\x12 \x02(\x02\x12-\n\x0e\x61nalog_sensors\x18\x13 \x02(\x0b\x32\x15.AnalogSensorReadings\x12\x1e\n\x07lidar_1\x18\x15 \x01(\x0b\x32\r.LidarReading\x12\x1e\n\x07lidar_2\x18\x16 \x01(\x0b\x32\r.LidarReading\x12/\n\x11\x66uel_valve_status\x18\\ \x01(\x0b\x32\x14.ThrottleValveStatus\x12.\n\x10lox_valve_status\x18] \x01(\x0b\x32\x14.ThrottleValveStatus\x12\x18\n\x03imu\x18\x17 \x01(\x0b\x32\x0b.ImuReading\x12(\n\x0f\x65stimated_state\x18V \x01(\x0b\x32\x0f.EstimatedState\x12\x17\n\x0f\x61\x62ort_time_msec\x18U \x01(\x02\x12\x17\n\x0ftrace_time_msec\x18\x03 \x01(\x02\x12#\n\x1bthrottle_thrust_command_lbf\x18S \x01(\x02\x12\x1d\n\x15tvc_pitch_command_deg\x18T \x01(\x02\x12\x1b\n\x13tvc_yaw_command_deg\x18G \x01(\x02\x12\x1c\n\x14rcs_roll_command_deg\x18H \x01(\x02\x12\x1a\n\x12\x66light_x_command_m\x18I \x01(\x02\x12\x1a\n\x12\x66light_y_command_m\x18J \x01(\x02\x12\x1a\n\x12\x66light_z_command_m\x18K \x01(\x02\x12!\n\x19\x66light_pitch_accel_rad_s2\x18X \x01(\x02\x12\x1f\n\x17\x66light_yaw_accel_rad_s2\x18Y \x01(\x02\x12\x1b\n\x13\x66light_z_accel_m_s2\x18Z \x01(\x02\x12;\n\x19\x66light_controller_metrics\x18\x45 \x01(\x0b\x32\x18.FlightControllerMetrics\x12\x37\n\x17ranger_throttle_metrics\x18N \x01(\x0b\x32\x16.RangerThrottleMetrics\x12\x37\n\x17hornet_throttle_metrics\x18M \x01(\x0b\x32\x16.HornetThrottleMetrics\x12-\n\x12ranger_tvc_metrics\x18P \x01(\x0b\x32\x11.RangerTvcMetrics\x12-\n\x12hornet_tvc_metrics\x18O \x01(\x0b\x32\x11.HornetTvcMetrics\x12-\n\x12ranger_rcs_metrics\x18R \x01(\x0b\x32\x11.RangerRcsMetrics\x12-\n\x12hornet_rcs_metrics\x18Q \x01(\x0b\x32\x11.HornetRcsMetrics\x12\"\n\x0cvalve_states\x18W \x02(\x0b\x32\x0c.ValveStates\x12\x31\n\x12\x66uel_valve_command\x18< \x01(\x0b\x32\x15.ThrottleValveCommand\x12\x30\n\x11lox_valve_command\x18= \x01(\x0b\x32\x15.ThrottleValveCommand\x12\x33\n\x16pitch_actuator_command\x18> \x01(\x0b\x32\x13.TvcActuatorCommand\x12\x31\n\x14yaw_actuator_command\x18? \x01(\x0b\x32\x13.TvcActuatorCommand\x12\x1b\n\x04gnss\x18[ \x01(\x0b\x32\r.GnssReadings\x12\x1e\n\x16main_propeller_command\x18@ \x01(\x05\x12\x1b\n\x13pitch_servo_command\x18\x43 \x01(\x05\x12\x19\n\x11yaw_servo_command\x18\x44 \x01(\x05\x12 \n\x18rcs_propeller_cw_command\x18\x41 \x01(\x05\x12!\n\x19rcs_propeller_ccw_command\x18\x42 \x01(\x05\"\x81\x01\n\x10\x43ontrollerTiming\x12\x1f\n\x17\x63ontroller_tick_time_ns\x18\x01 \x02(\x02\x12$\n\x1c\x61nalog_sensors_sense_time_ns\x18\x02 \x02(\x02\x12&\n\x1estate_estimator_update_time_ns\x18\x03 \x02(\x02\"=\n\x13ThrottleValveStatus\x12\x17\n\x0f\x65ncoder_pos_deg\x18\x03 \x02(\x02\x12\r\n\x05is_on\x18\x04 \x02(\x08\"K\n\x14ThrottleValveCommand\x12\x0e\n\x06\x65nable\x18\x01 \x02(\x08\x12\x0f\n\x07set_pos\x18\x02 \x02(\x08\x12\x12\n\ntarget_deg\x18\x03 \x02(\x02\"\x14\n\x12TvcActuatorCommand\"\xf5\x02\n\x14\x41nalogSensorReadings\x12\r\n\x05pt001\x18\x01 \x01(\x02\x12\r\n\x05pt002\x18\x02 \x01(\x02\x12\r\n\x05pt003\x18\x03 \x01(\x02\x12\r\n\x05pt004\x18\x04 \x01(\x02\x12\r\n\x05pt005\x18\x05 \x01(\x02\x12\r\n\x05pt006\x18\x06 \x01(\x02\x12\r\n\x05pt103\x18\x07 \x01(\x02\x12\r\n\x05pt203\x18\x08 \x01(\x02\x12\r\n\x05pt301\x18\t \x01(\x02\x12\x0e\n\x06ptf401\x18\n \x01(\x02\x12\x0e\n\x06pto401\x18\x0b \x01(\x02\x12\x0e\n\x06ptc401\x18\x0c \x01(\x02\x12\x0e\n\x06ptc402\x18\r \x01(\x02\x12\r\n\x05tc002\x18\x0e \x01(\x02\x12\r\n\x05tc102\x18\x0f \x01(\x02\x12\x0f\n\x07tc102_5\x18\x10 \x01(\x02\x12\x0e\n\x06tcf401\x18\x11 \x01(\x02\x12\x0e\n\x06tco401\x18\x12 \x01(\x02\x12\x0e\n\x06ptg001\x18\x13 \x01(\x02\x12\x0e\n\x06ptg002\x18\x14 \x01(\x02\x12\x0e\n\x06ptg101\x18\x15 \x01(\x02\x12\x17\n\x0f\x62\x61ttery_voltage\x18\x16 \x01(\x02\"+\n\x08Vector3D\x12\t\n\x01x\x18\x01 \x02(\x02\x12\t\n\x01y\x18\x02 \x02(\x02\x12\t\n\x01z\x18\x03 \x02(\x02\"\x80\x03\n\x0bValveStates\x12\x1a\n\x05sv001\x18\x01 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv002\x18\x02 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv003\x18\x03 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv004\x18\x04 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv005\x18\x05 \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06pbv006\x18\x06 \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06pbv101\x18\x07 \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06pbv201\x18\x08 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv301\x18\t \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06svr001\x18\n \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06svr002\x18\x0b \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06svr003\x18\x0c \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06svr004\x18\r \x01(\x0e\x32\x0b.ValveState\"K\n\x0cLidarReading\x12\x12\n\ndistance_m\x18\x01 \x02(\x02\x12\x10\n\x08strength\x18\x02 \x02(\x02\x12\x15\n\rsense_time_ns\x18\x03 \x02(\x02\"\xb0\x03\n\nImuReading\x12\x0b\n\x03yaw\x18\x01 \x01(\x02\x12\r\n\x05pitch\x18\x02 \x01(\x02\x12\x0c\n\x04roll\x18\x03 \x01(\x02\x12\x0f\n\x07\x61\x63\x63\x65l_x\x18\x04 \x02(\x02\x12\x0f\n\x07\x61\x63\x63\x65l_y\x18\x05 \x02(\x02\x12\x0f\n\x07\x61\x63\x63\x65l_z\x18\x06 \x02(\x02\x12\x0e\n\x06gyro_x\x18\x07 \x02(\x02\x12\x0e\n\x06gyro_y\x18\x08 \x02(\x02\x12\x0e\n\x06gyro_z\x18\t \x02(\x02\x12\x0f\n\x07gps_lat\x18\n \x01(\x02\x12\x0f\n\x07gps_lon\x18\x0b \x01(\x02\x12\x0f\n\x07gps_alt\x18\x0c \x01(\x02\x12\x0f\n\x07ins_lat\x18\r \x01(\x02\x12\x0f\n\x07ins_lon\x18\x0e \x01(\x02\x12\x0f\n\x07ins_alt\x18\x0f \x01(\x02\x12\r\n\x05vel_n\x18\x10 \x01(\x02\x12\r\n\x05vel_e\x18\x11 \x01(\x02\x12\r\n\x05vel_d\x18\x12 \x01(\x02\x12\r\n\x05mag_x\x18\x13 \x02(\x02\x12\r\n\x05mag_y\x18\x14 \x02(\x02\x12\r\n\x05mag_z\x18\x15 \x02(\x02\x12\x0e\n\x06quat_w\x18\x16 \x02(\x02\x12\x0e\n\x06quat_x\x18\x17 \x02(\x02\x12\x0e\n\x06quat_y\x18\x18 \x02(\x02\x12\x0e\n\x06quat_z\x18\x19 \x02(\x02\x12\x15\n\rsense_time_ns\x18\x1a \x02(\x02\"\x18\n\x16\x46lightControllerOutput\"<\n\nQuaternion\x12\n\n\x02qw\x18\n \x02(\x02\x12\n\n\x02qx\x18\x01 \x02(\x02\x12\n\n\x02qy\x18\x02 \x02(\x02\x12\n\n\x02qz\x18\x03 \x02(\x02\"\x7f\n\x0e\x45stimatedState\x12\x19\n\x04R_WB\x18\x01 \x02(\x0b\x32\x0b.Quaternion\x12\x18\n\x05\x65uler\x18\x04 \x02(\x0b\x32\t.Vector3D\x12\x1b\n\x08position\x18\x02 \x02(\x0b\x32\t.Vector3D\x12\x1b\n\x08velocity\x18\x03 \x02(\x0b\x32\t.Vector3D\"w\n\x1c\x46lightControllerDesiredState\x12\x1b\n\x08position\x18\x01 \x02(\x0b\x32\t.Vector3D\x12\x14\n\x0cworld_tilt_x\x18\x02 \x02(\x02\x12\x14\n\x0cworld_tilt_y\x18\x03 \x02(\x02\x12\x0e\n\x06vz_m_s\x18\x05 \x02(\x02\"\xcc\x02\n\x17\x46lightControllerMetrics\x12 \n\x18\x64\x65sired_world_tilt_x_rad\x18\x01 \x02(\x02\x12 \n\x18\x64\x65sired_world_tilt_y_rad\x18\x02 \x02(\x02\x12\x1f\n\x17\x61\x63tual_world_tilt_x_rad\x18\x03 \x02(\x02\x12\x1f\n\x17\x61\x63tual_world_tilt_y_rad\x18\x04 \x02(\x02\x12%\n\x1d\x64\x65sired_vertical_velocity_m_s\x18\x05 \x02(\x02\x12,\n$commanded_vertical_acceleration_m_s2\x18\x06 \x02(\x02\x12+\n#commanded_pitch_acceleration_rad_s2\x18\x07 \x02(\x02\x12)\n!commanded_yaw_acceleration_rad_s2\x18\x08 \x02(\x02\"\xda\x01\n\x15RangerThrottleMetrics\x12\x1c\n\x14predicted_thrust_lbf\x18\x01 \x02(\x02\x12\x14\n\x0cpredicted_of\x18\x02 \x02(\x02\x12\x11\n\tmdot_fuel\x18\x03 \x02(\x02\x12\x10\n\x08mdot_lox\x18\x04 \x02(\x02\x12\x18\n\x10\x63hange_alpha_cmd\x18\x07 \x02(\x02\x12 \n\x18\x63lamped_change_alpha_cmd\x18\x08 \x02(\x02\x12\r\n\x05\x61lpha\x18\t \x02(\x02\x12\x1d\n\x15thrust_from_alpha_lbf\x18\n \x02(\x02\")\n\x15HornetThrottleMetrics\x12\x10\n\x08thrust_N\x18\x01 \x01(\x02\"\x12\n\x10RangerTvcMetrics\"\x12\n\x10HornetTvcMetrics\"\x12\n\x10RangerRcsMetrics\"\x12\n\x10HornetRcsMetrics\"\xbc\x02\n\x0cGnssReadings\x12\x0f\n\x07north_m\x18\x01 \x02(\x02\x12\x0e\n\x06\x65\x61st_m\x18\x02 \x02(\x02\x12\x0c\n\x04up_m\x18\x03 \x02(\x02\x12\x13\n\x0bpos_sigma_m\x18\x04 \x02(\x02\x12\r\n\x05vx_ms\x18\x05 \x02(\x02\x12\r\n\x05vy_ms\x18\x06 \x02(\x02\x12\r\n\x05vz_ms\x18\x07 \x02(\x02\x12\x14\n\x0cvel_sigma_ms\x18\x08 \x02(\x02\x12\x0e\n\x06hrms_m\x18\t \x02(\x02\x12\x0e\n\x06vrms_m\x18\n \x02(\x02\x12\x13\n\x0bhvel_rms_ms\x18\x0b \x02(\x02\x12\x13\n\x0bvvel_rms_ms\x18\x0c \x02(\x02\x12\x18\n\x10solution_time_ms\x18\r \x02(\r\x12\x18\n\x10receiver_time_ms\x18\x0e \x02(\r\x12\x10\n\x08sol_type\x18\x0f \x02(\r\x12\x15\n\rsense_time_ns\x18\x10 \x02(\x02*2\n\nClientType\x12\x12\n\x0eUNKNOWN_CLIENT\x10\x01\x12\x07\n\x03GNC\x10\x02\x12\x07\n\x03\x44\x41Q\x10\x03*5\n\x06TCType\x12\x13\n\x0fUNKNOWN_TC_TYPE\x10\x00\x12\n\n\x06K_TYPE\x10\x01\x12\n\n\x06T_TYPE\x10\x02*\xb0\x02\n\x0c\x41nalogSensor\x12\x19\n\x15UNKNOWN_ANALOG_SENSOR\x10\x00\x12\t\n\x05PT001\x10\x01\x12\t\n\x05PT002\x10\x02\x12\t\n\x05PT003\x10\x03\x12\t\n\x05PT004\x10\x04\x12\t\n\x05PT005\x10\x05\x12\t\n\x05PT006\x10\x06\x12\t\n\x05PT103\x10\x07\x12\t\n\x05PT203\x10\x08\x12\t\n\x05PT301\x10\t\x12\n\n\x06PTF401\x10\n\x12\n\n\x06PTO401\x10\x0b\x12\n\n\x06PTC401\x10\x0c\x12\n\n\x06PTC402\x10\r\x12\t\n\x05TC002\x10\x0e\x12\t\n\x05TC102\x10\x0f\x12\x0b\n\x07TC102_5\x10\x10\x12\n\n\x06TCF401\x10\x11\x12\n\n\x06TCO401\x10\x12\x12\n\n\x06PTG001\x10\x13\x12\n\n\x06PTG002\x10\x14\x12\n\n\x06PTG101\x10\x15\x12\x13\n\x0f\x42\x41TTERY_VOLTAGE\x10\x16*\xb0\x01\n\x05Valve\x12\x11\n\rUNKNOWN_VALVE\x10\x00\x12\t\n\x05SV001\x10\x01\x12\t\n\x05SV002\x10\x02\x12\t\n\x05SV003\x10\x03\x12\t\n\x05SV004\x10\x04\x12\t\n\x05SV005\x10\x05\x12\n\n\x06PBV006\x10\x06\x12\n\n\x06PBV101\x10\x07\x12\n\n\x06PBV201\x10\x08\x12\t\n\x05SV301\x10\t\x12\n\n\x06SVR001\x10\n\x12\n\n\x06SVR002\x10\x0b\x12\n\n\x06SVR003\x10\x0c\x12\n\n\x06SVR004\x10\r*;\n\nValveState\x12\x17\n\x13UNKNOWN_VALVE_STATE\x10\x00\x12\x08\n\x04OPEN\x10\x01\x12\n\n\x06\x43LOSED\x10\x02*G\n\x11ThrottleValveType\x12\x1f\n\x1bUNKNOWN_THROTTLE_VALVE_TYPE\x10\x00\x12\x08\n\x04\x46UEL\x10\x01\x12\x07\n\x03LOX\x10\x02*\xc3\x03\n\x0bSystemState\x12\x11\n\rSTATE_UNKNOWN\x10\x00\x12\x0e\n\nSTATE_IDLE\x10\x01\x12\x0f\n\x0bSTATE_ABORT\x10\x02\x12\"\n\x1eSTATE_CALIBRATE_THROTTLE_VALVE\x10\x03\x12\x18\n\x14STATE_THROTTLE_VALVE\x10\x04\x12\x1f\n\x1bSTATE_THROTTLE_VALVE_PRIMED\x10\x05\x12\x12\n\x0eSTATE_THROTTLE\x10\x06\x12\x19\n\x15STATE_THROTTLE_PRIMED\x10\x07\x12\x17\n\x13STATE_CALIBRATE_TVC\x10\x08\x12\r\n\tSTATE_TVC\x10\t\x12\x14\n\x10STATE_TVC_PRIMED\x10\n\x12\x13\n\x0fSTATE_RCS_VALVE\x10\x0b\x12\x1a\n\x16STATE_RCS_VALVE_PRIMED\x10\x0c\x12\r\n\tSTATE_RCS\x10\r\x12\x14\n\x10STATE_RCS_PRIMED\x10\x0e\x12\x15\n\x11STATE_STATIC_FIRE\x10\x0f\x12\x1c\n\x18STATE_STATIC_FIRE_PRIMED\x10\x10\x12\x10\n\x0cSTATE_FLIGHT\x10\x11\x12\x17\n\x13STATE_FLIGHT_PRIMED\x10\x12')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0c\x63lover.proto\"\x9f\x0e\n\x07Request\x12<\n\x15subscribe_data_stream\x18\x01 \x01(\x0b\x32\x1b.SubscribeDataStreamRequestH\x00\x12\x31\n\x0fidentify_client\x18\x06 \x01(\x0b\x32\x16.IdentifyClientRequestH\x00\x12\x36\n\x16is_not_aborted_request\x18\x1a \x01(\x0b\x32\x14.IsNotAbortedRequestH\x00\x12\x42\n\x18\x63onfigure_analog_sensors\x18\x19 \x01(\x0b\x32\x1e.ConfigureAnalogSensorsRequestH\x00\x12K\n\x1dthrottle_reset_valve_position\x18\x02 \x01(\x0b\x32\".ThrottleResetValvePositionRequestH\x00\x12\x36\n\x12throttle_power_off\x18\x18 \x01(\x0b\x32\x18.ThrottlePowerOffRequestH\x00\x12\x34\n\x11throttle_power_on\x18\x17 \x01(\x0b\x32\x17.ThrottlePowerOnRequestH\x00\x12;\n\x18\x63onfigure_valves_request\x18\x05 \x01(\x0b\x32\x17.ConfigureValvesRequestH\x00\x12\x35\n\x15\x61\x63tuate_valve_request\x18\' \x01(\x0b\x32\x14.ActuateValveRequestH\x00\x12\x1e\n\x05\x61\x62ort\x18\n \x01(\x0b\x32\r.AbortRequestH\x00\x12\x1c\n\x04halt\x18\" \x01(\x0b\x32\x0c.HaltRequestH\x00\x12\"\n\x07unprime\x18# \x01(\x0b\x32\x0f.UnprimeRequestH\x00\x12S\n!configure_flight_controller_gains\x18\x03 \x01(\x0b\x32&.ConfigureFlightControllerGainsRequestH\x00\x12\x43\n\x19load_flight_gain_schedule\x18( \x01(\x0b\x32\x1e.LoadFlightGainScheduleRequestH\x00\x12\x42\n\x18\x63\x61librate_throttle_valve\x18! \x01(\x0b\x32\x1e.CalibrateThrottleValveRequestH\x00\x12I\n\x1cload_throttle_valve_sequence\x18\r \x01(\x0b\x32!.LoadThrottleValveSequenceRequestH\x00\x12K\n\x1dstart_throttle_valve_sequence\x18\x0f \x01(\x0b\x32\".StartThrottleValveSequenceRequestH\x00\x12>\n\x16load_throttle_sequence\x18\x0e \x01(\x0b\x32\x1c.LoadThrottleSequenceRequestH\x00\x12@\n\x17start_throttle_sequence\x18\x10 \x01(\x0b\x32\x1d.StartThrottleSequenceRequestH\x00\x12-\n\rcalibrate_tvc\x18\t \x01(\x0b\x32\x14.CalibrateTvcRequestH\x00\x12\x34\n\x11load_tvc_sequence\x18\x1d \x01(\x0b\x32\x17.LoadTvcSequenceRequestH\x00\x12\x36\n\x12start_tvc_sequence\x18\x1e \x01(\x0b\x32\x18.StartTvcSequenceRequestH\x00\x12?\n\x17load_rcs_valve_sequence\x18\x13 \x01(\x0b\x32\x1c.LoadRcsValveSequenceRequestH\x00\x12\x41\n\x18start_rcs_valve_sequence\x18\x14 \x01(\x0b\x32\x1d.StartRcsValveSequenceRequestH\x00\x12\x34\n\x11load_rcs_sequence\x18\x15 \x01(\x0b\x32\x17.LoadRcsSequenceRequestH\x00\x12\x36\n\x12start_rcs_sequence\x18\x16 \x01(\x0b\x32\x18.StartRcsSequenceRequestH\x00\x12\x43\n\x19load_static_fire_sequence\x18\x04 \x01(\x0b\x32\x1e.LoadStaticFireSequenceRequestH\x00\x12\x45\n\x1astart_static_fire_sequence\x18& \x01(\x0b\x32\x1f.StartStaticFireSequenceRequestH\x00\x12:\n\x14load_flight_sequence\x18\x1f \x01(\x0b\x32\x1a.LoadFlightSequenceRequestH\x00\x12<\n\x15start_flight_sequence\x18  \x01(\x0b\x32\x1b.StartFlightSequenceRequestH\x00\x42\t\n\x07payload\"\x17\n\x08Response\x12\x0b\n\x03\x65rr\x18\x01 \x01(\t\"\x1c\n\x1aSubscribeDataStreamRequest\"\x15\n\x13IsNotAbortedRequest\"4\n\x15IdentifyClientRequest\x12\x1b\n\x06\x63lient\x18\x01 \x02(\x0e\x32\x0b.ClientType\"E\n\x1d\x43onfigureAnalogSensorsRequest\x12$\n\x07\x63onfigs\x18\x01 \x03(\x0b\x32\x13.AnalogSensorConfig\"\xb8\x01\n\x12\x41nalogSensorConfig\x12\x0f\n\x07\x63hannel\x18\x01 \x02(\r\x12!\n\nassignment\x18\x02 \x02(\x0e\x32\r.AnalogSensor\x12\x15\n\rpt_range_psig\x18\x03 \x01(\x02\x12\x14\n\x0cpt_bias_psig\x18\x04 \x01(\x02\x12\x18\n\x07tc_type\x18\x05 \x01(\x0e\x32\x07.TCType\x12\x13\n\x0braw_range_v\x18\x06 \x01(\x02\x12\x12\n\nraw_bias_v\x18\x07 \x01(\x02\"7\n\x16\x43onfigureValvesRequest\x12\x1d\n\x07\x63onfigs\x18\x01 \x03(\x0b\x32\x0c.ValveConfig\"S\n\x0bValveConfig\x12\x0f\n\x07\x63hannel\x18\x01 \x02(\r\x12\x1a\n\nassignment\x18\x02 \x02(\x0e\x32\x06.Valve\x12\x17\n\x0fnormally_closed\x18\x03 \x01(\x08\"H\n\x13\x41\x63tuateValveRequest\x12\x15\n\x05valve\x18\x01 \x02(\x0e\x32\x06.Valve\x12\x1a\n\x05state\x18\x02 \x02(\x0e\x32\x0b.ValveState\"[\n!ThrottleResetValvePositionRequest\x12!\n\x05valve\x18\x01 \x02(\x0e\x32\x12.ThrottleValveType\x12\x13\n\x0bnew_pos_deg\x18\x02 \x02(\x02\"\x0e\n\x0c\x41\x62ortRequest\"\r\n\x0bHaltRequest\"\x10\n\x0eUnprimeRequest\";\n\x16ThrottlePowerOnRequest\x12!\n\x05valve\x18\x01 \x02(\x0e\x32\x12.ThrottleValveType\"<\n\x17ThrottlePowerOffRequest\x12!\n\x05valve\x18\x01 \x02(\x0e\x32\x12.ThrottleValveType\"B\n\x1d\x43\x61librateThrottleValveRequest\x12!\n\x05valve\x18\x01 \x02(\x0e\x32\x12.ThrottleValveType\"o\n LoadThrottleValveSequenceRequest\x12%\n\x0e\x66uel_trace_deg\x18\x01 \x01(\x0b\x32\r.ControlTrace\x12$\n\rlox_trace_deg\x18\x02 \x01(\x0b\x32\r.ControlTrace\"#\n!StartThrottleValveSequenceRequest\"@\n\x1bLoadThrottleSequenceRequest\x12!\n\nthrust_lbf\x18\x01 \x02(\x0b\x32\r.ControlTrace\"\x1e\n\x1cStartThrottleSequenceRequest\"t\n\x1bLoadRcsValveSequenceRequest\x12)\n\x12rcs_cw_valve_trace\x18\x01 \x02(\x0b\x32\r.ControlTrace\x12*\n\x13rcs_ccw_valve_trace\x18\x02 \x02(\x0b\x32\r.ControlTrace\"\x1e\n\x1cStartRcsValveSequenceRequest\":\n\x16LoadRcsSequenceRequest\x12 \n\ttrace_deg\x18\x01 \x02(\x0b\x32\r.ControlTrace\"\x19\n\x17StartRcsSequenceRequest\"\x90\x01\n\x1dLoadStaticFireSequenceRequest\x12!\n\nthrust_lbf\x18\x01 \x02(\x0b\x32\r.ControlTrace\x12&\n\x0fpitch_trace_deg\x18\x02 \x02(\x0b\x32\r.ControlTrace\x12$\n\ryaw_trace_deg\x18\x03 \x02(\x0b\x32\r.ControlTrace\" \n\x1eStartStaticFireSequenceRequest\"\x15\n\x13\x43\x61librateTvcRequest\"f\n\x16LoadTvcSequenceRequest\x12&\n\x0fpitch_trace_deg\x18\x01 \x02(\x0b\x32\r.ControlTrace\x12$\n\ryaw_trace_deg\x18\x02 \x02(\x0b\x32\r.ControlTrace\"\x19\n\x17StartTvcSequenceRequest\"\xc9\x01\n\x19LoadFlightSequenceRequest\x12)\n\x12x_position_trace_m\x18\x01 \x02(\x0b\x32\r.ControlTrace\x12)\n\x12y_position_trace_m\x18\x02 \x02(\x0b\x32\r.ControlTrace\x12)\n\x12z_position_trace_m\x18\x03 \x02(\x0b\x32\r.ControlTrace\x12+\n\x14roll_angle_trace_deg\x18\x04 \x02(\x0b\x32\r.ControlTrace\"\x1c\n\x1aStartFlightSequenceRequest\"\x94\x0b\n%ConfigureFlightControllerGainsRequest\x12\x13\n\x0bpidXTilt_kp\x18\x01 \x01(\x02\x12\x13\n\x0bpidXTilt_ki\x18\x02 \x01(\x02\x12\x13\n\x0bpidXTilt_kd\x18\x03 \x01(\x02\x12\x13\n\x0bpidYTilt_kp\x18\x04 \x01(\x02\x12\x13\n\x0bpidYTilt_ki\x18\x05 \x01(\x02\x12\x13\n\x0bpidYTilt_kd\x18\x06 \x01(\x02\x12\x0f\n\x07pidX_kp\x18\x07 \x01(\x02\x12\x0f\n\x07pidX_ki\x18\x08 \x01(\x02\x12\x0f\n\x07pidX_kd\x18\t \x01(\x02\x12\x0f\n\x07pidY_kp\x18\n \x01(\x02\x12\x0f\n\x07pidY_ki\x18\x0b \x01(\x02\x12\x0f\n\x07pidY_kd\x18\x0c \x01(\x02\x12\x0f\n\x07pidZ_kp\x18\r \x01(\x02\x12\x0f\n\x07pidZ_ki\x18\x0e \x01(\x02\x12\x0f\n\x07pidZ_kd\x18\x0f \x01(\x02\x12\x17\n\x0fpidZVelocity_kp\x18\x10 \x01(\x02\x12\x17\n\x0fpidZVelocity_ki\x18\x11 \x01(\x02\x12\x17\n\x0fpidZVelocity_kd\x18\x12 \x01(\x02\x12\x18\n\x10pidXTilt_min_out\x18\x13 \x01(\x02\x12\x18\n\x10pidXTilt_max_out\x18\x14 \x01(\x02\x12\x18\n\x10pidYTilt_min_out\x18\x15 \x01(\x02\x12\x18\n\x10pidYTilt_max_out\x18\x16 \x01(\x02\x12\x14\n\x0cpidX_min_out\x18\x17 \x01(\x02\x12\x14\n\x0cpidX_max_out\x18\x18 \x01(\x02\x12\x14\n\x0cpidY_min_out\x18\x19 \x01(\x02\x12\x14\n\x0cpidY_max_out\x18\x1a \x01(\x02\x12\x14\n\x0cpidZ_min_out\x18\x1b \x01(\x02\x12\x14\n\x0cpidZ_max_out\x18\x1c \x01(\x02\x12\x1c\n\x14pidZVelocity_min_out\x18\x1d \x01(\x02\x12\x1c\n\x14pidZVelocity_max_out\x18\x1e \x01(\x02\x12\x1d\n\x15pidXTilt_min_integral\x18\x1f \x01(\x02\x12\x1d\n\x15pidXTilt_max_integral\x18  \x01(\x02\x12\x1d\n\x15pidYTilt_min_integral\x18! \x01(\x02\x12\x1d\n\x15pidYTilt_max_integral\x18\" \x01(\x02\x12\x19\n\x11pidX_min_integral\x18# \x01(\x02\x12\x19\n\x11pidX_max_integral\x18$ \x01(\x02\x12\x19\n\x11pidY_min_integral\x18% \x01(\x02\x12\x19\n\x11pidY_max_integral\x18& \x01(\x02\x12\x19\n\x11pidZ_min_integral\x18\' \x01(\x02\x12\x19\n\x11pidZ_max_integral\x18( \x01(\x02\x12!\n\x19pidZVelocity_min_integral\x18) \x01(\x02\x12!\n\x19pidZVelocity_max_integral\x18* \x01(\x02\x12\x1e\n\x16pidXTilt_integral_zone\x18+ \x01(\x02\x12\x1e\n\x16pidYTilt_integral_zone\x18, \x01(\x02\x12\x1a\n\x12pidX_integral_zone\x18- \x01(\x02\x12\x1a\n\x12pidY_integral_zone\x18. \x01(\x02\x12\x1a\n\x12pidZ_integral_zone\x18/ \x01(\x02\x12\"\n\x1apidZVelocity_integral_zone\x18\x30 \x01(\x02\x12\x1c\n\x14pidXTilt_deriv_lp_hz\x18\x31 \x01(\x02\x12\x1c\n\x14pidYTilt_deriv_lp_hz\x18\x32 \x01(\x02\x12\x18\n\x10pidX_deriv_lp_hz\x18\x33 \x01(\x02\x12\x18\n\x10pidY_deriv_lp_hz\x18\x34 \x01(\x02\x12\x18\n\x10pidZ_deriv_lp_hz\x18\x35 \x01(\x02\x12 \n\x18pidZVelocity_deriv_lp_hz\x18\x36 \x01(\x02\x12\x19\n\x11reset_integrators\x18\x37 \x01(\x08\"\xe3\x01\n\x1dLoadFlightGainScheduleRequest\x12\x14\n\x0cthrust_min_N\x18\x01 \x02(\x02\x12\x14\n\x0cthrust_gap_N\x18\x02 \x02(\x02\x12\x16\n\x0e\x61ltitude_min_m\x18\x03 \x02(\x02\x12\x16\n\x0e\x61ltitude_gap_m\x18\x04 \x02(\x02\x12\"\n\x08pidXTilt\x18\x05 \x01(\x0b\x32\x10.FlightGainTable\x12\"\n\x08pidYTilt\x18\x06 \x01(\x0b\x32\x10.FlightGainTable\x12\x1e\n\x04pidZ\x18\x07 \x01(\x0b\x32\x10.FlightGainTable\"5\n\x0f\x46lightGainTable\x12\n\n\x02kp\x18\x01 \x03(\x02\x12\n\n\x02ki\x18\x02 \x03(\x02\x12\n\n\x02kd\x18\x03 \x03(\x02\"A\n\x0c\x43ontrolTrace\x12\x15\n\rtotal_time_ms\x18\x01 \x02(\r\x12\x1a\n\x08segments\x18\x02 \x03(\x0b\x32\x08.Segment\"v\n\x07Segment\x12\x10\n\x08start_ms\x18\x01 \x02(\r\x12\x11\n\tlength_ms\x18\x02 \x02(\r\x12 \n\x06linear\x18\x03 \x01(\x0b\x32\x0e.LinearSegmentH\x00\x12\x1c\n\x04sine\x18\x04 \x01(\x0b\x32\x0c.SineSegmentH\x00\x42\x06\n\x04type\"3\n\rLinearSegment\x12\x11\n\tstart_val\x18\x01 \x02(\x02\x12\x0f\n\x07\x65nd_val\x18\x02 \x02(\x02\"S\n\x0bSineSegment\x12\x0e\n\x06offset\x18\x01 \x02(\x02\x12\x11\n\tamplitude\x18\x02 \x02(\x02\x12\x0e\n\x06period\x18\x03 \x02(\x02\x12\x11\n\tphase_deg\x18\x04 \x02(\x02\"\x90\r\n\nDataPacket\x12\x0f\n\x07time_ns\x18\x01 \x02(\x04\x12\x1b\n\x05state\x18\x06 \x02(\x0e\x32\x0c.SystemState\x12,\n\x11\x63ontroller_timing\x18\x14 \x02(\x0b\x32\x11.ControllerTiming\x12\x17\n\x0f\x64\x61ta_queue_size\x18\x02 \x02(\r\x12\x17\n\x0fsequence_number\x18\x08 \x02(\x04\x12\x15\n\rgnc_connected\x18\x0f \x02(\x08\x12\x1a\n\x12gnc_last_pinged_ns\x18\x10 \x02(\x02\x12\x15\n\rdaq_connected\x18\x11 \x02(\x08\x12\x1a\n\x12\x64\x61q_last_pinged_ns\x18\x12 \x02(\x02\x12-\n\x0e\x61nalog_sensors\x18\x13 \x02(\x0b\x32\x15.AnalogSensorReadings\x12\x1e\n\x07lidar_1\x18\x15 \x01(\x0b\x32\r.LidarReading\x12\x1e\n\x07lidar_2\x18\x16 \x01(\x0b\x32\r.LidarReading\x12/\n\x11\x66uel_valve_status\x18\\ \x01(\x0b\x32\x14.ThrottleValveStatus\x12.\n\x10lox_valve_status\x18] \x01(\x0b\x32\x14.ThrottleValveStatus\x12\x18\n\x03imu\x18\x17 \x01(\x0b\x32\x0b.ImuReading\x12(\n\x0f\x65stimated_state\x18V \x01(\x0b\x32\x0f.EstimatedState\x12\x17\n\x0f\x61\x62ort_time_msec\x18U \x01(\x02\x12\x17\n\x0ftrace_time_msec\x18\x03 \x01(\x02\x12#\n\x1bthrottle_thrust_command_lbf\x18S \x01(\x02\x12\x1d\n\x15tvc_pitch_command_deg\x18T \x01(\x02\x12\x1b\n\x13tvc_yaw_command_deg\x18G \x01(\x02\x12\x1c\n\x14rcs_roll_command_deg\x18H \x01(\x02\x12\x1a\n\x12\x66light_x_command_m\x18I \x01(\x02\x12\x1a\n\x12\x66light_y_command_m\x18J \x01(\x02\x12\x1a\n\x12\x66light_z_command_m\x18K \x01(\x02\x12!\n\x19\x66light_pitch_accel_rad_s2\x18X \x01(\x02\x12\x1f\n\x17\x66light_yaw_accel_rad_s2\x18Y \x01(\x02\x12\x1b\n\x13\x66light_z_accel_m_s2\x18Z \x01(\x02\x12;\n\x19\x66light_controller_metrics\x18\x45 \x01(\x0b\x32\x18.FlightControllerMetrics\x12\x37\n\x17ranger_throttle_metrics\x18N \x01(\x0b\x32\x16.RangerThrottleMetrics\x12\x37\n\x17hornet_throttle_metrics\x18M \x01(\x0b\x32\x16.HornetThrottleMetrics\x12-\n\x12ranger_tvc_metrics\x18P \x01(\x0b\x32\x11.RangerTvcMetrics\x12-\n\x12hornet_tvc_metrics\x18O \x01(\x0b\x32\x11.HornetTvcMetrics\x12-\n\x12ranger_rcs_metrics\x18R \x01(\x0b\x32\x11.RangerRcsMetrics\x12-\n\x12hornet_rcs_metrics\x18Q \x01(\x0b\x32\x11.HornetRcsMetrics\x12\"\n\x0cvalve_states\x18W \x02(\x0b\x32\x0c.ValveStates\x12\x31\n\x12\x66uel_valve_command\x18< \x01(\x0b\x32\x15.ThrottleValveCommand\x12\x30\n\x11lox_valve_command\x18= \x01(\x0b\x32\x15.ThrottleValveCommand\x12\x33\n\x16pitch_actuator_command\x18> \x01(\x0b\x32\x13.TvcActuatorCommand\x12\x31\n\x14yaw_actuator_command\x18? \x01(\x0b\x32\x13.TvcActuatorCommand\x12\x1b\n\x04gnss\x18[ \x01(\x0b\x32\r.GnssReadings\x12\x1e\n\x16main_propeller_command\x18@ \x01(\x05\x12\x1b\n\x13pitch_servo_command\x18\x43 \x01(\x05\x12\x19\n\x11yaw_servo_command\x18\x44 \x01(\x05\x12 \n\x18rcs_propeller_cw_command\x18\x41 \x01(\x05\x12!\n\x19rcs_propeller_ccw_command\x18\x42 \x01(\x05\"\x86\x01\n\x0fRateGroupTiming\x12\x0b\n\x03ran\x18\x01 \x02(\x08\x12\x0c\n\x04\x64t_s\x18\x02 \x02(\x02\x12\x14\n\x0c\x65xec_time_ns\x18\x03 \x02(\x02\x12\x18\n\x10max_exec_time_ns\x18\x04 \x02(\x02\x12\x11\n\trun_count\x18\x05 \x02(\r\x12\x15\n\roverrun_count\x18\x06 \x02(\r\"\xb3\x02\n\x10\x43ontrollerTiming\x12\x1f\n\x17\x63ontroller_tick_time_ns\x18\x01 \x02(\x02\x12$\n\x1c\x61nalog_sensors_sense_time_ns\x18\x02 \x02(\x02\x12&\n\x1estate_estimator_update_time_ns\x18\x03 \x02(\x02\x12&\n\x0c\x66light_outer\x18\x04 \x01(\x0b\x32\x10.RateGroupTiming\x12&\n\x0c\x66light_inner\x18\x05 \x01(\x0b\x32\x10.RateGroupTiming\x12\"\n\x08throttle\x18\x06 \x01(\x0b\x32\x10.RateGroupTiming\x12\x1d\n\x03tvc\x18\x07 \x01(\x0b\x32\x10.RateGroupTiming\x12\x1d\n\x03rcs\x18\x08 \x01(\x0b\x32\x10.RateGroupTiming\"m\n\x13ThrottleValveStatus\x12\x17\n\x0f\x65ncoder_pos_deg\x18\x03 \x02(\x02\x12\r\n\x05is_on\x18\x04 \x02(\x08\x12.\n\x0b\x63\x61libration\x18\x05 \x01(\x0b\x32\x19.ThrottleValveCalibration\"u\n\x18ThrottleValveCalibration\x12\x14\n\x0chardstop_deg\x18\x01 \x02(\x02\x12\x19\n\x11repeatability_deg\x18\x02 \x02(\x02\x12\x13\n\x0b\x66ine_passes\x18\x03 \x02(\r\x12\x13\n\x0b\x64uration_ms\x18\x04 \x02(\r\":\n\x14ThrottleValveCommand\x12\x0e\n\x06\x65nable\x18\x01 \x02(\x08\x12\x12\n\ntarget_deg\x18\x03 \x02(\x02\"\x14\n\x12TvcActuatorCommand\"\xa6\x03\n\x14\x41nalogSensorReadings\x12\r\n\x05pt001\x18\x01 \x01(\x02\x12\r\n\x05pt002\x18\x02 \x01(\x02\x12\r\n\x05pt003\x18\x03 \x01(\x02\x12\r\n\x05pt004\x18\x04 \x01(\x02\x12\r\n\x05pt005\x18\x05 \x01(\x02\x12\r\n\x05pt006\x18\x06 \x01(\x02\x12\r\n\x05pt103\x18\x07 \x01(\x02\x12\r\n\x05pt203\x18\x08 \x01(\x02\x12\r\n\x05pt301\x18\t \x01(\x02\x12\x0e\n\x06ptf401\x18\n \x01(\x02\x12\x0e\n\x06pto401\x18\x0b \x01(\x02\x12\x0e\n\x06ptc401\x18\x0c \x01(\x02\x12\x0e\n\x06ptc402\x18\r \x01(\x02\x12\r\n\x05tc002\x18\x0e \x01(\x02\x12\r\n\x05tc102\x18\x0f \x01(\x02\x12\x0f\n\x07tc102_5\x18\x10 \x01(\x02\x12\x0e\n\x06tcf401\x18\x11 \x01(\x02\x12\x0e\n\x06tco401\x18\x12 \x01(\x02\x12\x0e\n\x06ptg001\x18\x13 \x01(\x02\x12\x0e\n\x06ptg002\x18\x14 \x01(\x02\x12\x0e\n\x06ptg101\x18\x15 \x01(\x02\x12\x17\n\x0f\x62\x61ttery_voltage\x18\x16 \x01(\x02\x12\x17\n\x0f\x63\x61pture_time_ns\x18\x17 \x01(\x04\x12\x16\n\x0esample_counter\x18\x18 \x01(\r\"+\n\x08Vector3D\x12\t\n\x01x\x18\x01 \x02(\x02\x12\t\n\x01y\x18\x02 \x02(\x02\x12\t\n\x01z\x18\x03 \x02(\x02\"\x80\x03\n\x0bValveStates\x12\x1a\n\x05sv001\x18\x01 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv002\x18\x02 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv003\x18\x03 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv004\x18\x04 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv005\x18\x05 \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06pbv006\x18\x06 \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06pbv101\x18\x07 \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06pbv201\x18\x08 \x01(\x0e\x32\x0b.ValveState\x12\x1a\n\x05sv301\x18\t \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06svr001\x18\n \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06svr002\x18\x0b \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06svr003\x18\x0c \x01(\x0e\x32\x0b.ValveState\x12\x1b\n\x06svr004\x18\r \x01(\x0e\x32\x0b.ValveState\"\xb5\x01\n\x0cLidarReading\x12\x12\n\ndistance_m\x18\x01 \x02(\x02\x12\x10\n\x08strength\x18\x02 \x02(\x02\x12\x15\n\rsense_time_ns\x18\x03 \x02(\x02\x12\x17\n\x0f\x63\x61pture_time_ns\x18\x04 \x02(\x04\x12\x16\n\x0esample_counter\x18\x05 \x02(\r\x12\x19\n\x11\x66rame_error_count\x18\x06 \x02(\r\x12\x1c\n\x14\x63hecksum_error_count\x18\x07 \x02(\r\"\xac\x05\n\nImuReading\x12\x0b\n\x03yaw\x18\x01 \x01(\x02\x12\r\n\x05pitch\x18\x02 \x01(\x02\x12\x0c\n\x04roll\x18\x03 \x01(\x02\x12\x0f\n\x07\x61\x63\x63\x65l_x\x18\x04 \x02(\x02\x12\x0f\n\x07\x61\x63\x63\x65l_y\x18\x05 \x02(\x02\x12\x0f\n\x07\x61\x63\x63\x65l_z\x18\x06 \x02(\x02\x12\x0e\n\x06gyro_x\x18\x07 \x02(\x02\x12\x0e\n\x06gyro_y\x18\x08 \x02(\x02\x12\x0e\n\x06gyro_z\x18\t \x02(\x02\x12\x0f\n\x07gps_lat\x18\n \x01(\x02\x12\x0f\n\x07gps_lon\x18\x0b \x01(\x02\x12\x0f\n\x07gps_alt\x18\x0c \x01(\x02\x12\x0f\n\x07ins_lat\x18\r \x01(\x02\x12\x0f\n\x07ins_lon\x18\x0e \x01(\x02\x12\x0f\n\x07ins_alt\x18\x0f \x01(\x02\x12\r\n\x05vel_n\x18\x10 \x01(\x02\x12\r\n\x05vel_e\x18\x11 \x01(\x02\x12\r\n\x05vel_d\x18\x12 \x01(\x02\x12\r\n\x05mag_x\x18\x13 \x02(\x02\x12\r\n\x05mag_y\x18\x14 \x02(\x02\x12\r\n\x05mag_z\x18\x15 \x02(\x02\x12\x0e\n\x06quat_w\x18\x16 \x02(\x02\x12\x0e\n\x06quat_x\x18\x17 \x02(\x02\x12\x0e\n\x06quat_y\x18\x18 \x02(\x02\x12\x0e\n\x06quat_z\x18\x19 \x02(\x02\x12\x15\n\rsense_time_ns\x18\x1a \x02(\x02\x12\x12\n\nins_status\x18\x1b \x01(\r\x12\x1a\n\x12vn_time_startup_ns\x18\x1c \x01(\x04\x12\x17\n\x0f\x63rc_error_count\x18\x1d \x01(\r\x12\x17\n\x0f\x63\x61pture_time_ns\x18\x1e \x02(\x04\x12\x16\n\x0esample_counter\x18\x1f \x02(\r\x12\"\n\x0f\x64\x65lta_angle_rad\x18  \x01(\x0b\x32\t.Vector3D\x12%\n\x12\x64\x65lta_velocity_m_s\x18! \x01(\x0b\x32\t.Vector3D\x12\x14\n\x0c\x64\x65lta_time_s\x18\" \x01(\x02\x12\x1f\n\x17integrated_sample_count\x18# \x01(\r\"\x18\n\x16\x46lightControllerOutput\"<\n\nQuaternion\x12\n\n\x02qw\x18\n \x02(\x02\x12\n\n\x02qx\x18\x01 \x02(\x02\x12\n\n\x02qy\x18\x02 \x02(\x02\x12\n\n\x02qz\x18\x03 \x02(\x02\"\xe6\x01\n\x0e\x45stimatedState\x12\x19\n\x04R_WB\x18\x01 \x02(\x0b\x32\x0b.Quaternion\x12\x18\n\x05\x65uler\x18\x04 \x02(\x0b\x32\t.Vector3D\x12\x1b\n\x08position\x18\x02 \x02(\x0b\x32\t.Vector3D\x12\x1b\n\x08velocity\x18\x03 \x02(\x0b\x32\t.Vector3D\x12\x12\n\nimu_age_ns\x18\x05 \x02(\x02\x12\x14\n\x0clidar_age_ns\x18\x06 \x02(\x02\x12\x13\n\x0bgnss_age_ns\x18\x07 \x02(\x02\x12\r\n\x05stale\x18\x08 \x02(\x08\x12\x17\n\x0f\x65stimate_age_ns\x18\t \x02(\x02\"w\n\x1c\x46lightControllerDesiredState\x12\x1b\n\x08position\x18\x01 \x02(\x0b\x32\t.Vector3D\x12\x14\n\x0cworld_tilt_x\x18\x02 \x02(\x02\x12\x14\n\x0cworld_tilt_y\x18\x03 \x02(\x02\x12\x0e\n\x06vz_m_s\x18\x05 \x02(\x02\"\xcc\x02\n\x17\x46lightControllerMetrics\x12 \n\x18\x64\x65sired_world_tilt_x_rad\x18\x01 \x02(\x02\x12 \n\x18\x64\x65sired_world_tilt_y_rad\x18\x02 \x02(\x02\x12\x1f\n\x17\x61\x63tual_world_tilt_x_rad\x18\x03 \x02(\x02\x12\x1f\n\x17\x61\x63tual_world_tilt_y_rad\x18\x04 \x02(\x02\x12%\n\x1d\x64\x65sired_vertical_velocity_m_s\x18\x05 \x02(\x02\x12,\n$commanded_vertical_acceleration_m_s2\x18\x06 \x02(\x02\x12+\n#commanded_pitch_acceleration_rad_s2\x18\x07 \x02(\x02\x12)\n!commanded_yaw_acceleration_rad_s2\x18\x08 \x02(\x02\"\xda\x01\n\x15RangerThrottleMetrics\x12\x1c\n\x14predicted_thrust_lbf\x18\x01 \x02(\x02\x12\x14\n\x0cpredicted_of\x18\x02 \x02(\x02\x12\x11\n\tmdot_fuel\x18\x03 \x02(\x02\x12\x10\n\x08mdot_lox\x18\x04 \x02(\x02\x12\x18\n\x10\x63hange_alpha_cmd\x18\x07 \x02(\x02\x12 \n\x18\x63lamped_change_alpha_cmd\x18\x08 \x02(\x02\x12\r\n\x05\x61lpha\x18\t \x02(\x02\x12\x1d\n\x15thrust_from_alpha_lbf\x18\n \x02(\x02\")\n\x15HornetThrottleMetrics\x12\x10\n\x08thrust_N\x18\x01 \x01(\x02\"\x12\n\x10RangerTvcMetrics\"\x12\n\x10HornetTvcMetrics\"\x12\n\x10RangerRcsMetrics\"\x12\n\x10HornetRcsMetrics\"\xed\x02\n\x0cGnssReadings\x12\x0f\n\x07north_m\x18\x01 \x02(\x02\x12\x0e\n\x06\x65\x61st_m\x18\x02 \x02(\x02\x12\x0c\n\x04up_m\x18\x03 \x02(\x02\x12\x13\n\x0bpos_sigma_m\x18\x04 \x02(\x02\x12\r\n\x05vx_ms\x18\x05 \x02(\x02\x12\r\n\x05vy_ms\x18\x06 \x02(\x02\x12\r\n\x05vz_ms\x18\x07 \x02(\x02\x12\x14\n\x0cvel_sigma_ms\x18\x08 \x02(\x02\x12\x0e\n\x06hrms_m\x18\t \x02(\x02\x12\x0e\n\x06vrms_m\x18\n \x02(\x02\x12\x13\n\x0bhvel_rms_ms\x18\x0b \x02(\x02\x12\x13\n\x0bvvel_rms_ms\x18\x0c \x02(\x02\x12\x18\n\x10solution_time_ms\x18\r \x02(\r\x12\x18\n\x10receiver_time_ms\x18\x0e \x02(\r\x12\x10\n\x08sol_type\x18\x0f \x02(\r\x12\x15\n\rsense_time_ns\x18\x10 \x02(\x02\x12\x17\n\x0f\x63\x61pture_time_ns\x18\x11 \x02(\x04\x12\x16\n\x0esample_counter\x18\x12 \x02(\r*2\n\nClientType\x12\x12\n\x0eUNKNOWN_CLIENT\x10\x01\x12\x07\n\x03GNC\x10\x02\x12\x07\n\x03\x44\x41Q\x10\x03*5\n\x06TCType\x12\x13\n\x0fUNKNOWN_TC_TYPE\x10\x00\x12\n\n\x06K_TYPE\x10\x01\x12\n\n\x06T_TYPE\x10\x02*\xb0\x02\n\x0c\x41nalogSensor\x12\x19\n\x15UNKNOWN_ANALOG_SENSOR\x10\x00\x12\t\n\x05PT001\x10\x01\x12\t\n\x05PT002\x10\x02\x12\t\n\x05PT003\x10\x03\x12\t\n\x05PT004\x10\x04\x12\t\n\x05PT005\x10\x05\x12\t\n\x05PT006\x10\x06\x12\t\n\x05PT103\x10\x07\x12\t\n\x05PT203\x10\x08\x12\t\n\x05PT301\x10\t\x12\n\n\x06PTF401\x10\n\x12\n\n\x06PTO401\x10\x0b\x12\n\n\x06PTC401\x10\x0c\x12\n\n\x06PTC402\x10\r\x12\t\n\x05TC002\x10\x0e\x12\t\n\x05TC102\x10\x0f\x12\x0b\n\x07TC102_5\x10\x10\x12\n\n\x06TCF401\x10\x11\x12\n\n\x06TCO401\x10\x12\x12\n\n\x06PTG001\x10\x13\x12\n\n\x06PTG002\x10\x14\x12\n\n\x06PTG101\x10\x15\x12\x13\n\x0f\x42\x41TTERY_VOLTAGE\x10\x16*\xb0\x01\n\x05Valve\x12\x11\n\rUNKNOWN_VALVE\x10\x00\x12\t\n\x05SV001\x10\x01\x12\t\n\x05SV002\x10\x02\x12\t\n\x05SV003\x10\x03\x12\t\n\x05SV004\x10\x04\x12\t\n\x05SV005\x10\x05\x12\n\n\x06PBV006\x10\x06\x12\n\n\x06PBV101\x10\x07\x12\n\n\x06PBV201\x10\x08\x12\t\n\x05SV301\x10\t\x12\n\n\x06SVR001\x10\n\x12\n\n\x06SVR002\x10\x0b\x12\n\n\x06SVR003\x10\x0c\x12\n\n\x06SVR004\x10\r*;\n\nValveState\x12\x17\n\x13UNKNOWN_VALVE_STATE\x10\x00\x12\x08\n\x04OPEN\x10\x01\x12\n\n\x06\x43LOSED\x10\x02*G\n\x11ThrottleValveType\x12\x1f\n\x1bUNKNOWN_THROTTLE_VALVE_TYPE\x10\x00\x12\x08\n\x04\x46UEL\x10\x01\x12\x07\n\x03LOX\x10\x02*\xc3\x03\n\x0bSystemState\x12\x11\n\rSTATE_UNKNOWN\x10\x00\x12\x0e\n\nSTATE_IDLE\x10\x01\x12\x0f\n\x0bSTATE_ABORT\x10\x02\x12\"\n\x1eSTATE_CALIBRATE_THROTTLE_VALVE\x10\x03\x12\x18\n\x14STATE_THROTTLE_VALVE\x10\x04\x12\x1f\n\x1bSTATE_THROTTLE_VALVE_PRIMED\x10\x05\x12\x12\n\x0eSTATE_THROTTLE\x10\x06\x12\x19\n\x15STATE_THROTTLE_PRIMED\x10\x07\x12\x17\n\x13STATE_CALIBRATE_TVC\x10\x08\x12\r\n\tSTATE_TVC\x10\t\x12\x14\n\x10STATE_TVC_PRIMED\x10\n\x12\x13\n\x0fSTATE_RCS_VALVE\x10\x0b\x12\x1a\n\x16STATE_RCS_VALVE_PRIMED\x10\x0c\x12\r\n\tSTATE_RCS\x10\r\x12\x14\n\x10STATE_RCS_PRIMED\x10\x0e\x12\x15\n\x11STATE_STATIC_FIRE\x10\x0f\x12\x1c\n\x18STATE_STATIC_FIRE_PRIMED\x10\x10\x12\x10\n\x0cSTATE_FLIGHT\x10\x11\x12\x17\n\x13STATE_FLIGHT_PRIMED\x10\x12')
 
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, globals())
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'clover_pb2', globals())
 if _descriptor._USE_C_DESCRIPTORS == False:
 
   DESCRIPTOR._options = None
-  _CLIENTTYPE._serialized_start=10128
-  _CLIENTTYPE._serialized_end=10178
-  _TCTYPE._serialized_start=10180
-  _TCTYPE._serialized_end=10233
-  _ANALOGSENSOR._serialized_start=10236
-  _ANALOGSENSOR._serialized_end=10540
-  _VALVE._serialized_start=10543
-  _VALVE._serialized_end=10719
-  _VALVESTATE._serialized_start=10721
-  _VALVESTATE._serialized_end=10780
-  _THROTTLEVALVETYPE._serialized_start=10782
-  _THROTTLEVALVETYPE._serialized_end=10853
-  _SYSTEMSTATE._serialized_start=10856
-  _SYSTEMSTATE._serialized_end=11307
+  _CLIENTTYPE._serialized_start=11535
+  _CLIENTTYPE._serialized_end=11585
+  _TCTYPE._serialized_start=11587
+  _TCTYPE._serialized_end=11640
+  _ANALOGSENSOR._serialized_start=11643
+  _ANALOGSENSOR._serialized_end=11947
+  _VALVE._serialized_start=11950
+  _VALVE._serialized_end=12126
+  _VALVESTATE._serialized_start=12128
+  _VALVESTATE._serialized_end=12187
+  _THROTTLEVALVETYPE._serialized_start=12189
+  _THROTTLEVALVETYPE._serialized_end=12260
+  _SYSTEMSTATE._serialized_start=12263
+  _SYSTEMSTATE._serialized_end=12714
   _REQUEST._serialized_start=17
-  _REQUEST._serialized_end=1771
-  _RESPONSE._serialized_start=1773
-  _RESPONSE._serialized_end=1796
-  _SUBSCRIBEDATASTREAMREQUEST._serialized_start=1798
-  _SUBSCRIBEDATASTREAMREQUEST._serialized_end=1826
-  _ISNOTABORTEDREQUEST._serialized_start=1828
-  _ISNOTABORTEDREQUEST._serialized_end=1849
-  _IDENTIFYCLIENTREQUEST._serialized_start=1851
-  _IDENTIFYCLIENTREQUEST._serialized_end=1903
-  _CONFIGUREANALOGSENSORSREQUEST._serialized_start=1905
-  _CONFIGUREANALOGSENSORSREQUEST._serialized_end=1974
-  _ANALOGSENSORCONFIG._serialized_start=1977
-  _ANALOGSENSORCONFIG._serialized_end=2161
-  _CONFIGUREVALVESREQUEST._serialized_start=2163
-  _CONFIGUREVALVESREQUEST._serialized_end=2218
-  _VALVECONFIG._serialized_start=2220
-  _VALVECONFIG._serialized_end=2303
-  _ACTUATEVALVEREQUEST._serialized_start=2305
-  _ACTUATEVALVEREQUEST._serialized_end=2377
-  _THROTTLERESETVALVEPOSITIONREQUEST._serialized_start=2379
-  _THROTTLERESETVALVEPOSITIONREQUEST._serialized_end=2470
-  _ABORTREQUEST._serialized_start=2472
-  _ABORTREQUEST._serialized_end=2486
-  _HALTREQUEST._serialized_start=2488
-  _HALTREQUEST._serialized_end=2501
-  _UNPRIMEREQUEST._serialized_start=2503
-  _UNPRIMEREQUEST._serialized_end=2519
-  _THROTTLEPOWERONREQUEST._serialized_start=2521
-  _THROTTLEPOWERONREQUEST._serialized_end=2580
-  _THROTTLEPOWEROFFREQUEST._serialized_start=2582
-  _THROTTLEPOWEROFFREQUEST._serialized_end=2642
-  _CALIBRATETHROTTLEVALVEREQUEST._serialized_start=2644
-  _CALIBRATETHROTTLEVALVEREQUEST._serialized_end=2710
-  _LOADTHROTTLEVALVESEQUENCEREQUEST._serialized_start=2712
-  _LOADTHROTTLEVALVESEQUENCEREQUEST._serialized_end=2823
-  _STARTTHROTTLEVALVESEQUENCEREQUEST._serialized_start=2825
-  _STARTTHROTTLEVALVESEQUENCEREQUEST._serialized_end=2860
-  _LOADTHROTTLESEQUENCEREQUEST._serialized_start=2862
-  _LOADTHROTTLESEQUENCEREQUEST._serialized_end=2926
-  _STARTTHROTTLESEQUENCEREQUEST._serialized_start=2928
-  _STARTTHROTTLESEQUENCEREQUEST._serialized_end=2958
-  _LOADRCSVALVESEQUENCEREQUEST._serialized_start=2960
-  _LOADRCSVALVESEQUENCEREQUEST._serialized_end=3076
-  _STARTRCSVALVESEQUENCEREQUEST._serialized_start=3078
-  _STARTRCSVALVESEQUENCEREQUEST._serialized_end=3108
-  _LOADRCSSEQUENCEREQUEST._serialized_start=3110
-  _LOADRCSSEQUENCEREQUEST._serialized_end=3168
-  _STARTRCSSEQUENCEREQUEST._serialized_start=3170
-  _STARTRCSSEQUENCEREQUEST._serialized_end=3195
-  _LOADSTATICFIRESEQUENCEREQUEST._serialized_start=3198
-  _LOADSTATICFIRESEQUENCEREQUEST._serialized_end=3342
-  _STARTSTATICFIRESEQUENCEREQUEST._serialized_start=3344
-  _STARTSTATICFIRESEQUENCEREQUEST._serialized_end=3376
-  _CALIBRATETVCREQUEST._serialized_start=3378
-  _CALIBRATETVCREQUEST._serialized_end=3399
-  _LOADTVCSEQUENCEREQUEST._serialized_start=3401
-  _LOADTVCSEQUENCEREQUEST._serialized_end=3503
-  _STARTTVCSEQUENCEREQUEST._serialized_start=3505
-  _STARTTVCSEQUENCEREQUEST._serialized_end=3530
-  _LOADFLIGHTSEQUENCEREQUEST._serialized_start=3533
-  _LOADFLIGHTSEQUENCEREQUEST._serialized_end=3734
-  _STARTFLIGHTSEQUENCEREQUEST._serialized_start=3736
-  _STARTFLIGHTSEQUENCEREQUEST._serialized_end=3764
-  _CONFIGUREFLIGHTCONTROLLERGAINSREQUEST._serialized_start=3767
-  _CONFIGUREFLIGHTCONTROLLERGAINSREQUEST._serialized_end=5168
-  _CONTROLTRACE._serialized_start=5170
-  _CONTROLTRACE._serialized_end=5235
-  _SEGMENT._serialized_start=5237
-  _SEGMENT._serialized_end=5355
-  _LINEARSEGMENT._serialized_start=5357
-  _LINEARSEGMENT._serialized_end=5408
-  _SINESEGMENT._serialized_start=5410
-  _SINESEGMENT._serialized_end=5493
-  _DATAPACKET._serialized_start=5496
-  _DATAPACKET._serialized_end=7176
-  _CONTROLLERTIMING._serialized_start=7179
-  _CONTROLLERTIMING._serialized_end=7308
-  _THROTTLEVALVESTATUS._serialized_start=7310
-  _THROTTLEVALVESTATUS._serialized_end=7371
-  _THROTTLEVALVECOMMAND._serialized_start=7373
-  _THROTTLEVALVECOMMAND._serialized_end=7448
-  _TVCACTUATORCOMMAND._serialized_start=7450
-  _TVCACTUATORCOMMAND._serialized_end=7470
-  _ANALOGSENSORREADINGS._serialized_start=7473
-  _ANALOGSENSORREADINGS._serialized_end=7846
-  _VECTOR3D._serialized_start=7848
-  _VECTOR3D._serialized_end=7891
-  _VALVESTATES._serialized_start=7894
-  _VALVESTATES._serialized_end=8278
-  _LIDARREADING._serialized_start=8280
-  _LIDARREADING._serialized_end=8355
-  _IMUREADING._serialized_start=8358
-  _IMUREADING._serialized_end=8790
-  _FLIGHTCONTROLLEROUTPUT._serialized_start=8792
-  _FLIGHTCONTROLLEROUTPUT._serialized_end=8816
-  _QUATERNION._serialized_start=8818
-  _QUATERNION._serialized_end=8878
-  _ESTIMATEDSTATE._serialized_start=8880
-  _ESTIMATEDSTATE._serialized_end=9007
-  _FLIGHTCONTROLLERDESIREDSTATE._serialized_start=9009
-  _FLIGHTCONTROLLERDESIREDSTATE._serialized_end=9128
-  _FLIGHTCONTROLLERMETRICS._serialized_start=9131
-  _FLIGHTCONTROLLERMETRICS._serialized_end=9463
-  _RANGERTHROTTLEMETRICS._serialized_start=9466
-  _RANGERTHROTTLEMETRICS._serialized_end=9684
-  _HORNETTHROTTLEMETRICS._serialized_start=9686
-  _HORNETTHROTTLEMETRICS._serialized_end=9727
-  _RANGERTVCMETRICS._serialized_start=9729
-  _RANGERTVCMETRICS._serialized_end=9747
-  _HORNETTVCMETRICS._serialized_start=9749
-  _HORNETTVCMETRICS._serialized_end=9767
-  _RANGERRCSMETRICS._serialized_start=9769
-  _RANGERRCSMETRICS._serialized_end=9787
-  _HORNETRCSMETRICS._serialized_start=9789
-  _HORNETRCSMETRICS._serialized_end=9807
-  _GNSSREADINGS._serialized_start=9810
-  _GNSSREADINGS._serialized_end=10126
+  _REQUEST._serialized_end=1840
+  _RESPONSE._serialized_start=1842
+  _RESPONSE._serialized_end=1865
+  _SUBSCRIBEDATASTREAMREQUEST._serialized_start=1867
+  _SUBSCRIBEDATASTREAMREQUEST._serialized_end=1895
+  _ISNOTABORTEDREQUEST._serialized_start=1897
+  _ISNOTABORTEDREQUEST._serialized_end=1918
+  _IDENTIFYCLIENTREQUEST._serialized_start=1920
+  _IDENTIFYCLIENTREQUEST._serialized_end=1972
+  _CONFIGUREANALOGSENSORSREQUEST._serialized_start=1974
+  _CONFIGUREANALOGSENSORSREQUEST._serialized_end=2043
+  _ANALOGSENSORCONFIG._serialized_start=2046
+  _ANALOGSENSORCONFIG._serialized_end=2230
+  _CONFIGUREVALVESREQUEST._serialized_start=2232
+  _CONFIGUREVALVESREQUEST._serialized_end=2287
+  _VALVECONFIG._serialized_start=2289
+  _VALVECONFIG._serialized_end=2372
+  _ACTUATEVALVEREQUEST._serialized_start=2374
+  _ACTUATEVALVEREQUEST._serialized_end=2446
+  _THROTTLERESETVALVEPOSITIONREQUEST._serialized_start=2448
+  _THROTTLERESETVALVEPOSITIONREQUEST._serialized_end=2539
+  _ABORTREQUEST._serialized_start=2541
+  _ABORTREQUEST._serialized_end=2555
+  _HALTREQUEST._serialized_start=2557
+  _HALTREQUEST._serialized_end=2570
+  _UNPRIMEREQUEST._serialized_start=2572
+  _UNPRIMEREQUEST._serialized_end=2588
+  _THROTTLEPOWERONREQUEST._serialized_start=2590
+  _THROTTLEPOWERONREQUEST._serialized_end=2649
+  _THROTTLEPOWEROFFREQUEST._serialized_start=2651
+  _THROTTLEPOWEROFFREQUEST._serialized_end=2711
+  _CALIBRATETHROTTLEVALVEREQUEST._serialized_start=2713
+  _CALIBRATETHROTTLEVALVEREQUEST._serialized_end=2779
+  _LOADTHROTTLEVALVESEQUENCEREQUEST._serialized_start=2781
+  _LOADTHROTTLEVALVESEQUENCEREQUEST._serialized_end=2892
+  _STARTTHROTTLEVALVESEQUENCEREQUEST._serialized_start=2894
+  _STARTTHROTTLEVALVESEQUENCEREQUEST._serialized_end=2929
+  _LOADTHROTTLESEQUENCEREQUEST._serialized_start=2931
+  _LOADTHROTTLESEQUENCEREQUEST._serialized_end=2995
+  _STARTTHROTTLESEQUENCEREQUEST._serialized_start=2997
+  _STARTTHROTTLESEQUENCEREQUEST._serialized_end=3027
+  _LOADRCSVALVESEQUENCEREQUEST._serialized_start=3029
+  _LOADRCSVALVESEQUENCEREQUEST._serialized_end=3145
+  _STARTRCSVALVESEQUENCEREQUEST._serialized_start=3147
+  _STARTRCSVALVESEQUENCEREQUEST._serialized_end=3177
+  _LOADRCSSEQUENCEREQUEST._serialized_start=3179
+  _LOADRCSSEQUENCEREQUEST._serialized_end=3237
+  _STARTRCSSEQUENCEREQUEST._serialized_start=3239
+  _STARTRCSSEQUENCEREQUEST._serialized_end=3264
+  _LOADSTATICFIRESEQUENCEREQUEST._serialized_start=3267
+  _LOADSTATICFIRESEQUENCEREQUEST._serialized_end=3411
+  _STARTSTATICFIRESEQUENCEREQUEST._serialized_start=3413
+  _STARTSTATICFIRESEQUENCEREQUEST._serialized_end=3445
+  _CALIBRATETVCREQUEST._serialized_start=3447
+  _CALIBRATETVCREQUEST._serialized_end=3468
+  _LOADTVCSEQUENCEREQUEST._serialized_start=3470
+  _LOADTVCSEQUENCEREQUEST._serialized_end=3572
+  _STARTTVCSEQUENCEREQUEST._serialized_start=3574
+  _STARTTVCSEQUENCEREQUEST._serialized_end=3599
+  _LOADFLIGHTSEQUENCEREQUEST._serialized_start=3602
+  _LOADFLIGHTSEQUENCEREQUEST._serialized_end=3803
+  _STARTFLIGHTSEQUENCEREQUEST._serialized_start=3805
+  _STARTFLIGHTSEQUENCEREQUEST._serialized_end=3833
+  _CONFIGUREFLIGHTCONTROLLERGAINSREQUEST._serialized_start=3836
+  _CONFIGUREFLIGHTCONTROLLERGAINSREQUEST._serialized_end=5264
+  _LOADFLIGHTGAINSCHEDULEREQUEST._serialized_start=5267
+  _LOADFLIGHTGAINSCHEDULEREQUEST._serialized_end=5494
+  _FLIGHTGAINTABLE._serialized_start=5496
+  _FLIGHTGAINTABLE._serialized_end=5549
+  _CONTROLTRACE._serialized_start=5551
+  _CONTROLTRACE._serialized_end=5616
+  _SEGMENT._serialized_start=5618
+  _SEGMENT._serialized_end=5736
+  _LINEARSEGMENT._serialized_start=5738
+  _LINEARSEGMENT._serialized_end=5789
+  _SINESEGMENT._serialized_start=5791
+  _SINESEGMENT._serialized_end=5874
+  _DATAPACKET._serialized_start=5877
+  _DATAPACKET._serialized_end=7557
+  _RATEGROUPTIMING._serialized_start=7560
+  _RATEGROUPTIMING._serialized_end=7694
+  _CONTROLLERTIMING._serialized_start=7697
+  _CONTROLLERTIMING._serialized_end=8004
+  _THROTTLEVALVESTATUS._serialized_start=8006
+  _THROTTLEVALVESTATUS._serialized_end=8115
+  _THROTTLEVALVECALIBRATION._serialized_start=8117
+  _THROTTLEVALVECALIBRATION._serialized_end=8234
+  _THROTTLEVALVECOMMAND._serialized_start=8236
+  _THROTTLEVALVECOMMAND._serialized_end=8294
+  _TVCACTUATORCOMMAND._serialized_start=8296
+  _TVCACTUATORCOMMAND._serialized_end=8316
+  _ANALOGSENSORREADINGS._serialized_start=8319
+  _ANALOGSENSORREADINGS._serialized_end=8741
+  _VECTOR3D._serialized_start=8743
+  _VECTOR3D._serialized_end=8786
+  _VALVESTATES._serialized_start=8789
+  _VALVESTATES._serialized_end=9173
+  _LIDARREADING._serialized_start=9176
+  _LIDARREADING._serialized_end=9357
+  _IMUREADING._serialized_start=9360
+  _IMUREADING._serialized_end=10044
+  _FLIGHTCONTROLLEROUTPUT._serialized_start=10046
+  _FLIGHTCONTROLLEROUTPUT._serialized_end=10070
+  _QUATERNION._serialized_start=10072
+  _QUATERNION._serialized_end=10132
+  _ESTIMATEDSTATE._serialized_start=10135
+  _ESTIMATEDSTATE._serialized_end=10365
+  _FLIGHTCONTROLLERDESIREDSTATE._serialized_start=10367
+  _FLIGHTCONTROLLERDESIREDSTATE._serialized_end=10486
+  _FLIGHTCONTROLLERMETRICS._serialized_start=10489
+  _FLIGHTCONTROLLERMETRICS._serialized_end=10821
+  _RANGERTHROTTLEMETRICS._serialized_start=10824
+  _RANGERTHROTTLEMETRICS._serialized_end=11042
+  _HORNETTHROTTLEMETRICS._serialized_start=11044
+  _HORNETTHROTTLEMETRICS._serialized_end=11085
+  _RANGERTVCMETRICS._serialized_start=11087
+  _RANGERTVCMETRICS._serialized_end=11105
+  _HORNETTVCMETRICS._serialized_start=11107
+  _HORNETTVCMETRICS._serialized_end=11125
+  _RANGERRCSMETRICS._serialized_start=11127
+  _RANGERRCSMETRICS._serialized_end=11145
+  _HORNETRCSMETRICS._serialized_start=11147
+  _HORNETRCSMETRICS._serialized_end=11165
+  _GNSSREADINGS._serialized_start=11168
+  _GNSSREADINGS._serialized_end=11533
 # @@protoc_insertion_point(module_scope)
@@ -0,0 +1,85 @@
+"""
+Generates the controller benchmark baseline from the console output of a benchmark run. Every state and phase in the
+report becomes a baseline p99 that later runs on the same host must stay within CONFIG_CONTROLLER_BENCHMARK_TOLERANCE_PERCENT
+of. Call this script as such from ~/arty --
+
+```
+west build ~/arty/clover --pristine auto --board native_sim --build-dir ~/arty/clover/build-bench -- -DEXTRA_CONF_FILE=benchmark.conf
+~/arty/clover/build-bench/zephyr/zephyr.exe > bench.log
+uv --project ~/arty/scripts run ~/arty/scripts/gen_controller_benchmark_baseline.py <ranger|hornet> bench.log ../clover/src/sim/controller_benchmark_baseline_<ranger|hornet>.h
+```
+"""
+
+import json
+import re
+import sys
+
+VARIANTS = ('ranger', 'hornet')
+REPORT_LINE = re.compile(r'bench: (\{.*\})\s*$')
+# Phases with fewer samples than this have too noisy a p99 to hold later runs to
+MIN_COUNT = 100
+
+if len(sys.argv) != 4:
+    print(
+        'usage: uv --project ~/arty/scripts run ~/arty/scripts/gen_controller_benchmark_baseline.py <ranger|hornet> <benchmark_log_path> <output_file_path>'
+    )
+    sys.exit(1)
+
+variant = sys.argv[1]
+input_file_path = sys.argv[2]
+output_file_path = sys.argv[3]
+
+if variant not in VARIANTS:
+    raise ValueError(f'variant `{variant}` must be one of {VARIANTS}')
+
+# Parse report lines, skipping everything else the run logged
+entries = []
+passed = False
+with open(input_file_path) as f:
+    for line in f:
+        if 'Controller benchmark PASSED' in line:
+            passed = True
+        match = REPORT_LINE.search(line)
+        if match is None:
+            continue
+        entry = json.loads(match.group(1))
+        if entry['variant'] != variant:
+            raise ValueError(f'Report in `{input_file_path}` is for `{entry["variant"]}`, not `{variant}`')
+        if entry['count'] >= MIN_COUNT:
+            entries.append(entry)
+
+if not entries:
+    raise ValueError(f'No benchmark report lines found in `{input_file_path}`')
+if not passed:
+    print(f'warning: the run in `{input_file_path}` did not pass, check it is not regressed before baselining it')
+
+rows = '\n'.join(
+    f'    ControllerBenchmark::Baseline{{SystemState_{e["state"]}, ControllerBenchmark::Phase::{e["phase"].upper()}, {e["p99_ns"]}}},'
+    for e in entries
+)
+
+payload = f"""/*
+>>> GENERATED FILE <<<
+
+Re-create this from a benchmark run on the CI host whenever the controller's cost changes on purpose, by running from the
+arty directory:
+
+```
+uv --project ~/arty/scripts run ~/arty/scripts/gen_controller_benchmark_baseline.py {variant} {input_file_path} {output_file_path}
+```
+*/
+
+#pragma once
+
+#include <array>
+#include "ControllerBenchmark.h"
+
+constexpr std::array<ControllerBenchmark::Baseline, {len(entries)}> CONTROLLER_BENCHMARK_BASELINE {{{{
+{rows}
+}}}};
+"""
+with open(output_file_path, '+w') as f:
+    f.write(payload)
+
+print(f'>>>> wrote payload to {output_file_path} <<<<')
+print(payload)
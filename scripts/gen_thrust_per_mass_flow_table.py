@@ -0,0 +1,168 @@
+"""
+Generates the thrust predictor's thrust per unit propellant mass flow [lbf/(kg/s)] against chamber pressure [psi], by
+slicing the CEA specific impulse table at a fixed O/F and folding in the c* efficiency and N to lbf conversion. Input is
+the same headerless CSV gen_lookup_table_2d.py takes for the CEA table, rows along chamber pressure and columns along
+O/F, with its grid given the same way. Prints the error against sampling the full CEA table.
+Call this script as such from ~/arty --
+
+```
+uv --project ~/arty/scripts run ~/arty/scripts/gen_thrust_per_mass_flow_table.py <x_len> <x_min> <x_max> <x_gap> <y_len> <y_min> <y_max> <y_gap> <of> <efficiency> <input_file_path> <output_file_path>
+```
+"""
+
+import csv
+import math
+import struct
+import sys
+
+EPSILON = 0.0001
+N_TO_LBF = 0.224809
+NAME = 'thrust_per_mass_flow'
+ERROR_SAMPLES_PER_GAP = 20
+
+if len(sys.argv) != 13:
+    print(
+        'usage: uv --project ~/arty/scripts run ~/arty/scripts/gen_thrust_per_mass_flow_table.py <x_len> <x_min> <x_max> <x_gap> <y_len> <y_min> <y_max> <y_gap> <of> <efficiency> <input_file_path> <output_file_path>'
+    )
+    sys.exit(1)
+
+x_len = int(sys.argv[1])
+x_min = float(sys.argv[2])
+x_max = float(sys.argv[3])
+x_gap = float(sys.argv[4])
+y_len = int(sys.argv[5])
+y_min = float(sys.argv[6])
+y_max = float(sys.argv[7])
+y_gap = float(sys.argv[8])
+of = float(sys.argv[9])
+efficiency = float(sys.argv[10])
+input_file_path = sys.argv[11]
+output_file_path = sys.argv[12]
+
+# Validate input
+if x_min >= x_max:
+    raise ValueError(f'x_min `{x_min}` must be less than x_max `{x_max}`')
+if x_gap <= 0:
+    raise ValueError(f'x_gap `{x_gap}` must be positive')
+if math.fabs(x_min + (x_len - 1) * x_gap - x_max) > EPSILON:
+    raise ValueError(
+        f'x_max `{x_max}` must match expected given x_len `{x_len}`, x_gap `{x_gap}`, and x_min `{x_min}`'
+    )
+if y_min >= y_max:
+    raise ValueError(f'y_min `{y_min}` must be less than y_max `{y_max}`')
+if y_gap <= 0:
+    raise ValueError(f'y_gap `{y_gap}` must be positive')
+if math.fabs(y_min + (y_len - 1) * y_gap - y_max) > EPSILON:
+    raise ValueError(
+        f'y_max `{y_max}` must match expected given y_len `{y_len}`, y_gap `{y_gap}`, and y_min `{y_min}`'
+    )
+if not y_min <= of <= y_max:
+    raise ValueError(f'of `{of}` must be within [y_min `{y_min}`, y_max `{y_max}`]')
+if not 0 < efficiency <= 1:
+    raise ValueError(f'efficiency `{efficiency}` must be within (0, 1]')
+
+# Parse input file
+isp = []
+with open(input_file_path) as f:
+    reader = csv.reader(f)
+    for row in reader:
+        if len(row) != y_len:
+            raise ValueError(
+                f'Bad row in input file at `{input_file_path}`: {row} should match y_len `{y_len}`'
+            )
+        isp.append([float(x) for x in row])
+
+if len(isp) != x_len:
+    raise ValueError(
+        f'Number of rows in input file at `{input_file_path}` must match given x_len `{x_len}`'
+    )
+
+
+def f32(x):
+    return struct.unpack('f', struct.pack('f', x))[0]
+
+
+def cell(v, v_min, v_max, v_gap, v_len):
+    """Low breakpoint index and tween of v, as lookup_cell_2d finds them."""
+    low_idx = min(max(math.floor((v - v_min) / v_gap), 0), v_len - 2)
+    tween = min(max((min(max(v, v_min), v_max) - v_min) / v_gap - low_idx, 0.0), 1.0)
+    return low_idx, tween
+
+
+def lerp(low, high, tween):
+    return low + (high - low) * tween
+
+
+# Locate the O/F column the way the firmware did when sampling the CEA table, with the header's float constants
+of_idx, of_tween = cell(f32(of), f32(y_min), f32(y_max), f32(y_gap), y_len)
+scale = efficiency * N_TO_LBF
+breakpoints = [lerp(row[of_idx], row[of_idx + 1], of_tween) * scale for row in isp]
+
+
+def sample_cea(pc):
+    pc_idx, pc_tween = cell(pc, x_min, x_max, x_gap, x_len)
+    low = lerp(isp[pc_idx][of_idx], isp[pc_idx][of_idx + 1], of_tween)
+    high = lerp(isp[pc_idx + 1][of_idx], isp[pc_idx + 1][of_idx + 1], of_tween)
+    return lerp(low, high, pc_tween) * scale
+
+
+def sample_slice(pc):
+    pc_idx, pc_tween = cell(pc, x_min, x_max, x_gap, x_len)
+    return lerp(f32(breakpoints[pc_idx]), f32(breakpoints[pc_idx + 1]), pc_tween)
+
+
+# Error of the float table against sampling the full CEA table, over the chamber pressure axis
+samples = (x_len - 1) * ERROR_SAMPLES_PER_GAP + 1
+max_error = 0.0
+max_relative_error = 0.0
+for i in range(samples):
+    pc = x_min + (x_max - x_min) * i / (samples - 1)
+    expected = sample_cea(pc)
+    error = math.fabs(sample_slice(pc) - expected)
+    max_error = max(max_error, error)
+    max_relative_error = max(max_relative_error, error / math.fabs(expected))
+
+error_report = (
+    f'Against sampling the full {x_len}x{y_len} CEA table at O/F {of} over {samples} chamber pressures: '
+    f'max error {max_error:.3e} lbf/(kg/s), max relative error {max_relative_error:.3e}.'
+)
+
+# Build output file
+name_upper_snake = NAME.upper()
+name_upper_camel = ''.join(word[0].upper() + word[1:] for word in NAME.split('_'))
+
+payload = f"""/*
+>>> GENERATED FILE <<<
+
+Re-create this whenever {input_file_path} changes by running from the arty directory:
+
+```
+uv --project ~/arty/scripts run ~/arty/scripts/gen_thrust_per_mass_flow_table.py {x_len} {x_min} {x_max} {x_gap} {y_len} {y_min} {y_max} {y_gap} {of} {efficiency} {input_file_path} {output_file_path}
+```
+
+Thrust per unit propellant mass flow [lbf/(kg/s)] against chamber pressure [psi], at O/F {of} and c* efficiency {efficiency}.
+{error_report}
+*/
+
+#pragma once
+
+#include <array>
+#include "LookupTable1D.h"
+
+constexpr float {name_upper_snake}_OF = {of:.10f}f;
+constexpr float {name_upper_snake}_EFFICIENCY = {efficiency:.10f}f;
+
+constexpr int {name_upper_snake}_X_LEN = {x_len};
+constexpr float {name_upper_snake}_X_MIN = {x_min:.10f}f;
+constexpr float {name_upper_snake}_X_MAX = {x_max:.10f}f;
+constexpr float {name_upper_snake}_X_GAP = {x_gap:.10f}f;
+
+constexpr std::array<float, {name_upper_snake}_X_LEN> {name_upper_snake}_BPS {{{', '.join([f'{bp:.10f}f' for bp in breakpoints])}}};
+
+typedef LookupTable1D<{name_upper_snake}_X_LEN, {name_upper_snake}_X_MIN, {name_upper_snake}_X_MAX, {name_upper_snake}_X_GAP, {name_upper_snake}_BPS> {name_upper_camel};
+"""
+with open(output_file_path, '+w') as f:
+    f.write(payload)
+
+print(f'>>>> wrote payload to {output_file_path} <<<<')
+print(error_report)
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// Host clocks, implemented in bench_host_clock.c inside the native simulator runner. Simulated time stands still while
+// code executes on native_sim, so these are the only way to measure real execution cost.
+extern "C" {
+uint64_t bench_host_monotonic_ns(void);
+uint64_t bench_host_cpu_ns(void);
+}
+
+/// Running min/mean/max of a series of samples [ns].
+struct BenchStats {
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t min_ns = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ns = 0;
+
+    void add(uint64_t sample_ns)
+    {
+        count++;
+        total_ns += sample_ns;
+        min_ns = std::min(min_ns, sample_ns);
+        max_ns = std::max(max_ns, sample_ns);
+    }
+
+    double mean_ns() const
+    {
+        return count ? static_cast<double>(total_ns) / static_cast<double>(count) : 0.0;
+    }
+};
+
+/// Time a callable over a number of iterations on the host clock, returning per-iteration stats.
+template <typename F> BenchStats bench_run(int iterations, F&& f)
+{
+    BenchStats stats;
+    for (int i = 0; i < iterations; ++i) {
+        uint64_t start = bench_host_monotonic_ns();
+        f();
+        stats.add(bench_host_monotonic_ns() - start);
+    }
+    return stats;
+}
@@ -0,0 +1,24 @@
+/*
+ * Runs in the native simulator runner (host) context, not the embedded image, so it may use host libc directly.
+ */
+#include <stdint.h>
+#include <time.h>
+
+static uint64_t timespec_to_ns(const struct timespec* ts)
+{
+    return (uint64_t)ts->tv_sec * 1000000000ULL + (uint64_t)ts->tv_nsec;
+}
+
+uint64_t bench_host_monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return timespec_to_ns(&ts);
+}
+
+uint64_t bench_host_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return timespec_to_ns(&ts);
+}
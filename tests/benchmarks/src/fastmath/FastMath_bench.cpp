@@ -0,0 +1,89 @@
+// fastmath cost against libm on the host running native_sim, per call over inputs spread across each function's domain,
+// plus the per-tick trig of FlightController's attitude loop with either implementation. Absolute numbers are host
+// numbers, only the ratios carry over to the Cortex-M7. Accuracy is covered by the FastMath tests.
+#include "FastMath.h"
+#include "bench.h"
+#include <array>
+#include <zephyr/ztest.h>
+
+namespace {
+
+constexpr int ITERATIONS = 2000;
+constexpr int INPUTS = 256;
+
+// Keeps results observable so the timed work is not optimized away
+volatile float sink;
+
+std::array<float, INPUTS> spread(float lo, float hi)
+{
+    std::array<float, INPUTS> inputs;
+    for (int i = 0; i < INPUTS; i++) {
+        inputs[i] = lo + (hi - lo) * static_cast<float>((i * 97) % INPUTS) / (INPUTS - 1);
+    }
+    return inputs;
+}
+
+// Mean cost of one call of f over the inputs
+template <typename F> BenchStats bench_calls(const std::array<float, INPUTS>& inputs, F&& f)
+{
+    return bench_run(ITERATIONS, [&] {
+        float sum = 0.0f;
+        for (float x : inputs) {
+            sum += f(x);
+        }
+        sink = sum;
+    });
+}
+
+void print_stats(const char* name, const BenchStats& fast, const BenchStats& precise)
+{
+    TC_PRINT("[fastmath] %-8s fast %7.2f ns/call  libm %7.2f ns/call  speedup %5.2fx\n", name, fast.mean_ns() / INPUTS,
+        precise.mean_ns() / INPUTS, precise.mean_ns() / fast.mean_ns());
+}
+
+template <typename Math> float attitude_loop_trig(float tilt_x, float tilt_y, const std::array<float, 3>& z_act)
+{
+    // Mirrors lateralPID: two atan2 for the actual tilt, two tan and a normalization for the desired thrust axis
+    const float actual_x = Math::atan2(z_act[0], z_act[2]);
+    const float actual_y = Math::atan2(z_act[1], z_act[2]);
+    const float tx = Math::tan(tilt_x);
+    const float ty = Math::tan(tilt_y);
+    const float inv_norm = Math::rsqrt(tx * tx + ty * ty + 1.0f);
+    return actual_x + actual_y + (tx + ty + 1.0f) * inv_norm;
+}
+
+}  // namespace
+
+ZTEST(FastMath_bench, test_functions)
+{
+    const auto angles = spread(-6.3f, 6.3f);
+    const auto unit = spread(-1.0f, 1.0f);
+    const auto positive = spread(1e-3f, 1e3f);
+
+    print_stats("sin", bench_calls(angles, fastmath::Fast::sin), bench_calls(angles, fastmath::Precise::sin));
+    print_stats("cos", bench_calls(angles, fastmath::Fast::cos), bench_calls(angles, fastmath::Precise::cos));
+    print_stats("tan", bench_calls(angles, fastmath::Fast::tan), bench_calls(angles, fastmath::Precise::tan));
+    print_stats("asin", bench_calls(unit, fastmath::Fast::asin), bench_calls(unit, fastmath::Precise::asin));
+    print_stats("rsqrt", bench_calls(positive, fastmath::Fast::rsqrt), bench_calls(positive, fastmath::Precise::rsqrt));
+    print_stats(
+        "atan2",
+        bench_calls(angles, [](float x) { return fastmath::Fast::atan2(x, 1.7f - x); }),
+        bench_calls(angles, [](float x) { return fastmath::Precise::atan2(x, 1.7f - x); }));
+}
+
+ZTEST(FastMath_bench, test_attitude_loop_trig)
+{
+    const std::array<float, 3> z_act = {0.05f, -0.03f, 0.998f};
+
+    BenchStats fast = bench_run(ITERATIONS * 10, [&] { sink = attitude_loop_trig<fastmath::Fast>(0.1f, -0.12f, z_act); });
+    BenchStats precise = bench_run(ITERATIONS * 10, [&] { sink = attitude_loop_trig<fastmath::Precise>(0.1f, -0.12f, z_act); });
+
+    TC_PRINT("[fastmath] attitude loop trig  fast %7.1f ns  libm %7.1f ns\n", fast.mean_ns(), precise.mean_ns());
+    zassert_within(
+        attitude_loop_trig<fastmath::Fast>(0.1f, -0.12f, z_act),
+        attitude_loop_trig<fastmath::Precise>(0.1f, -0.12f, z_act),
+        1e-5f,
+        "fast and precise attitude trig should agree");
+}
+
+ZTEST_SUITE(FastMath_bench, NULL, NULL, NULL, NULL, NULL);
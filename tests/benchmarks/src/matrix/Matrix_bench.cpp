@@ -0,0 +1,129 @@
+// Matrix library cost on the host running native_sim: the 3x3/3-vector operations the flight controller does every tick,
+// and the 15-state covariance propagation of the state estimator, each against the code it replaced. Absolute numbers
+// are host numbers, only the ratios carry over to the Cortex-M7.
+#include "Matrix.h"
+#include "bench.h"
+#include "math_util.h"
+#include <zephyr/ztest.h>
+
+namespace {
+
+constexpr int ITERATIONS = 20000;
+
+// Keeps results observable so the timed work is not optimized away
+volatile float sink;
+
+template <int R, int C> Matrix<R, C> ramp(float scale)
+{
+    Matrix<R, C> m;
+    for (int i = 0; i < R * C; i++) {
+        m.data[i] = scale * static_cast<float>((i * 7) % 11 - 5);
+    }
+    return m;
+}
+
+void print_stats(const char* name, const BenchStats& stats)
+{
+    TC_PRINT("[matrix] %-36s mean %8.1f ns  min %6llu ns  max %8llu ns\n", name, stats.mean_ns(),
+        static_cast<unsigned long long>(stats.min_ns), static_cast<unsigned long long>(stats.max_ns));
+}
+
+}  // namespace
+
+ZTEST(Matrix_bench, test_vector_rotation)
+{
+    Quaternion q = math_util::normalizeQuaternion(math_util::createQuaternion(0.9f, 0.2f, -0.3f, 0.25f));
+    Vector3D v = math_util::createVector3D(0.4f, -1.2f, 2.0f);
+
+    // FlightController rotates two vectors per tick: one by q, one by its conjugate
+    BenchStats proto = bench_run(ITERATIONS, [&] {
+        Vector3D a = math_util::multiplyQuaternionVector(q, v);
+        Vector3D b = math_util::multiplyQuaternionVector(math_util::conjugateQuaternion(q), v);
+        sink = a.x + b.y;
+    });
+    BenchStats matrix = bench_run(ITERATIONS, [&] {
+        const Matrix<3, 3> R = math_util::quaternionToRotationMatrix(q);
+        const Vec<3> vec = math_util::toVec3(v);
+        Vec<3> a = R * vec;
+        Vec<3> b = transpose(R) * vec;
+        sink = a[0] + b[1];
+    });
+
+    print_stats("2 rotations, proto quaternion", proto);
+    print_stats("2 rotations, Matrix<3,3>", matrix);
+}
+
+ZTEST(Matrix_bench, test_covariance_propagation)
+{
+    const Matrix<15, 15> f = Matrix<15, 15>::identity() + ramp<15, 15>(0.001f);
+    const Matrix<15, 15> half = ramp<15, 15>(0.1f);
+    const Matrix<15, 15> p0 = half * transpose(half);
+
+    // Plain nested loops over std::array, as the estimator was first written
+    static float f_raw[15][15], p_raw[15][15], fp_raw[15][15], out_raw[15][15];
+    for (int i = 0; i < 15; i++) {
+        for (int j = 0; j < 15; j++) {
+            f_raw[i][j] = f(i, j);
+            p_raw[i][j] = p0(i, j);
+        }
+    }
+    BenchStats loops = bench_run(ITERATIONS / 10, [&] {
+        for (int i = 0; i < 15; i++) {
+            for (int j = 0; j < 15; j++) {
+                float sum = 0.0f;
+                for (int k = 0; k < 15; k++) {
+                    sum += f_raw[i][k] * p_raw[k][j];
+                }
+                fp_raw[i][j] = sum;
+            }
+        }
+        for (int i = 0; i < 15; i++) {
+            for (int j = 0; j < 15; j++) {
+                float sum = 0.0f;
+                for (int k = 0; k < 15; k++) {
+                    sum += fp_raw[i][k] * f_raw[j][k];
+                }
+                out_raw[i][j] = sum;
+            }
+        }
+        sink = out_raw[3][7];
+    });
+
+    static Matrix<15, 15> out, scratch;
+    BenchStats matrix = bench_run(ITERATIONS / 10, [&] {
+        sandwich(out, f, p0, scratch);
+        sink = out(3, 7);
+    });
+
+    print_stats("F P F^T 15x15, nested loops", loops);
+    print_stats("F P F^T 15x15, sandwich()", matrix);
+
+    for (int i = 0; i < 15; i++) {
+        for (int j = 0; j < 15; j++) {
+            zassert_within(out(i, j), out_raw[i][j], 1e-3f * (1.0f + std::fabs(out_raw[i][j])), "sandwich should match the loops");
+        }
+    }
+}
+
+ZTEST(Matrix_bench, test_scalar_kalman_update)
+{
+    static Matrix<15, 15> p;
+    const Matrix<15, 15> half = ramp<15, 15>(0.1f);
+    const Matrix<15, 15> p0 = half * transpose(half) + Matrix<15, 15>::identity();
+
+    // One scalar measurement fused into a 15-state covariance, as StateEstimator does per lidar/GNSS axis
+    BenchStats update = bench_run(ITERATIONS, [&] {
+        p = p0;
+        Vec<15> observed;
+        for (int i = 0; i < 15; i++) {
+            observed[i] = p(2, i);
+        }
+        rank1_update(p, -1.0f / (p(2, 2) + 0.01f), observed, observed);
+        sink = p(4, 4);
+    });
+
+    print_stats("scalar update 15 states (incl. copy)", update);
+    zassert_true(p(2, 2) < p0(2, 2), "fusing a measurement should shrink its variance");
+}
+
+ZTEST_SUITE(Matrix_bench, NULL, NULL, NULL, NULL, NULL);
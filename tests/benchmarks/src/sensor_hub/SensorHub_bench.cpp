@@ -0,0 +1,248 @@
+// Compares the thread-per-sensor model against the CONFIG_SENSOR_HUB k_poll model.
+//
+// The real drivers need the vehicle UARTs, so this models them: a 4 kHz timer "ISR" pushes frames at each sensor's
+// real rate and size into per-sensor ring buffers and gives the sensor's data_ready semaphore, exactly like UartDmaRx.
+// Consumers drain with ring_buf_get_claim and checksum each frame. Both models run for the same simulated time and
+// report host CPU time, wakeups, and worst/mean latency from frame arrival to the start of its decode.
+#include "bench.h"
+#include <array>
+#include <cstring>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/ztest.h>
+
+namespace {
+
+constexpr uint32_t PRODUCER_PERIOD_US = 250;
+constexpr int RUN_TIME_MS = 2000;
+constexpr int CONSUMER_STACK_SIZE = 2048;
+constexpr int CONSUMER_PRIORITY = -5;
+constexpr int RING_SIZE = 1024;
+constexpr uint8_t FRAME_HEADER = 0x59;
+constexpr size_t NUM_SENSORS = 4;
+
+struct SimSensor {
+    const char* name;
+    uint32_t period_us;
+    uint32_t frame_size;
+
+    uint8_t ring_data[RING_SIZE];
+    ring_buf ring;
+    k_sem data_ready;
+
+    // Written by the producer ISR; 0 once the consumer has seen it
+    volatile uint64_t arrival_host_ns;
+
+    uint32_t frames_produced;
+    uint32_t frames_dropped;
+    uint32_t frames_decoded;
+    uint32_t wakeups;
+    uint32_t checksum;
+    BenchStats latency;
+};
+
+// Rates and frame sizes of the vehicle sensors: 2 lidars, VN-300 binary at 400 Hz, GNSS epoch at 20 Hz.
+std::array<SimSensor, NUM_SENSORS> sensors = {{
+    {.name = "lidar_1", .period_us = 10000, .frame_size = 9},
+    {.name = "lidar_2", .period_us = 10000, .frame_size = 9},
+    {.name = "vectornav", .period_us = 2500, .frame_size = 76},
+    {.name = "gnss", .period_us = 50000, .frame_size = 160},
+}};
+
+uint32_t producer_tick = 0;
+
+void produce(k_timer*)
+{
+    producer_tick++;
+    uint8_t frame[256];
+    for (SimSensor& sensor : sensors) {
+        if ((producer_tick * PRODUCER_PERIOD_US) % sensor.period_us != 0) {
+            continue;
+        }
+        memset(frame, static_cast<uint8_t>(sensor.frames_produced), sensor.frame_size);
+        frame[0] = FRAME_HEADER;
+        frame[1] = FRAME_HEADER;
+        // Only whole frames are put so the stream stays aligned; an overrun drops the frame like a full UART ring would
+        if (ring_buf_space_get(&sensor.ring) < sensor.frame_size) {
+            sensor.frames_dropped++;
+            continue;
+        }
+        ring_buf_put(&sensor.ring, frame, sensor.frame_size);
+        sensor.frames_produced++;
+        if (sensor.arrival_host_ns == 0) {
+            sensor.arrival_host_ns = bench_host_monotonic_ns();
+        }
+        k_sem_give(&sensor.data_ready);
+    }
+}
+
+K_TIMER_DEFINE(producer_timer, produce, nullptr);
+
+uint8_t frame_checksum(const uint8_t* frame, uint32_t frame_size)
+{
+    uint8_t sum = 0;
+    for (uint32_t i = 0; i < frame_size; ++i) {
+        sum += frame[i];
+    }
+    return sum;
+}
+
+/// Decode all complete frames waiting for a sensor, the work a driver's service() does: in place from the claimed
+/// span, copying out only frames that straddle the ring buffer wrap.
+void service(SimSensor& sensor)
+{
+    uint64_t arrival = sensor.arrival_host_ns;
+    if (arrival != 0) {
+        sensor.latency.add(bench_host_monotonic_ns() - arrival);
+        sensor.arrival_host_ns = 0;
+    }
+    sensor.wakeups++;
+
+    while (ring_buf_size_get(&sensor.ring) >= sensor.frame_size) {
+        uint8_t* data;
+        uint32_t len = ring_buf_get_claim(&sensor.ring, &data, sensor.frame_size);
+        if (len == sensor.frame_size) {
+            zassert_equal(data[0], FRAME_HEADER, "%s: frame out of sync", sensor.name);
+            sensor.checksum += frame_checksum(data, len);
+            ring_buf_get_finish(&sensor.ring, len);
+        }
+        else {
+            uint8_t frame[256];
+            ring_buf_get_finish(&sensor.ring, 0);
+            ring_buf_get(&sensor.ring, frame, sensor.frame_size);
+            zassert_equal(frame[0], FRAME_HEADER, "%s: frame out of sync", sensor.name);
+            sensor.checksum += frame_checksum(frame, sensor.frame_size);
+        }
+        sensor.frames_decoded++;
+    }
+}
+
+K_THREAD_STACK_ARRAY_DEFINE(consumer_stacks, NUM_SENSORS, CONSUMER_STACK_SIZE);
+std::array<k_thread, NUM_SENSORS> consumer_threads;
+
+void per_sensor_loop(void* p1, void*, void*)
+{
+    SimSensor& sensor = *static_cast<SimSensor*>(p1);
+    while (true) {
+        k_sem_take(&sensor.data_ready, K_FOREVER);
+        service(sensor);
+    }
+}
+
+void hub_loop(void*, void*, void*)
+{
+    std::array<k_poll_event, NUM_SENSORS> events;
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &sensors[i].data_ready);
+    }
+    while (true) {
+        k_poll(events.data(), events.size(), K_FOREVER);
+        for (size_t i = 0; i < sensors.size(); ++i) {
+            if (events[i].state == K_POLL_STATE_SEM_AVAILABLE) {
+                k_sem_take(events[i].sem, K_NO_WAIT);
+                service(sensors[i]);
+            }
+            events[i].state = K_POLL_STATE_NOT_READY;
+        }
+    }
+}
+
+void reset_sensors()
+{
+    producer_tick = 0;
+    for (SimSensor& sensor : sensors) {
+        ring_buf_init(&sensor.ring, RING_SIZE, sensor.ring_data);
+        k_sem_init(&sensor.data_ready, 0, 1);
+        sensor.arrival_host_ns = 0;
+        sensor.frames_produced = 0;
+        sensor.frames_dropped = 0;
+        sensor.frames_decoded = 0;
+        sensor.wakeups = 0;
+        sensor.checksum = 0;
+        sensor.latency = {};
+    }
+}
+
+struct ModelResult {
+    uint64_t cpu_ns;
+    uint32_t wakeups;
+    uint64_t worst_latency_ns;
+    double mean_latency_ns;
+    int stack_bytes;
+};
+
+/// Run the producer for RUN_TIME_MS with the given number of consumer threads already started.
+ModelResult run_model(const char* model, int num_threads)
+{
+    uint64_t cpu_start = bench_host_cpu_ns();
+    k_timer_start(&producer_timer, K_USEC(PRODUCER_PERIOD_US), K_USEC(PRODUCER_PERIOD_US));
+    k_msleep(RUN_TIME_MS);
+    k_timer_stop(&producer_timer);
+    k_msleep(10);  // Let consumers drain
+    uint64_t cpu_ns = bench_host_cpu_ns() - cpu_start;
+
+    for (int i = 0; i < num_threads; ++i) {
+        k_thread_abort(&consumer_threads[i]);
+    }
+
+    ModelResult result = {.cpu_ns = cpu_ns, .wakeups = 0, .worst_latency_ns = 0, .mean_latency_ns = 0.0, .stack_bytes = num_threads * CONSUMER_STACK_SIZE};
+    uint64_t latency_total = 0;
+    uint64_t latency_count = 0;
+
+    TC_PRINT("[%s] %-10s %8s %8s %8s %8s %12s %12s\n", model, "sensor", "frames", "dropped", "decoded", "wakeups", "mean_lat_ns", "worst_lat_ns");
+    for (SimSensor& sensor : sensors) {
+        TC_PRINT(
+            "[%s] %-10s %8u %8u %8u %8u %12.0f %12llu\n",
+            model,
+            sensor.name,
+            sensor.frames_produced,
+            sensor.frames_dropped,
+            sensor.frames_decoded,
+            sensor.wakeups,
+            sensor.latency.mean_ns(),
+            static_cast<unsigned long long>(sensor.latency.max_ns));
+        zassert_equal(sensor.frames_decoded, sensor.frames_produced, "%s: every produced frame should be decoded", sensor.name);
+
+        result.wakeups += sensor.wakeups;
+        result.worst_latency_ns = std::max(result.worst_latency_ns, sensor.latency.max_ns);
+        latency_total += sensor.latency.total_ns;
+        latency_count += sensor.latency.count;
+    }
+    result.mean_latency_ns = latency_count ? static_cast<double>(latency_total) / static_cast<double>(latency_count) : 0.0;
+    return result;
+}
+
+void print_summary(const char* model, const ModelResult& r)
+{
+    TC_PRINT(
+        "[%s] host cpu %llu us, %u services, mean latency %.0f ns, worst latency %llu ns, consumer stacks %d B\n",
+        model,
+        static_cast<unsigned long long>(r.cpu_ns / 1000),
+        r.wakeups,
+        r.mean_latency_ns,
+        static_cast<unsigned long long>(r.worst_latency_ns),
+        r.stack_bytes);
+}
+
+}  // namespace
+
+ZTEST(SensorHub_bench, test_thread_per_sensor_vs_hub)
+{
+    reset_sensors();
+    for (size_t i = 0; i < NUM_SENSORS; ++i) {
+        k_thread_create(
+            &consumer_threads[i], consumer_stacks[i], CONSUMER_STACK_SIZE, per_sensor_loop, &sensors[i], nullptr, nullptr, CONSUMER_PRIORITY, 0, K_NO_WAIT);
+    }
+    ModelResult per_sensor = run_model("per-sensor", NUM_SENSORS);
+
+    reset_sensors();
+    k_thread_create(&consumer_threads[0], consumer_stacks[0], CONSUMER_STACK_SIZE, hub_loop, nullptr, nullptr, nullptr, CONSUMER_PRIORITY, 0, K_NO_WAIT);
+    ModelResult hub = run_model("hub", 1);
+
+    print_summary("per-sensor", per_sensor);
+    print_summary("hub", hub);
+
+    zassert_true(hub.stack_bytes < per_sensor.stack_bytes, "the hub should use fewer consumer stacks");
+}
+
+ZTEST_SUITE(SensorHub_bench, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,69 @@
+// Cost of the Ranger thrust predictor's Isp stage per tick: sampling the full CEA table at the design O/F and scaling
+// to lbf, as the predictor used to, against the precomputed thrust per mass flow slice it samples now. Inputs spread
+// over the chamber pressures the engine runs at. Absolute numbers are host numbers; on the Cortex-M7 the slice also
+// keeps the predictor out of the 160 KB CEA table in flash. Accuracy is covered by the RangerThrottle tests.
+#include "bench.h"
+#include "lut/cea_lut.h"
+#include "lut/thrust_per_mass_flow.h"
+#include <array>
+#include <zephyr/ztest.h>
+
+namespace {
+
+constexpr int ITERATIONS = 2000;
+constexpr int INPUTS = 256;
+constexpr float MIN_P_CH_PSI = 150.0f;
+constexpr float MAX_P_CH_PSI = 350.0f;
+constexpr float NEWTON_TO_LBF = 0.224809f;
+
+// Keeps results observable so the timed work is not optimized away
+volatile float sink;
+
+std::array<float, INPUTS> spread(float lo, float hi)
+{
+    std::array<float, INPUTS> inputs;
+    for (int i = 0; i < INPUTS; i++) {
+        inputs[i] = lo + (hi - lo) * static_cast<float>((i * 97) % INPUTS) / (INPUTS - 1);
+    }
+    return inputs;
+}
+
+float cea_thrust_per_mass_flow(float p_ch)
+{
+    return PcOfCea::sample(p_ch, THRUST_PER_MASS_FLOW_OF) * THRUST_PER_MASS_FLOW_EFFICIENCY * NEWTON_TO_LBF;
+}
+
+// Mean cost of one call of f over the inputs
+template <typename F> BenchStats bench_calls(const std::array<float, INPUTS>& inputs, F&& f)
+{
+    return bench_run(ITERATIONS, [&] {
+        float sum = 0.0f;
+        for (float x : inputs) {
+            sum += f(x);
+        }
+        sink = sum;
+    });
+}
+
+}  // namespace
+
+ZTEST(ThrustPredictor_bench, test_thrust_per_mass_flow)
+{
+    const auto p_ch = spread(MIN_P_CH_PSI, MAX_P_CH_PSI);
+
+    BenchStats slice = bench_calls(p_ch, ThrustPerMassFlow::sample);
+    BenchStats cea = bench_calls(p_ch, cea_thrust_per_mass_flow);
+
+    TC_PRINT(
+        "[thrust_predictor] thrust per mass flow  slice %6.2f ns/call (%zu B)  cea %6.2f ns/call (%zu B)  speedup %5.2fx\n",
+        slice.mean_ns() / INPUTS,
+        sizeof(THRUST_PER_MASS_FLOW_BPS),
+        cea.mean_ns() / INPUTS,
+        sizeof(PC_OF_CEA_BPS),
+        cea.mean_ns() / slice.mean_ns());
+    for (float x : p_ch) {
+        zassert_within(ThrustPerMassFlow::sample(x), cea_thrust_per_mass_flow(x), 0.01f, "slice and CEA table should agree");
+    }
+}
+
+ZTEST_SUITE(ThrustPredictor_bench, NULL, NULL, NULL, NULL, NULL);
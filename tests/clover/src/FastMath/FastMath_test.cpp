@@ -0,0 +1,113 @@
+// Accuracy of the fastmath approximations over their whole documented domain, against double-precision libm.
+#include "FastMath.h"
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <zephyr/ztest.h>
+
+using fastmath::Fast;
+
+constexpr double PI = std::numbers::pi;
+
+// Max absolute error of f against reference over n evenly spaced points in [lo, hi]
+template <typename F, typename R> static double max_abs_error(F&& f, R&& reference, double lo, double hi, int n)
+{
+    double max_error = 0.0;
+    for (int i = 0; i <= n; i++) {
+        const float x = static_cast<float>(lo + (hi - lo) * i / n);
+        max_error = std::max(max_error, std::fabs(f(x) - reference(static_cast<double>(x))));
+    }
+    return max_error;
+}
+
+ZTEST(FastMath_tests, test_sin_cos)
+{
+    auto fsin = [](float x) { return static_cast<double>(Fast::sin(x)); };
+    auto fcos = [](float x) { return static_cast<double>(Fast::cos(x)); };
+    auto dsin = [](double x) { return std::sin(x); };
+    auto dcos = [](double x) { return std::cos(x); };
+
+    double sin_near = max_abs_error(fsin, dsin, -2 * PI, 2 * PI, 200000);
+    double cos_near = max_abs_error(fcos, dcos, -2 * PI, 2 * PI, 200000);
+    double sin_far = max_abs_error(fsin, dsin, -1e4, 1e4, 400000);
+    double cos_far = max_abs_error(fcos, dcos, -1e4, 1e4, 400000);
+    TC_PRINT("sin max error %.3g (|x| <= 2pi), %.3g (|x| <= 1e4)\n", sin_near, sin_far);
+    TC_PRINT("cos max error %.3g (|x| <= 2pi), %.3g (|x| <= 1e4)\n", cos_near, cos_far);
+
+    zassert_true(sin_near <= 2e-7, "sin should be within its documented error");
+    zassert_true(cos_near <= 2e-7, "cos should be within its documented error");
+    zassert_true(sin_far <= 2e-7, "sin should be within its documented error up to 1e4 rad");
+    zassert_true(cos_far <= 2e-7, "cos should be within its documented error up to 1e4 rad");
+    zassert_equal(Fast::sin(0.0f), 0.0f, "sin(0) should be exact");
+    zassert_equal(Fast::cos(0.0f), 1.0f, "cos(0) should be exact");
+}
+
+ZTEST(FastMath_tests, test_tan)
+{
+    // Relative error, scaled down by the (1 + tan^2) that amplifies any error in the reduced argument near the poles
+    auto scaled_error = [](float x) {
+        const double reference = std::tan(static_cast<double>(x));
+        return std::fabs(Fast::tan(x) - reference) / (std::fabs(reference) + reference * reference + 1.0);
+    };
+
+    double near_error = 0.0;
+    double far_error = 0.0;
+    for (int i = 0; i <= 400000; i++) {
+        near_error = std::max(near_error, scaled_error(static_cast<float>(-2 * PI + 4 * PI * i / 400000)));
+        far_error = std::max(far_error, scaled_error(static_cast<float>(-1e4 + 2e4 * i / 400000)));
+    }
+    TC_PRINT("tan max scaled error %.3g (|x| <= 2pi), %.3g (|x| <= 1e4)\n", near_error, far_error);
+    zassert_true(near_error <= 2e-7, "tan should be within its documented error");
+    zassert_true(far_error <= 4e-7, "tan should be within its documented error up to 1e4 rad");
+}
+
+ZTEST(FastMath_tests, test_atan2)
+{
+    // Every direction, at magnitudes from tiny to huge
+    double max_error = 0.0;
+    for (float magnitude : {1e-30f, 1e-3f, 1.0f, 1e3f, 1e30f}) {
+        for (int i = 0; i <= 100000; i++) {
+            const double angle = -PI + 2 * PI * i / 100000;
+            const float y = static_cast<float>(magnitude * std::sin(angle));
+            const float x = static_cast<float>(magnitude * std::cos(angle));
+            const double reference = std::atan2(static_cast<double>(y), static_cast<double>(x));
+            double error = std::fabs(Fast::atan2(y, x) - reference);
+            error = std::min(error, 2 * PI - error);  // -pi and pi are the same direction
+            max_error = std::max(max_error, error);
+        }
+    }
+    TC_PRINT("atan2 max error %.3g\n", max_error);
+    zassert_true(max_error <= 3e-7, "atan2 should be within its documented error");
+
+    zassert_equal(Fast::atan2(0.0f, 1.0f), 0.0f, "atan2 along +x should be exact");
+    zassert_equal(Fast::atan2(0.0f, 0.0f), 0.0f, "atan2(0, 0) should match libm");
+    zassert_within(Fast::atan2(0.0f, -1.0f), std::numbers::pi_v<float>, 1e-7f, "atan2 along -x should be pi");
+    zassert_within(Fast::atan2(-1.0f, 0.0f), -std::numbers::pi_v<float> / 2, 1e-7f, "atan2 along -y should be -pi/2");
+}
+
+ZTEST(FastMath_tests, test_asin)
+{
+    auto fasin = [](float x) { return static_cast<double>(Fast::asin(x)); };
+    auto dasin = [](double x) { return std::asin(x); };
+
+    double max_error = max_abs_error(fasin, dasin, -1.0, 1.0, 400000);
+    TC_PRINT("asin max error %.3g\n", max_error);
+    zassert_true(max_error <= 2e-7, "asin should be within its documented error");
+    zassert_within(Fast::asin(1.0f), std::numbers::pi_v<float> / 2, 1e-7f, "asin(1) should be pi/2");
+    zassert_within(Fast::asin(-1.0f), -std::numbers::pi_v<float> / 2, 1e-7f, "asin(-1) should be -pi/2");
+}
+
+ZTEST(FastMath_tests, test_rsqrt)
+{
+    // Every exponent of the normal floats, with a spread of mantissas
+    double max_error = 0.0;
+    for (uint32_t bits = 0x00800000u; bits < 0x7f800000u; bits += 0x1357u) {
+        const float x = std::bit_cast<float>(bits);
+        const double reference = 1.0 / std::sqrt(static_cast<double>(x));
+        max_error = std::max(max_error, std::fabs(Fast::rsqrt(x) - reference) / reference);
+    }
+    TC_PRINT("rsqrt max relative error %.3g\n", max_error);
+    zassert_true(max_error <= 5e-6, "rsqrt should be within its documented error");
+}
+
+ZTEST_SUITE(FastMath_tests, NULL, NULL, NULL, NULL, NULL);
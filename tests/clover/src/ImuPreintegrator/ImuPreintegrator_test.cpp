@@ -0,0 +1,209 @@
+#include "sensors/ImuPreintegrator.h"
+#include <cmath>
+#include <zephyr/ztest.h>
+
+constexpr float EPSILON = 1e-5f;
+
+// Reference motion: angular rate and specific force as functions of time, integrated finely in double precision.
+struct Motion {
+    double rate_amplitude;  // rad/s
+    double force_amplitude; // m/s^2
+    double frequency;       // rad/s
+    bool coning;            // Rate vector rotating in the xy plane, else rocking about x with force along y
+
+    void rate(double t, double out[3]) const
+    {
+        if (coning) {
+            out[0] = rate_amplitude * std::cos(frequency * t);
+            out[1] = rate_amplitude * std::sin(frequency * t);
+            out[2] = 0.0;
+        }
+        else {
+            out[0] = rate_amplitude * std::cos(frequency * t);
+            out[1] = 0.0;
+            out[2] = 0.0;
+        }
+    }
+
+    void force(double t, double out[3]) const
+    {
+        out[0] = 0.0;
+        out[1] = coning ? 0.0 : force_amplitude * std::sin(frequency * t);
+        out[2] = 0.0;
+    }
+};
+
+constexpr int SUBSTEPS = 2000;
+
+// Integrate the motion over [t0, t0 + dt]: body rotation (start frame to current) and specific force in the start frame
+// are accumulated into c and dv. Also returns the mean rate and force over the step, which is what an IMU reports.
+static void integrate_step(const Motion& m, double t0, double dt, double c[3][3], double dv[3], Vec<3>& mean_rate, Vec<3>& mean_force)
+{
+    double h = dt / SUBSTEPS;
+    double rate_sum[3] = {0, 0, 0};
+    double force_sum[3] = {0, 0, 0};
+    for (int s = 0; s < SUBSTEPS; s++) {
+        double t = t0 + (s + 0.5) * h;
+        double w[3];
+        double f[3];
+        m.rate(t, w);
+        m.force(t, f);
+        for (int i = 0; i < 3; i++) {
+            dv[i] += (c[i][0] * f[0] + c[i][1] * f[1] + c[i][2] * f[2]) * h;
+            rate_sum[i] += w[i];
+            force_sum[i] += f[i];
+        }
+        // c <- c * exp([w h]x), second order
+        double k[3][3] = {{0, -w[2] * h, w[1] * h}, {w[2] * h, 0, -w[0] * h}, {-w[1] * h, w[0] * h, 0}};
+        double e[3][3];
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                double k2 = k[i][0] * k[0][j] + k[i][1] * k[1][j] + k[i][2] * k[2][j];
+                e[i][j] = (i == j ? 1.0 : 0.0) + k[i][j] + 0.5 * k2;
+            }
+        }
+        double next[3][3];
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                next[i][j] = c[i][0] * e[0][j] + c[i][1] * e[1][j] + c[i][2] * e[2][j];
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                c[i][j] = next[i][j];
+            }
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        mean_rate[i] = static_cast<float>(rate_sum[i] / SUBSTEPS);
+        mean_force[i] = static_cast<float>(force_sum[i] / SUBSTEPS);
+    }
+}
+
+// Rotation vector of a rotation matrix
+static Vec<3> rotation_vector(const double c[3][3])
+{
+    double angle = std::acos(std::fmin(1.0, std::fmax(-1.0, 0.5 * (c[0][0] + c[1][1] + c[2][2] - 1.0))));
+    double scale = angle < 1e-9 ? 0.5 : angle / (2.0 * std::sin(angle));
+    return {{static_cast<float>(scale * (c[2][1] - c[1][2])), static_cast<float>(scale * (c[0][2] - c[2][0])),
+        static_cast<float>(scale * (c[1][0] - c[0][1]))}};
+}
+
+struct Result {
+    Vec<3> exact_angle;
+    Vec<3> exact_velocity;
+    Vec<3> naive_angle;
+    Vec<3> naive_velocity;
+    ImuPreintegrator integrator;
+};
+
+static Result run(const Motion& m, int samples, double sample_dt)
+{
+    Result r;
+    double c[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    double dv[3] = {0, 0, 0};
+    for (int k = 0; k < samples; k++) {
+        Vec<3> rate;
+        Vec<3> force;
+        integrate_step(m, k * sample_dt, sample_dt, c, dv, rate, force);
+        r.integrator.add(rate, force, static_cast<float>(sample_dt));
+        axpy(r.naive_angle, static_cast<float>(sample_dt), rate);
+        axpy(r.naive_velocity, static_cast<float>(sample_dt), force);
+    }
+    r.exact_angle = rotation_vector(c);
+    r.exact_velocity = {{static_cast<float>(dv[0]), static_cast<float>(dv[1]), static_cast<float>(dv[2])}};
+    return r;
+}
+
+ZTEST(ImuPreintegrator_tests, test_empty_interval_is_zero)
+{
+    ImuPreintegrator integrator;
+
+    zassert_within(norm(integrator.delta_angle()), 0.0f, EPSILON, "no samples should give no rotation");
+    zassert_within(norm(integrator.delta_velocity()), 0.0f, EPSILON, "no samples should give no velocity change");
+    zassert_within(integrator.delta_time(), 0.0f, EPSILON, "no samples should span no time");
+    zassert_equal(integrator.sample_count(), 0, "no samples should be counted");
+}
+
+ZTEST(ImuPreintegrator_tests, test_constant_rate_sums_exactly)
+{
+    ImuPreintegrator integrator;
+    for (int i = 0; i < 4; i++) {
+        integrator.add({{0.1f, -0.2f, 0.3f}}, {{0.0f, 0.0f, -9.8f}}, 0.0025f);
+    }
+
+    // A fixed rotation axis has no coning
+    Vec<3> angle = integrator.delta_angle();
+    zassert_within(angle[0], 0.001f, EPSILON, "x delta angle should be rate * time");
+    zassert_within(angle[1], -0.002f, EPSILON, "y delta angle should be rate * time");
+    zassert_within(angle[2], 0.003f, EPSILON, "z delta angle should be rate * time");
+    zassert_within(integrator.delta_time(), 0.01f, EPSILON, "time should be summed");
+    zassert_equal(integrator.sample_count(), 4, "every sample should be counted");
+}
+
+ZTEST(ImuPreintegrator_tests, test_no_rotation_sums_velocity)
+{
+    ImuPreintegrator integrator;
+    for (int i = 0; i < 4; i++) {
+        integrator.add({}, {{1.0f, 2.0f, -9.8f}}, 0.0025f);
+    }
+
+    Vec<3> velocity = integrator.delta_velocity();
+    zassert_within(velocity[0], 0.01f, EPSILON, "x delta velocity should be force * time");
+    zassert_within(velocity[1], 0.02f, EPSILON, "y delta velocity should be force * time");
+    zassert_within(velocity[2], -0.098f, EPSILON, "z delta velocity should be force * time");
+}
+
+ZTEST(ImuPreintegrator_tests, test_reset_starts_new_interval)
+{
+    ImuPreintegrator integrator;
+    integrator.add({{1.0f, 0.0f, 0.0f}}, {{1.0f, 0.0f, 0.0f}}, 0.01f);
+    integrator.reset();
+
+    zassert_within(norm(integrator.delta_angle()), 0.0f, EPSILON, "reset should clear the rotation");
+    zassert_within(norm(integrator.delta_velocity()), 0.0f, EPSILON, "reset should clear the velocity change");
+    zassert_equal(integrator.sample_count(), 0, "reset should clear the sample count");
+}
+
+ZTEST(ImuPreintegrator_tests, test_rotating_force_matches_exact_velocity)
+{
+    // Spinning about z at 2 rad/s with a constant body x force, over 10 samples at 400 Hz
+    ImuPreintegrator integrator;
+    const float rate = 2.0f;
+    const float dt = 0.0025f;
+    for (int i = 0; i < 10; i++) {
+        integrator.add({{0.0f, 0.0f, rate}}, {{5.0f, 0.0f, 0.0f}}, dt);
+    }
+
+    const float angle = rate * 10 * dt;
+    Vec<3> velocity = integrator.delta_velocity();
+    // Rotation compensation is second order, so the x error is third order in the 0.05 rad turned
+    zassert_within(velocity[0], 5.0f / rate * std::sin(angle), 1e-4f, "x velocity should follow the rotating force");
+    zassert_within(velocity[1], 5.0f / rate * (1.0f - std::cos(angle)), 1e-5f, "y velocity should follow the rotating force");
+}
+
+ZTEST(ImuPreintegrator_tests, test_coning_correction_reduces_attitude_error)
+{
+    Motion coning = {.rate_amplitude = 1.0, .force_amplitude = 0.0, .frequency = 2.0 * M_PI * 10.0, .coning = true};
+    Result r = run(coning, 8, 0.0025);
+
+    float corrected_error = norm(r.integrator.delta_angle() - r.exact_angle);
+    float naive_error = norm(r.naive_angle - r.exact_angle);
+    zassert_true(naive_error > 1e-5f, "coning motion should defeat a plain sum, error %f", (double)naive_error);
+    zassert_true(corrected_error < 0.1f * naive_error, "coning correction should remove most of the error: %f vs %f",
+        (double)corrected_error, (double)naive_error);
+}
+
+ZTEST(ImuPreintegrator_tests, test_sculling_correction_reduces_velocity_error)
+{
+    Motion sculling = {.rate_amplitude = 1.0, .force_amplitude = 10.0, .frequency = 2.0 * M_PI * 10.0, .coning = false};
+    Result r = run(sculling, 8, 0.0025);
+
+    float corrected_error = norm(r.integrator.delta_velocity() - r.exact_velocity);
+    float naive_error = norm(r.naive_velocity - r.exact_velocity);
+    zassert_true(naive_error > 1e-3f, "sculling motion should defeat a plain sum, error %f", (double)naive_error);
+    zassert_true(corrected_error < 0.1f * naive_error, "sculling correction should remove most of the error: %f vs %f",
+        (double)corrected_error, (double)naive_error);
+}
+
+ZTEST_SUITE(ImuPreintegrator_tests, NULL, NULL, NULL, NULL, NULL);
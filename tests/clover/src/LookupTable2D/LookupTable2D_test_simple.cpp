@@ -205,4 +205,18 @@ ZTEST(LookupTable2D_test_simple, test_x_high_y_high_clamp)
     zassert_within(val, 20.0f, EPSILON);
 }
 
+// Runtime grid
+
+ZTEST(LookupTable2D_test_simple, test_runtime_grid_matches_table)
+{
+    LookupGrid2D<TEST_LUT_2D_SIMPLE_X_LEN, TEST_LUT_2D_SIMPLE_Y_LEN> grid(
+        TEST_LUT_2D_SIMPLE_X_MIN, TEST_LUT_2D_SIMPLE_X_GAP, TEST_LUT_2D_SIMPLE_Y_MIN, TEST_LUT_2D_SIMPLE_Y_GAP);
+
+    for (float x = -1.5f; x <= 1.5f; x += 0.1f) {
+        for (float y = -0.5f; y <= 6.5f; y += 0.1f) {
+            zassert_within(grid.sample(TEST_LUT_2D_SIMPLE_BPS, x, y), TestLut2dSimple::sample(x, y), EPSILON);
+        }
+    }
+}
+
 ZTEST_SUITE(LookupTable2D_test_simple, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,147 @@
+#include "Matrix.h"
+#include "math_util.h"
+#include <cmath>
+#include <zephyr/ztest.h>
+
+constexpr float EPSILON = 0.0001f;
+
+template <int R, int C> static void assert_matrix_within(const Matrix<R, C>& actual, const Matrix<R, C>& expected, const char* what)
+{
+    for (int r = 0; r < R; r++) {
+        for (int c = 0; c < C; c++) {
+            zassert_within(actual(r, c), expected(r, c), EPSILON, "%s: element (%d, %d) is %f, expected %f", what, r, c,
+                (double)actual(r, c), (double)expected(r, c));
+        }
+    }
+}
+
+// Deterministic, non-symmetric test matrix
+template <int R, int C> static Matrix<R, C> ramp(float scale)
+{
+    Matrix<R, C> m;
+    for (int i = 0; i < R * C; i++) {
+        m.data[i] = scale * static_cast<float>((i * 7) % 11 - 5);
+    }
+    return m;
+}
+
+// Reference product without any unrolling or backend
+template <int R, int K, int C> static Matrix<R, C> naive_product(const Matrix<R, K>& a, const Matrix<K, C>& b)
+{
+    Matrix<R, C> out;
+    for (int r = 0; r < R; r++) {
+        for (int c = 0; c < C; c++) {
+            for (int k = 0; k < K; k++) {
+                out(r, c) += a(r, k) * b(k, c);
+            }
+        }
+    }
+    return out;
+}
+
+// Dimensions and small products are usable at compile time
+static_assert((Matrix<2, 2>::identity() * Matrix<2, 2>::filled(3.0f))(1, 0) == 3.0f);
+static_assert(Vec<3>::SIZE == 3 && Matrix<2, 5>::COLS == 5);
+
+ZTEST(Matrix_tests, test_identity_is_neutral)
+{
+    Matrix<4, 4> a = ramp<4, 4>(0.5f);
+    assert_matrix_within(Matrix<4, 4>::identity() * a, a, "I * A");
+    assert_matrix_within(a * Matrix<4, 4>::identity(), a, "A * I");
+}
+
+ZTEST(Matrix_tests, test_small_product_matches_reference)
+{
+    Matrix<3, 2> a{{1, 2, 3, 4, 5, 6}};
+    Matrix<2, 3> b{{7, 8, 9, 10, 11, 12}};
+    Matrix<3, 3> expected{{27, 30, 33, 61, 68, 75, 95, 106, 117}};
+    assert_matrix_within(a * b, expected, "3x2 * 2x3");
+}
+
+ZTEST(Matrix_tests, test_large_product_matches_reference)
+{
+    // Large enough to take the looped (or CMSIS-DSP) path
+    Matrix<15, 15> a = ramp<15, 15>(0.1f);
+    Matrix<15, 15> b = ramp<15, 15>(-0.2f);
+    assert_matrix_within(a * b, naive_product(a, b), "15x15 product");
+
+    Matrix<15, 15> accumulated = Matrix<15, 15>::identity();
+    multiply_add(accumulated, a, b);
+    assert_matrix_within(accumulated, Matrix<15, 15>::identity() + naive_product(a, b), "multiply_add");
+}
+
+ZTEST(Matrix_tests, test_transpose_products)
+{
+    Matrix<4, 6> a = ramp<4, 6>(1.0f);
+    Matrix<5, 6> b = ramp<5, 6>(0.3f);
+    Matrix<4, 5> out;
+    multiply_transposed_into(out, a, b);
+    assert_matrix_within(out, a * transpose(b), "A * B^T");
+    assert_matrix_within(transpose(transpose(a)), a, "double transpose");
+}
+
+ZTEST(Matrix_tests, test_sandwich_is_symmetric_and_correct)
+{
+    Matrix<15, 15> f = Matrix<15, 15>::identity() + ramp<15, 15>(0.01f);
+    Matrix<15, 15> half = ramp<15, 15>(0.1f);
+    Matrix<15, 15> p = half * transpose(half);
+
+    Matrix<15, 15> out;
+    Matrix<15, 15> scratch;
+    sandwich(out, f, p, scratch);
+
+    assert_matrix_within(out, naive_product(naive_product(f, p), transpose(f)), "F P F^T");
+    for (int r = 0; r < 15; r++) {
+        for (int c = 0; c < 15; c++) {
+            zassert_equal(out(r, c), out(c, r), "sandwich result should be exactly symmetric");
+        }
+    }
+}
+
+ZTEST(Matrix_tests, test_rank1_update_and_axpy)
+{
+    Vec<3> u{{1, 2, 3}};
+    Vec<2> v{{4, 5}};
+    Matrix<3, 2> m = Matrix<3, 2>::filled(1.0f);
+    rank1_update(m, 2.0f, u, v);
+    assert_matrix_within(m, Matrix<3, 2>{{9, 11, 17, 21, 25, 31}}, "m + 2 u v^T");
+
+    Vec<3> y{{1, 1, 1}};
+    axpy(y, -0.5f, u);
+    assert_matrix_within(y, Vec<3>{{0.5f, 0.0f, -0.5f}}, "y - 0.5 u");
+}
+
+ZTEST(Matrix_tests, test_blocks)
+{
+    Matrix<6, 6> m;
+    set_block<3, 0>(m, Matrix<3, 3>::identity() * 2.0f);
+    zassert_within(m(4, 1), 2.0f, EPSILON, "set_block should write inside the block");
+    zassert_within(m(1, 1), 0.0f, EPSILON, "set_block should not write outside the block");
+
+    Matrix<2, 3> b = block<3, 0, 2, 3>(m);
+    assert_matrix_within(b, Matrix<2, 3>{{2, 0, 0, 0, 2, 0}}, "block");
+}
+
+ZTEST(Matrix_tests, test_vector_operations)
+{
+    Vec<3> x{{1, 0, 0}};
+    Vec<3> y{{0, 1, 0}};
+    assert_matrix_within(cross(x, y), Vec<3>{{0, 0, 1}}, "x cross y");
+    assert_matrix_within(skew(x) * y, cross(x, y), "skew(x) * y");
+    zassert_within(dot(x, y), 0.0f, EPSILON, "orthogonal vectors");
+    zassert_within(norm(Vec<3>{{3, 4, 0}}), 5.0f, EPSILON, "3-4-5 norm");
+    assert_matrix_within(normalized(Vec<3>{{0, 0, 2}}), Vec<3>{{0, 0, 1}}, "normalized");
+    assert_matrix_within(normalized(Vec<3>{}), Vec<3>{}, "normalized zero vector stays zero");
+}
+
+ZTEST(Matrix_tests, test_rotation_matrix_matches_quaternion_rotation)
+{
+    Quaternion q = math_util::normalizeQuaternion(math_util::createQuaternion(0.9f, 0.2f, -0.3f, 0.25f));
+    Vector3D v = math_util::createVector3D(0.4f, -1.2f, 2.0f);
+
+    Vector3D expected = math_util::multiplyQuaternionVector(q, v);
+    Vec<3> actual = math_util::quaternionToRotationMatrix(q) * math_util::toVec3(v);
+    assert_matrix_within(actual, math_util::toVec3(expected), "R(q) v");
+}
+
+ZTEST_SUITE(Matrix_tests, NULL, NULL, NULL, NULL, NULL);
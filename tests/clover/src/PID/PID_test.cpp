@@ -0,0 +1,409 @@
+#include "PID.h"
+#include <random>
+#include <zephyr/ztest.h>
+
+static constexpr float DT = 0.002f;
+
+// PID as it was before it became a policy template, kept as the reference BasicPID must match.
+class ReferencePID
+{
+public:
+    ReferencePID(float kp, float ki, float kd,
+        float min_out = -1e6f, float max_out = 1e6f,
+        float min_integral = -1e6f, float max_integral = 1e6f,
+        float integral_zone = std::numeric_limits<float>::infinity(),
+        float deriv_lowpass_hz = 0.0f)
+        : kp_(kp), ki_(ki), kd_(kd)
+    {
+        if (min_out != -1e6f || max_out != 1e6f) {
+            setOutputLimits(min_out, max_out);
+        }
+        if (min_integral != -1e6f || max_integral != 1e6f) {
+            setIntegralLimits(min_integral, max_integral);
+        }
+        if (integral_zone != std::numeric_limits<float>::infinity()) {
+            setIntegralZone(integral_zone);
+        }
+        if (deriv_lowpass_hz > 0.0f) {
+            setDerivativeLowPass(deriv_lowpass_hz);
+        }
+    }
+
+    float calculate(float setpoint, float measurement, float measurement_d, float dt)
+    {
+        if (std::isnan(prev_meas_))
+        {
+            prev_meas_ = measurement;
+            const float error = setpoint - measurement;
+            return clampOutput(kp_ * error);
+        }
+
+        const float error = setpoint - measurement;
+
+        if (!use_integral_zone_ || std::abs(error) <= integral_zone_)
+        {
+            integral_ += error * dt;
+        }
+
+        float deriv_raw = 0.0f;
+        if (!std::isnan(prev_meas_))
+        {
+            deriv_raw = -measurement_d / std::max(dt, 1e-9f);
+        }
+        prev_meas_ = measurement;
+
+        float deriv_term = deriv_raw;
+        if (use_deriv_lp_)
+        {
+            const float rc = 1.0f / (2.0f * pi * std::max(deriv_cutoff_hz_, 1e-6f));
+            const float a = dt / (rc + dt);
+            deriv_state_ += a * (deriv_raw - deriv_state_);
+            deriv_term = deriv_state_;
+        }
+
+        float integral_output = integral_ * ki_;
+        if (use_integral_limits_)
+        {
+            integral_output = std::clamp(integral_output, min_integral_, max_integral_);
+        }
+        if (ki_ > 0.000001f)
+        {
+            integral_ = integral_output / ki_;
+        }
+        float output = kp_ * error + integral_output + kd_ * deriv_term;
+
+        return clampOutput(output);
+    }
+
+    float calculate(float setpoint, float measurement, float dt)
+    {
+        float dmeas = 0.0f;
+        if (!std::isnan(prev_meas_))
+        {
+            dmeas = measurement - prev_meas_;
+        }
+        return calculate(setpoint, measurement, dmeas, dt);
+    }
+
+    void reset(float integral = 0.0f)
+    {
+        integral_ = integral;
+        prev_meas_ = std::numeric_limits<float>::quiet_NaN();
+        deriv_state_ = 0.0f;
+    }
+
+    void setGains(float kp, float ki, float kd)
+    {
+        kp_ = kp;
+        ki_ = ki;
+        kd_ = kd;
+        reset();
+    }
+
+    void setI(float ki) { ki_ = ki; }
+    float getIntegralOutput() const { return integral_ * ki_; }
+
+    void setOutputLimits(float min_out, float max_out)
+    {
+        min_out_ = min_out;
+        max_out_ = max_out;
+        use_output_limits_ = true;
+        if (min_out_ > max_out_)
+            std::swap(min_out_, max_out_);
+    }
+    void clearOutputLimits() { use_output_limits_ = false; }
+
+    void setIntegralLimits(float min_i, float max_i)
+    {
+        min_integral_ = min_i;
+        max_integral_ = max_i;
+        use_integral_limits_ = true;
+        if (min_integral_ > max_integral_)
+            std::swap(min_integral_, max_integral_);
+    }
+    void clearIntegralLimits() { use_integral_limits_ = false; }
+
+    void setIntegralZone(float zone_abs_error)
+    {
+        integral_zone_ = std::max(0.0f, zone_abs_error);
+        use_integral_zone_ = true;
+    }
+    void clearIntegralZone() { use_integral_zone_ = false; }
+
+    void setDerivativeLowPass(float cutoff_hz)
+    {
+        deriv_cutoff_hz_ = cutoff_hz;
+        use_deriv_lp_ = true;
+    }
+    void clearDerivativeLowPass()
+    {
+        use_deriv_lp_ = false;
+        deriv_state_ = 0.0f;
+    }
+
+private:
+    float clampOutput(float u) const
+    {
+        if (!use_output_limits_)
+            return u;
+        if (u > max_out_)
+            return max_out_;
+        if (u < min_out_)
+            return min_out_;
+        return u;
+    }
+
+    float kp_{};
+    float ki_{};
+    float kd_{};
+
+    const float pi = std::acos(-1.0);
+
+    float integral_ = 0.0f;
+    float prev_meas_ = std::numeric_limits<float>::quiet_NaN();
+
+    bool use_deriv_lp_ = false;
+    float deriv_cutoff_hz_ = 0.0f;
+    float deriv_state_ = 0.0f;
+
+    bool use_output_limits_ = false;
+    float min_out_ = -1.0f, max_out_ = 1.0f;
+    bool use_integral_limits_ = false;
+    float min_integral_ = -1e6f, max_integral_ = 1e6f;
+    bool use_integral_zone_ = false;
+    float integral_zone_ = std::numeric_limits<float>::infinity();
+};
+
+// Fuzzed outputs may differ from the reference by float rounding only, relative to the output's size.
+static constexpr float kToleranceReferenceRelative = 1e-4f;
+static constexpr int kReferenceConfigs = 2000;
+static constexpr int kReferenceSteps = 400;
+
+ZTEST(PID_tests, test_first_call_is_proportional_only)
+{
+    PID pid(2.0f, 1.0f, 1.0f);
+
+    zassert_within(pid.calculate(1.0f, 0.0f, DT), 2.0f, 1e-6f, "first call should only apply kp");
+    zassert_within(pid.getIntegralOutput(), 0.0f, 1e-9f, "first call should not integrate");
+}
+
+ZTEST(PID_tests, test_unused_features_match_simple_pid)
+{
+    PID full(1.5f, 0.8f, 0.05f);
+    SimplePID simple(1.5f, 0.8f, 0.05f);
+
+    // With nothing configured, the full-featured PID must behave exactly like the plain one.
+    for (int i = 0; i < 200; i++) {
+        float measurement = 0.01f * i;
+        zassert_within(
+            full.calculate(1.0f, measurement, DT), simple.calculate(1.0f, measurement, DT), 1e-6f, "outputs should match");
+    }
+}
+
+ZTEST(PID_tests, test_integral_limits_clamp_stored_integral)
+{
+    PID pid(0.0f, 2.0f, 0.0f);
+    pid.setIntegralLimits(-0.5f, 0.5f);
+
+    float output = 0.0f;
+    for (int i = 0; i < 1000; i++) {
+        output = pid.calculate(1.0f, 0.0f, DT);
+    }
+    zassert_within(output, 0.5f, 1e-6f, "integral output should saturate at its limit");
+
+    // Unwinding must start immediately rather than after the excess integral is paid back.
+    output = pid.calculate(-1.0f, 0.0f, DT);
+    zassert_true(output < 0.5f, "integral should unwind as soon as the error reverses");
+}
+
+ZTEST(PID_tests, test_integral_zone)
+{
+    PID pid(0.0f, 1.0f, 0.0f);
+    pid.setIntegralZone(0.5f);
+
+    pid.calculate(1.0f, 0.0f, DT);
+    pid.calculate(1.0f, 0.0f, DT);
+    zassert_within(pid.getIntegralOutput(), 0.0f, 1e-9f, "error outside the zone should not integrate");
+
+    pid.calculate(0.25f, 0.0f, DT);
+    zassert_within(pid.getIntegralOutput(), 0.25f * DT, 1e-9f, "error inside the zone should integrate");
+}
+
+ZTEST(PID_tests, test_derivative_lowpass_tracks_dt)
+{
+    PID pid(0.0f, 0.0f, 1.0f);
+    pid.setDerivativeLowPass(10.0f);
+
+    // A measurement ramp gives a constant derivative that the filter converges to at any dt.
+    float output = 0.0f;
+    float measurement = 0.0f;
+    for (int i = 0; i < 500; i++) {
+        float dt = (i % 2) ? DT : 2.0f * DT;
+        measurement += dt;
+        output = pid.calculate(0.0f, measurement, dt);
+    }
+    zassert_within(output, -1.0f, 1e-3f, "filtered derivative should converge to the ramp rate");
+}
+
+ZTEST(PID_tests, test_output_limits)
+{
+    PID pid(10.0f, 0.0f, 0.0f);
+    pid.setOutputLimits(1.0f, -1.0f);
+
+    zassert_within(pid.calculate(1.0f, 0.0f, DT), 1.0f, 1e-6f, "output should clamp to the upper limit");
+    zassert_within(pid.calculate(-1.0f, 0.0f, DT), -1.0f, 1e-6f, "output should clamp to the lower limit");
+
+    pid.clearOutputLimits();
+    zassert_within(pid.calculate(1.0f, 0.0f, DT), 10.0f, 1e-6f, "cleared limits should not clamp");
+}
+
+ZTEST(PID_tests, test_batched_matches_individual)
+{
+    SimplePID x(1.0f, 0.5f, 0.1f);
+    SimplePID y(2.0f, 0.1f, 0.2f);
+    SimplePID x_ref(1.0f, 0.5f, 0.1f);
+    SimplePID y_ref(2.0f, 0.1f, 0.2f);
+
+    for (int i = 0; i < 50; i++) {
+        float mx = 0.02f * i;
+        float my = -0.03f * i;
+        auto [out_x, out_y] = SimplePID::calculate<2>({&x, &y}, {1.0f, -1.0f}, {mx, my}, DT);
+        zassert_within(out_x, x_ref.calculate(1.0f, mx, DT), 1e-6f, "batched x should match an individual call");
+        zassert_within(out_y, y_ref.calculate(-1.0f, my, DT), 1e-6f, "batched y should match an individual call");
+    }
+}
+
+// Ki the integral store-back and clamp treat as zero, at and around their 1e-6 threshold
+static float draw_ki(std::mt19937& rng)
+{
+    constexpr float SMALL_KI[] = {0.0f, 1e-7f, 1e-6f, -1e-6f, -0.3f};
+    if (std::uniform_int_distribution<int>(0, 3)(rng) == 0) {
+        return SMALL_KI[std::uniform_int_distribution<size_t>(0, std::size(SMALL_KI) - 1)(rng)];
+    }
+    return std::uniform_real_distribution<float>(1e-5f, 5.0f)(rng);
+}
+
+static bool agrees_with_reference(float value, float reference)
+{
+    return std::abs(value - reference) <= kToleranceReferenceRelative * std::max(1.0f, std::abs(reference));
+}
+
+ZTEST(PID_tests, test_matches_reference_pid)
+{
+    std::mt19937 rng(36);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    auto uniform = [&](float lo, float hi) { return lo + (hi - lo) * unit(rng); };
+    auto chance = [&](float p) { return unit(rng) < p; };
+    constexpr float DTS[] = {0.001f, 0.002f, 0.004f, 0.01f};
+
+    for (int config = 0; config < kReferenceConfigs; config++) {
+        const float kp = uniform(0.0f, 5.0f);
+        const float ki = draw_ki(rng);
+        const float kd = uniform(0.0f, 0.5f);
+        const float min_out = chance(0.5f) ? uniform(-3.0f, 0.0f) : -1e6f;
+        const float max_out = min_out != -1e6f ? uniform(0.0f, 3.0f) : 1e6f;
+        const float min_integral = chance(0.5f) ? uniform(-1.0f, 0.0f) : -1e6f;
+        const float max_integral = min_integral != -1e6f ? uniform(0.0f, 1.0f) : 1e6f;
+        const float zone = chance(0.5f) ? uniform(0.0f, 2.0f) : std::numeric_limits<float>::infinity();
+        const float lowpass_hz = chance(0.5f) ? uniform(1.0f, 100.0f) : 0.0f;
+
+        PID pid(kp, ki, kd, min_out, max_out, min_integral, max_integral, zone, lowpass_hz);
+        ReferencePID reference(kp, ki, kd, min_out, max_out, min_integral, max_integral, zone, lowpass_hz);
+
+        float setpoint = uniform(-2.0f, 2.0f);
+        float measurement = 0.0f;
+        float dt = DTS[config % std::size(DTS)];
+        for (int step = 0; step < kReferenceSteps; step++) {
+            // Reconfigure both now and then, like FlightController does when gains are published
+            if (chance(0.01f)) {
+                const float new_ki = draw_ki(rng);
+                const float new_kp = uniform(0.0f, 5.0f);
+                const float new_kd = uniform(0.0f, 0.5f);
+                pid.setGains(new_kp, new_ki, new_kd);
+                reference.setGains(new_kp, new_ki, new_kd);
+            }
+            if (chance(0.01f)) {
+                const float new_ki = draw_ki(rng);
+                pid.setI(new_ki);
+                reference.setI(new_ki);
+            }
+            if (chance(0.01f)) {
+                if (chance(0.5f)) {
+                    const float hz = uniform(1.0f, 100.0f);
+                    pid.setDerivativeLowPass(hz);
+                    reference.setDerivativeLowPass(hz);
+                }
+                else {
+                    pid.clearDerivativeLowPass();
+                    reference.clearDerivativeLowPass();
+                }
+            }
+            if (chance(0.01f)) {
+                if (chance(0.5f)) {
+                    const float lo = uniform(-1.0f, 0.0f);
+                    const float hi = uniform(0.0f, 1.0f);
+                    pid.setIntegralLimits(hi, lo);
+                    reference.setIntegralLimits(hi, lo);
+                }
+                else {
+                    pid.clearIntegralLimits();
+                    reference.clearIntegralLimits();
+                }
+            }
+            if (chance(0.01f)) {
+                if (chance(0.5f)) {
+                    const float lo = uniform(-3.0f, 0.0f);
+                    const float hi = uniform(0.0f, 3.0f);
+                    pid.setOutputLimits(lo, hi);
+                    reference.setOutputLimits(lo, hi);
+                }
+                else {
+                    pid.clearOutputLimits();
+                    reference.clearOutputLimits();
+                }
+            }
+            if (chance(0.01f)) {
+                if (chance(0.5f)) {
+                    const float new_zone = uniform(0.0f, 2.0f);
+                    pid.setIntegralZone(new_zone);
+                    reference.setIntegralZone(new_zone);
+                }
+                else {
+                    pid.clearIntegralZone();
+                    reference.clearIntegralZone();
+                }
+            }
+            if (chance(0.005f)) {
+                const float integral = uniform(-1.0f, 1.0f);
+                pid.reset(integral);
+                reference.reset(integral);
+            }
+            if (chance(0.02f)) {
+                setpoint = uniform(-2.0f, 2.0f);
+            }
+            if (chance(0.05f)) {
+                dt = chance(0.5f) ? DTS[std::uniform_int_distribution<size_t>(0, std::size(DTS) - 1)(rng)] : uniform(0.0005f, 0.02f);
+            }
+
+            measurement += uniform(-0.05f, 0.05f);
+            float output;
+            float reference_output;
+            if (chance(0.5f)) {
+                output = pid.calculate(setpoint, measurement, dt);
+                reference_output = reference.calculate(setpoint, measurement, dt);
+            }
+            else {
+                const float measurement_d = uniform(-0.05f, 0.05f);
+                output = pid.calculate(setpoint, measurement, measurement_d, dt);
+                reference_output = reference.calculate(setpoint, measurement, measurement_d, dt);
+            }
+            zassert_true(agrees_with_reference(output, reference_output),
+                "config %d step %d: output %f should match the reference's %f", config, step, (double)output, (double)reference_output);
+            zassert_true(agrees_with_reference(pid.getIntegralOutput(), reference.getIntegralOutput()),
+                "config %d step %d: integral output %f should match the reference's %f",
+                config, step, (double)pid.getIntegralOutput(), (double)reference.getIntegralOutput());
+        }
+    }
+}
+
+ZTEST_SUITE(PID_tests, NULL, NULL, NULL, NULL, NULL);
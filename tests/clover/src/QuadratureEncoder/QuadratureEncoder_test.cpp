@@ -0,0 +1,134 @@
+// QdecQuadratureEncoder against a fake QDEC sensor, which reports its position in degrees like the i.MX RT ENC driver.
+#include "QuadratureEncoder.h"
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+LOG_MODULE_REGISTER(ThrottleValve);
+
+static constexpr int CPR = 4000;
+static constexpr int64_t MICRO_DEG_PER_COUNT = 360'000'000 / CPR;
+
+// Position the fake QDEC reports [micro degrees], and the error its fetch returns
+static int64_t fake_qdec_micro_deg = 0;
+static int fake_qdec_err = 0;
+
+static int fake_qdec_sample_fetch(const device*, sensor_channel) { return fake_qdec_err; }
+
+static int fake_qdec_channel_get(const device*, sensor_channel chan, sensor_value* val)
+{
+    if (chan != SENSOR_CHAN_ROTATION) {
+        return -ENOTSUP;
+    }
+    val->val1 = static_cast<int32_t>(fake_qdec_micro_deg / 1'000'000);
+    val->val2 = static_cast<int32_t>(fake_qdec_micro_deg % 1'000'000);
+    return 0;
+}
+
+static DEVICE_API(sensor, fake_qdec_api) = {
+    .sample_fetch = fake_qdec_sample_fetch,
+    .channel_get = fake_qdec_channel_get,
+};
+
+DEVICE_DEFINE(fake_qdec, "fake_qdec", NULL, NULL, NULL, NULL, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &fake_qdec_api);
+
+typedef QdecQuadratureEncoder<DEVICE_GET(fake_qdec), CPR, false> Encoder;
+typedef QdecQuadratureEncoder<DEVICE_GET(fake_qdec), CPR, true> ReversedEncoder;
+
+// Makes the fake QDEC report a position of whole counts plus a fraction of a count [micro counts]
+static void set_reading(int64_t counts, int64_t micro_counts = 0)
+{
+    fake_qdec_micro_deg = counts * MICRO_DEG_PER_COUNT + micro_counts * MICRO_DEG_PER_COUNT / 1'000'000;
+}
+
+// Walks the shaft by step counts at a time, reporting positions the way a driver wrapping to [wrap_min, wrap_min + CPR)
+// would, and checks the encoder counts every step.
+template <typename E> static void walk(int start, int step, int steps, int wrap_min, int sign)
+{
+    auto wrapped = [&](int64_t position) { return ((position - wrap_min) % CPR + CPR) % CPR + wrap_min; };
+
+    set_reading(wrapped(start));
+    zassert_true(E::init("test").has_value(), "init should succeed");
+    int64_t position = start;
+    for (int i = 0; i < steps; i++) {
+        position += step;
+        set_reading(wrapped(position));
+        zassert_equal(E::count(), sign * (position - start), "count should follow the shaft across wraps");
+    }
+}
+
+ZTEST(QuadratureEncoder_tests, test_rounds_to_nearest_count)
+{
+    set_reading(0);
+    zassert_true(Encoder::init("test").has_value(), "init should succeed");
+
+    set_reading(10, 400'000);
+    zassert_equal(Encoder::count(), 10, "0.4 of a count should round down");
+    set_reading(10, 600'000);
+    zassert_equal(Encoder::count(), 11, "0.6 of a count should round up");
+    set_reading(0, 500'000);
+    zassert_equal(Encoder::count(), 1, "half a count should round away from zero");
+    set_reading(0, -500'000);
+    zassert_equal(Encoder::count(), -1, "half a count should round away from zero below zero");
+    set_reading(-10, -400'000);
+    zassert_equal(Encoder::count(), -10, "-0.4 of a count should round towards zero");
+    set_reading(-10, -600'000);
+    zassert_equal(Encoder::count(), -11, "-0.6 of a count should round away from zero");
+}
+
+ZTEST(QuadratureEncoder_tests, test_unwraps_forward)
+{
+    walk<Encoder>(3500, 700, 20, 0, 1);
+}
+
+ZTEST(QuadratureEncoder_tests, test_unwraps_backward)
+{
+    walk<Encoder>(500, -700, 20, 0, 1);
+}
+
+ZTEST(QuadratureEncoder_tests, test_unwraps_negative_readings)
+{
+    // Drivers reporting (-180, 180] deg wrap from -CPR / 2 to CPR / 2
+    walk<Encoder>(0, -700, 20, -CPR / 2 + 1, 1);
+    walk<Encoder>(0, 700, 20, -CPR / 2 + 1, 1);
+}
+
+ZTEST(QuadratureEncoder_tests, test_reversed)
+{
+    walk<ReversedEncoder>(3500, 700, 20, 0, -1);
+    walk<ReversedEncoder>(500, -700, 20, 0, -1);
+    walk<ReversedEncoder>(0, -700, 20, -CPR / 2 + 1, -1);
+}
+
+ZTEST(QuadratureEncoder_tests, test_set_count_rebases)
+{
+    set_reading(3990);
+    zassert_true(Encoder::init("test").has_value(), "init should succeed");
+
+    Encoder::set_count(100);
+    set_reading(10);
+    zassert_equal(Encoder::count(), 120, "count should continue from the rebased count");
+}
+
+ZTEST(QuadratureEncoder_tests, test_failed_read_keeps_count)
+{
+    set_reading(0);
+    zassert_true(Encoder::init("test").has_value(), "init should succeed");
+
+    set_reading(50);
+    zassert_equal(Encoder::count(), 50, "count should follow the reading");
+    fake_qdec_err = -EIO;
+    set_reading(80);
+    zassert_equal(Encoder::count(), 50, "a failed read should leave the count as it was");
+    fake_qdec_err = 0;
+    zassert_equal(Encoder::count(), 80, "the next read should catch up");
+}
+
+static void reset_fake_qdec(void*)
+{
+    fake_qdec_micro_deg = 0;
+    fake_qdec_err = 0;
+}
+
+ZTEST_SUITE(QuadratureEncoder_tests, NULL, NULL, reset_fake_qdec, NULL, NULL);
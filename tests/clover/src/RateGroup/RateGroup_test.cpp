@@ -0,0 +1,65 @@
+#include "RateGroup.h"
+#include <zephyr/ztest.h>
+
+static constexpr uint64_t TICK_NS = 1'000'000;
+
+ZTEST(RateGroup_tests, test_due_on_divisor_and_phase)
+{
+    RateGroup group({"test", 4, 1, 100'000}, TICK_NS);
+
+    for (uint64_t tick = 0; tick < 12; tick++) {
+        zassert_equal(group.due(tick), tick % 4 == 1, "group should be due only on ticks where tick % 4 == 1");
+    }
+}
+
+ZTEST(RateGroup_tests, test_staggered_groups)
+{
+    constexpr RateGroupConfig outer = {"outer", 4, 1, 0};
+    constexpr RateGroupConfig inner = {"inner", 2, 0, 0};
+    constexpr RateGroupConfig every_tick = {"every_tick", 1, 0, 0};
+
+    static_assert(rate_groups_staggered(outer, inner));
+    static_assert(!rate_groups_staggered(outer, every_tick));
+    static_assert(!rate_groups_staggered({"a", 4, 1, 0}, {"b", 6, 3, 0}));  // Both run on tick 9
+
+    RateGroup outer_group(outer, TICK_NS);
+    RateGroup inner_group(inner, TICK_NS);
+    for (uint64_t tick = 0; tick < 100; tick++) {
+        zassert_false(outer_group.due(tick) && inner_group.due(tick), "staggered groups should never share a tick");
+    }
+}
+
+ZTEST(RateGroup_tests, test_measured_dt)
+{
+    RateGroup group({"test", 2, 0, 100'000}, TICK_NS);
+
+    zassert_within(group.begin(10 * TICK_NS), 0.002f, 1e-9f, "first run should use the nominal period");
+    zassert_within(group.begin(12 * TICK_NS + 300'000), 0.0023f, 1e-7f, "later runs should measure the period");
+    zassert_within(group.stats().dt_s, 0.0023f, 1e-7f, "stats should report the measured period");
+
+    // After sitting idle (e.g. between traces) the measurement is meaningless.
+    zassert_within(group.begin(1000 * TICK_NS), 0.002f, 1e-9f, "a long gap should fall back to the nominal period");
+}
+
+ZTEST(RateGroup_tests, test_exec_time_and_overruns)
+{
+    RateGroup group({"test", 1, 0, 100'000}, TICK_NS);
+
+    group.begin(0);
+    group.end(50'000);
+    group.begin(TICK_NS);
+    group.end(150'000);
+    group.begin(2 * TICK_NS);
+    group.end(80'000);
+
+    zassert_equal(group.stats().exec_time_ns, 80'000, "exec time should be that of the latest run");
+    zassert_equal(group.stats().max_exec_time_ns, 150'000, "max exec time should be kept");
+    zassert_equal(group.stats().run_count, 3, "every run should be counted");
+    zassert_equal(group.stats().overrun_count, 1, "only the run over budget should count as an overrun");
+
+    group.reset_stats();
+    zassert_equal(group.stats().run_count, 0, "reset should clear the stats");
+    zassert_equal(group.stats().max_exec_time_ns, 0, "reset should clear the max exec time");
+}
+
+ZTEST_SUITE(RateGroup_tests, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,89 @@
+#include "SCurveTrajectory.h"
+#include <cmath>
+#include <numbers>
+#include <zephyr/ztest.h>
+
+static constexpr SCurveLimits LIMITS = {900.0f, 480000.0f, 1.92e9f};
+static constexpr float DT = 0.0002f;
+static constexpr int STEPS_PER_UPDATE = 5;
+
+ZTEST(SCurveTrajectory_tests, test_step_respects_limits_without_overshoot)
+{
+    for (float step : {0.045f, 0.5f, 5.0f, -40.0f}) {
+        SCurveTrajectory trajectory(LIMITS);
+        trajectory.reset(0.0f);
+        trajectory.set_target(step);
+
+        float max_overshoot = 0.0f;
+        float prev_acceleration = 0.0f;
+        for (int i = 0; i < 1000; i++) {
+            trajectory.advance(DT);
+
+            zassert_true(std::abs(trajectory.velocity()) <= LIMITS.max_velocity, "velocity limit exceeded");
+            zassert_true(std::abs(trajectory.acceleration()) <= LIMITS.max_acceleration, "acceleration limit exceeded");
+            const float jerk = (trajectory.acceleration() - prev_acceleration) / DT;
+            zassert_true(std::abs(jerk) <= LIMITS.max_jerk * 1.001f, "jerk limit exceeded");
+            prev_acceleration = trajectory.acceleration();
+
+            max_overshoot = std::max(max_overshoot, std::copysign(1.0f, step) * (trajectory.position() - step));
+        }
+
+        zassert_within(trajectory.position(), step, 1e-4f, "trajectory should settle on the target");
+        zassert_within(trajectory.velocity(), 0.0f, 1e-2f, "trajectory should come to rest");
+        zassert_true(max_overshoot < 1e-3f, "trajectory should not overshoot, got %f", static_cast<double>(max_overshoot));
+    }
+}
+
+ZTEST(SCurveTrajectory_tests, test_reset_stops_in_place)
+{
+    SCurveTrajectory trajectory(LIMITS);
+    trajectory.reset(0.0f);
+    trajectory.set_target(10.0f);
+    for (int i = 0; i < 20; i++) {
+        trajectory.advance(DT);
+    }
+    zassert_true(trajectory.velocity() > 0.0f, "trajectory should be moving");
+
+    trajectory.reset(3.0f);
+    zassert_within(trajectory.position(), 3.0f, 1e-9f, "reset should move the position");
+    zassert_within(trajectory.velocity(), 0.0f, 1e-9f, "reset should stop");
+    zassert_within(trajectory.acceleration(), 0.0f, 1e-9f, "reset should stop");
+
+    trajectory.advance(DT);
+    zassert_within(trajectory.position(), 3.0f, 1e-9f, "reset should also hold the target");
+}
+
+ZTEST(SCurveTrajectory_tests, test_tracks_target_between_updates)
+{
+    // A sine target updated every STEPS_PER_UPDATE steps. Holding each update until the next, like a per-update
+    // controller does at best, lags a whole update behind; extrapolating the target should do much better.
+    constexpr float UPDATE_DT = DT * STEPS_PER_UPDATE;
+    constexpr float AMPLITUDE = 5.0f;
+    constexpr float FREQUENCY_HZ = 10.0f;
+    auto reference = [](float t) { return AMPLITUDE * std::sin(2.0f * std::numbers::pi_v<float> * FREQUENCY_HZ * t); };
+
+    SCurveTrajectory trajectory(LIMITS);
+    trajectory.reset(0.0f);
+    float prev_target = 0.0f;
+    float max_error = 0.0f;
+    float max_hold_error = 0.0f;
+    for (int k = 0; k < 500; k++) {
+        const float target = reference(k * UPDATE_DT);
+        trajectory.set_target(target, (target - prev_target) / UPDATE_DT);
+        prev_target = target;
+        for (int i = 0; i < STEPS_PER_UPDATE; i++) {
+            trajectory.advance(DT);
+        }
+
+        if (k > 50) {
+            const float next = reference((k + 1) * UPDATE_DT);
+            max_error = std::max(max_error, std::abs(trajectory.position() - next));
+            max_hold_error = std::max(max_hold_error, std::abs(target - next));
+        }
+    }
+
+    zassert_true(max_error < 0.5f * max_hold_error, "tracking error %f should beat holding each update, %f",
+        static_cast<double>(max_error), static_cast<double>(max_hold_error));
+}
+
+ZTEST_SUITE(SCurveTrajectory_tests, NULL, NULL, NULL, NULL, NULL);
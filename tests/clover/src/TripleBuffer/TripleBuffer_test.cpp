@@ -0,0 +1,64 @@
+#include "TripleBuffer.h"
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+struct Sample {
+    uint32_t counter;
+    uint32_t check;  // Always ~counter in a consistently written sample
+};
+
+ZTEST(TripleBuffer_tests, test_read_before_publish_is_default)
+{
+    TripleBuffer<Sample> buffer;
+
+    zassert_equal(buffer.read().counter, 0, "read before any publish should return a default value");
+}
+
+ZTEST(TripleBuffer_tests, test_read_returns_newest_write)
+{
+    TripleBuffer<Sample> buffer;
+
+    buffer.write({1, ~1u});
+    buffer.write({2, ~2u});
+    buffer.write({3, ~3u});
+
+    zassert_equal(buffer.read().counter, 3, "read should return the newest of several writes");
+    zassert_equal(buffer.read().counter, 3, "reading again without a write should return the same value");
+
+    buffer.write({4, ~4u});
+    zassert_equal(buffer.read().counter, 4, "read should pick up a later write");
+}
+
+ZTEST(TripleBuffer_tests, test_back_buffer_is_not_visible_until_published)
+{
+    TripleBuffer<Sample> buffer;
+    buffer.write({1, ~1u});
+    zassert_equal(buffer.read().counter, 1, "first write should be read");
+
+    buffer.back() = {2, ~2u};
+    zassert_equal(buffer.read().counter, 1, "an unpublished back buffer should not be read");
+
+    buffer.publish();
+    zassert_equal(buffer.read().counter, 2, "the back buffer should be read once published");
+}
+
+ZTEST(TripleBuffer_tests, test_interleaved_reads_never_see_a_reused_buffer)
+{
+    TripleBuffer<Sample> buffer;
+
+    // Reads between writes must never alias the buffer the writer fills next.
+    for (uint32_t i = 1; i <= 100; i++) {
+        Sample& back = buffer.back();
+        const Sample& front = buffer.read();
+        zassert_not_equal(&back, &front, "writer and reader buffers should never alias");
+        back = {i, ~i};
+        buffer.publish();
+        if (i % 3 == 0) {
+            const Sample& sample = buffer.read();
+            zassert_equal(sample.counter, i, "read should return the value just published");
+            zassert_equal(sample.check, ~i, "read should return a consistently written value");
+        }
+    }
+}
+
+ZTEST_SUITE(TripleBuffer_tests, NULL, NULL, NULL, NULL, NULL);
@@ -1,7 +1,22 @@
+#include "../../../../clover/src/config.h"
 #include "../../../../clover/src/flight/FlightController.h"
 #include <zephyr/ztest.h>
 #include <cmath>
 
+static constexpr float OUTER_DT_S = 0.01f;
+static constexpr float INNER_DT_S = 0.002f;
+
+// One outer loop run followed by one inner loop run, as the rate groups do on their first ticks.
+static std::expected<std::tuple<float, float, float, FlightControllerMetrics>, Error>
+tick(EstimatedState state, float x_command_m, float y_command_m, float z_command_m)
+{
+    auto desired = FlightController::tick_outer(state, x_command_m, y_command_m, z_command_m, 0.0f, OUTER_DT_S);
+    if (!desired) {
+        return std::unexpected(desired.error());
+    }
+    return FlightController::tick_inner(state, *desired, INNER_DT_S);
+}
+
 ZTEST(FlightController_tests, test_flight_tick_given_default_state)
 {
     // Reset the flight controller state
@@ -22,7 +37,7 @@ ZTEST(FlightController_tests, test_flight_tick_given_default_state)
     state.velocity.z = 0.0f;
 
     // Call tick with zero desired positions
-    auto result = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
+    auto result = tick(state, 0.0f, 0.0f, 0.0f);
 
     // Verify the call succeeded
     zassert_true(result.has_value(), "FlightController::tick should succeed");
@@ -71,7 +86,7 @@ ZTEST(FlightController_tests, test_actual_tilt_with_pitched_quaternion)
     state.velocity.y = 0.0f;
     state.velocity.z = 0.0f;
 
-    auto result = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
+    auto result = tick(state, 0.0f, 0.0f, 0.0f);
     zassert_true(result.has_value(), "FlightController::tick should succeed for pitched quaternion");
 
     auto [thrust_cmd, pitch_cmd, yaw_cmd, metrics] = *result;
@@ -100,7 +115,7 @@ ZTEST(FlightController_tests, test_lateral_position_error_creates_tilt_command)
     state.velocity.z = 0.0f;
 
     // Request 5m lateral displacement
-    auto result = FlightController::tick(state, 5.0f, 0.0f, 0.0f);
+    auto result = tick(state, 5.0f, 0.0f, 0.0f);
     zassert_true(result.has_value(), "FlightController::tick should succeed for lateral error");
 
     auto [thrust_cmd, pitch_cmd, yaw_cmd, metrics] = *result;
@@ -128,7 +143,7 @@ ZTEST(FlightController_tests, test_vertical_position_error_creates_velocity_comm
     state.velocity.z = 0.0f;
 
     // Request 10m altitude gain
-    auto result = FlightController::tick(state, 0.0f, 0.0f, 10.0f);
+    auto result = tick(state, 0.0f, 0.0f, 10.0f);
     zassert_true(result.has_value(), "FlightController::tick should succeed for vertical error");
 
     auto [thrust_cmd, pitch_cmd, yaw_cmd, metrics] = *result;
@@ -154,7 +169,7 @@ ZTEST(FlightController_tests, test_metrics_do_not_contain_nan_or_inf)
     state.velocity.y = -20.0f;
     state.velocity.z = 15.0f;
 
-    auto result = FlightController::tick(state, 100.0f, -100.0f, 50.0f);
+    auto result = tick(state, 100.0f, -100.0f, 50.0f);
     zassert_true(result.has_value(), "FlightController::tick should succeed for large errors");
 
     auto [thrust_cmd, pitch_cmd, yaw_cmd, metrics] = *result;
@@ -198,17 +213,17 @@ ZTEST(FlightController_tests, test_multiple_ticks_with_consistent_state)
     state.velocity.z = 0.0f;
 
     // First tick
-    auto result1 = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
+    auto result1 = tick(state, 0.0f, 0.0f, 0.0f);
     zassert_true(result1.has_value(), "First tick should succeed");
     auto [thrust1, pitch1, yaw1, metrics1] = *result1;
 
     // Second tick with same state - should be different due to integral terms
-    auto result2 = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
+    auto result2 = tick(state, 0.0f, 0.0f, 0.0f);
     zassert_true(result2.has_value(), "Second tick should succeed");
     auto [thrust2, pitch2, yaw2, metrics2] = *result2;
 
     // Third tick - should continue to change
-    auto result3 = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
+    auto result3 = tick(state, 0.0f, 0.0f, 0.0f);
     zassert_true(result3.has_value(), "Third tick should succeed");
     auto [thrust3, pitch3, yaw3, metrics3] = *result3;
 
@@ -223,13 +238,13 @@ ZTEST(FlightController_tests, test_multiple_ticks_with_consistent_state)
     // and the 1 m z-error falls outside pidZ's 0.05 m integral zone – constant by design.
 
     FlightController::reset();
-    auto result_pos = FlightController::tick(state, 5.0f, 0.0f, 0.0f);
+    auto result_pos = tick(state, 5.0f, 0.0f, 0.0f);
     zassert_true(result_pos.has_value(), "Positive error tick should succeed");
     auto [thrust_pos, pitch_pos, yaw_pos, metrics_pos] = *result_pos;
 
     // Reset and test negative error in X
     FlightController::reset();
-    auto result_neg = FlightController::tick(state, -5.0f, 0.0f, 0.0f);
+    auto result_neg = tick(state, -5.0f, 0.0f, 0.0f);
     zassert_true(result_neg.has_value(), "Negative error tick should succeed");
     auto [thrust_neg, pitch_neg, yaw_neg, metrics_neg] = *result_neg;
 
@@ -255,8 +270,8 @@ ZTEST(FlightController_tests, test_multiple_ticks_with_consistent_state)
     auto gain_result = FlightController::handle_configure_gains(req);
     zassert_true(gain_result.has_value(), "Gain configuration should succeed");
     // Run two ticks, should be identical
-    auto result_a = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
-    auto result_b = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
+    auto result_a = tick(state, 0.0f, 0.0f, 0.0f);
+    auto result_b = tick(state, 0.0f, 0.0f, 0.0f);
     zassert_true(result_a.has_value() && result_b.has_value(), "Both ticks should succeed with zero I/D gains");
     auto [ta, pa, ya, ma] = *result_a;
     auto [tb, pb, yb, mb] = *result_b;
@@ -284,7 +299,7 @@ ZTEST(FlightController_tests, test_non_unit_quaternion)
     state.velocity.y = 0.0f;
     state.velocity.z = 0.0f;
 
-    auto result = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
+    auto result = tick(state, 0.0f, 0.0f, 0.0f);
     zassert_true(result.has_value(), "Should handle non-unit quaternion");
 
     auto [thrust_cmd, pitch_cmd, yaw_cmd, metrics] = *result;
@@ -296,6 +311,213 @@ ZTEST(FlightController_tests, test_non_unit_quaternion)
     zassert_false(std::isinf(metrics.actual_world_tilt_y_rad), "actual_world_tilt_y_rad should not be Inf for non-unit quaternion");
 }
 
+ZTEST(FlightController_tests, test_gain_update_keeps_integrators)
+{
+    EstimatedState state = EstimatedState_init_default;
+    state.R_WB.qw = 1.0f;
+    state.position.x = 2.0f;
+    state.position.z = 1.0f;
+
+    // Reference: integrate for a while, then take one more tick.
+    FlightController::reset();
+    for (int i = 0; i < 20; ++i) {
+        tick(state, 0.0f, 0.0f, 0.0f);
+    }
+    auto reference = tick(state, 0.0f, 0.0f, 0.0f);
+    zassert_true(reference.has_value(), "reference tick should succeed");
+
+    // Same run with a gain update that changes nothing, published mid-run.
+    FlightController::reset();
+    for (int i = 0; i < 20; ++i) {
+        tick(state, 0.0f, 0.0f, 0.0f);
+    }
+    ConfigureFlightControllerGainsRequest req = ConfigureFlightControllerGainsRequest_init_default;
+    zassert_true(FlightController::handle_configure_gains(req).has_value(), "gain update should succeed");
+    auto updated = tick(state, 0.0f, 0.0f, 0.0f);
+    zassert_true(updated.has_value(), "tick after gain update should succeed");
+
+    auto [ref_pitch, ref_yaw, ref_z, ref_metrics] = *reference;
+    auto [pitch, yaw, z, metrics] = *updated;
+    zassert_within(pitch, ref_pitch, 1e-6f, "gain update should not disturb the pitch integrator");
+    zassert_within(z, ref_z, 1e-6f, "gain update should not disturb the vertical integrators");
+}
+
+ZTEST(FlightController_tests, test_gain_update_applies_at_next_tick)
+{
+    EstimatedState state = EstimatedState_init_default;
+    state.R_WB.qw = 1.0f;
+    state.position.z = 1.0f;
+    FlightController::reset();
+    tick(state, 0.0f, 0.0f, 0.0f);
+
+    // Only the vertical velocity loop's P term acts on this tick: the state is at rest and the setpoint is held.
+    FlightControllerDesiredState desired = FlightControllerDesiredState_init_default;
+    desired.vz_m_s = 1.0f;
+
+    ConfigureFlightControllerGainsRequest req = ConfigureFlightControllerGainsRequest_init_default;
+    req.has_pidZVelocity_kp = true;
+    req.pidZVelocity_kp = 2.0f;
+    req.has_pidZVelocity_ki = true;
+    req.pidZVelocity_ki = 0.0f;
+    req.has_pidZVelocity_kd = true;
+    req.pidZVelocity_kd = 0.0f;
+    req.has_reset_integrators = true;
+    req.reset_integrators = true;
+    zassert_true(FlightController::handle_configure_gains(req).has_value(), "gain update should succeed");
+
+    auto result = FlightController::tick_inner(state, desired, 0.002f);
+    zassert_true(result.has_value(), "tick after gain update should succeed");
+    auto [pitch, yaw, z, metrics] = *result;
+    zassert_within(metrics.commanded_vertical_acceleration_m_s2, 2.0f, 1e-5f, "new kp should apply from the next tick");
+
+    // Restore the default gains for the other tests.
+    req.pidZVelocity_kp = FLIGHT_PID_Z_VEL_KP;
+    req.pidZVelocity_ki = FLIGHT_PID_Z_VEL_KI;
+    req.pidZVelocity_kd = FLIGHT_PID_Z_VEL_KD;
+    zassert_true(FlightController::handle_configure_gains(req).has_value(), "gain restore should succeed");
+    FlightController::reset();
+}
+
+// pidZ gains that only vary with thrust: kp = 0.1, 0.2, 0.3, 0.4 at 0, 100, 200, 300 N, ki = kd = 0.
+static LoadFlightGainScheduleRequest thrust_scheduled_z_request()
+{
+    LoadFlightGainScheduleRequest req = LoadFlightGainScheduleRequest_init_default;
+    req.thrust_min_N = 0.0f;
+    req.thrust_gap_N = 100.0f;
+    req.altitude_min_m = 0.0f;
+    req.altitude_gap_m = 1.0f;
+    req.has_pidZ = true;
+    for (int i = 0; i < FLIGHT_GAIN_SCHEDULE_THRUST_LEN; i++) {
+        for (int j = 0; j < FLIGHT_GAIN_SCHEDULE_ALTITUDE_LEN; j++) {
+            req.pidZ.kp[req.pidZ.kp_count++] = 0.1f * static_cast<float>(i + 1);
+            req.pidZ.ki[req.pidZ.ki_count++] = 0.0f;
+            req.pidZ.kd[req.pidZ.kd_count++] = 0.0f;
+        }
+    }
+    return req;
+}
+
+static void clear_gain_schedule()
+{
+    LoadFlightGainScheduleRequest req = LoadFlightGainScheduleRequest_init_default;
+    req.thrust_gap_N = 1.0f;
+    req.altitude_gap_m = 1.0f;
+    zassert_true(FlightController::handle_load_gain_schedule(req).has_value(), "clearing the schedule should succeed");
+}
+
+ZTEST(FlightController_tests, test_gain_schedule_interpolates_thrust)
+{
+    EstimatedState state = EstimatedState_init_default;
+    state.R_WB.qw = 1.0f;
+    FlightController::reset();
+
+    zassert_true(FlightController::handle_load_gain_schedule(thrust_scheduled_z_request()).has_value(),
+                 "gain schedule should load");
+
+    // First run after a reset is proportional only: vz = kp * 1 m of error, with kp interpolated at 150 N.
+    auto desired = FlightController::tick_outer(state, 0.0f, 0.0f, 1.0f, 150.0f, OUTER_DT_S);
+    zassert_true(desired.has_value(), "outer tick should succeed");
+    zassert_within(desired->vz_m_s, 0.25f, 1e-5f, "pidZ kp should be interpolated at the measured thrust");
+
+    // Thrust beyond the grid clamps to its edge.
+    FlightController::reset();
+    desired = FlightController::tick_outer(state, 0.0f, 0.0f, 1.0f, 1000.0f, OUTER_DT_S);
+    zassert_within(desired->vz_m_s, 0.4f, 1e-5f, "thrust beyond the grid should use the last breakpoint");
+
+    clear_gain_schedule();
+    FlightController::reset();
+    desired = FlightController::tick_outer(state, 0.0f, 0.0f, 1.0f, 150.0f, OUTER_DT_S);
+    zassert_within(desired->vz_m_s, FLIGHT_PID_Z_KP, 1e-6f, "clearing the schedule should restore the configured gains");
+    FlightController::reset();
+}
+
+ZTEST(FlightController_tests, test_gain_schedule_keeps_integrators)
+{
+    EstimatedState state = EstimatedState_init_default;
+    state.R_WB.qw = 1.0f;
+    state.position.z = 0.5f;
+
+    ConfigureFlightControllerGainsRequest gains = ConfigureFlightControllerGainsRequest_init_default;
+    gains.has_pidZ_kp = gains.has_pidZ_ki = gains.has_pidZ_kd = true;
+    gains.pidZ_kp = FLIGHT_PID_Z_KP;
+    gains.pidZ_ki = FLIGHT_PID_Z_KI;
+    gains.pidZ_kd = FLIGHT_PID_Z_KD;
+    zassert_true(FlightController::handle_configure_gains(gains).has_value(), "gain update should succeed");
+
+    // Schedule that reproduces the configured pidZ gains everywhere
+    LoadFlightGainScheduleRequest req = thrust_scheduled_z_request();
+    for (int i = 0; i < req.pidZ.kp_count; i++) {
+        req.pidZ.kp[i] = FLIGHT_PID_Z_KP;
+        req.pidZ.ki[i] = FLIGHT_PID_Z_KI;
+        req.pidZ.kd[i] = FLIGHT_PID_Z_KD;
+    }
+
+    FlightController::reset();
+    for (int i = 0; i < 20; ++i) {
+        FlightController::tick_outer(state, 0.0f, 0.0f, 0.52f, 0.0f, OUTER_DT_S);
+    }
+    auto reference = FlightController::tick_outer(state, 0.0f, 0.0f, 0.52f, 0.0f, OUTER_DT_S);
+
+    FlightController::reset();
+    for (int i = 0; i < 20; ++i) {
+        FlightController::tick_outer(state, 0.0f, 0.0f, 0.52f, 0.0f, OUTER_DT_S);
+    }
+    zassert_true(FlightController::handle_load_gain_schedule(req).has_value(), "gain schedule should load");
+    auto scheduled = FlightController::tick_outer(state, 0.0f, 0.0f, 0.52f, 0.0f, OUTER_DT_S);
+
+    zassert_true(reference.has_value() && scheduled.has_value(), "outer ticks should succeed");
+    zassert_within(scheduled->vz_m_s, reference->vz_m_s, 1e-6f, "loading a schedule should not reset pidZ");
+
+    clear_gain_schedule();
+    FlightController::reset();
+}
+
+ZTEST(FlightController_tests, test_integrator_reset_survives_later_publish)
+{
+    EstimatedState state = EstimatedState_init_default;
+    state.R_WB.qw = 1.0f;
+    state.position.z = 0.5f;
+
+    // Reference: the first outer tick after a reset
+    FlightController::reset();
+    auto reference = FlightController::tick_outer(state, 0.0f, 0.0f, 0.52f, 0.0f, OUTER_DT_S);
+
+    FlightController::reset();
+    for (int i = 0; i < 20; ++i) {
+        FlightController::tick_outer(state, 0.0f, 0.0f, 0.52f, 0.0f, OUTER_DT_S);
+    }
+
+    // A reset request, then a schedule update published over it before the tick picks either up
+    ConfigureFlightControllerGainsRequest gains = ConfigureFlightControllerGainsRequest_init_default;
+    gains.has_reset_integrators = true;
+    gains.reset_integrators = true;
+    zassert_true(FlightController::handle_configure_gains(gains).has_value(), "gain update should succeed");
+    clear_gain_schedule();
+    auto after = FlightController::tick_outer(state, 0.0f, 0.0f, 0.52f, 0.0f, OUTER_DT_S);
+
+    zassert_true(reference.has_value() && after.has_value(), "outer ticks should succeed");
+    zassert_within(after->vz_m_s, reference->vz_m_s, 1e-6f, "the requested integrator reset should still apply");
+
+    // Later publishes do not reset again
+    clear_gain_schedule();
+    auto next = FlightController::tick_outer(state, 0.0f, 0.0f, 0.52f, 0.0f, OUTER_DT_S);
+    zassert_true(next.has_value(), "outer tick should succeed");
+    zassert_true(std::fabs(next->vz_m_s - reference->vz_m_s) > 1e-6f, "an applied reset should not repeat");
+
+    FlightController::reset();
+}
+
+ZTEST(FlightController_tests, test_gain_schedule_rejects_bad_tables)
+{
+    LoadFlightGainScheduleRequest req = thrust_scheduled_z_request();
+    req.pidZ.kd_count--;
+    zassert_false(FlightController::handle_load_gain_schedule(req).has_value(), "short tables should be rejected");
+
+    req = thrust_scheduled_z_request();
+    req.thrust_gap_N = 0.0f;
+    zassert_false(FlightController::handle_load_gain_schedule(req).has_value(), "a zero gap should be rejected");
+}
+
 ZTEST_SUITE(FlightController_tests, NULL, NULL, NULL, NULL, NULL);
 
 ZTEST(FlightController_tests, test_desired_tilt_clamped_to_max)
@@ -316,7 +538,7 @@ ZTEST(FlightController_tests, test_desired_tilt_clamped_to_max)
     state.velocity.z = 0.0f;
 
     // Large lateral error that should cause tilt > 8 degrees if not clamped
-    auto result = FlightController::tick(state, 100.0f, 0.0f, 0.0f);
+    auto result = tick(state, 100.0f, 0.0f, 0.0f);
     zassert_true(result.has_value(), "FlightController::tick should succeed for large lateral error (clamp test)");
 
     auto [thrust_cmd, pitch_cmd, yaw_cmd, metrics] = *result;
@@ -326,9 +548,9 @@ ZTEST(FlightController_tests, test_desired_tilt_clamped_to_max)
     zassert_true(std::abs(metrics.desired_world_tilt_y_rad) <= 0.175f, "Desired tilt Y should be clamped to <= 10 degrees");
 }
 
-ZTEST(FlightController_tests, test_loop_count_effect_on_outer_loop)
+ZTEST(FlightController_tests, test_inner_loop_tracks_given_setpoint)
 {
-    // Verify outer loop only updates desired tilt when loopCount % 3 == 0.
+    // The inner loop only tracks the setpoint it is given; position error alone must not tilt it.
     FlightController::reset();
 
     EstimatedState state = EstimatedState_init_default;
@@ -343,28 +565,29 @@ ZTEST(FlightController_tests, test_loop_count_effect_on_outer_loop)
     state.velocity.y = 0.0f;
     state.velocity.z = 0.0f;
 
-    // Force loopCount=1 so outer loop is skipped this tick (1 % 3 != 0).
-    // des_state was zeroed by reset(), so desired tilt must stay at 0.
-    FlightController::set_loop_count_for_testing(1);
-    auto result_skip = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
-    zassert_true(result_skip.has_value(), "Tick with skipped outer loop should succeed");
-    auto [t_skip, p_skip, y_skip, m_skip] = *result_skip;
-    zassert_within(m_skip.desired_world_tilt_x_rad, 0.0f, 0.01f,
-                   "Desired tilt should be 0 when outer loop is skipped");
+    FlightControllerDesiredState level = FlightControllerDesiredState_init_default;
+    auto result_level = FlightController::tick_inner(state, level, INNER_DT_S);
+    zassert_true(result_level.has_value(), "Inner tick with a level setpoint should succeed");
+    auto [t_level, p_level, y_level, m_level] = *result_level;
+    zassert_within(m_level.desired_world_tilt_x_rad, 0.0f, 0.01f,
+                   "Desired tilt should be 0 until the outer loop sets one");
 
-    // Force loopCount=0 so the outer loop runs (0 % 3 == 0).
     // With 5 m position error the outer PID must produce a non-zero tilt command.
-    FlightController::set_loop_count_for_testing(0);
-    auto result_run = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
-    zassert_true(result_run.has_value(), "Tick with outer loop running should succeed");
-    auto [t_run, p_run, y_run, m_run] = *result_run;
-    zassert_true(std::abs(m_run.desired_world_tilt_x_rad) > 0.001f,
+    auto desired = FlightController::tick_outer(state, 0.0f, 0.0f, 0.0f, 0.0f, OUTER_DT_S);
+    zassert_true(desired.has_value(), "Outer tick should succeed");
+    zassert_true(std::abs(desired->world_tilt_x) > 0.001f,
                  "Desired tilt should be non-zero when outer loop runs with position error");
+
+    auto result_run = FlightController::tick_inner(state, *desired, INNER_DT_S);
+    zassert_true(result_run.has_value(), "Inner tick with the outer setpoint should succeed");
+    auto [t_run, p_run, y_run, m_run] = *result_run;
+    zassert_within(m_run.desired_world_tilt_x_rad, desired->world_tilt_x, 1e-6f,
+                   "Inner loop should report the outer loop setpoint");
 }
 
-ZTEST(FlightController_tests, test_loop_count_outer_loop_vs_integral_drift)
+ZTEST(FlightController_tests, test_inner_loop_holds_outer_setpoint)
 {
-    // Verify desired_world_tilt is stable between outer-loop ticks.
+    // Verify desired_world_tilt is stable between outer-loop runs.
     // The inner-loop integral must not alter desired_world_tilt_x_rad.
     FlightController::reset();
 
@@ -380,28 +603,20 @@ ZTEST(FlightController_tests, test_loop_count_outer_loop_vs_integral_drift)
     state.velocity.y = 0.0f;
     state.velocity.z = 0.0f;
 
-    // Outer-loop tick (loopCount=0 % 3 == 0) – sets a non-zero desired tilt.
-    auto result_outer = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
-    zassert_true(result_outer.has_value(), "Outer loop tick should succeed");
-    auto [to, po, yo, m_outer] = *result_outer;
-    float tilt_after_outer = m_outer.desired_world_tilt_x_rad;
+    auto desired = FlightController::tick_outer(state, 0.0f, 0.0f, 0.0f, 0.0f, OUTER_DT_S);
+    zassert_true(desired.has_value(), "Outer loop tick should succeed");
+    float tilt_after_outer = desired->world_tilt_x;
     zassert_true(std::abs(tilt_after_outer) > 0.001f,
                  "Outer loop should set a non-zero desired tilt with position error");
 
-    // Two inner-loop-only ticks (loopCount=1, 2) must not change desired_world_tilt.
-    FlightController::set_loop_count_for_testing(1);
-    auto result_inner1 = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
-    zassert_true(result_inner1.has_value(), "Inner-only tick 1 should succeed");
-    auto [ti1, pi1, yi1, m_inner1] = *result_inner1;
-    zassert_within(m_inner1.desired_world_tilt_x_rad, tilt_after_outer, 0.001f,
-                   "Desired tilt must not change on inner-only tick 1");
-
-    FlightController::set_loop_count_for_testing(2);
-    auto result_inner2 = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
-    zassert_true(result_inner2.has_value(), "Inner-only tick 2 should succeed");
-    auto [ti2, pi2, yi2, m_inner2] = *result_inner2;
-    zassert_within(m_inner2.desired_world_tilt_x_rad, tilt_after_outer, 0.001f,
-                   "Desired tilt must not change on inner-only tick 2");
+    // Several inner-loop runs between outer runs must not change desired_world_tilt.
+    for (int i = 0; i < 4; i++) {
+        auto result_inner = FlightController::tick_inner(state, *desired, INNER_DT_S);
+        zassert_true(result_inner.has_value(), "Inner-only tick should succeed");
+        auto [ti, pi, yi, m_inner] = *result_inner;
+        zassert_within(m_inner.desired_world_tilt_x_rad, tilt_after_outer, 0.001f,
+                       "Desired tilt must not change on inner-only ticks");
+    }
 }
 
 ZTEST(FlightController_tests, test_multiple_ticks_integral_accumulation_and_reset)
@@ -424,7 +639,7 @@ ZTEST(FlightController_tests, test_multiple_ticks_integral_accumulation_and_rese
     // Run multiple ticks and collect metrics
     FlightControllerMetrics metrics_history[5];
     for (int i = 0; i < 5; ++i) {
-        auto result = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
+        auto result = tick(state, 0.0f, 0.0f, 0.0f);
         zassert_true(result.has_value(), "Tick should succeed in accumulation test");
         auto [thrust, pitch, yaw, metrics] = *result;
         metrics_history[i] = metrics;
@@ -446,7 +661,7 @@ ZTEST(FlightController_tests, test_multiple_ticks_integral_accumulation_and_rese
 
     // Now reset and run the same sequence again
     FlightController::reset();
-    auto result_reset = FlightController::tick(state, 0.0f, 0.0f, 0.0f);
+    auto result_reset = tick(state, 0.0f, 0.0f, 0.0f);
     zassert_true(result_reset.has_value(), "Tick after reset should succeed");
     auto [thrust_reset, pitch_reset, yaw_reset, metrics_reset] = *result_reset;
 
@@ -0,0 +1,224 @@
+#include "../../../../clover/src/config.h"
+#include "../../../../clover/src/flight/StateEstimator.h"
+#include <cmath>
+#include <optional>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+static uint64_t now_ns()
+{
+    return k_cyc_to_ns_floor64(k_cycle_get_64());
+}
+
+struct SensorInputs {
+    LidarReading lidar_1 = LidarReading_init_default;
+    LidarReading lidar_2 = LidarReading_init_default;
+    ImuReading imu = ImuReading_init_default;
+    GnssReadings gnss = GnssReadings_init_default;
+};
+
+// All sensors report a sample captured at the given time.
+static SensorInputs fresh_inputs(uint32_t sample_counter, uint64_t capture_time_ns)
+{
+    SensorInputs in;
+    in.lidar_1.sample_counter = sample_counter;
+    in.lidar_1.capture_time_ns = capture_time_ns;
+    in.lidar_2.sample_counter = sample_counter;
+    in.lidar_2.capture_time_ns = capture_time_ns;
+    in.imu.sample_counter = sample_counter;
+    in.imu.capture_time_ns = capture_time_ns;
+    in.imu.quat_w = 1.0f;
+    in.gnss.sample_counter = sample_counter;
+    in.gnss.capture_time_ns = capture_time_ns;
+    return in;
+}
+
+ZTEST(StateEstimator_tests, test_no_samples_is_stale)
+{
+    StateEstimator::reset();
+
+    SensorInputs in;
+    auto estimate = StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+
+    zassert_true(estimate.has_value(), "estimate should always produce a state");
+    zassert_true(estimate->stale, "estimate without any samples should be stale");
+    zassert_true(std::isinf(estimate->imu_age_ns), "imu age should be infinite before the first sample");
+    zassert_within(estimate->R_WB.qw, 1.0f, 1e-6f, "attitude should stay identity without imu samples");
+}
+
+ZTEST(StateEstimator_tests, test_fresh_samples_are_not_stale)
+{
+    StateEstimator::reset();
+
+    SensorInputs in = fresh_inputs(1, now_ns());
+    auto estimate = StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+
+    zassert_true(estimate.has_value(), "estimate should always produce a state");
+    zassert_false(estimate->stale, "freshly captured samples should not be stale");
+    zassert_true(estimate->imu_age_ns < IMU_STALE_AFTER_NS, "imu age should be below its limit");
+}
+
+ZTEST(StateEstimator_tests, test_old_capture_is_stale)
+{
+    StateEstimator::reset();
+
+    // Let enough time pass that a sample captured at boot exceeds the imu limit.
+    k_sleep(K_NSEC(2 * IMU_STALE_AFTER_NS));
+    uint64_t now = now_ns();
+
+    SensorInputs in = fresh_inputs(1, now);
+    in.imu.capture_time_ns = now - 2 * IMU_STALE_AFTER_NS;
+    auto estimate = StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+
+    zassert_true(estimate.has_value(), "estimate should always produce a state");
+    zassert_true(estimate->stale, "an old imu capture should mark the estimate stale");
+    zassert_true(estimate->imu_age_ns >= 2 * IMU_STALE_AFTER_NS, "imu age should reflect the capture time");
+}
+
+ZTEST(StateEstimator_tests, test_repeated_sample_counter_is_ignored)
+{
+    StateEstimator::reset();
+
+    SensorInputs in = fresh_inputs(7, now_ns());
+    StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+
+    // Same sample counter with different contents must not be treated as new data.
+    in.imu.quat_w = 0.9962f; // 10 deg yaw
+    in.imu.quat_z = 0.0872f;
+    in.gnss.north_m = 42.0f;
+    auto estimate = StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+
+    zassert_true(estimate.has_value(), "estimate should always produce a state");
+    zassert_within(estimate->R_WB.qw, 1.0f, 1e-6f, "repeated imu sample should not update attitude");
+    zassert_within(estimate->position.x, 0.0f, 1e-6f, "repeated gnss sample should not update position");
+
+    // The next counter is new data and pulls the estimate toward it.
+    in.imu.sample_counter = 8;
+    in.gnss.sample_counter = 8;
+    estimate = StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+    zassert_within(estimate->R_WB.qz, 0.0872f, 0.01f, "new imu sample should update attitude");
+    zassert_true(estimate->position.x > 10.0f, "new gnss sample should update position");
+}
+
+// Hovering at rest: IMU reads gravity only, lidars and GNSS agree on 2 m of height.
+static SensorInputs hover_inputs(uint32_t sample_counter, uint64_t capture_time_ns)
+{
+    SensorInputs in = fresh_inputs(sample_counter, capture_time_ns);
+    in.imu.accel_z = -GRAVITY_M_S2;
+    in.lidar_1.distance_m = 2.0f;
+    in.lidar_2.distance_m = 2.0f;
+    in.gnss.north_m = 1.0f;
+    in.gnss.east_m = -1.0f;
+    in.gnss.up_m = 2.0f;
+    in.gnss.hrms_m = 0.3f;
+    in.gnss.vrms_m = 0.5f;
+    in.gnss.vel_sigma_ms = 0.05f;
+    return in;
+}
+
+ZTEST(StateEstimator_tests, test_hover_converges)
+{
+    StateEstimator::reset();
+
+    std::optional<EstimatedState> estimate;
+    for (uint32_t tick = 1; tick <= 500; tick++) {
+        k_sleep(K_MSEC(1));
+        SensorInputs in = hover_inputs(tick, now_ns());
+        estimate = StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+    }
+
+    zassert_true(estimate.has_value(), "estimate should always produce a state");
+    zassert_within(estimate->position.x, 1.0f, 0.05f, "north should converge to gnss");
+    zassert_within(estimate->position.y, -1.0f, 0.05f, "east should converge to gnss");
+    zassert_within(estimate->position.z, 2.0f, 0.02f, "height should converge to lidar");
+    zassert_within(estimate->velocity.z, 0.0f, 0.05f, "vertical velocity should settle at rest");
+}
+
+ZTEST(StateEstimator_tests, test_imu_prediction_between_corrections)
+{
+    StateEstimator::reset();
+
+    // Settle at rest on the ground, then climb at 1 m/s^2 with only the IMU.
+    for (uint32_t tick = 1; tick <= 200; tick++) {
+        k_sleep(K_MSEC(1));
+        SensorInputs in = hover_inputs(tick, now_ns());
+        in.lidar_1.distance_m = in.lidar_2.distance_m = 0.0f;
+        in.gnss.up_m = 0.0f;
+        StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+    }
+
+    uint64_t climb_start_ns = now_ns();
+    std::optional<EstimatedState> estimate;
+    for (uint32_t tick = 201; tick <= 300; tick++) {
+        k_sleep(K_MSEC(1));
+        SensorInputs in = hover_inputs(tick, now_ns());
+        in.imu.accel_z = -GRAVITY_M_S2 - 1.0f;
+        in.lidar_1.sample_counter = in.lidar_2.sample_counter = in.gnss.sample_counter = 0;
+        estimate = StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+    }
+
+    float climb_s = static_cast<float>(now_ns() - climb_start_ns) * 1e-9f;
+    zassert_within(estimate->velocity.z, climb_s, 0.01f, "vertical velocity should integrate imu acceleration");
+    zassert_within(estimate->position.z, 0.5f * climb_s * climb_s, 0.005f, "height should integrate imu velocity");
+}
+
+ZTEST(StateEstimator_tests, test_preintegrated_imu_prediction)
+{
+    StateEstimator::reset();
+
+    for (uint32_t tick = 1; tick <= 200; tick++) {
+        k_sleep(K_MSEC(1));
+        SensorInputs in = hover_inputs(tick, now_ns());
+        in.lidar_1.distance_m = in.lidar_2.distance_m = 0.0f;
+        in.gnss.up_m = 0.0f;
+        StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+    }
+
+    // Climb at 1 m/s^2 with the IMU delivering 5 ms of pre-integrated increments per call.
+    constexpr float READ_PERIOD_S = 0.005f;
+    std::optional<EstimatedState> estimate;
+    for (uint32_t read = 1; read <= 20; read++) {
+        k_sleep(K_MSEC(5));
+        SensorInputs in = hover_inputs(200 + read, now_ns());
+        in.imu.has_delta_angle_rad = true;
+        in.imu.delta_angle_rad = {0.0f, 0.0f, 0.0f};
+        in.imu.has_delta_velocity_m_s = true;
+        in.imu.delta_velocity_m_s = {0.0f, 0.0f, (-GRAVITY_M_S2 - 1.0f) * READ_PERIOD_S};
+        in.imu.has_delta_time_s = true;
+        in.imu.delta_time_s = READ_PERIOD_S;
+        in.lidar_1.sample_counter = in.lidar_2.sample_counter = in.gnss.sample_counter = 0;
+        estimate = StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+    }
+
+    float climb_s = 20 * READ_PERIOD_S;
+    zassert_within(estimate->velocity.z, climb_s, 0.01f, "vertical velocity should integrate the velocity increments");
+    zassert_within(estimate->position.z, 0.5f * climb_s * climb_s, 0.005f, "height should integrate the increments exactly");
+}
+
+ZTEST(StateEstimator_tests, test_latest_returns_newest_published_estimate)
+{
+    StateEstimator::reset();
+    zassert_false(StateEstimator::latest().has_value(), "nothing should be published before the first estimate");
+
+    SensorInputs in = fresh_inputs(1, now_ns());
+    in.gnss.north_m = 3.0f;
+    StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+    in = fresh_inputs(2, now_ns());
+    in.gnss.north_m = 3.0f;
+    auto estimate = StateEstimator::estimate(in.lidar_1, in.lidar_2, in.imu, in.gnss);
+
+    auto snapshot = StateEstimator::latest();
+    zassert_true(snapshot.has_value(), "the estimate should be published");
+    zassert_equal(snapshot->estimate_counter, 2, "only the newest of two estimates should be read");
+    zassert_within(snapshot->state.position.x, estimate->position.x, 1e-6f, "snapshot should hold the returned estimate");
+    zassert_true(snapshot->update_time_ns >= 0.0f, "update time should be measured");
+
+    auto again = StateEstimator::latest();
+    zassert_true(again.has_value(), "reading again without a new estimate should return the same snapshot");
+    zassert_equal(again->estimate_counter, 2, "reading again should not lose the newest estimate");
+
+    StateEstimator::reset();
+    zassert_false(StateEstimator::latest().has_value(), "reset should clear the published estimate");
+}
+
+ZTEST_SUITE(StateEstimator_tests, NULL, NULL, NULL, NULL, NULL);
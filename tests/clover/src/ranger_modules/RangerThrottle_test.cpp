@@ -1,7 +1,14 @@
+#include "../../../../clover/src/lut/cea_lut.h"
+#include "../../../../clover/src/lut/thrust_per_mass_flow.h"
 #include "../../../../clover/src/ranger/RangerThrottle.h"
+#include "../../../../clover/src/sim/RangerEngineModel.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdio>
+#include <random>
 #include <zephyr/ztest.h>
 
 #include "alpha.h"
@@ -18,6 +25,8 @@ static constexpr float kToleranceValveDeg = 0.8f;
 static constexpr float kTolerancePredictorThrustLbf = 5.0f;
 static constexpr float kTolerancePredictorOf = 0.01f;
 static constexpr float kTolerancePredictorMdot = 0.01f;
+static constexpr float kToleranceThrustPerMassFlowRelative = 1e-5f;
+static constexpr float kNewtonToLbf = 0.224809f;
 
 static_assert(TIME_ALPHA_X_LEN == TIME_PREDICTED_THRUST_X_LEN);
 static_assert(TIME_ALPHA_X_LEN == TIME_TARGET_THRUST_X_LEN);
@@ -349,4 +358,285 @@ ZTEST(RangerThrottle_tests, test_thrust_predictor_time_series_mdot_lox)
 	}
 }
 
+// The predictor's thrust per mass flow is the CEA table sliced at the design O/F, so sampling it must match sampling
+// the full table there. A mismatch means one of them was regenerated without the other.
+ZTEST(RangerThrottle_tests, test_thrust_per_mass_flow_matches_cea)
+{
+	for (float p_ch = PC_OF_CEA_X_MIN - 10.0f; p_ch <= PC_OF_CEA_X_MAX + 10.0f; p_ch += 0.25f) {
+		const float expected = PcOfCea::sample(p_ch, THRUST_PER_MASS_FLOW_OF) * THRUST_PER_MASS_FLOW_EFFICIENCY * kNewtonToLbf;
+		zassert_within(
+			ThrustPerMassFlow::sample(p_ch),
+			expected,
+			expected * kToleranceThrustPerMassFlowRelative,
+			"thrust per mass flow mismatch at p_ch=%.2f",
+			(double)p_ch);
+	}
+}
+
+// Valve model for calibration: follows the command one tick late, up to a hardstop it cannot pass. Each contact
+// stops it a little differently, by up to bounce_deg.
+struct CalibrationValveModel {
+	float pos_deg;
+	float hardstop_deg;
+	float bounce_deg;
+	int contacts = 0;
+	bool in_contact = false;
+
+	void follow(float target_deg)
+	{
+		if (target_deg >= hardstop_deg) {
+			if (!in_contact) {
+				contacts++;
+				in_contact = true;
+			}
+			pos_deg = hardstop_deg - bounce_deg * static_cast<float>(contacts % 3) / 2.0f;
+		}
+		else {
+			in_contact = false;
+			pos_deg = target_deg;
+		}
+	}
+};
+
+struct CalibrationRun {
+	std::expected<void, Error> result;
+	uint32_t duration_ms;
+};
+
+static CalibrationRun run_calibration(CalibrationValveModel& valve, uint32_t max_ms)
+{
+	RangerThrottle::calibration_reset(ThrottleValveType_FUEL, 0, valve.pos_deg);
+	for (uint32_t t = 1; t <= max_ms; ++t) {
+		auto command = RangerThrottle::calibration_tick(ThrottleValveType_FUEL, t, valve.pos_deg);
+		if (!command.has_value()) {
+			return {std::unexpected(command.error()), t};
+		}
+		zassert_true(command->enable, "valve should stay enabled during calibration");
+		if (RangerThrottle::calibration_result().has_value()) {
+			return {{}, t};
+		}
+		valve.follow(command->target_deg);
+	}
+	return {std::unexpected(Error::from_cause("calibration did not finish")), max_ms};
+}
+
+ZTEST(RangerThrottle_tests, test_calibration_finds_hardstop_quickly)
+{
+	CalibrationValveModel valve{.pos_deg = 10.0f, .hardstop_deg = 92.3f, .bounce_deg = 0.02f};
+
+	CalibrationRun run = run_calibration(valve, 60'000);
+	zassert_true(run.result.has_value(), "calibration should succeed");
+
+	auto calibration = RangerThrottle::calibration_result();
+	zassert_true(calibration.has_value(), "calibration should report a result");
+	zassert_within(calibration->hardstop_deg, 92.3f, 0.03f, "hardstop should be found");
+	zassert_within(calibration->repeatability_deg, 0.02f, 1e-4f, "repeatability should be the spread of the fine passes");
+	zassert_true(calibration->fine_passes >= 2, "result should come from repeated passes");
+	zassert_equal(calibration->duration_ms, run.duration_ms, "duration should be measured from the reset");
+	zassert_true(run.duration_ms < 5'000, "calibration from 82 deg away should take seconds, took %u ms", run.duration_ms);
+	zassert_true(valve.pos_deg < 92.3f - 1.0f, "valve should be left backed off the hardstop");
+}
+
+ZTEST(RangerThrottle_tests, test_calibration_without_hardstop_fails)
+{
+	CalibrationValveModel valve{.pos_deg = 10.0f, .hardstop_deg = 1000.0f, .bounce_deg = 0.0f};
+
+	CalibrationRun run = run_calibration(valve, 60'000);
+	zassert_false(run.result.has_value(), "calibration should fail without a hardstop");
+	zassert_false(RangerThrottle::calibration_result().has_value(), "a failed calibration should not report a result");
+}
+
+// PTs reading the engine model, each with independent Gaussian noise. The engine inlet PTs read below the manifold by
+// the model's line losses.
+static AnalogSensorReadings read_engine_pts(const RangerEngineState& engine, std::mt19937& rng, float noise_psi)
+{
+	std::normal_distribution<float> noise(0.0f, noise_psi);
+	AnalogSensorReadings sensors = AnalogSensorReadings_init_default;
+	sensors.pt103 = static_cast<float>(engine.lox_manifold_psi) + noise(rng);
+	sensors.pto401 = static_cast<float>(engine.lox_inlet_psi) + noise(rng);
+	sensors.pt203 = static_cast<float>(engine.fuel_manifold_psi) + noise(rng);
+	sensors.ptf401 = static_cast<float>(engine.fuel_inlet_psi) + noise(rng);
+	sensors.ptc401 = static_cast<float>(engine.p_ch_psi) + noise(rng);
+	sensors.ptc402 = static_cast<float>(engine.p_ch_psi) + noise(rng);
+	sensors.has_pt103 = true;
+	sensors.has_pto401 = true;
+	sensors.has_pt203 = true;
+	sensors.has_ptf401 = true;
+	sensors.has_ptc401 = true;
+	sensors.has_ptc402 = true;
+	return sensors;
+}
+
+static RangerEngineModel steady_engine(double fuel_valve_deg, double lox_valve_deg)
+{
+	RangerEngineModel engine;
+	engine.reset();
+	for (int i = 0; i < 10'000; ++i) {
+		engine.step(fuel_valve_deg, lox_valve_deg, 1e-4);
+	}
+	return engine;
+}
+
+struct RunningStats {
+	int count = 0;
+	double sum = 0.0;
+	double sum_squares = 0.0;
+
+	void add(double value)
+	{
+		count++;
+		sum += value;
+		sum_squares += value * value;
+	}
+	double mean() const { return sum / count; }
+	double stddev() const { return std::sqrt(std::max(0.0, sum_squares / count - mean() * mean())); }
+};
+
+ZTEST(RangerThrottle_tests, test_observer_filters_pt_noise)
+{
+	const RangerEngineModel engine = steady_engine(60.0, 60.0);
+	std::mt19937 rng(1);
+	RangerThrottle::reset();
+
+	RunningStats raw_thrust;
+	RunningStats observed_thrust;
+	RunningStats observed_p_ch;
+	for (int tick = 0; tick < 2'000; ++tick) {
+		AnalogSensorReadings sensors = read_engine_pts(engine.state(), rng, 1.5f);
+		RangerThrottleMetrics raw_metrics = RangerThrottleMetrics_init_default;
+		zassert_true(RangerThrottle::thrust_predictor(sensors, raw_metrics).has_value());
+		auto output = RangerThrottle::tick(sensors, 500.0f);
+		zassert_true(output.has_value());
+		if (tick < 500) {
+			continue;  // Converging from the first sample
+		}
+		raw_thrust.add(raw_metrics.predicted_thrust_lbf);
+		observed_thrust.add(std::get<2>(*output).predicted_thrust_lbf);
+		observed_p_ch.add(RangerThrottle::engine_estimate_test().p_ch_psi);
+	}
+
+	zassert_within(observed_p_ch.mean(), engine.state().p_ch_psi, 0.5, "chamber pressure estimate should be unbiased");
+	zassert_within(observed_thrust.mean(), raw_thrust.mean(), 1.0, "observed thrust should match the single-sample mean");
+	zassert_true(
+		observed_thrust.stddev() < raw_thrust.stddev() / 2.0,
+		"observer should at least halve thrust noise (raw %f lbf, observed %f lbf)",
+		raw_thrust.stddev(),
+		observed_thrust.stddev());
+}
+
+ZTEST(RangerThrottle_tests, test_observer_holds_estimate_without_pts)
+{
+	const RangerEngineModel engine = steady_engine(60.0, 60.0);
+	std::mt19937 rng(2);
+	RangerThrottle::reset();
+
+	for (int tick = 0; tick < 200; ++tick) {
+		AnalogSensorReadings sensors = read_engine_pts(engine.state(), rng, 1.5f);
+		zassert_true(RangerThrottle::tick(sensors, 500.0f).has_value());
+	}
+	const RangerThrottle::EngineEstimate before = RangerThrottle::engine_estimate_test();
+
+	AnalogSensorReadings missing = AnalogSensorReadings_init_default;
+	for (int tick = 0; tick < 10; ++tick) {
+		zassert_true(RangerThrottle::tick(missing, 500.0f).has_value());
+	}
+	const RangerThrottle::EngineEstimate after = RangerThrottle::engine_estimate_test();
+
+	zassert_equal(after.p_ch_psi, before.p_ch_psi, "chamber pressure should hold without PTs");
+	zassert_equal(after.mdot_fuel, before.mdot_fuel, "fuel flow should hold without PTs");
+	zassert_equal(after.mdot_lox, before.mdot_lox, "lox flow should hold without PTs");
+}
+
+ZTEST(RangerThrottle_tests, test_feedforward_moves_alpha_with_command)
+{
+	const RangerEngineModel engine = steady_engine(60.0, 60.0);
+	std::mt19937 rng(3);
+	RangerThrottle::reset();
+
+	float alpha_before = 0.0f;
+	for (int tick = 0; tick < 10; ++tick) {
+		AnalogSensorReadings sensors = read_engine_pts(engine.state(), rng, 0.0f);
+		auto output = RangerThrottle::tick(sensors, 450.0f);
+		zassert_true(output.has_value());
+		alpha_before = std::get<2>(*output).alpha;
+	}
+
+	AnalogSensorReadings sensors = read_engine_pts(engine.state(), rng, 0.0f);
+	auto output = RangerThrottle::tick(sensors, 505.0f);
+	zassert_true(output.has_value());
+	const RangerThrottleMetrics& metrics = std::get<2>(*output);
+
+	// 55 lbf is a fifth of the LUTs' thrust range; the proportional term adds its usual rate-limited step on top
+	zassert_within(metrics.alpha - alpha_before - metrics.clamped_change_alpha_cmd, 0.2f, 1e-5f, "alpha should follow the command");
+}
+
+ZTEST(RangerThrottle_tests, test_closed_loop_step_settles_without_chatter)
+{
+	// The valves slew at 300 deg/s towards their targets, and the engine model steps ten times per control tick
+	constexpr int SUBSTEPS = 10;
+	constexpr double SUBSTEP_S = 1e-4;
+	constexpr double MAX_VALVE_STEP_DEG = 300.0 * SUBSTEP_S;
+	constexpr int STEP_TICK = 4'000;
+	constexpr int END_TICK = 8'000;
+
+	RangerEngineModel engine;
+	engine.reset();
+	std::mt19937 rng(4);
+	RangerThrottle::reset();
+
+	double fuel_deg = 60.0;
+	double lox_deg = 60.0;
+	float prev_fuel_target_deg = 0.0f;
+	float prev_lox_target_deg = 0.0f;
+	double valve_travel_deg = 0.0;  // Over the last second before the step
+	RunningStats thrust_before_step;
+	RunningStats thrust_after_step;
+	RunningStats predicted_after_step;
+	int last_unsettled_tick = STEP_TICK;
+	std::array<double, END_TICK> thrust_lbf = {};
+
+	for (int tick = 0; tick < END_TICK; ++tick) {
+		const float command_lbf = tick < STEP_TICK ? 380.0f : 420.0f;
+		AnalogSensorReadings sensors = read_engine_pts(engine.state(), rng, 1.5f);
+		auto output = RangerThrottle::tick(sensors, command_lbf);
+		zassert_true(output.has_value());
+		const auto& [fuel_command, lox_command, metrics] = *output;
+
+		if (tick >= STEP_TICK - 1'000 && tick < STEP_TICK) {
+			valve_travel_deg += std::fabs(fuel_command.target_deg - prev_fuel_target_deg);
+			valve_travel_deg += std::fabs(lox_command.target_deg - prev_lox_target_deg);
+		}
+		prev_fuel_target_deg = fuel_command.target_deg;
+		prev_lox_target_deg = lox_command.target_deg;
+
+		for (int i = 0; i < SUBSTEPS; ++i) {
+			fuel_deg += std::clamp(fuel_command.target_deg - fuel_deg, -MAX_VALVE_STEP_DEG, MAX_VALVE_STEP_DEG);
+			lox_deg += std::clamp(lox_command.target_deg - lox_deg, -MAX_VALVE_STEP_DEG, MAX_VALVE_STEP_DEG);
+			engine.step(fuel_deg, lox_deg, SUBSTEP_S);
+		}
+		thrust_lbf[tick] = engine.state().thrust_lbf;
+
+		if (tick >= STEP_TICK - 500 && tick < STEP_TICK) {
+			thrust_before_step.add(thrust_lbf[tick]);
+		}
+		if (tick >= END_TICK - 500) {
+			thrust_after_step.add(thrust_lbf[tick]);
+			predicted_after_step.add(metrics.predicted_thrust_lbf);
+		}
+	}
+	const double band_lbf = 0.05 * std::fabs(thrust_after_step.mean() - thrust_before_step.mean());
+	for (int tick = STEP_TICK; tick < END_TICK; ++tick) {
+		if (std::fabs(thrust_lbf[tick] - thrust_after_step.mean()) > band_lbf) {
+			last_unsettled_tick = tick;
+		}
+	}
+
+	zassert_within(predicted_after_step.mean(), 420.0, 1.0, "predicted thrust should settle on the command");
+	zassert_true(
+		last_unsettled_tick - STEP_TICK < 2'500,
+		"thrust should settle within 5%% of the step in 2.5 s, took %d ms",
+		last_unsettled_tick - STEP_TICK);
+	zassert_true(valve_travel_deg < 0.75, "valve targets should hold still at steady state, moved %f deg in 1 s", valve_travel_deg);
+}
+
 ZTEST_SUITE(RangerThrottle_tests, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,63 @@
+#include "sim/LatencyHistogram.h"
+#include <zephyr/ztest.h>
+
+ZTEST(LatencyHistogram_tests, test_empty)
+{
+    LatencyHistogram hist;
+    zassert_equal(hist.count(), 0u);
+    zassert_equal(hist.min_ns(), 0u);
+    zassert_equal(hist.max_ns(), 0u);
+    zassert_equal(hist.percentile_ns(0.99), 0u);
+}
+
+ZTEST(LatencyHistogram_tests, test_buckets_cover_every_duration_in_order)
+{
+    // Each value falls in a bucket whose upper bound is at least the value and within 1/16 of it
+    size_t prev_index = 0;
+    for (uint64_t value = 0; value <= UINT32_MAX; value = value < 4096 ? value + 1 : value * 17 / 16) {
+        const size_t index = LatencyHistogram::bucket_index(static_cast<uint32_t>(value));
+        zassert_true(index < LatencyHistogram::NUM_BUCKETS);
+        zassert_true(index >= prev_index, "buckets out of order at %llu", static_cast<unsigned long long>(value));
+        const uint32_t upper = LatencyHistogram::bucket_upper_ns(index);
+        zassert_true(upper >= value, "bucket %u ends at %u below %llu", static_cast<unsigned>(index), upper, static_cast<unsigned long long>(value));
+        zassert_true(upper - value <= value / 16, "bucket %u too wide for %llu", static_cast<unsigned>(index), static_cast<unsigned long long>(value));
+        prev_index = index;
+    }
+    zassert_equal(LatencyHistogram::bucket_index(UINT32_MAX), LatencyHistogram::NUM_BUCKETS - 1);
+    zassert_equal(LatencyHistogram::bucket_upper_ns(LatencyHistogram::NUM_BUCKETS - 1), UINT32_MAX);
+}
+
+ZTEST(LatencyHistogram_tests, test_stats_and_percentiles)
+{
+    LatencyHistogram hist;
+    // 1000 ticks of 10..19.99 us, and 10 outliers of 500 us
+    for (uint32_t i = 0; i < 1000; i++) {
+        hist.add(10'000 + i * 10);
+    }
+    for (int i = 0; i < 10; i++) {
+        hist.add(500'000);
+    }
+
+    zassert_equal(hist.count(), 1010u);
+    zassert_equal(hist.min_ns(), 10'000u);
+    zassert_equal(hist.max_ns(), 500'000u);
+    zassert_within(hist.mean_ns(), (1000 * 14'995.0 + 10 * 500'000.0) / 1010, 1e-6);
+
+    // The 99th percentile is the last of the regular ticks, give or take a bucket
+    zassert_within(hist.percentile_ns(0.99), 19'990, 19'990 / 16);
+    zassert_within(hist.percentile_ns(0.5), 14'990, 14'990 / 16);
+    zassert_equal(hist.percentile_ns(1.0), 500'000u, "capped at the maximum");
+
+    hist.reset();
+    zassert_equal(hist.count(), 0u);
+}
+
+ZTEST(LatencyHistogram_tests, test_saturates_long_durations)
+{
+    LatencyHistogram hist;
+    hist.add(10'000'000'000ULL);
+    zassert_equal(hist.max_ns(), UINT32_MAX);
+    zassert_equal(hist.percentile_ns(0.99), UINT32_MAX);
+}
+
+ZTEST_SUITE(LatencyHistogram_tests, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,78 @@
+#include "lut/thrust_to_fuel.h"
+#include "lut/thrust_to_lox.h"
+#include "sim/RangerEngineModel.h"
+#include <cmath>
+#include <zephyr/ztest.h>
+
+static constexpr double DT = 0.00025;
+
+static RangerEngineState settle(RangerEngineModel& engine, double fuel_deg, double lox_deg)
+{
+    for (int i = 0; i < 2000; i++) {
+        engine.step(fuel_deg, lox_deg, DT);
+    }
+    return engine.state();
+}
+
+ZTEST(RangerEngineModel_tests, test_closed_valves_make_no_thrust)
+{
+    RangerEngineModel engine;
+    engine.reset();
+    const RangerEngineState state = settle(engine, 0.0, 0.0);
+    zassert_within(state.p_ch_psi, 0.0, 1e-9);
+    zassert_within(state.thrust_lbf, 0.0, 1e-9);
+    zassert_within(state.fuel_tank_psi, 750.0, 1e-9);
+}
+
+ZTEST(RangerEngineModel_tests, test_steady_state_follows_thrust_luts)
+{
+    for (float thrust : {400.0f, 500.0f, 600.0f, 675.0f}) {
+        RangerEngineModel engine;
+        engine.reset();
+        const RangerEngineState state = settle(engine, ThrustToFuelAxis::sample(thrust), ThrustToLoxAxis::sample(thrust));
+
+        zassert_within(state.thrust_lbf, thrust, 0.1 * thrust, "%f lbf on the LUT contour gave %f lbf", static_cast<double>(thrust), state.thrust_lbf);
+        const double of = state.mdot_lox / state.mdot_fuel;
+        zassert_true(of > 1.2 && of < 1.8, "mixture ratio %f", of);
+
+        // Manifolds sit above the chamber by the injector drop, and the inlet PTs below them by the line losses
+        zassert_true(state.fuel_manifold_psi > state.p_ch_psi && state.lox_manifold_psi > state.p_ch_psi);
+        zassert_within(state.fuel_manifold_psi - state.fuel_inlet_psi, 21.0, 1e-9);
+        zassert_within(state.lox_manifold_psi - state.lox_inlet_psi, 41.0, 1e-9);
+    }
+}
+
+ZTEST(RangerEngineModel_tests, test_thrust_rises_with_opening)
+{
+    double prev_thrust = 0.0;
+    for (double angle = 20.0; angle <= 90.0; angle += 10.0) {
+        RangerEngineModel engine;
+        engine.reset();
+        const double thrust = settle(engine, angle, angle * 0.8).thrust_lbf;
+        zassert_true(thrust > prev_thrust, "thrust %f at %f deg should exceed %f", thrust, angle, prev_thrust);
+        prev_thrust = thrust;
+    }
+}
+
+ZTEST(RangerEngineModel_tests, test_valve_loses_steps_at_hardstops_and_while_disabled)
+{
+    StepperValveModel valve{-2.0, 93.0};
+    valve.reset(0.0, 0.0);
+
+    valve.step(50.0, true);
+    zassert_within(valve.position_deg(), 50.0, 1e-9);
+
+    // Driven 20 deg into the open stop, then back 10: the valve backs off the stop by 10
+    valve.step(113.0, true);
+    zassert_within(valve.position_deg(), 93.0, 1e-9);
+    valve.step(103.0, true);
+    zassert_within(valve.position_deg(), 83.0, 1e-9);
+
+    // Steps sent while disabled are lost
+    valve.step(50.0, false);
+    zassert_within(valve.position_deg(), 83.0, 1e-9);
+    valve.step(40.0, true);
+    zassert_within(valve.position_deg(), 73.0, 1e-9);
+}
+
+ZTEST_SUITE(RangerEngineModel_tests, NULL, NULL, NULL, NULL, NULL);
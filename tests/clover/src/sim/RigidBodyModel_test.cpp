@@ -0,0 +1,92 @@
+#include "sim/HornetPropulsionModel.h"
+#include "sim/RigidBodyModel.h"
+#include <cmath>
+#include <zephyr/ztest.h>
+
+static constexpr double DT = 0.00025;
+static constexpr double G = 9.80665;
+static const RigidBodyParams PARAMS = {
+    .mass_kg = 6.8,
+    .inertia_kg_m2 = {{0.12, 0.12, 0.05}},
+    .linear_drag_n_s_m = 0.0,
+    .angular_drag_n_m_s = 0.0,
+};
+
+ZTEST(RigidBodyModel_tests, test_rests_on_pad_without_thrust)
+{
+    RigidBodyModel body{PARAMS};
+    for (int i = 0; i < 4000; i++) {
+        body.step({}, {{0.3, -0.2, 0.1}}, DT);
+    }
+    zassert_true(body.on_pad());
+    zassert_within(body.position_ned()[2], 0.0, 1e-12);
+    zassert_within(body.attitude()[0], 1.0, 1e-12, "the pad should hold attitude");
+    zassert_within(body.specific_force_b()[2], -G, 1e-9, "an accelerometer at rest reads -g along body z");
+}
+
+ZTEST(RigidBodyModel_tests, test_climbs_and_falls_ballistically)
+{
+    RigidBodyModel body{PARAMS};
+    const double thrust = 2.0 * PARAMS.mass_kg * G;
+    for (int i = 0; i < 4000; i++) {
+        body.step({{0.0, 0.0, -thrust}}, {}, DT);
+    }
+
+    // 1 s at 1 g up
+    zassert_false(body.on_pad());
+    zassert_within(body.position_ned()[2], -0.5 * G, 0.01);
+    zassert_within(body.velocity_ned()[2], -G, 1e-6);
+    zassert_within(body.specific_force_b()[2], -2.0 * G, 1e-9);
+
+    // Free fall reads zero specific force, and the pad catches the body
+    body.step({}, {}, DT);
+    zassert_within(body.specific_force_b()[2], 0.0, 1e-9);
+    for (int i = 0; i < 20000 && !body.on_pad(); i++) {
+        body.step({}, {}, DT);
+    }
+    zassert_true(body.on_pad());
+    zassert_within(body.velocity_ned()[2], 0.0, 1e-12);
+}
+
+ZTEST(RigidBodyModel_tests, test_torque_spins_up_about_its_axis)
+{
+    RigidBodyModel body{PARAMS};
+    const double weight = PARAMS.mass_kg * G;
+    for (int i = 0; i < 4000; i++) {
+        body.step({{0.0, 0.0, -weight * 1.01}}, {{0.0, 0.0, 0.05}}, DT);
+    }
+    // 1 s at 0.05 / 0.05 rad/s^2 about z, a quarter-angle of 0.25 rad
+    zassert_within(body.angular_rate_b()[2], 1.0, 1e-3);
+    zassert_within(body.attitude()[3], std::sin(0.25), 1e-3);
+    zassert_within(body.rotation()(2, 2), 1.0, 1e-9, "yaw should not tilt the body");
+}
+
+ZTEST(RigidBodyModel_tests, test_hornet_hovers_near_trim_throttle)
+{
+    // Thrust curve inverse: total lbf at throttle t >= 0.63 is 27.321 t - 7.3123
+    const double hover_lbf = PARAMS.mass_kg * G / 4.44822;
+    const double throttle = (hover_lbf + 7.3123) / 27.321;
+    const auto pulse = static_cast<uint32_t>(std::lround(1000.0 + 1000.0 * throttle));
+
+    HornetPropulsionModel propulsion;
+    propulsion.reset();
+    const std::array<uint32_t, HornetPropulsionModel::NUM_CHANNELS> pulses = {1500, 1500, 1000, 1000, 1000, 1000, pulse, pulse};
+    HornetWrench wrench{};
+    for (int i = 0; i < 4000; i++) {
+        wrench = propulsion.step(pulses, DT);
+    }
+    zassert_within(-wrench.force_b[2], PARAMS.mass_kg * G, 0.05 * PARAMS.mass_kg * G);
+    zassert_within(wrench.torque_b[0], 0.0, 1e-9);
+    zassert_within(wrench.torque_b[1], 0.0, 1e-9);
+
+    // Tilting SERVO_X towards +x pitches about +y, and the clockwise roll props roll about +z
+    const std::array<uint32_t, HornetPropulsionModel::NUM_CHANNELS> tilted = {1600, 1500, 2000, 1000, 2000, 1000, pulse, pulse};
+    for (int i = 0; i < 4000; i++) {
+        wrench = propulsion.step(tilted, DT);
+    }
+    zassert_true(wrench.force_b[0] > 0.0 && wrench.torque_b[1] > 0.0);
+    zassert_true(wrench.torque_b[2] > 0.0);
+    zassert_true(std::abs(propulsion.gimbal_x_deg()) <= 12.0);
+}
+
+ZTEST_SUITE(RigidBodyModel_tests, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,97 @@
+#include "sim/SensorFrames.h"
+#include <cstring>
+#include <zephyr/ztest.h>
+
+ZTEST(SensorFrames_tests, test_tf_lidar_frame)
+{
+    uint8_t frame[SensorFrames::TF_LIDAR_FRAME_SIZE];
+    SensorFrames::encode_tf_lidar(frame, 3.21, 1000, 25.0);
+
+    zassert_equal(frame[0], 0x59);
+    zassert_equal(frame[1], 0x59);
+    zassert_equal(frame[2] | (frame[3] << 8), 321);
+    zassert_equal(frame[4] | (frame[5] << 8), 1000);
+    zassert_equal(frame[6] | (frame[7] << 8), (25 + 256) * 8);
+
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < SensorFrames::TF_LIDAR_FRAME_SIZE - 1; i++) {
+        checksum += frame[i];
+    }
+    zassert_equal(frame[8], checksum);
+}
+
+ZTEST(SensorFrames_tests, test_vn_binary_packet)
+{
+    const SensorFrames::VnBinarySample sample = {
+        .time_startup_ns = 123456789012ULL,
+        .quat = {0.1f, 0.2f, 0.3f, 0.9f},
+        .gyro = {0.01f, -0.02f, 0.03f},
+        .accel = {0.1f, 0.2f, -9.8f},
+        .mag = {0.2f, 0.0f, 0.4f},
+        .temperature_c = 25.0f,
+        .pressure_kpa = 101.3f,
+        .ins_status = 0x0102,
+    };
+    uint8_t packet[SensorFrames::VN_BINARY_PACKET_SIZE];
+    SensorFrames::encode_vn_binary(packet, sample);
+
+    // The header and offsets the IMU driver decodes
+    zassert_equal(packet[0], 0xFA);
+    zassert_equal(packet[1], 0x01);
+    zassert_equal(packet[2] | (packet[3] << 8), 0x1531);
+    uint64_t time;
+    memcpy(&time, packet + 4, sizeof(time));
+    zassert_equal(time, sample.time_startup_ns);
+    float f;
+    memcpy(&f, packet + 12 + 12, sizeof(f));
+    zassert_equal(f, 0.9f, "quaternion w");
+    memcpy(&f, packet + 40 + 8, sizeof(f));
+    zassert_equal(f, -9.8f, "accel z");
+    memcpy(&f, packet + 52, sizeof(f));
+    zassert_equal(f, 0.2f, "mag x");
+    zassert_equal(packet[72] | (packet[73] << 8), 0x0102);
+
+    zassert_equal(SensorFrames::vn_crc16(packet + 1, SensorFrames::VN_BINARY_PACKET_SIZE - 1), 0);
+    packet[30] ^= 0x01;
+    zassert_not_equal(SensorFrames::vn_crc16(packet + 1, SensorFrames::VN_BINARY_PACKET_SIZE - 1), 0);
+}
+
+ZTEST(SensorFrames_tests, test_greis_epoch)
+{
+    const SensorFrames::GnssEpoch epoch = {
+        .time_ms = 43200000,
+        .north_m = 1.5,
+        .east_m = -2.5,
+        .up_m = 10.25,
+        .velocity_m_s = {0.5f, -0.25f, 1.0f},
+        .pos_sigma_m = 0.02f,
+        .vel_sigma_m_s = 0.03f,
+        .sol_type = 4,
+    };
+    uint8_t frames[SensorFrames::GREIS_EPOCH_MAX_SIZE];
+    const size_t len = SensorFrames::encode_greis_epoch(frames, epoch);
+
+    // Walk the messages: ID, three hex digits of body length, body ending in its checksum, line feed
+    const char* expected_ids[] = {"ST", "mp", "VE", "SG", "~~"};
+    const int expected_lengths[] = {6, 45, 18, 18, 5};
+    size_t pos = 0;
+    for (int i = 0; i < 5; i++) {
+        zassert_mem_equal(frames + pos, expected_ids[i], 2);
+        char length[4] = {};
+        memcpy(length, frames + pos + 2, 3);
+        const int body_length = static_cast<int>(strtol(length, nullptr, 16));
+        zassert_equal(body_length, expected_lengths[i], "[%s] length", expected_ids[i]);
+
+        const uint8_t checksum = frames[pos + 5 + body_length - 1];
+        zassert_equal(SensorFrames::greis_checksum(frames + pos, 5 + body_length - 1), checksum, "[%s] checksum", expected_ids[i]);
+        zassert_equal(frames[pos + 5 + body_length], '\n');
+        pos += 5 + body_length + 1;
+    }
+    zassert_equal(pos, len);
+
+    double north;
+    memcpy(&north, frames + 12 + 5, sizeof(north));
+    zassert_equal(north, 1.5);
+}
+
+ZTEST_SUITE(SensorFrames_tests, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,45 @@
+/*
+ * Runs in the native simulator runner (host) context, not the embedded image, so it may use host libc directly.
+ */
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+int replay_host_open_read(const char* path)
+{
+    return open(path, O_RDONLY);
+}
+
+int replay_host_open_write(const char* path)
+{
+    return open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+long replay_host_read(int fd, void* buf, unsigned long len)
+{
+    return (long)read(fd, buf, len);
+}
+
+long replay_host_write(int fd, const void* buf, unsigned long len)
+{
+    const char* p = (const char*)buf;
+    unsigned long written = 0;
+    while (written < len) {
+        ssize_t n = write(fd, p + written, len - written);
+        if (n <= 0) {
+            return -1;
+        }
+        written += (unsigned long)n;
+    }
+    return (long)written;
+}
+
+void replay_host_close(int fd)
+{
+    close(fd);
+}
+
+const char* replay_host_getenv(const char* name)
+{
+    return getenv(name);
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+// Host file access, implemented in replay_host_io.c inside the native simulator runner. Returns follow POSIX: a file
+// descriptor or byte count, negative on error.
+extern "C" {
+int replay_host_open_read(const char* path);
+int replay_host_open_write(const char* path);
+long replay_host_read(int fd, void* buf, unsigned long len);
+long replay_host_write(int fd, const void* buf, unsigned long len);
+void replay_host_close(int fd);
+const char* replay_host_getenv(const char* name);
+}
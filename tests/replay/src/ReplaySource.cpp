@@ -0,0 +1,250 @@
+#include "ReplaySource.h"
+#include "replay_host_io.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <pb_decode.h>
+
+namespace {
+
+struct CsvField {
+    const char* sensor;
+    void (*apply)(DataPacket& packet, float value);
+};
+
+#define ANALOG_FIELD(name) \
+    CsvField{#name, [](DataPacket& p, float v) { p.analog_sensors.has_##name = true; p.analog_sensors.name = v; }}
+
+// Sensor names written by _packet_to_row() in scripts/client-new.py, including the ones it currently has commented out.
+constexpr CsvField CSV_FIELDS[] = {
+    {"sequence_number", [](DataPacket& p, float v) { p.sequence_number = static_cast<uint64_t>(v); }},
+    {"trace_time_msec", [](DataPacket& p, float v) { p.has_trace_time_msec = true; p.trace_time_msec = v; }},
+
+    ANALOG_FIELD(pt001),
+    ANALOG_FIELD(pt002),
+    ANALOG_FIELD(pt003),
+    ANALOG_FIELD(pt004),
+    ANALOG_FIELD(pt005),
+    ANALOG_FIELD(pt006),
+    ANALOG_FIELD(pt103),
+    ANALOG_FIELD(pt203),
+    ANALOG_FIELD(pt301),
+    ANALOG_FIELD(ptf401),
+    ANALOG_FIELD(pto401),
+    ANALOG_FIELD(ptc401),
+    ANALOG_FIELD(ptc402),
+    ANALOG_FIELD(tc002),
+    ANALOG_FIELD(tc102),
+    ANALOG_FIELD(tc102_5),
+    ANALOG_FIELD(tcf401),
+    ANALOG_FIELD(tco401),
+    ANALOG_FIELD(ptg001),
+    ANALOG_FIELD(ptg002),
+    ANALOG_FIELD(ptg101),
+    ANALOG_FIELD(battery_voltage),
+
+    {"throttle_thrust_command_lbf", [](DataPacket& p, float v) { p.has_throttle_thrust_command_lbf = true; p.throttle_thrust_command_lbf = v; }},
+    {"predicted_thrust", [](DataPacket& p, float v) { p.has_ranger_throttle_metrics = true; p.ranger_throttle_metrics.predicted_thrust_lbf = v; }},
+    {"thrust_from_alpha", [](DataPacket& p, float v) { p.has_ranger_throttle_metrics = true; p.ranger_throttle_metrics.thrust_from_alpha_lbf = v; }},
+    {"predicted_of", [](DataPacket& p, float v) { p.has_ranger_throttle_metrics = true; p.ranger_throttle_metrics.predicted_of = v; }},
+    {"mdot_fuel", [](DataPacket& p, float v) { p.has_ranger_throttle_metrics = true; p.ranger_throttle_metrics.mdot_fuel = v; }},
+    {"mdot_lox", [](DataPacket& p, float v) { p.has_ranger_throttle_metrics = true; p.ranger_throttle_metrics.mdot_lox = v; }},
+    {"change_alpha_cmd", [](DataPacket& p, float v) { p.has_ranger_throttle_metrics = true; p.ranger_throttle_metrics.change_alpha_cmd = v; }},
+    {"clamped_change_alpha_cmd", [](DataPacket& p, float v) { p.has_ranger_throttle_metrics = true; p.ranger_throttle_metrics.clamped_change_alpha_cmd = v; }},
+    {"alpha", [](DataPacket& p, float v) { p.has_ranger_throttle_metrics = true; p.ranger_throttle_metrics.alpha = v; }},
+
+    {"gnc_fuel_enable", [](DataPacket& p, float v) { p.has_fuel_valve_command = true; p.fuel_valve_command.enable = v != 0.0f; }},
+    {"gnc_fuel_target_deg", [](DataPacket& p, float v) { p.has_fuel_valve_command = true; p.fuel_valve_command.target_deg = v; }},
+    {"gnc_lox_enable", [](DataPacket& p, float v) { p.has_lox_valve_command = true; p.lox_valve_command.enable = v != 0.0f; }},
+    {"gnc_lox_target_deg", [](DataPacket& p, float v) { p.has_lox_valve_command = true; p.lox_valve_command.target_deg = v; }},
+    {"fuel_encoder_pos_deg", [](DataPacket& p, float v) { p.has_fuel_valve_status = true; p.fuel_valve_status.encoder_pos_deg = v; }},
+    {"fuel_is_on", [](DataPacket& p, float v) { p.has_fuel_valve_status = true; p.fuel_valve_status.is_on = v != 0.0f; }},
+    {"lox_encoder_pos_deg", [](DataPacket& p, float v) { p.has_lox_valve_status = true; p.lox_valve_status.encoder_pos_deg = v; }},
+    {"lox_is_on", [](DataPacket& p, float v) { p.has_lox_valve_status = true; p.lox_valve_status.is_on = v != 0.0f; }},
+
+    {"est_pos_x_m", [](DataPacket& p, float v) { p.has_estimated_state = true; p.estimated_state.position.x = v; }},
+    {"est_pos_y_m", [](DataPacket& p, float v) { p.has_estimated_state = true; p.estimated_state.position.y = v; }},
+    {"est_pos_z_m", [](DataPacket& p, float v) { p.has_estimated_state = true; p.estimated_state.position.z = v; }},
+    {"est_vel_x_m_s", [](DataPacket& p, float v) { p.has_estimated_state = true; p.estimated_state.velocity.x = v; }},
+    {"est_vel_y_m_s", [](DataPacket& p, float v) { p.has_estimated_state = true; p.estimated_state.velocity.y = v; }},
+    {"est_vel_z_m_s", [](DataPacket& p, float v) { p.has_estimated_state = true; p.estimated_state.velocity.z = v; }},
+    {"flight_x_command_m", [](DataPacket& p, float v) { p.has_flight_x_command_m = true; p.flight_x_command_m = v; }},
+    {"flight_y_command_m", [](DataPacket& p, float v) { p.has_flight_y_command_m = true; p.flight_y_command_m = v; }},
+    {"flight_z_command_m", [](DataPacket& p, float v) { p.has_flight_z_command_m = true; p.flight_z_command_m = v; }},
+    {"flight_pitch_accel_rad_s2", [](DataPacket& p, float v) { p.has_flight_pitch_accel_rad_s2 = true; p.flight_pitch_accel_rad_s2 = v; }},
+    {"flight_yaw_accel_rad_s2", [](DataPacket& p, float v) { p.has_flight_yaw_accel_rad_s2 = true; p.flight_yaw_accel_rad_s2 = v; }},
+    {"flight_z_accel_m_s2", [](DataPacket& p, float v) { p.has_flight_z_accel_m_s2 = true; p.flight_z_accel_m_s2 = v; }},
+};
+
+#undef ANALOG_FIELD
+
+bool ends_with(const char* s, const char* suffix)
+{
+    const size_t s_len = std::strlen(s);
+    const size_t suffix_len = std::strlen(suffix);
+    return s_len >= suffix_len && std::strcmp(s + s_len - suffix_len, suffix) == 0;
+}
+
+}  // namespace
+
+ReplaySource::~ReplaySource()
+{
+    if (fd_ >= 0) {
+        replay_host_close(fd_);
+    }
+}
+
+std::expected<void, Error> ReplaySource::open(const char* path)
+{
+    fd_ = replay_host_open_read(path);
+    if (fd_ < 0) {
+        return std::unexpected(Error::from_cause("failed to open recording %s", path));
+    }
+    format_ = ends_with(path, ".csv") ? Format::CSV : Format::PACKETS;
+    return {};
+}
+
+std::expected<bool, Error> ReplaySource::next(DataPacket& packet)
+{
+    packet = DataPacket_init_default;
+    return format_ == Format::CSV ? next_csv(packet) : next_packet(packet);
+}
+
+/// Refill the buffer once it has been consumed. Returns false at the end of the file.
+bool ReplaySource::fill()
+{
+    if (begin_ < end_) {
+        return true;
+    }
+    const long n = replay_host_read(fd_, buffer_, sizeof(buffer_));
+    begin_ = 0;
+    end_ = n > 0 ? static_cast<size_t>(n) : 0;
+    return end_ > 0;
+}
+
+bool ReplaySource::read(uint8_t* buf, size_t count)
+{
+    while (count > 0) {
+        if (!fill()) {
+            return false;
+        }
+        const size_t n = std::min(count, end_ - begin_);
+        if (buf != nullptr) {
+            std::memcpy(buf, buffer_ + begin_, n);
+            buf += n;
+        }
+        begin_ += n;
+        count -= n;
+    }
+    return true;
+}
+
+/// Read one line without its line ending, truncated to fit. Returns false at the end of the file.
+bool ReplaySource::read_line(char* line, size_t size)
+{
+    size_t len = 0;
+    bool any = false;
+    while (fill()) {
+        any = true;
+        const char c = static_cast<char>(buffer_[begin_++]);
+        if (c == '\n') {
+            break;
+        }
+        if (c != '\r' && len + 1 < size) {
+            line[len++] = c;
+        }
+    }
+    line[len] = '\0';
+    line_number_++;
+    return any;
+}
+
+bool ReplaySource::pb_read_callback(pb_istream_t* stream, uint8_t* buf, size_t count)
+{
+    return static_cast<ReplaySource*>(stream->state)->read(buf, count);
+}
+
+std::expected<bool, Error> ReplaySource::next_packet(DataPacket& packet)
+{
+    if (!fill()) {
+        return false;
+    }
+
+    pb_istream_t stream = {.callback = pb_read_callback, .state = this, .bytes_left = SIZE_MAX};
+    if (!pb_decode_ex(&stream, DataPacket_fields, &packet, PB_DECODE_DELIMITED)) {
+        return std::unexpected(Error::from_cause("failed to decode packet %u: %s", packets_read_, PB_GET_ERROR(&stream)));
+    }
+    packets_read_++;
+    return true;
+}
+
+/// Read the next data row, skipping the header and blank lines. Returns false at the end of the file.
+std::expected<bool, Error> ReplaySource::read_csv_row(CsvRow& row)
+{
+    char line[256];
+    while (read_line(line, sizeof(line))) {
+        if (line[0] == '\0' || std::strncmp(line, "time,", 5) == 0) {
+            continue;
+        }
+
+        // time,sensor,value,event,system,source
+        char* end = nullptr;
+        row.time_ns = std::strtoull(line, &end, 10);
+        if (*end != ',') {
+            return std::unexpected(Error::from_cause("bad time on CSV line %u", line_number_));
+        }
+        const char* sensor = end + 1;
+        const char* comma = std::strchr(sensor, ',');
+        if (comma == nullptr || static_cast<size_t>(comma - sensor) >= sizeof(row.sensor)) {
+            return std::unexpected(Error::from_cause("bad sensor on CSV line %u", line_number_));
+        }
+        std::memcpy(row.sensor, sensor, comma - sensor);
+        row.sensor[comma - sensor] = '\0';
+        row.value = std::strtof(comma + 1, &end);
+        if (end == comma + 1) {
+            return std::unexpected(Error::from_cause("bad value on CSV line %u", line_number_));
+        }
+        return true;
+    }
+    return false;
+}
+
+std::expected<bool, Error> ReplaySource::next_csv(DataPacket& packet)
+{
+    CsvRow row;
+    if (has_pending_row_) {
+        row = pending_row_;
+        has_pending_row_ = false;
+    }
+    else {
+        auto read = read_csv_row(row);
+        if (!read.has_value() || !*read) {
+            return read;
+        }
+    }
+
+    packet.time_ns = row.time_ns;
+    while (true) {
+        for (const CsvField& field : CSV_FIELDS) {
+            if (std::strcmp(field.sensor, row.sensor) == 0) {
+                field.apply(packet, row.value);
+                break;
+            }
+        }
+
+        auto read = read_csv_row(row);
+        if (!read.has_value()) {
+            return std::unexpected(read.error());
+        }
+        if (!*read) {
+            break;
+        }
+        if (row.time_ns != packet.time_ns) {
+            pending_row_ = row;
+            has_pending_row_ = true;
+            break;
+        }
+    }
+    packets_read_++;
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Error.h"
+#include "clover.pb.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+/// Reads a telemetry recording one DataPacket at a time, from either format client-new.py records:
+///   *.csv  unpivoted rows of time, sensor, value, ... Consecutive rows with the same time make one packet, and only
+///          the fields client-new.py writes to the CSV are filled in.
+///   *      length-delimited DataPackets, exactly as received, so every field is there.
+class ReplaySource {
+public:
+    enum class Format { PACKETS, CSV };
+
+    ReplaySource() = default;
+    ~ReplaySource();
+    ReplaySource(const ReplaySource&) = delete;
+    ReplaySource& operator=(const ReplaySource&) = delete;
+
+    std::expected<void, Error> open(const char* path);
+
+    /// Read the next packet into packet. Returns false at the end of the recording.
+    std::expected<bool, Error> next(DataPacket& packet);
+
+    Format format() const { return format_; }
+
+private:
+    struct CsvRow {
+        uint64_t time_ns;
+        char sensor[48];
+        float value;
+    };
+
+    static bool pb_read_callback(pb_istream_t* stream, uint8_t* buf, size_t count);
+
+    bool fill();
+    bool read(uint8_t* buf, size_t count);
+    bool read_line(char* line, size_t size);
+    std::expected<bool, Error> read_csv_row(CsvRow& row);
+
+    std::expected<bool, Error> next_packet(DataPacket& packet);
+    std::expected<bool, Error> next_csv(DataPacket& packet);
+
+    int fd_ = -1;
+    Format format_ = Format::PACKETS;
+    uint32_t packets_read_ = 0;
+
+    uint8_t buffer_[4096];
+    size_t begin_ = 0;
+    size_t end_ = 0;
+
+    uint32_t line_number_ = 0;
+    CsvRow pending_row_ = {};  // First row of the next packet, read while finding the end of the current one
+    bool has_pending_row_ = false;
+};
@@ -0,0 +1,550 @@
+// Replays recorded telemetry through the controller modules and compares their outputs against the recording.
+//
+// Point REPLAY_INPUT at a recording from scripts/client-new.py, either its raw_packets_*.pb or raw_sensors_*.csv, and
+// run the native_sim build:
+//
+//   west build -b native_sim tests/replay
+//   REPLAY_INPUT=data/raw_packets_20250101_120000.pb build/zephyr/zephyr.exe
+//
+// REPLAY_DIFF_OUTPUT optionally names a CSV to write every compared pair of values to, for plotting. Without
+// REPLAY_INPUT that test is skipped. A synthetic hot fire (SyntheticRecording.h) is always recorded in both formats and
+// replayed, so the readers and the throttle path are covered without a recording from the stand.
+//
+// Each packet drives the modules the controller ran on that tick: a throttle thrust command runs RangerThrottle, flight
+// position commands run the FlightController loops, and an IMU reading runs StateEstimator. Rate groups follow the
+// recorded schedule and dt when the packets carry controller timing, and config.h otherwise. The simulated clock is
+// slept to each packet's time so the estimator sees recorded sample ages, and without real-time slowdown those sleeps
+// return at once, so a hot fire replays in seconds. Every call is timed on the host clock, next to the on-target time
+// the recording reports. Throttle tracking, valve travel and how noisy the thrust prediction is are summarized for the
+// recorded and replayed sides alike, to weigh a throttle control change on the same hot fire.
+//
+// The flight controller is fed the recorded estimate, so its diffs come from controller changes only. The estimator runs
+// once per packet on the IMU reading the packet carries, where the vehicle runs it per IMU sample in its own thread,
+// so its tolerances are looser.
+#include "Controller.h"
+#include "ReplaySource.h"
+#include "SyntheticRecording.h"
+#include "bench.h"
+#include "config.h"
+#include "flight/FlightController.h"
+#include "flight/StateEstimator.h"
+#include "ranger/RangerThrottle.h"
+#include "replay_host_io.h"
+#include <cmath>
+#include <cstdio>
+#include <optional>
+#include <tuple>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+namespace {
+
+/// One replayed output compared against its recorded value.
+struct Channel {
+    const char* name;
+    float tolerance;
+
+    uint32_t count = 0;
+    uint32_t over_tolerance = 0;
+    float max_error = 0.0f;
+    uint64_t max_error_time_ns = 0;
+    double sum_squared_error = 0.0;
+};
+
+enum ChannelIndex {
+    THROTTLE_PREDICTED_THRUST,
+    THROTTLE_ALPHA,
+    THROTTLE_MDOT_FUEL,
+    THROTTLE_MDOT_LOX,
+    THROTTLE_FUEL_TARGET,
+    THROTTLE_LOX_TARGET,
+    FLIGHT_PITCH_ACCEL,
+    FLIGHT_YAW_ACCEL,
+    FLIGHT_Z_ACCEL,
+    ESTIMATE_POS_X,
+    ESTIMATE_POS_Y,
+    ESTIMATE_POS_Z,
+    ESTIMATE_VEL_X,
+    ESTIMATE_VEL_Y,
+    ESTIMATE_VEL_Z,
+    NUM_CHANNELS,
+};
+
+Channel channels[NUM_CHANNELS] = {
+    {"throttle predicted_thrust_lbf", 0.5f},
+    {"throttle alpha", 1e-3f},
+    {"throttle mdot_fuel", 1e-3f},
+    {"throttle mdot_lox", 1e-3f},
+    {"throttle fuel_target_deg", 0.05f},
+    {"throttle lox_target_deg", 0.05f},
+    {"flight pitch_accel_rad_s2", 1e-2f},
+    {"flight yaw_accel_rad_s2", 1e-2f},
+    {"flight z_accel_m_s2", 1e-2f},
+    {"estimate position.x", 0.1f},
+    {"estimate position.y", 0.1f},
+    {"estimate position.z", 0.1f},
+    {"estimate velocity.x", 0.1f},
+    {"estimate velocity.y", 0.1f},
+    {"estimate velocity.z", 0.1f},
+};
+
+/// Execution time of one module: replayed on the host, and on the target as the recording reports it.
+struct ModuleTiming {
+    const char* name;
+    BenchStats host = {};
+    BenchStats recorded = {};
+    uint32_t errors = 0;
+};
+
+/// How one side of the replay, recorded or replayed, tracked the thrust command: the error against its own predicted
+/// thrust, how much that prediction moved tick to tick, and how far the valve targets travelled. Reported, not checked,
+/// to compare throttle control changes on the same recording. The loop is open, so the replayed prediction still
+/// follows the recorded engine.
+struct ThrottleTracking {
+    const char* name;
+
+    uint32_t count = 0;
+    double sum_squared_error_lbf = 0.0;
+    double sum_squared_prediction_change_lbf = 0.0;
+    double valve_travel_deg = 0.0;
+    float prev_predicted_lbf = 0.0f;
+    float prev_fuel_target_deg = 0.0f;
+    float prev_lox_target_deg = 0.0f;
+
+    void add(float command_lbf, float predicted_lbf, float fuel_target_deg, float lox_target_deg)
+    {
+        const float error_lbf = command_lbf - predicted_lbf;
+        sum_squared_error_lbf += static_cast<double>(error_lbf) * error_lbf;
+        if (count > 0) {
+            const float change_lbf = predicted_lbf - prev_predicted_lbf;
+            sum_squared_prediction_change_lbf += static_cast<double>(change_lbf) * change_lbf;
+            valve_travel_deg += std::fabs(fuel_target_deg - prev_fuel_target_deg) + std::fabs(lox_target_deg - prev_lox_target_deg);
+        }
+        count++;
+        prev_predicted_lbf = predicted_lbf;
+        prev_fuel_target_deg = fuel_target_deg;
+        prev_lox_target_deg = lox_target_deg;
+    }
+};
+
+ThrottleTracking recorded_tracking{.name = "recorded"};
+ThrottleTracking replayed_tracking{.name = "replayed"};
+
+ModuleTiming throttle_timing{.name = "RangerThrottle::tick"};
+ModuleTiming flight_outer_timing{.name = "FlightController::tick_outer"};
+ModuleTiming flight_inner_timing{.name = "FlightController::tick_inner"};
+ModuleTiming estimator_timing{.name = "StateEstimator::estimate"};
+
+int diff_fd = -1;
+
+// Written to the working directory by the suite setup
+constexpr char SYNTHETIC_PACKETS_PATH[] = "replay_synthetic_hot_fire.pb";
+constexpr char SYNTHETIC_CSV_PATH[] = "replay_synthetic_hot_fire.csv";
+
+void compare(ChannelIndex index, uint64_t time_ns, float recorded, float replayed)
+{
+    Channel& channel = channels[index];
+    const float error = std::fabs(replayed - recorded);
+    channel.count++;
+    channel.sum_squared_error += static_cast<double>(error) * error;
+    if (error > channel.max_error) {
+        channel.max_error = error;
+        channel.max_error_time_ns = time_ns;
+    }
+    if (!(error <= channel.tolerance)) {
+        channel.over_tolerance++;
+    }
+
+    if (diff_fd >= 0) {
+        char line[128];
+        int len = std::snprintf(line, sizeof(line), "%llu,%s,%.9g,%.9g\n", static_cast<unsigned long long>(time_ns),
+            channel.name, static_cast<double>(recorded), static_cast<double>(replayed));
+        replay_host_write(diff_fd, line, static_cast<unsigned long>(len));
+    }
+}
+
+/// Replay state of one rate group. Runs when the recording says the group ran, or on the controller's own schedule
+/// for recordings without controller timing.
+struct ReplayGroup {
+    RateGroup group;
+    ModuleTiming& timing;
+
+    bool due(uint64_t tick, bool held, bool has_recorded, const RateGroupTiming& recorded) const
+    {
+        return has_recorded ? recorded.ran : !held || group.due(tick);
+    }
+
+    /// dt for a run at time_ns: the recorded one when there is one, else measured between packets like the controller.
+    float begin(uint64_t time_ns, bool has_recorded, const RateGroupTiming& recorded)
+    {
+        const float dt_s = group.begin(time_ns);
+        return has_recorded ? recorded.dt_s : dt_s;
+    }
+
+    template <typename F> auto run(bool has_recorded, const RateGroupTiming& recorded, F&& f)
+    {
+        const uint64_t start_ns = bench_host_monotonic_ns();
+        auto output = f();
+        timing.host.add(bench_host_monotonic_ns() - start_ns);
+        if (has_recorded) {
+            timing.recorded.add(static_cast<uint64_t>(recorded.exec_time_ns));
+        }
+        if (!output.has_value()) {
+            timing.errors++;
+            if (timing.errors == 1) {
+                TC_PRINT("[replay] %s failed: %s\n", timing.name, output.error().build_message().c_str());
+            }
+        }
+        return output;
+    }
+};
+
+class Replay {
+public:
+    /// Feed one recorded packet through the modules it would have run.
+    void step(DataPacket& packet)
+    {
+        advance_clock(packet.time_ns);
+
+        const bool throttle_active = packet.has_throttle_thrust_command_lbf;
+        const bool flight_active = packet.has_flight_x_command_m && packet.has_flight_y_command_m
+                                   && packet.has_flight_z_command_m && packet.has_estimated_state;
+        if ((throttle_active || flight_active) && !active_) {
+            start_active_control(throttle_active, flight_active);
+        }
+        active_ = throttle_active || flight_active;
+
+        if (packet.has_imu) {
+            step_estimator(packet);
+        }
+        // Flight runs ahead of the throttle, scheduling its gains on the previous throttle output, as in the controller.
+        if (flight_active) {
+            step_flight(packet);
+        }
+        if (throttle_active) {
+            step_throttle(packet);
+        }
+
+        if (active_) {
+            active_tick_++;
+        }
+    }
+
+    uint64_t first_time_ns() const { return first_time_ns_; }
+    uint64_t last_time_ns() const { return last_time_ns_; }
+
+private:
+    /// Sleep the simulated clock to the packet's time. Recordings taken sooner after boot than this image has been
+    /// running are shifted later, along with their sensor capture times.
+    void advance_clock(uint64_t time_ns)
+    {
+        if (!started_) {
+            const uint64_t now_ns = k_cyc_to_ns_floor64(k_cycle_get_64());
+            clock_offset_ns_ = now_ns > time_ns ? now_ns - time_ns : 0;
+            first_time_ns_ = time_ns;
+            started_ = true;
+        }
+        last_time_ns_ = time_ns;
+        k_sleep(K_TIMEOUT_ABS_NS(time_ns + clock_offset_ns_));
+    }
+
+    void start_active_control(bool throttle_active, bool flight_active)
+    {
+        active_tick_ = 0;
+        flight_outer_.group = RateGroup{FLIGHT_OUTER_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK};
+        flight_inner_.group = RateGroup{FLIGHT_INNER_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK};
+        throttle_.group = RateGroup{THROTTLE_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK};
+        desired_state_.reset();
+        flight_output_.reset();
+        throttle_output_.reset();
+
+        if (throttle_active) {
+            RangerThrottle::reset();
+        }
+        if (flight_active) {
+            FlightController::reset();
+        }
+    }
+
+    void step_estimator(DataPacket& packet)
+    {
+        // Absent sensors read as never sampled, like the controller's defaults.
+        LidarReading lidar_1 = LidarReading_init_default;
+        LidarReading lidar_2 = LidarReading_init_default;
+        GnssReadings gnss = GnssReadings_init_default;
+        if (packet.has_lidar_1) {
+            lidar_1 = packet.lidar_1;
+        }
+        if (packet.has_lidar_2) {
+            lidar_2 = packet.lidar_2;
+        }
+        if (packet.has_gnss) {
+            gnss = packet.gnss;
+        }
+        ImuReading imu = packet.imu;
+        lidar_1.capture_time_ns += clock_offset_ns_;
+        lidar_2.capture_time_ns += clock_offset_ns_;
+        gnss.capture_time_ns += clock_offset_ns_;
+        imu.capture_time_ns += clock_offset_ns_;
+
+        const uint64_t start_ns = bench_host_monotonic_ns();
+        std::optional<EstimatedState> estimate = StateEstimator::estimate(lidar_1, lidar_2, imu, gnss);
+        estimator_timing.host.add(bench_host_monotonic_ns() - start_ns);
+        if (packet.controller_timing.state_estimator_update_time_ns > 0.0f) {
+            estimator_timing.recorded.add(static_cast<uint64_t>(packet.controller_timing.state_estimator_update_time_ns));
+        }
+
+        if (estimate.has_value() && packet.has_estimated_state) {
+            const EstimatedState& recorded = packet.estimated_state;
+            compare(ESTIMATE_POS_X, packet.time_ns, recorded.position.x, estimate->position.x);
+            compare(ESTIMATE_POS_Y, packet.time_ns, recorded.position.y, estimate->position.y);
+            compare(ESTIMATE_POS_Z, packet.time_ns, recorded.position.z, estimate->position.z);
+            compare(ESTIMATE_VEL_X, packet.time_ns, recorded.velocity.x, estimate->velocity.x);
+            compare(ESTIMATE_VEL_Y, packet.time_ns, recorded.velocity.y, estimate->velocity.y);
+            compare(ESTIMATE_VEL_Z, packet.time_ns, recorded.velocity.z, estimate->velocity.z);
+        }
+    }
+
+    void step_flight(DataPacket& packet)
+    {
+        const ControllerTiming& timing = packet.controller_timing;
+
+        if (flight_outer_.due(active_tick_, desired_state_.has_value(), timing.has_flight_outer, timing.flight_outer)) {
+            const float dt_s = flight_outer_.begin(packet.time_ns, timing.has_flight_outer, timing.flight_outer);
+            const float thrust_N = throttle_output_.has_value() ? std::get<2>(*throttle_output_).predicted_thrust_lbf / N_TO_LBF : 0.0f;
+            auto output = flight_outer_.run(timing.has_flight_outer, timing.flight_outer, [&] {
+                return FlightController::tick_outer(packet.estimated_state, packet.flight_x_command_m,
+                    packet.flight_y_command_m, packet.flight_z_command_m, thrust_N, dt_s);
+            });
+            if (output.has_value()) {
+                desired_state_ = *output;
+            }
+        }
+        if (!desired_state_.has_value()) {
+            return;
+        }
+
+        if (flight_inner_.due(active_tick_, flight_output_.has_value(), timing.has_flight_inner, timing.flight_inner)) {
+            const float dt_s = flight_inner_.begin(packet.time_ns, timing.has_flight_inner, timing.flight_inner);
+            auto output = flight_inner_.run(timing.has_flight_inner, timing.flight_inner,
+                [&] { return FlightController::tick_inner(packet.estimated_state, *desired_state_, dt_s); });
+            if (output.has_value()) {
+                flight_output_ = *output;
+            }
+        }
+        if (!flight_output_.has_value()) {
+            return;
+        }
+
+        const auto& [pitch_accel, yaw_accel, z_accel, metrics] = *flight_output_;
+        if (packet.has_flight_pitch_accel_rad_s2) {
+            compare(FLIGHT_PITCH_ACCEL, packet.time_ns, packet.flight_pitch_accel_rad_s2, pitch_accel);
+        }
+        if (packet.has_flight_yaw_accel_rad_s2) {
+            compare(FLIGHT_YAW_ACCEL, packet.time_ns, packet.flight_yaw_accel_rad_s2, yaw_accel);
+        }
+        if (packet.has_flight_z_accel_m_s2) {
+            compare(FLIGHT_Z_ACCEL, packet.time_ns, packet.flight_z_accel_m_s2, z_accel);
+        }
+    }
+
+    void step_throttle(DataPacket& packet)
+    {
+        const ControllerTiming& timing = packet.controller_timing;
+
+        if (throttle_.due(active_tick_, throttle_output_.has_value(), timing.has_throttle, timing.throttle)) {
+            throttle_.begin(packet.time_ns, timing.has_throttle, timing.throttle);
+            auto output = throttle_.run(timing.has_throttle, timing.throttle,
+                [&] { return RangerThrottle::tick(packet.analog_sensors, packet.throttle_thrust_command_lbf); });
+            if (output.has_value()) {
+                throttle_output_ = *output;
+            }
+        }
+        if (!throttle_output_.has_value()) {
+            return;
+        }
+
+        const auto& [fuel_command, lox_command, metrics] = *throttle_output_;
+        if (packet.has_ranger_throttle_metrics) {
+            const RangerThrottleMetrics& recorded = packet.ranger_throttle_metrics;
+            compare(THROTTLE_PREDICTED_THRUST, packet.time_ns, recorded.predicted_thrust_lbf, metrics.predicted_thrust_lbf);
+            compare(THROTTLE_ALPHA, packet.time_ns, recorded.alpha, metrics.alpha);
+            compare(THROTTLE_MDOT_FUEL, packet.time_ns, recorded.mdot_fuel, metrics.mdot_fuel);
+            compare(THROTTLE_MDOT_LOX, packet.time_ns, recorded.mdot_lox, metrics.mdot_lox);
+        }
+        if (packet.has_fuel_valve_command) {
+            compare(THROTTLE_FUEL_TARGET, packet.time_ns, packet.fuel_valve_command.target_deg, fuel_command.target_deg);
+        }
+        if (packet.has_lox_valve_command) {
+            compare(THROTTLE_LOX_TARGET, packet.time_ns, packet.lox_valve_command.target_deg, lox_command.target_deg);
+        }
+        if (packet.has_ranger_throttle_metrics && packet.has_fuel_valve_command && packet.has_lox_valve_command) {
+            const float command_lbf = packet.throttle_thrust_command_lbf;
+            recorded_tracking.add(command_lbf, packet.ranger_throttle_metrics.predicted_thrust_lbf,
+                packet.fuel_valve_command.target_deg, packet.lox_valve_command.target_deg);
+            replayed_tracking.add(command_lbf, metrics.predicted_thrust_lbf, fuel_command.target_deg, lox_command.target_deg);
+        }
+    }
+
+    bool started_ = false;
+    uint64_t clock_offset_ns_ = 0;
+    uint64_t first_time_ns_ = 0;
+    uint64_t last_time_ns_ = 0;
+
+    bool active_ = false;
+    uint64_t active_tick_ = 0;
+    ReplayGroup flight_outer_{RateGroup{FLIGHT_OUTER_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK}, flight_outer_timing};
+    ReplayGroup flight_inner_{RateGroup{FLIGHT_INNER_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK}, flight_inner_timing};
+    ReplayGroup throttle_{RateGroup{THROTTLE_RATE_GROUP, Controller::NSEC_PER_CONTROL_TICK}, throttle_timing};
+    std::optional<FlightControllerDesiredState> desired_state_;
+    std::optional<std::tuple<float, float, float, FlightControllerMetrics>> flight_output_;
+    std::optional<std::tuple<ThrottleValveCommand, ThrottleValveCommand, RangerThrottleMetrics>> throttle_output_;
+};
+
+void print_timing(const ModuleTiming& timing)
+{
+    if (timing.host.count == 0) {
+        return;
+    }
+    TC_PRINT("[replay] %-30s %7llu calls  host mean %8.1f ns  max %8llu ns", timing.name,
+        static_cast<unsigned long long>(timing.host.count), timing.host.mean_ns(),
+        static_cast<unsigned long long>(timing.host.max_ns));
+    if (timing.recorded.count > 0) {
+        TC_PRINT("  target mean %8.1f ns  max %8llu ns", timing.recorded.mean_ns(),
+            static_cast<unsigned long long>(timing.recorded.max_ns));
+    }
+    TC_PRINT("\n");
+}
+
+void print_channel(const Channel& channel)
+{
+    if (channel.count == 0) {
+        return;
+    }
+    TC_PRINT("[replay] %-30s %7u samples  max err %10.4g at t=%.3f s  rms %10.4g  over tol %u\n", channel.name,
+        channel.count, static_cast<double>(channel.max_error), static_cast<double>(channel.max_error_time_ns) * 1e-9,
+        std::sqrt(channel.sum_squared_error / channel.count), channel.over_tolerance);
+}
+
+void print_tracking(const ThrottleTracking& tracking)
+{
+    if (tracking.count < 2) {
+        return;
+    }
+    TC_PRINT("[replay] throttle %-21s %7u samples  thrust err rms %8.3f lbf  prediction step rms %8.3f lbf  "
+             "valve travel %8.4f deg/sample\n",
+        tracking.name, tracking.count, std::sqrt(tracking.sum_squared_error_lbf / tracking.count),
+        std::sqrt(tracking.sum_squared_prediction_change_lbf / (tracking.count - 1)),
+        tracking.valve_travel_deg / (tracking.count - 1));
+}
+
+/// Reset the statistics of a previous replay, keeping names and tolerances.
+void reset_stats()
+{
+    for (Channel& channel : channels) {
+        channel = Channel{.name = channel.name, .tolerance = channel.tolerance};
+    }
+    for (ModuleTiming* timing : {&throttle_timing, &flight_outer_timing, &flight_inner_timing, &estimator_timing}) {
+        *timing = ModuleTiming{.name = timing->name};
+    }
+    recorded_tracking = ThrottleTracking{.name = recorded_tracking.name};
+    replayed_tracking = ThrottleTracking{.name = replayed_tracking.name};
+}
+
+/// Replay a recording, report it, and check every output stayed within tolerance.
+void replay_recording(const char* input)
+{
+    reset_stats();
+
+    static std::optional<ReplaySource> source;
+    source.emplace();
+    auto opened = source->open(input);
+    zassert_true(opened.has_value(), "%s", opened.has_value() ? "" : opened.error().build_message().c_str());
+
+    const char* diff_output = replay_host_getenv("REPLAY_DIFF_OUTPUT");
+    if (diff_output != nullptr && diff_output[0] != '\0') {
+        diff_fd = replay_host_open_write(diff_output);
+        zassert_true(diff_fd >= 0, "failed to open %s", diff_output);
+        constexpr char HEADER[] = "time_ns,channel,recorded,replayed\n";
+        replay_host_write(diff_fd, HEADER, sizeof(HEADER) - 1);
+    }
+
+    StateEstimator::reset();
+    static std::optional<Replay> replay;
+    replay.emplace();
+    static DataPacket packet;
+    uint32_t packets = 0;
+    const uint64_t start_ns = bench_host_monotonic_ns();
+    while (true) {
+        auto read = source->next(packet);
+        zassert_true(read.has_value(), "%s", read.has_value() ? "" : read.error().build_message().c_str());
+        if (!*read) {
+            break;
+        }
+        replay->step(packet);
+        packets++;
+    }
+    const uint64_t elapsed_ns = bench_host_monotonic_ns() - start_ns;
+
+    if (diff_fd >= 0) {
+        replay_host_close(diff_fd);
+        diff_fd = -1;
+    }
+
+    const double recorded_s = static_cast<double>(replay->last_time_ns() - replay->first_time_ns()) * 1e-9;
+    const double replay_s = static_cast<double>(elapsed_ns) * 1e-9;
+    TC_PRINT("[replay] %s: %u %s packets, %.1f s recorded, replayed in %.2f s (%.0fx real time)\n", input, packets,
+        source->format() == ReplaySource::Format::CSV ? "CSV" : "protobuf", recorded_s, replay_s,
+        replay_s > 0.0 ? recorded_s / replay_s : 0.0);
+    for (const ModuleTiming* timing : {&throttle_timing, &flight_outer_timing, &flight_inner_timing, &estimator_timing}) {
+        print_timing(*timing);
+    }
+    for (const Channel& channel : channels) {
+        print_channel(channel);
+    }
+    print_tracking(recorded_tracking);
+    print_tracking(replayed_tracking);
+
+    zassert_true(packets > 0, "recording %s has no packets", input);
+    for (const ModuleTiming* timing : {&throttle_timing, &flight_outer_timing, &flight_inner_timing, &estimator_timing}) {
+        zassert_equal(timing->errors, 0, "%s failed on %u calls", timing->name, timing->errors);
+    }
+    for (const Channel& channel : channels) {
+        zassert_equal(channel.over_tolerance, 0, "%s exceeded %g on %u of %u samples, worst %g at t=%.3f s", channel.name,
+            static_cast<double>(channel.tolerance), channel.over_tolerance, channel.count,
+            static_cast<double>(channel.max_error), static_cast<double>(channel.max_error_time_ns) * 1e-9);
+    }
+}
+
+void* write_synthetic_recording()
+{
+    auto written = write_synthetic_hot_fire(SYNTHETIC_PACKETS_PATH, SYNTHETIC_CSV_PATH);
+    zassert_true(written.has_value(), "%s", written.has_value() ? "" : written.error().build_message().c_str());
+    return nullptr;
+}
+
+}  // namespace
+
+ZTEST(Replay, test_replay_synthetic_packets)
+{
+    replay_recording(SYNTHETIC_PACKETS_PATH);
+    zassert_true(channels[THROTTLE_PREDICTED_THRUST].count > 0, "the synthetic hot fire should compare throttle outputs");
+    zassert_true(throttle_timing.recorded.count > 0, "the packet stream should carry the recorded throttle timing");
+}
+
+ZTEST(Replay, test_replay_synthetic_csv)
+{
+    replay_recording(SYNTHETIC_CSV_PATH);
+    zassert_true(channels[THROTTLE_PREDICTED_THRUST].count > 0, "the synthetic hot fire should compare throttle outputs");
+}
+
+ZTEST(Replay, test_replay_recording)
+{
+    const char* input = replay_host_getenv("REPLAY_INPUT");
+    if (input == nullptr || input[0] == '\0') {
+        ztest_test_skip();
+    }
+    replay_recording(input);
+}
+
+ZTEST_SUITE(Replay, NULL, write_synthetic_recording, NULL, NULL, NULL);
@@ -0,0 +1,231 @@
+#include "SyntheticRecording.h"
+#include "bench.h"
+#include "clover.pb.h"
+#include "ranger/RangerThrottle.h"
+#include "replay_host_io.h"
+#include "sim/RangerEngineModel.h"
+#include <algorithm>
+#include <cstdio>
+#include <pb_encode.h>
+#include <random>
+
+namespace {
+
+constexpr uint64_t START_TIME_NS = 10'000'000'000;  // Recordings start well after boot
+constexpr uint64_t TICK_NS = 1'000'000;
+constexpr int TICKS = 600;
+constexpr int STEP_TICK = 300;
+constexpr float COMMAND_BEFORE_STEP_LBF = 400.0f;
+constexpr float COMMAND_AFTER_STEP_LBF = 450.0f;
+constexpr float PT_NOISE_PSI = 1.5f;
+
+// The valves slew at 300 deg/s towards their targets, and the engine model steps ten times per control tick
+constexpr int SUBSTEPS = 10;
+constexpr double SUBSTEP_S = 1e-4;
+constexpr double MAX_VALVE_STEP_DEG = 300.0 * SUBSTEP_S;
+constexpr double START_VALVE_DEG = 60.0;
+
+/// A host file that closes itself.
+class HostFile {
+public:
+    explicit HostFile(const char* path) : fd_(replay_host_open_write(path)) {}
+    ~HostFile()
+    {
+        if (fd_ >= 0) {
+            replay_host_close(fd_);
+        }
+    }
+    HostFile(const HostFile&) = delete;
+    HostFile& operator=(const HostFile&) = delete;
+
+    bool is_open() const { return fd_ >= 0; }
+    bool write(const void* buf, size_t len) { return replay_host_write(fd_, buf, len) == static_cast<long>(len); }
+
+private:
+    int fd_;
+};
+
+/// Writes the unpivoted rows of client-new.py's _packet_to_csv_rows(), with csv.DictWriter's line endings.
+class CsvWriter {
+public:
+    explicit CsvWriter(HostFile& file) : file_(file) {}
+
+    bool header()
+    {
+        constexpr char HEADER[] = "time,sensor,value,event,system,source\r\n";
+        return file_.write(HEADER, sizeof(HEADER) - 1);
+    }
+
+    bool row(uint64_t time_ns, const char* sensor, float value)
+    {
+        char line[128];
+        const int len = std::snprintf(line, sizeof(line), "%llu,%s,%.9g,,atlas,gnc\r\n", static_cast<unsigned long long>(time_ns),
+            sensor, static_cast<double>(value));
+        return len > 0 && static_cast<size_t>(len) < sizeof(line) && file_.write(line, static_cast<size_t>(len));
+    }
+
+    bool optional_row(uint64_t time_ns, const char* sensor, bool has, float value) { return !has || row(time_ns, sensor, value); }
+
+private:
+    HostFile& file_;
+};
+
+/// The fields _packet_to_row() in scripts/client-new.py writes to the CSV.
+bool write_csv_rows(CsvWriter& csv, const DataPacket& packet)
+{
+    const uint64_t t = packet.time_ns;
+    const AnalogSensorReadings& analog = packet.analog_sensors;
+    bool ok = csv.row(t, "sequence_number", static_cast<float>(packet.sequence_number));
+    ok = ok && csv.optional_row(t, "pt004", analog.has_pt004, analog.pt004);
+    ok = ok && csv.optional_row(t, "pt005", analog.has_pt005, analog.pt005);
+    ok = ok && csv.optional_row(t, "pt006", analog.has_pt006, analog.pt006);
+    ok = ok && csv.optional_row(t, "pt103", analog.has_pt103, analog.pt103);
+    ok = ok && csv.optional_row(t, "pt203", analog.has_pt203, analog.pt203);
+    ok = ok && csv.optional_row(t, "ptf401", analog.has_ptf401, analog.ptf401);
+    ok = ok && csv.optional_row(t, "pto401", analog.has_pto401, analog.pto401);
+    ok = ok && csv.optional_row(t, "ptc401", analog.has_ptc401, analog.ptc401);
+    ok = ok && csv.optional_row(t, "ptc402", analog.has_ptc402, analog.ptc402);
+    if (packet.has_fuel_valve_command) {
+        ok = ok && csv.row(t, "gnc_fuel_enable", packet.fuel_valve_command.enable ? 1.0f : 0.0f);
+        ok = ok && csv.row(t, "gnc_fuel_target_deg", packet.fuel_valve_command.target_deg);
+    }
+    if (packet.has_lox_valve_command) {
+        ok = ok && csv.row(t, "gnc_lox_enable", packet.lox_valve_command.enable ? 1.0f : 0.0f);
+        ok = ok && csv.row(t, "gnc_lox_target_deg", packet.lox_valve_command.target_deg);
+    }
+    if (packet.has_fuel_valve_status) {
+        ok = ok && csv.row(t, "fuel_encoder_pos_deg", packet.fuel_valve_status.encoder_pos_deg);
+        ok = ok && csv.row(t, "fuel_is_on", packet.fuel_valve_status.is_on ? 1.0f : 0.0f);
+    }
+    if (packet.has_lox_valve_status) {
+        ok = ok && csv.row(t, "lox_encoder_pos_deg", packet.lox_valve_status.encoder_pos_deg);
+        ok = ok && csv.row(t, "lox_is_on", packet.lox_valve_status.is_on ? 1.0f : 0.0f);
+    }
+    if (packet.has_ranger_throttle_metrics) {
+        const RangerThrottleMetrics& metrics = packet.ranger_throttle_metrics;
+        ok = ok && csv.optional_row(t, "throttle_thrust_command_lbf", packet.has_throttle_thrust_command_lbf, packet.throttle_thrust_command_lbf);
+        ok = ok && csv.row(t, "predicted_thrust", metrics.predicted_thrust_lbf);
+        ok = ok && csv.row(t, "thrust_from_alpha", metrics.thrust_from_alpha_lbf);
+        ok = ok && csv.row(t, "predicted_of", metrics.predicted_of);
+        ok = ok && csv.row(t, "mdot_fuel", metrics.mdot_fuel);
+        ok = ok && csv.row(t, "mdot_lox", metrics.mdot_lox);
+        ok = ok && csv.row(t, "change_alpha_cmd", metrics.change_alpha_cmd);
+        ok = ok && csv.row(t, "clamped_change_alpha_cmd", metrics.clamped_change_alpha_cmd);
+        ok = ok && csv.row(t, "alpha", metrics.alpha);
+    }
+    return ok;
+}
+
+/// A length-delimited DataPacket, as client-new.py's _write_raw_packet() writes it.
+bool write_packet(HostFile& file, const DataPacket& packet)
+{
+    static uint8_t buf[DataPacket_size + 5];  // Varint length prefix of up to 5 bytes
+    pb_ostream_t stream = pb_ostream_from_buffer(buf, sizeof(buf));
+    if (!pb_encode_ex(&stream, DataPacket_fields, &packet, PB_ENCODE_DELIMITED)) {
+        return false;
+    }
+    return file.write(buf, stream.bytes_written);
+}
+
+// PTs reading the engine model, each with independent Gaussian noise, like the RangerThrottle tests.
+AnalogSensorReadings read_engine_pts(const RangerEngineState& engine, std::mt19937& rng)
+{
+    std::normal_distribution<float> noise(0.0f, PT_NOISE_PSI);
+    AnalogSensorReadings sensors = AnalogSensorReadings_init_default;
+    sensors.pt103 = static_cast<float>(engine.lox_manifold_psi) + noise(rng);
+    sensors.pto401 = static_cast<float>(engine.lox_inlet_psi) + noise(rng);
+    sensors.pt203 = static_cast<float>(engine.fuel_manifold_psi) + noise(rng);
+    sensors.ptf401 = static_cast<float>(engine.fuel_inlet_psi) + noise(rng);
+    sensors.ptc401 = static_cast<float>(engine.p_ch_psi) + noise(rng);
+    sensors.ptc402 = static_cast<float>(engine.p_ch_psi) + noise(rng);
+    sensors.has_pt103 = true;
+    sensors.has_pto401 = true;
+    sensors.has_pt203 = true;
+    sensors.has_ptf401 = true;
+    sensors.has_ptc401 = true;
+    sensors.has_ptc402 = true;
+    return sensors;
+}
+
+}  // namespace
+
+std::expected<void, Error> write_synthetic_hot_fire(const char* packets_path, const char* csv_path)
+{
+    HostFile packets_file(packets_path);
+    if (!packets_file.is_open()) {
+        return std::unexpected(Error::from_cause("failed to open %s", packets_path));
+    }
+    HostFile csv_file(csv_path);
+    if (!csv_file.is_open()) {
+        return std::unexpected(Error::from_cause("failed to open %s", csv_path));
+    }
+    CsvWriter csv(csv_file);
+    if (!csv.header()) {
+        return std::unexpected(Error::from_cause("failed to write %s", csv_path));
+    }
+
+    // Start from the engine running steadily with both valves at 60 deg
+    RangerEngineModel engine;
+    engine.reset();
+    for (int i = 0; i < 10'000; i++) {
+        engine.step(START_VALVE_DEG, START_VALVE_DEG, SUBSTEP_S);
+    }
+    double fuel_deg = START_VALVE_DEG;
+    double lox_deg = START_VALVE_DEG;
+    std::mt19937 rng(1);
+    RangerThrottle::reset();
+
+    static DataPacket packet;
+    float max_exec_time_ns = 0.0f;
+    for (int tick = 0; tick < TICKS; tick++) {
+        packet = DataPacket_init_default;
+        packet.time_ns = START_TIME_NS + tick * TICK_NS;
+        packet.sequence_number = tick;
+        packet.analog_sensors = read_engine_pts(engine.state(), rng);
+        packet.has_throttle_thrust_command_lbf = true;
+        packet.throttle_thrust_command_lbf = tick < STEP_TICK ? COMMAND_BEFORE_STEP_LBF : COMMAND_AFTER_STEP_LBF;
+        packet.has_fuel_valve_status = true;
+        packet.fuel_valve_status.encoder_pos_deg = static_cast<float>(fuel_deg);
+        packet.fuel_valve_status.is_on = true;
+        packet.has_lox_valve_status = true;
+        packet.lox_valve_status.encoder_pos_deg = static_cast<float>(lox_deg);
+        packet.lox_valve_status.is_on = true;
+
+        const uint64_t start_ns = bench_host_monotonic_ns();
+        auto output = RangerThrottle::tick(packet.analog_sensors, packet.throttle_thrust_command_lbf);
+        const uint64_t exec_time_ns = bench_host_monotonic_ns() - start_ns;
+        if (!output.has_value()) {
+            return std::unexpected(output.error().context("throttle tick %d failed", tick));
+        }
+        const auto& [fuel_command, lox_command, metrics] = *output;
+        packet.has_ranger_throttle_metrics = true;
+        packet.ranger_throttle_metrics = metrics;
+        packet.has_fuel_valve_command = true;
+        packet.fuel_valve_command = fuel_command;
+        packet.has_lox_valve_command = true;
+        packet.lox_valve_command = lox_command;
+
+        RateGroupTiming& timing = packet.controller_timing.throttle;
+        packet.controller_timing.has_throttle = true;
+        timing.ran = true;
+        timing.dt_s = TICK_NS * 1e-9f;
+        timing.exec_time_ns = static_cast<float>(exec_time_ns);
+        max_exec_time_ns = std::max(max_exec_time_ns, timing.exec_time_ns);
+        timing.max_exec_time_ns = max_exec_time_ns;
+        timing.run_count = tick + 1;
+
+        if (!write_packet(packets_file, packet)) {
+            return std::unexpected(Error::from_cause("failed to write packet %d to %s", tick, packets_path));
+        }
+        if (!write_csv_rows(csv, packet)) {
+            return std::unexpected(Error::from_cause("failed to write packet %d to %s", tick, csv_path));
+        }
+
+        for (int i = 0; i < SUBSTEPS; i++) {
+            fuel_deg += std::clamp(fuel_command.target_deg - fuel_deg, -MAX_VALVE_STEP_DEG, MAX_VALVE_STEP_DEG);
+            lox_deg += std::clamp(lox_command.target_deg - lox_deg, -MAX_VALVE_STEP_DEG, MAX_VALVE_STEP_DEG);
+            engine.step(fuel_deg, lox_deg, SUBSTEP_S);
+        }
+    }
+    return {};
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Error.h"
+#include <expected>
+
+/// Records a short synthetic Ranger hot fire in both formats client-new.py writes, for the replay to run without a
+/// recording from the stand: RangerThrottle closes the loop on the simulated engine (src/sim/RangerEngineModel.h)
+/// through a thrust command step, with noisy PTs, and every tick is written as a packet. The CSV carries the fields
+/// client-new.py puts in it; the packet stream also carries the controller timing.
+std::expected<void, Error> write_synthetic_hot_fire(const char* packets_path, const char* csv_path);